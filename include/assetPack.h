@@ -0,0 +1,191 @@
+/**
+ * @file assetPack.h
+ * @brief Binäres Ressourcenpaket
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * Ein Paket enthält den gesamten Konfigurationsbaum als Liste von Einträgen in
+ * Reihenfolge der Konfigurationsdateien. Zu jedem Eintrag sind optional bereits
+ * dekodierte Daten abgelegt, z.B. die Pixel einer Textur. Das Paket wird beim
+ * Laden in den Speicher eingeblendet (mmap), die Daten werden direkt aus der
+ * Abbildung verwendet.
+ *
+ * Aufbau der Datei:
+ * - \ref assetPackHeader_t
+ * - Daten aller Einträge, jeweils auf \ref ASSETPACK_ALIGNMENT ausgerichtet
+ * - Tabelle mit \ref assetPackHeader_t.entryCount Einträgen \ref assetPackEntry_t
+ */
+
+#pragma once
+
+
+/*
+ * Includes
+ *
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+
+/*
+ * Typdeklarationen
+ *
+ */
+
+#define ASSETPACK_MAGIC 0x4B504E54u //!< "TNPK" in little-endian
+#define ASSETPACK_VERSION 2         //!< Version des Dateiformats
+#define ASSETPACK_ALIGNMENT 16      //!< Ausrichtung der Daten in Bytes
+
+/**
+ * @brief Art der Daten eines Eintrags
+ *
+ */
+typedef enum {
+    ASSETPACK_DATA_NONE = 0, //!< Keine Daten, nur die Konfigurationszeile
+    ASSETPACK_DATA_PIXELS,   //!< Pixel im Format SDL_PIXELFORMAT_RGBA32
+    ASSETPACK_DATA_SAMPLES,  //!< Samples im Audioformat des Kopfs
+    ASSETPACK_DATA_FILE      //!< Unveränderter Dateiinhalt
+} assetPackDataType_t;
+
+/**
+ * @brief Kopf einer Paketdatei
+ *
+ */
+typedef struct {
+    uint32_t magic;          //!< Immer \ref ASSETPACK_MAGIC
+    uint32_t version;        //!< Immer \ref ASSETPACK_VERSION
+    uint32_t entryCount;     //!< Anzahl Einträge
+    uint32_t audioFormat;    //!< SDL Audioformat der Samples
+    uint32_t audioFrequency; //!< Abtastrate der Samples in [Hz]
+    uint32_t audioChannels;  //!< Anzahl Kanäle der Samples
+    uint64_t sourceHash;     //!< Prüfsumme der Quelldateien beim Erstellen
+    uint64_t entryOffset;    //!< Position der Eintragstabelle in der Datei
+    uint64_t fileSize;       //!< Gesamtgrösse der Datei in Bytes
+} assetPackHeader_t;
+
+/**
+ * @brief Eintrag eines Pakets, entspricht einer Zeile der Konfiguration
+ *
+ */
+typedef struct {
+    char config[256];  //!< Konfigurationszeile
+    char key[64];      //!< Die ID der Ressource
+    char type[32];     //!< Der Typ der Ressource
+    uint32_t dataType; //!< Art der Daten gemäss \ref assetPackDataType_t
+    uint32_t width;    //!< Breite in Pixel, nur für ASSETPACK_DATA_PIXELS
+    uint32_t height;   //!< Höhe in Pixel, nur für ASSETPACK_DATA_PIXELS
+    uint32_t pitch;    //!< Bytes pro Pixelzeile, nur für ASSETPACK_DATA_PIXELS
+    uint64_t offset;   //!< Position der Daten in der Datei
+    uint64_t size;     //!< Grösse der Daten in Bytes
+} assetPackEntry_t;
+
+/**
+ * @brief Ein geöffnetes und in den Speicher eingeblendetes Paket
+ *
+ * Ein mit 0 initialisiertes Paket gilt als geschlossen.
+ */
+typedef struct {
+    const uint8_t *base;             //!< Beginn der Abbildung
+    uint64_t size;                   //!< Grösse der Abbildung in Bytes
+    const assetPackHeader_t *header; //!< Kopf der Datei
+    const assetPackEntry_t *entries; //!< Eintragstabelle
+    void *mapping;                   //!< Betriebssystemspezifisches Handle
+} assetPack_t;
+
+/**
+ * @brief Schreiber zum Erstellen eines Pakets
+ *
+ */
+typedef struct {
+    FILE *file;                //!< Die Zieldatei
+    assetPackHeader_t header;  //!< Kopf, wird beim Abschluss geschrieben
+    assetPackEntry_t *entries; //!< Gesammelte Einträge
+    int count;                 //!< Anzahl Einträge
+    int capacity;              //!< Grösse von \ref entries
+    uint64_t position;         //!< Aktuelle Schreibposition
+} assetPackWriter_t;
+
+
+/*
+ * Öffentliche Funktionen
+ *
+ */
+
+/**
+ * @brief Öffnet ein Paket und blendet es in den Speicher ein.
+ *
+ * Kopf und Eintragstabelle werden überprüft. Ein Paket mit anderer Version
+ * wird abgelehnt.
+ *
+ * @param[in] packLocation Pfad der Paketdatei
+ * @param[out] pack Das geöffnete Paket
+ *
+ * @return 0, ERR_PARAMETER falls die Datei fehlt, ERR_FAIL bei ungültigem
+ * Inhalt oder Errorcode
+ */
+int AssetPack_Open(const char *packLocation, assetPack_t *pack);
+
+/**
+ * @brief Gibt die Daten eines Eintrags zurück.
+ *
+ * @param[in] pack Das geöffnete Paket
+ * @param[in] index Index des Eintrags
+ *
+ * @return Pointer in die Abbildung oder NULL falls der Eintrag keine Daten hat
+ */
+const void *AssetPack_GetData(const assetPack_t *pack, int index);
+
+/**
+ * @brief Schliesst ein Paket.
+ *
+ * Alle Pointer in die Abbildung werden ungültig. Ein geschlossenes Paket wird
+ * ignoriert.
+ *
+ * @param[in,out] pack Das Paket
+ *
+ * @return 0 oder Errorcode
+ */
+int AssetPack_Close(assetPack_t *pack);
+
+/**
+ * @brief Beginnt das Schreiben eines neuen Pakets.
+ *
+ * @param[out] writer Der Schreiber
+ * @param[in] packLocation Pfad der Paketdatei, wird überschrieben
+ * @param audioFormat SDL Audioformat der Samples
+ * @param audioFrequency Abtastrate der Samples in [Hz]
+ * @param audioChannels Anzahl Kanäle der Samples
+ * @param sourceHash Prüfsumme der Quelldateien, mit der das Paket als aktuell gilt
+ *
+ * @return 0 oder Errorcode
+ */
+int AssetPack_BeginWrite(assetPackWriter_t *writer, const char *packLocation, int audioFormat, int audioFrequency, int audioChannels, uint64_t sourceHash);
+
+/**
+ * @brief Hängt einen Eintrag samt Daten an das Paket an.
+ *
+ * Die Felder \ref assetPackEntry_t.offset und \ref assetPackEntry_t.size
+ * werden vom Schreiber gesetzt.
+ *
+ * @param[in,out] writer Der Schreiber
+ * @param[in] entry Der Eintrag
+ * @param[in] data Daten des Eintrags, darf bei \p size = 0 NULL sein
+ * @param size Grösse der Daten in Bytes
+ *
+ * @return 0 oder Errorcode
+ */
+int AssetPack_WriteEntry(assetPackWriter_t *writer, const assetPackEntry_t *entry, const void *data, uint64_t size);
+
+/**
+ * @brief Schreibt die Eintragstabelle sowie den Kopf und schliesst die Datei.
+ *
+ * Bei \p commit = 0 wird das Schreiben abgebrochen und die Datei entfernt.
+ *
+ * @param[in,out] writer Der Schreiber
+ * @param[in] packLocation Pfad der Paketdatei
+ * @param commit 1 = Paket abschliessen, 0 = abbrechen
+ *
+ * @return 0 oder Errorcode
+ */
+int AssetPack_EndWrite(assetPackWriter_t *writer, const char *packLocation, int commit);
@@ -0,0 +1,79 @@
+/**
+ * @file atlas.h
+ * @brief Platzierung von Texturen in einem Texturatlas
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * Mehrere kleine Texturen werden auf gemeinsame Seiten gepackt, damit beim
+ * Zeichnen weniger oft die Textur gewechselt werden muss. Dieses Modul
+ * berechnet nur die Platzierung, das Kopieren der Pixel übernimmt der
+ * sdlWrapper. Gepackt wird in Regalen: die Rechtecke werden nach Höhe sortiert
+ * und zeilenweise von links nach rechts abgelegt.
+ */
+
+#pragma once
+
+
+/*
+ * Includes
+ *
+ */
+
+#include <SDL.h>
+
+
+/*
+ * Typdeklarationen
+ *
+ */
+
+/**
+ * @brief Ein im Atlas zu platzierendes Rechteck
+ *
+ */
+typedef struct {
+    int w;         //!< Breite in Pixel
+    int h;         //!< Höhe in Pixel
+    int page;      //!< Seite auf der das Rechteck liegt, -1 falls es auf keine Seite passt
+    SDL_Rect rect; //!< Platzierung auf der Seite, ohne Rand
+} atlasItem_t;
+
+
+/*
+ * Öffentliche Funktionen
+ *
+ */
+
+/**
+ * @brief Platziert Rechtecke auf quadratischen Seiten.
+ *
+ * Um jedes Rechteck wird ein Rand von \p padding Pixeln freigehalten, damit
+ * beim Filtern keine Nachbarn durchscheinen. Rechtecke die mitsamt Rand
+ * grösser als eine Seite sind, erhalten die Seite -1. Die Reihenfolge von
+ * \p items bleibt erhalten.
+ *
+ * @param[in,out] items Die Rechtecke, \ref atlasItem_t.page und
+ * \ref atlasItem_t.rect werden gesetzt
+ * @param count Anzahl Rechtecke
+ * @param pageSize Breite und Höhe einer Seite in Pixel
+ * @param padding Rand um jedes Rechteck in Pixel
+ * @param[out] pageCount Anzahl benötigter Seiten
+ *
+ * @return 0 oder Errorcode
+ */
+int Atlas_Pack(atlasItem_t *items, int count, int pageSize, int padding, int *pageCount);
+
+/**
+ * @brief Berechnet die benötigte Höhe einer Seite.
+ *
+ * Seiten werden von oben gefüllt, der ungenutzte Teil unten muss nicht
+ * alloziert werden.
+ *
+ * @param[in] items Die mit Atlas_Pack() platzierten Rechtecke
+ * @param count Anzahl Rechtecke
+ * @param page Die Seite
+ * @param padding Rand wie bei Atlas_Pack()
+ *
+ * @return Höhe in Pixel, 0 für eine leere Seite
+ */
+int Atlas_PageHeight(const atlasItem_t *items, int count, int page, int padding);
@@ -18,6 +18,7 @@
  */
 
 #include "entity.h"
+#include "fixed.h"
 #include "sdlWrapper.h"
 
 
@@ -58,6 +59,23 @@
  */
 int Shell_Create(entity_t **shell, player_t *player, float x, float y, float velocity, double angle);
 
+/**
+ * @brief Erstelle einen Panzerschuss mit Startwerten in Festkommazahlen.
+ * 
+ * Wie \ref Shell_Create(), Position und Geschwindigkeit werden aber exakt
+ * übernommen. Für den deterministischen Modus der Physik, siehe
+ * \ref Physics_SetDeterministic().
+ * 
+ * @param shell Handle des Schusses, um ihn später zu löschen. Darf NULL sein.
+ * @param player Eigentümer des Panzerschusss, wird für Kollisionen verwendet
+ * @param position Startposition in der Welt
+ * @param velocity Startgeschwindigkeit des Schusses
+ * @param angle Startwinkel des Schusses [°]
+ * 
+ * @return ERR_OK, ERR_MEMORY oder ERR_FAIL
+ */
+int Shell_CreateFixed(entity_t **shell, player_t *player, fixedVector_t position, fixed_t velocity, fixed_t angle);
+
 /**
  * @brief Zerstöre einen Panzerschuss.
  * 
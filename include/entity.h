@@ -34,7 +34,7 @@
 
 #include "input.h"
 #include "sprite.h"
-#include "list.h"
+#include "intrusiveList.h"
 
 
 /*
@@ -42,7 +42,8 @@
  * 
  */
 
-struct entity_s; // Vorwärtsdeklaration einer Entitätsstruktur
+struct entity_s;        // Vorwärtsdeklaration einer Entitätsstruktur
+struct physicsStore_s;  // Vorwärtsdeklaration des Physikspeichers
 
 /**
  * @brief Status der Entität
@@ -165,6 +166,7 @@ typedef struct {
     const char *name;    //!< Name des Einzelteils
     sprite_t sprite;     //!< das reale Sprite mit Textur und relativen Angaben
     sprite_t tempSprite; //!< temporäres Sprite mit berechneten Absolutwerten
+    listLink_t link;     //!< Verkettung in \ref entity_t.parts, nur vom EntityHandler verwendet
 } entityPart_t;
 
 /**
@@ -248,18 +250,59 @@ typedef struct entity_s {
     /**
      * @brief Physikdaten der Entität
      * 
+     * Anfangswerte der Entität. Solange sie einen Slot in einem Physikspeicher
+     * belegt, sind die Werte dort massgebend und diese Struktur wird nicht
+     * nachgeführt. Gelesen wird deshalb mit den Physics_Get*() Funktionen.
      * @warning Ausser für die Initialisierung sind alle folgenden Änderungen
      * nur mittels Physics-Modul zulässig.
      */
     entityPhysics_t physics;
 
+    /**
+     * @brief Zustand vor dem letzten Simulationsschritt
+     *
+     * Position und Rotation zu Beginn des letzten \ref EntityHandler_Update().
+     * Gezeichnet wird zwischen diesem und dem aktuellen Zustand interpoliert,
+     * siehe \ref EntityHandler_Interpolate().
+     * @warning Darf nur vom EntityHandler verändert werden.
+     */
+    struct {
+        SDL_FPoint position; //!< Position [pixel]
+        double rotation;     //!< Rotation [°]
+    } previous;
+
+    /**
+     * @brief Physikspeicher in dem die Entität einen Slot belegt
+     *
+     * NULL solange die Entität keinem Speicher hinzugefügt wurde.
+     * @warning Darf nur vom physicsStore-Modul verändert werden.
+     */
+    struct physicsStore_s *physicsStore;
+
+    /**
+     * @brief Slot im Physikspeicher
+     *
+     * Index der Entität in \ref physicsStore. Dort liegen die Physikdaten aller
+     * Entitäten dicht beieinander.
+     * @warning Darf nur vom physicsStore-Modul verändert werden.
+     */
+    int physicsSlot;
+
     /**
      * @brief Liste an Einzelteilen
      * 
      * Aus diesen Einzelteilen besteht die Entität. Damit etwas sichtbar wird,
      * muss mindestens ein Teil vorhanden sein.
+     * @warning Darf nur vom EntityHandler verändert werden.
+     */
+    intrusiveList_t parts;
+
+    /**
+     * @brief Verkettung in der Entitätsliste
+     * 
+     * @warning Darf nur vom EntityHandler verändert werden.
      */
-    list_t *parts;
+    listLink_t link;
 
     /**
      * @brief Funktionscallbacks für interaktive Entitäten
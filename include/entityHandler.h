@@ -46,7 +46,10 @@
 /**
  * @brief Führt ein Update der Physik und aller Entitäten aus.
  * 
- * Aktualisiert zuerst die Entitäten und danach deren Physik.
+ * Aktualisiert zuerst die Entitäten und danach deren Physik. Danach werden
+ * die per \ref World_QueueModify() vorgemerkten Modifikationen der Welt
+ * angewendet und loses Gelände abgesetzt. Ein Aufruf entspricht einem
+ * Simulationsschritt fester Dauer, siehe \ref Scene_Update().
  * 
  * @param[in] inputEvents Eingabeevents für die Entitäten
  *
@@ -64,6 +67,22 @@ int EntityHandler_Update(inputEvent_t *inputEvents);
  */
 int EntityHandler_Draw();
 
+/**
+ * @brief Interpoliere die Einzelteile zwischen den letzten zwei Zuständen.
+ * 
+ * Setzt die berechneten Sprites aller Einzelteile auf den Zustand zwischen
+ * dem vorherigen und dem aktuellen Simulationsschritt. Damit bewegen sich die
+ * Entitäten auch dann flüssig, wenn mehr Bilder gezeichnet werden als
+ * Simulationsschritte stattfinden. Muss vor \ref EntityHandler_Draw()
+ * aufgerufen werden.
+ * 
+ * @param alpha Anteil des aktuellen Zustands, 0.0 = vorheriger Schritt,
+ * 1.0 = aktueller Schritt
+ * 
+ * @return ERR_OK, ERR_PARAMETER oder ERR_FAIL
+ */
+int EntityHandler_Interpolate(float alpha);
+
 /**
  * @brief Fügt eine Entität hinzu.
  * 
@@ -72,6 +91,9 @@ int EntityHandler_Draw();
  * Lebensdauer gültig bleiben (static).
  * @note Wird in einem laufendem Zyklus eine Entität hinzugefügt, so ist diese
  * erst nach Aufruf von \ref EntityHandler_Update() aktiv und sichtbar.
+ * @note Wird die Funktion innerhalb eines Callbacks aufgerufen, so wird das
+ * Hinzufügen bis zum Ende der aktuellen Phase aufgeschoben. Validiert wird
+ * aber sofort.
  * 
  * @param entity neue Entität
  *
@@ -82,13 +104,12 @@ int EntityHandler_AddEntity(entity_t *entity);
 /**
  * @brief Entfernt eine Entität.
  * 
- * Entfernt die gegebene Entität aus der internen Liste aller Entitäten.
- * Nach dem Aufruf darf der Speicher für die Entität freigegeben werden.
- * @warning Entfernen von Entitäten inherhalb von
- * \ref entityCallbacks_t.onCollision für Kollisionen zwischen zwei Entitäten
- * ist untersagt. Denn die andere Entität erhält im \ref entityCollision_t einen
- * Pointer zum Kollisionspartner. Ist dieser bereits gelöscht so könnte das
- * System abstürzen.
+ * Entfernt die gegebene Entität samt Einzelteilen aus der internen Liste
+ * aller Entitäten.
+ * @note Wird die Funktion innerhalb eines Callbacks aufgerufen, so wird das
+ * Entfernen bis zum Ende der aktuellen Phase aufgeschoben. Die Entität bleibt
+ * bis dahin in der Liste. Deren Speicher darf daher nur über
+ * \ref EntityHandler_FreeData() freigegeben werden.
  * 
  * @param entity zu entfernende Entität
  *
@@ -100,11 +121,7 @@ int EntityHandler_RemoveEntity(entity_t *entity);
  * @brief Entfernt alle Entitäten.
  * 
  * Entferne alle Entitäten aus der internen Liste.
- * @warning Entfernen von Entitäten inherhalb von
- * \ref entityCallbacks_t.onCollision für Kollisionen zwischen zwei Entitäten
- * ist untersagt. Denn die andere Entität erhält im \ref entityCollision_t einen
- * Pointer zum Kollisionspartner. Ist dieser bereits gelöscht so könnte das
- * System abstürzen.
+ * @note Gleiche Zyklusbedingungen wie \ref EntityHandler_RemoveEntity()
  * 
  * @return int ERR_OK, ERR_PARAMETER oder ERR_FAIL
  */
@@ -129,8 +146,7 @@ int EntityHandler_AddEntityPart(entity_t *entity, entityPart_t *part);
  * @brief Entfernt ein Einzelteil einer Entität.
  * 
  * Entfernt das gegebene Teil aus der Liste aller Teile in der Entität.
- * Nach dem Aufruf darf der Speicher für das Einzelteil freigegeben werden.
- * @warning Gleiche Löschbedingungen wie \ref EntityHandler_RemoveEntity()
+ * @note Gleiche Zyklusbedingungen wie \ref EntityHandler_RemoveEntity()
  * 
  * @param entity Entität der das Teil gehört
  * @param part zu entfernendes Einzelteil
@@ -143,10 +159,23 @@ int EntityHandler_RemoveEntityPart(entity_t *entity, entityPart_t *part);
  * @brief Entfernt alle Einzelteile einer Entität.
  * 
  * Entfernt alle Einzelteile aus der internen Liste.
- * @warning Gleiche Löschbedingungen wie \ref EntityHandler_RemoveAllEntities()
+ * @note Gleiche Zyklusbedingungen wie \ref EntityHandler_RemoveEntity()
  * 
  * @param entity Entität deren Einzelteile entfernt werden sollen
  * 
  * @return int ERR_OK, ERR_PARAMETER oder ERR_FAIL
  */
 int EntityHandler_RemoveAllEntityParts(entity_t *entity);
+
+/**
+ * @brief Befreit Speicher einer Entität.
+ * 
+ * Gibt \p data mit free() frei, sobald alle zuvor aufgeschobenen Befehle
+ * ausgeführt wurden. Ausserhalb eines Zyklus wird sofort befreit. Damit kann
+ * eine Entität sich selbst innerhalb ihrer Callbacks löschen.
+ * 
+ * @param data freizugebender Speicher, z.B. \ref entity_t.data
+ * 
+ * @return ERR_OK oder ERR_MEMORY
+ */
+int EntityHandler_FreeData(void *data);
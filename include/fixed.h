@@ -0,0 +1,142 @@
+/**
+ * @file fixed.h
+ * @brief Festkommazahlen im Format Q16.16
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * Gleitkommarechnungen und trigonometrische Funktionen der Standardbibliothek
+ * liefern je nach Compiler, Optimierung und Plattform leicht unterschiedliche
+ * Ergebnisse. Diese Festkommazahlen rechnen nur mit Ganzzahlen, Winkelfunktionen
+ * werden aus Tabellen interpoliert. Damit ist jedes Ergebnis auf allen
+ * Plattformen bitgenau gleich, siehe \ref Physics_SetDeterministic().
+ */
+
+#pragma once
+
+
+/*
+ * Includes
+ *
+ */
+
+#include <stdint.h>
+
+
+/*
+ * Typdeklarationen
+ *
+ */
+
+#define FIXED_SHIFT 16               //!< Anzahl Nachkommabits
+#define FIXED_ONE (1 << FIXED_SHIFT) //!< Die Zahl 1.0
+
+typedef int32_t fixed_t; //!< Festkommazahl, 16 Bit vor und 16 Bit nach dem Komma
+
+/**
+ * @brief Vektor aus zwei Festkommazahlen
+ *
+ */
+typedef struct {
+    fixed_t x; //!< x-Komponente
+    fixed_t y; //!< y-Komponente
+} fixedVector_t;
+
+
+/*
+ * Öffentliche Funktionen
+ *
+ */
+
+/**
+ * @brief Wandelt eine Ganzzahl in eine Festkommazahl.
+ *
+ * @param value Ganzzahl, muss im Bereich von ±32767 liegen
+ *
+ * @return Die Festkommazahl
+ */
+fixed_t Fixed_FromInt(int value);
+
+/**
+ * @brief Wandelt eine Gleitkommazahl in eine Festkommazahl.
+ * Es wird auf die nächste Festkommazahl gerundet, ausserhalb des Bereichs
+ * wird begrenzt. NAN ergibt 0.
+ *
+ * @param value Gleitkommazahl
+ *
+ * @return Die Festkommazahl
+ */
+fixed_t Fixed_FromFloat(float value);
+
+/**
+ * @brief Wandelt eine Festkommazahl in eine Gleitkommazahl.
+ *
+ * @param value Festkommazahl
+ *
+ * @return Nächste darstellbare Gleitkommazahl
+ */
+float Fixed_ToFloat(fixed_t value);
+
+/**
+ * @brief Wandelt eine Festkommazahl in eine Ganzzahl.
+ * Die Nachkommastellen werden wie bei einem Cast von float nach int
+ * abgeschnitten, also gegen 0 gerundet.
+ *
+ * @param value Festkommazahl
+ *
+ * @return Die Ganzzahl
+ */
+int Fixed_ToInt(fixed_t value);
+
+/**
+ * @brief Multipliziert zwei Festkommazahlen.
+ * Das Ergebnis wird gerundet und begrenzt.
+ *
+ * @param a erster Faktor
+ * @param b zweiter Faktor
+ *
+ * @return Das Produkt
+ */
+fixed_t Fixed_Mul(fixed_t a, fixed_t b);
+
+/**
+ * @brief Dividiert zwei Festkommazahlen.
+ * Das Ergebnis wird gegen 0 gerundet und begrenzt, eine Division durch 0
+ * ergibt den grössten Wert mit dem Vorzeichen von \p a.
+ *
+ * @param a Dividend
+ * @param b Divisor
+ *
+ * @return Der Quotient
+ */
+fixed_t Fixed_Div(fixed_t a, fixed_t b);
+
+/**
+ * @brief Sinus eines Winkels in Grad.
+ * Linear interpoliert aus einer Tabelle mit 256 Einträgen pro Viertelkreis,
+ * der Fehler ist kleiner als 0.0001.
+ *
+ * @param degrees Winkel [°], beliebig
+ *
+ * @return Sinus im Bereich von -1.0 bis 1.0
+ */
+fixed_t Fixed_Sin(fixed_t degrees);
+
+/**
+ * @brief Cosinus eines Winkels in Grad, siehe \ref Fixed_Sin().
+ *
+ * @param degrees Winkel [°], beliebig
+ *
+ * @return Cosinus im Bereich von -1.0 bis 1.0
+ */
+fixed_t Fixed_Cos(fixed_t degrees);
+
+/**
+ * @brief Winkel eines Vektors in Grad, wie atan2().
+ * Linear interpoliert aus einer Tabelle mit 256 Einträgen pro Achtelkreis.
+ *
+ * @param y y-Komponente
+ * @param x x-Komponente
+ *
+ * @return Winkel zur x-Achse im Bereich von -180° bis 180°, 0 für den Nullvektor
+ */
+fixed_t Fixed_Atan2(fixed_t y, fixed_t x);
@@ -20,7 +20,7 @@
 #include "SDL_ttf.h"
 #include "sdlWrapper.h"
 #include "input.h"
-#include "list.h"
+#include "intrusiveList.h"
 #include "guiElements/button.h"
 #include "guiElements/text.h"
 
@@ -52,6 +52,7 @@ typedef union {
 typedef struct {
     guiElemntType_t type;       //!< Element Typen Bezeichnung (0 = Button, 1 = Text, ...)
     elementUnion_t elementData; //!< Zugriff auf die Union von Elementen
+    listLink_t link;            //!< Kettenglied in der Elementliste des GUI
 } guiElement_t;
 
 /**
@@ -60,7 +61,7 @@ typedef struct {
  */
 
 typedef struct {
-    list_t element; //!< Die Liste der Elemente
+    intrusiveList_t element; //!< Die Liste der Elemente
 } gui_t;
 
 
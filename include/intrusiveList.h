@@ -0,0 +1,133 @@
+/**
+ * @file intrusiveList.h
+ * @brief Doppelt verlinkte intrusive Liste
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * Im Gegensatz zu \ref list_t wird hier kein Element alloziert. Jede Struktur
+ * die in eine Liste aufgenommen werden soll, trägt ihr eigenes Kettenglied
+ * \ref listLink_t. Dadurch ist das Entfernen in O(1) möglich, ohne die Liste
+ * zu durchsuchen.
+ */
+
+#pragma once
+
+
+/*
+ * Includes
+ *
+ */
+
+#include "list.h"
+
+
+/*
+ * Typdeklarationen
+ *
+ */
+
+/**
+ * @brief Kettenglied einer \ref intrusiveList_t
+ *
+ * Wird in die Struktur eingebettet, welche in die Liste aufgenommen werden
+ * soll. Ein mit 0 initialisiertes Glied gilt als nicht verkettet.
+ */
+typedef struct listLink_s {
+    void *data;                //!< Die Struktur zu der das Glied gehört
+    struct listLink_s *next;   //!< Das nächste Glied in der Liste
+    struct listLink_s **pprev; //!< Zeiger auf den Verweis der auf dieses Glied zeigt, NULL = nicht verkettet
+} listLink_t;
+
+/**
+ * @brief Intrusive doppelt verlinkte Liste
+ *
+ * Ein mit 0 initialisierte Liste ist leer und gültig.
+ */
+typedef struct {
+    listLink_t *first; //!< Das erste Glied in der Liste
+    int elementCount;  //!< Anzahl Glieder in der Liste
+} intrusiveList_t;
+
+
+/*
+ * Öffentliche Funktionen
+ *
+ */
+
+/**
+ * @brief Initialisiert eine leere Liste.
+ *
+ * @param[in] list Die Liste die Initialisiert werden soll
+ *
+ * @return 0 oder Errorcode
+ */
+int IntrusiveList_Init(intrusiveList_t *list);
+
+/**
+ * @brief Fügt ein Glied am Anfang der Liste hinzu.
+ * Ein Glied kann nur in einer Liste gleichzeitig sein.
+ *
+ * @param[in] list Die Liste die bearbeitet wird
+ * @param[in] link Das Kettenglied das eingefügt wird
+ * @param[in] data Die Struktur zu der das Glied gehört
+ *
+ * @return 0, ERR_SEQUENCE falls das Glied bereits verkettet ist oder Errorcode
+ */
+int IntrusiveList_Add(intrusiveList_t *list, listLink_t *link, void *data);
+
+/**
+ * @brief Entfernt ein Glied aus der Liste in O(1).
+ * Ein nicht verkettetes Glied wird ignoriert.
+ *
+ * @warning \p link muss Teil von \p list sein, ansonsten stimmt die Anzahl
+ * Elemente der Listen nicht mehr.
+ *
+ * @param[in] list Die Liste die bearbeitet wird
+ * @param[in] link Das Kettenglied das entfernt wird
+ *
+ * @return 0 oder Errorcode
+ */
+int IntrusiveList_Remove(intrusiveList_t *list, listLink_t *link);
+
+/**
+ * @brief Entfernt alle Glieder aus der Liste.
+ *
+ * @param[in] list Die Liste die bearbeitet wird
+ *
+ * @return 0 oder Errorcode
+ */
+int IntrusiveList_Clear(intrusiveList_t *list);
+
+/**
+ * @brief Prüft ob ein Glied in einer Liste verkettet ist.
+ *
+ * @param[in] link Das zu prüfende Kettenglied
+ *
+ * @return 0 = nicht verkettet, 1 = verkettet
+ */
+int IntrusiveList_IsLinked(const listLink_t *link);
+
+/**
+ * @brief Führt \p callback für alle Elemente aus.
+ * Bei einem Error wird die Schleife abgebrochen. Der Callback darf das Glied
+ * für das er aufgerufen wird entfernen.
+ *
+ * @param[in] list Die Liste die bearbeitet wird
+ * @param[in] callback Funktion die für jedes Element aufgerufen wird
+ *
+ * @return 0 oder Errorcode
+ */
+int IntrusiveList_Foreach(intrusiveList_t *list, fnPntrDataCallback callback);
+
+/**
+ * @brief Führt \p callback für alle Elemente aus.
+ * Bei einem Error wird die Schleife abgebrochen. Der Callback darf das Glied
+ * für das er aufgerufen wird entfernen.
+ *
+ * @param[in] list Die Liste die bearbeitet wird
+ * @param[in] callback Funktion die für jedes Element aufgerufen wird
+ * @param[in] userData Daten die jeder Aufruf zusätzlich bekommt
+ *
+ * @return 0 oder Errorcode
+ */
+int IntrusiveList_ForeachArg(intrusiveList_t *list, fnPntrDataCallbackArg callback, void *userData);
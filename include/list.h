@@ -38,6 +38,27 @@ typedef struct listElement_s {
     struct listElement_s *nextElement; //!< Das nächste Element in der Liste
 } listElement_t;
 
+/**
+ * @brief Ein Speicherblock des Elementpools \ref listPool_t
+ *
+ */
+typedef struct listPoolChunk_s {
+    struct listPoolChunk_s *nextChunk; //!< Der nächste Speicherblock
+    listElement_t elements[];          //!< Platz für die Elemente dieses Blocks
+} listPoolChunk_t;
+
+/**
+ * @brief Pool aus dem die Elemente einer Liste bezogen werden.
+ * Elemente werden blockweise alloziert und beim Entfernen in die Freiliste
+ * zurückgelegt. Ist der Pool einmal gross genug, entsteht kein Heapzugriff mehr.
+ *
+ */
+typedef struct listPool_s {
+    listPoolChunk_t *chunks;      //!< Alle allozierten Speicherblöcke
+    listElement_t *freeElements;  //!< Freiliste, verkettet über nextElement
+    int chunkCapacity;            //!< Anzahl Elemente pro Speicherblock
+} listPool_t;
+
 /**
  * @brief Einfach verlinkte dynamische liste
  *
@@ -46,6 +67,7 @@ typedef struct list_t {
     listElement_t *listHead;         //!< Das erste Element in der Liste
     int elementCount;                //!< Anzahl Elemente in der Liste
     fnPntrDataCallback dataAutoFree; //!< Wird benutzt um Datenstrukturen beim Entfernen automatisch zu deallozieren.
+    listPool_t *pool;                //!< Optionaler Elementpool, NULL = jedes Element einzeln allozieren
 } list_t;
 
 /*
@@ -73,6 +95,33 @@ int List_Create(list_t **list);
  */
 int List_Init(list_t *list);
 
+/**
+ * @brief Gibt einer list_t einen eigenen Elementpool.
+ * Die Elemente werden in Blöcken von \p capacityHint Elementen alloziert und
+ * beim Entfernen wiederverwendet. Der Pool wird mit List_Destroy() oder
+ * List_ReleasePool() befreit, List_Clear() behält ihn. Ein bereits vorhandener
+ * Pool wird samt allen Elementen zuerst befreit.
+ *
+ * @note Die Liste muss mit List_Create() oder List_Init() initialisiert sein.
+ * @note Erlaubter Wertebereich von \p capacityHint 1..65536
+ *
+ * @param[in] list Die Liste die einen Pool erhalten soll
+ * @param[in] capacityHint Erwartete Anzahl gleichzeitiger Elemente
+ *
+ * @return 0 oder Errorcode
+ */
+int List_InitPooled(list_t *list, int capacityHint);
+
+/**
+ * @brief Entfernt alle Elemente und befreit den Elementpool.
+ * Danach alloziert die Liste ihre Elemente wieder einzeln.
+ *
+ * @param[in] list Die Liste die bearbeitet wird
+ *
+ * @return 0 oder Errorcode
+ */
+int List_ReleasePool(list_t *list);
+
 /**
  * @brief Befreit die benutzten Ressourcen der Liste.
  * Befreit auch die benutzten Ressourcen der Elemente.
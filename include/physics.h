@@ -22,8 +22,8 @@
  * 
  */
 
-#include "list.h"
 #include "entity.h"
+#include "physicsStore.h"
 
 
 /*
@@ -31,7 +31,8 @@
  * 
  */
 
-/* ... */
+#define PHYSICS_STEP_RATE 60                         //!< Simulationsschritte pro Sekunde
+#define PHYSICS_STEP_TIME (1.0f / PHYSICS_STEP_RATE) //!< Dauer eines Simulationsschritts [s]
 
 
 /*
@@ -50,17 +51,152 @@
 /**
  * @brief Aktualisiere die Physik aller Entitäten.
  * 
- * Jede Entität hält in ihrer Struktur die eigenen Physikdaten. Diese werden von
- * dieser Funktion verarbeitet und ggf. aktualisiert. Weiter werden daraus die
- * x/y Koordinaten verändert, sofern dies erlaubt ist (keine Kollision mit
- * anderen Entitäten oder der Welt). Wird eine Kollision entdeckt, so wird der
- * onCollision-Callback beider Entitäten aufgerufen.
+ * Die Physikdaten aller Entitäten liegen in den dichten Arrays des
+ * Physikspeichers und werden dort linear verarbeitet. Weiter werden daraus die
+ * x/y Koordinaten verändert, sofern dies erlaubt ist (keine
+ * Kollision mit anderen Entitäten oder der Welt). Wird eine Kollision entdeckt,
+ * so wird der onCollision-Callback beider Entitäten aufgerufen.
+ * Mögliche Paare von Entitäten liefert eine Breitphase über einen räumlichen
+ * Hash, jedes Paar wird pro Update nur einmal geprüft.
+ * 
+ * @param[in,out] store Physikspeicher mit allen Entitäten
+ * 
+ * @return ERR_OK, ERR_PARAMETER, ERR_FAIL oder ERR_MEMORY
+ */
+int Physics_Update(physicsStore_t *store);
+
+/**
+ * @brief Schaltet den deterministischen Modus ein oder aus.
+ * 
+ * Im deterministischen Modus rechnet \ref Physics_Update() Positionen,
+ * Geschwindigkeiten, Erdbeschleunigung und Kollisionsnormalen in
+ * Festkommazahlen Q16.16, siehe \ref fixed.h. Auch
+ * \ref Physics_VectorToAngle() und \ref Physics_PolarToVector() verwenden
+ * dann Tabellen statt der Standardbibliothek. Gleiche Eingaben ergeben so auf
+ * allen Plattformen und mit allen Compilern bitgenau denselben Zustand, was
+ * Wiederholungen und synchrones Spiel über das Netzwerk ermöglicht. Die
+ * Gleitkommawerte von \ref Physics_GetPosition() und
+ * \ref Physics_GetVelocity() bleiben gültig, sind aber nur noch eine Kopie.
+ * Standardmässig ist der Modus ausgeschaltet.
+ * 
+ * @param enabled 1 zum Einschalten, 0 zum Ausschalten
+ * 
+ * @return immer 0
+ */
+int Physics_SetDeterministic(int enabled);
+
+/**
+ * @brief Ist der deterministische Modus eingeschaltet?
+ * 
+ * Spiellogik die selbst Zustand der Physik berechnet, etwa die Startwerte
+ * eines Schusses, verwendet dann die Physics_*Fixed() Funktionen.
+ * 
+ * @return 1 falls eingeschaltet, sonst 0
+ */
+int Physics_IsDeterministic(void);
+
+/**
+ * @brief Berechne den Winkel eines Vektors.
+ * 
+ * Die y-Achse zeigt wie auf dem Bildschirm nach unten, ein Vektor nach unten
+ * hat also den Winkel 90°.
+ * 
+ * @param x x-Komponente
+ * @param y y-Komponente (nicht kartesisch!, 0 = oben)
+ * 
+ * @return Winkel zur Horizontalen [°], -180° bis 180°, positiv = Uhrzeigersinn
+ */
+double Physics_VectorToAngle(float x, float y);
+
+/**
+ * @brief Berechne einen Vektor aus Betrag und Winkel.
+ * 
+ * Gegenstück zu \ref Physics_VectorToAngle(), mit demselben Winkel wie
+ * \ref Physics_SetVelocityPolar().
+ * 
+ * @param length Betrag des Vektors
+ * @param angle Winkel zur Horizontalen [°], positiv = Uhrzeigersinn
+ * 
+ * @return Der Vektor (nicht kartesisch!, y = 0 oben)
+ */
+SDL_FPoint Physics_PolarToVector(float length, double angle);
+
+/**
+ * @brief Berechne einen Vektor aus Betrag und Winkel in Festkommazahlen.
+ * 
+ * Wie \ref Physics_PolarToVector(), rechnet aber unabhängig vom Modus nur mit
+ * den Tabellen aus \ref fixed.h.
+ * 
+ * @param length Betrag des Vektors
+ * @param angle Winkel zur Horizontalen [°], positiv = Uhrzeigersinn
+ * 
+ * @return Der Vektor (nicht kartesisch!, y = 0 oben)
+ */
+fixedVector_t Physics_PolarToVectorFixed(fixed_t length, fixed_t angle);
+
+/**
+ * @brief Lese die Position.
+ * 
+ * Belegt die Entität einen Slot in einem Physikspeicher, so wird von dort
+ * gelesen, ansonsten aus \ref entity_t.physics. Gilt für alle Physics_Get*()
+ * Funktionen.
+ * 
+ * @param entity Entität deren Position gelesen wird
+ * 
+ * @return Position des Zentrums [pixel], 0/0 falls \p entity NULL ist
+ */
+SDL_FPoint Physics_GetPosition(const entity_t *entity);
+
+/**
+ * @brief Lese die Geschwindigkeit.
+ * 
+ * @param entity Entität deren Geschwindigkeit gelesen wird
+ * 
+ * @return Geschwindigkeit [pixel / s], 0/0 falls \p entity NULL ist
+ */
+SDL_FPoint Physics_GetVelocity(const entity_t *entity);
+
+/**
+ * @brief Lese die Rotation.
+ * 
+ * @param entity Entität deren Rotation gelesen wird
+ * 
+ * @return Winkel zur Horizontalen [°], 0 falls \p entity NULL ist
+ */
+double Physics_GetRotation(const entity_t *entity);
+
+/**
+ * @brief Lese die Position in Festkommazahlen.
+ * 
+ * Im deterministischen Modus ist dies der massgebende Wert, ansonsten wird
+ * die Gleitkommaposition umgerechnet.
  * 
- * @param[in] entityList Liste aller Entitäten
+ * @param entity Entität deren Position gelesen wird
  * 
- * @return ERR_OK, ERR_PARAMETER oder ERR_FAIL
+ * @return Position des Zentrums [pixel], 0/0 falls \p entity NULL ist
  */
-int Physics_Update(list_t *entityList);
+fixedVector_t Physics_GetPositionFixed(const entity_t *entity);
+
+/**
+ * @brief Lese die Rotation in Festkommazahlen.
+ * 
+ * Wurde die Rotation mit \ref Physics_SetRotationFixed() gesetzt, ist der
+ * Wert exakt derselbe.
+ * 
+ * @param entity Entität deren Rotation gelesen wird
+ * 
+ * @return Winkel zur Horizontalen [°], 0 falls \p entity NULL ist
+ */
+fixed_t Physics_GetRotationFixed(const entity_t *entity);
+
+/**
+ * @brief Lese die Kollisionsbox.
+ * 
+ * @param entity Entität deren Kollisionsbox gelesen wird
+ * 
+ * @return Die AABB, leer falls \p entity NULL ist
+ */
+SDL_Rect Physics_GetAABB(const entity_t *entity);
 
 /**
  * @brief Setze die Position.
@@ -169,6 +305,44 @@ int Physics_SetRelativeVelocityPolar(entity_t *entity, float velocity, double an
  */
 int Physics_SetRotation(entity_t *entity, double rotation);
 
+/**
+ * @brief Setze die Position in Festkommazahlen.
+ * 
+ * Im deterministischen Modus wird der Wert ohne Umweg über Gleitkommazahlen
+ * übernommen, die Gleitkommaposition ist nur eine Kopie.
+ * 
+ * @param entity Entität deren Position gesetzt werden soll
+ * @param position Position des Zentrums [pixel]
+ * 
+ * @return ERR_OK oder ERR_PARAMETER
+ */
+int Physics_SetPositionFixed(entity_t *entity, fixedVector_t position);
+
+/**
+ * @brief Setze die Geschwindigkeit in Festkommazahlen.
+ * 
+ * Gegenstück zu \ref Physics_SetPositionFixed().
+ * 
+ * @param entity Entität deren Geschwindigkeit gesetzt werden soll
+ * @param velocity Geschwindigkeit [pixel / s]
+ * 
+ * @return ERR_OK oder ERR_PARAMETER
+ */
+int Physics_SetVelocityFixed(entity_t *entity, fixedVector_t velocity);
+
+/**
+ * @brief Setze die Rotation in Festkommazahlen.
+ * 
+ * Gegenstück zu \ref Physics_SetPositionFixed(). Der Wert wird exakt
+ * gespeichert und von \ref Physics_GetRotationFixed() wieder geliefert.
+ * 
+ * @param entity Entität deren Rotation gesetzt werden soll
+ * @param rotation Winkel zur Horizontalen [°], positiv = Uhrzeigersinn
+ * 
+ * @return ERR_OK oder ERR_PARAMETER
+ */
+int Physics_SetRotationFixed(entity_t *entity, fixed_t rotation);
+
 /**
  * @brief Setze die relative Rotation
  * 
@@ -182,3 +356,29 @@ int Physics_SetRotation(entity_t *entity, double rotation);
  * @return ERR_OK oder ERR_PARAMETER
  */
 int Physics_SetRelativeRotation(entity_t *entity, double rotation);
+
+/**
+ * @brief Setze ob die Entität bewegungslos ist.
+ * 
+ * Siehe \ref entityPhysics_t.isStatic.
+ * 
+ * @param entity Entität die verändert werden soll
+ * @param isStatic 1 = bewegungslos, 0 = beweglich
+ * 
+ * @return ERR_OK oder ERR_PARAMETER
+ */
+int Physics_SetStatic(entity_t *entity, int isStatic);
+
+/**
+ * @brief Setze die Grösse der Kollisionsbox.
+ * 
+ * Die Kollisionsbox bleibt um die Position der Entität zentriert. Eine Grösse
+ * von 0 schliesst die Entität von allen Kollisionen mit anderen Entitäten aus.
+ * 
+ * @param entity Entität deren Kollisionsbox gesetzt werden soll
+ * @param w Breite [pixel]
+ * @param h Höhe [pixel]
+ * 
+ * @return ERR_OK oder ERR_PARAMETER
+ */
+int Physics_SetSize(entity_t *entity, int w, int h);
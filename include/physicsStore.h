@@ -0,0 +1,160 @@
+/**
+ * @file physicsStore.h
+ * @brief Dichter Speicher der Physikdaten aller Entitäten
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * Die Physikdaten werden hier als "Structure of Arrays" abgelegt. Jede Entität
+ * belegt einen Slot, d.h. einen Index in allen Arrays. Das physics-Modul kann
+ * somit linear über Position, Geschwindigkeit und AABB iterieren, ohne die
+ * restlichen Daten der Entitäten in den Cache zu laden.
+ */
+
+#pragma once
+
+
+/*
+ * Includes
+ *
+ */
+
+#include <SDL.h>
+
+#include "fixed.h"
+
+
+/*
+ * Typdeklarationen
+ *
+ */
+
+struct entity_s; // Vorwärtsdeklaration einer Entitätsstruktur
+
+/**
+ * @brief Räumlicher Hash der Kollisionsboxen für die Breitphase
+ *
+ * Wird von \ref Physics_Update() in jedem Schritt neu aufgebaut. Die Puffer
+ * gehören dem Speicher und werden erst mit \ref PhysicsStore_Destroy()
+ * befreit, damit nicht jeder Schritt alloziert.
+ */
+typedef struct {
+    int *bucketStart;   //!< Erster Eintrag jedes Eimers, ein zusätzliches Element für das Ende
+    int *entries;       //!< Slots nach Eimer sortiert, ein Eintrag pro belegter Zelle
+    int entryCapacity;  //!< Anzahl allozierter Einträge
+    int *visited;       //!< Letzte Abfrage die einen Slot gefunden hat, pro Slot
+    int *candidates;    //!< Mögliche Partner der letzten Abfrage
+    int *oversized;     //!< Slots mit zu vielen Zellen, diese werden mit allen geprüft
+    int oversizedCount; //!< Anzahl Slots in \ref oversized
+    int slotCapacity;   //!< Anzahl allozierter Slots von \ref visited, \ref candidates und \ref oversized
+    int query;          //!< Nummer der letzten Abfrage
+} physicsBroadPhase_t;
+
+/**
+ * @brief Physikdaten eines Slots im deterministischen Modus
+ *
+ * Massgebend sind die Werte in Q16.16, Position und Geschwindigkeit des Slots
+ * sind dann nur eine Kopie davon. Siehe \ref Physics_SetDeterministic().
+ * Die Rotation wird von der Physik nicht verändert und deshalb in beiden
+ * Modi mitgeführt.
+ */
+typedef struct {
+    fixedVector_t position;  //!< Position in Q16.16
+    fixedVector_t velocity;  //!< Geschwindigkeit in Q16.16
+    fixed_t rotation;        //!< Rotation in Q16.16 [°]
+} physicsFixed_t;
+
+/**
+ * @brief Physikspeicher mit einem Slot pro Entität
+ *
+ * Ein mit 0 initialisierter Speicher ist leer und gültig. Die Slots von 0 bis
+ * \ref count - 1 sind in der Reihenfolge des Hinzufügens. Entfernte
+ * Entitäten hinterlassen einen freien Slot mit \ref entity NULL, diese werden
+ * mit \ref PhysicsStore_Compact() zu Beginn jedes \ref Physics_Update()
+ * geschlossen. Solange eine Entität einen Slot belegt, sind die Werte hier
+ * massgebend und nicht die in \ref entity_t.physics. Gelesen und geschrieben
+ * werden sie über die Physics_Get* und Physics_Set* Funktionen.
+ */
+typedef struct physicsStore_s {
+    struct entity_s **entity; //!< Entität eines Slots
+    SDL_FPoint *position;     //!< Positionen, siehe \ref entityPhysics_t.position
+    SDL_FPoint *velocity;     //!< Geschwindigkeiten, siehe \ref entityPhysics_t.velocity
+    double *rotation;         //!< Rotationen, siehe \ref entityPhysics_t.rotation
+    SDL_Rect *aabb;           //!< Kollisionsboxen, siehe \ref entityPhysics_t.aabb
+    int *isStatic;            //!< Bewegungslos, siehe \ref entityPhysics_t.isStatic
+    physicsFixed_t *fixed;    //!< Festkommawerte für den deterministischen Modus
+    int *liftHint;            //!< Zuletzt gefundene Befreiungshöhe aus der Welt, Startwert der nächsten Suche
+    int fixedValid;           //!< Die Festkommawerte sind aktuell, siehe \ref Physics_SetDeterministic()
+    int count;                //!< Anzahl Slots inklusive der freien
+    int freeCount;            //!< Anzahl freier Slots, siehe \ref PhysicsStore_Compact()
+    int capacity;             //!< Anzahl allozierter Slots
+    physicsBroadPhase_t broadPhase; //!< Breitphase der Kollisionsprüfung
+} physicsStore_t;
+
+
+/*
+ * Öffentliche Funktionen
+ *
+ */
+
+/**
+ * @brief Fügt eine Entität dem Speicher hinzu.
+ *
+ * Die Entität erhält den nächsten freien Slot, dieser wird in
+ * \ref entity_t.physicsStore und \ref entity_t.physicsSlot vermerkt. Die
+ * Physikdaten werden einmalig aus \ref entity_t.physics übernommen.
+ *
+ * @param[in,out] store Der Physikspeicher
+ * @param[in,out] entity Die Entität die hinzugefügt wird
+ *
+ * @return 0, ERR_SEQUENCE falls die Entität bereits in einem Speicher ist oder Errorcode
+ */
+int PhysicsStore_Add(physicsStore_t *store, struct entity_s *entity);
+
+/**
+ * @brief Entfernt eine Entität aus dem Speicher.
+ *
+ * Die Physikdaten werden zurück in \ref entity_t.physics geschrieben. Der
+ * Slot wird nur als frei markiert, damit auch viele Entfernungen pro Schritt
+ * nichts verschieben müssen. Eine nicht vorhandene Entität wird ignoriert.
+ *
+ * @param[in,out] store Der Physikspeicher
+ * @param[in] entity Die Entität die entfernt wird
+ *
+ * @return 0 oder Errorcode
+ */
+int PhysicsStore_Remove(physicsStore_t *store, struct entity_s *entity);
+
+/**
+ * @brief Schliesst die freien Slots.
+ *
+ * Die folgenden Slots rücken in einem Durchgang nach vorne, die Reihenfolge
+ * des Hinzufügens und somit die Reihenfolge der Kollisionsprüfung bleibt
+ * erhalten. Wird von \ref Physics_Update() aufgerufen.
+ *
+ * @param[in,out] store Der Physikspeicher
+ *
+ * @return 0 oder Errorcode
+ */
+int PhysicsStore_Compact(physicsStore_t *store);
+
+/**
+ * @brief Prüft ob eine Entität einen Slot im Speicher belegt.
+ *
+ * @param[in] store Der Physikspeicher
+ * @param[in] entity Die zu prüfende Entität
+ *
+ * @return 0 = nicht vorhanden, 1 = vorhanden
+ */
+int PhysicsStore_Contains(const physicsStore_t *store, const struct entity_s *entity);
+
+/**
+ * @brief Entfernt alle Entitäten und befreit den Speicher.
+ *
+ * Wie bei \ref PhysicsStore_Remove() werden die Physikdaten zurück in die
+ * Entitäten geschrieben.
+ *
+ * @param[in,out] store Der Physikspeicher
+ *
+ * @return 0 oder Errorcode
+ */
+int PhysicsStore_Destroy(physicsStore_t *store);
@@ -0,0 +1,108 @@
+/**
+ * @file profiler.h
+ * @brief Zeitmessung des Programmstarts
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * Misst die Dauer der einzelnen Schritte beim Start, z.B. die Initialisierung
+ * der SDL-Subsysteme, das Laden jeder Ressource und das Erstellen der Szenen.
+ * Der Profiler ist standardmässig aus und wird mit dem Befehlszeilenargument
+ * "--profile[=datei]" oder der Umgebungsvariable TANKS_PROFILE[=datei]
+ * eingeschaltet. Ausgeschaltet kosten die Funktionen praktisch nichts.
+ * Profiler_Report() gibt die Messungen sortiert aus und schreibt sie als JSON.
+ */
+
+#pragma once
+
+
+/*
+ * Includes
+ *
+ */
+
+#include <stdint.h>
+
+
+/*
+ * Typdeklarationen
+ *
+ */
+
+/* ... */
+
+
+/*
+ * Öffentliche Funktionen
+ *
+ */
+
+/**
+ * @brief Schaltet den Profiler gemäss Befehlszeile oder Umgebung ein.
+ * Ab diesem Aufruf wird die Gesamtdauer gemessen.
+ *
+ * @param argc Anzahl Befehlszeilenargumente
+ * @param[in] argv Array der Argumente, darf bei \p argc = 0 NULL sein
+ *
+ * @return 0 oder Errorcode
+ */
+int Profiler_Init(int argc, char *argv[]);
+
+/**
+ * @brief Prüft ob der Profiler eingeschaltet ist.
+ *
+ * @return 1 wenn eingeschaltet, sonst 0
+ */
+int Profiler_IsEnabled(void);
+
+/**
+ * @brief Startet eine Messung.
+ * Darf aus jedem Thread aufgerufen werden.
+ *
+ * @return Startzeitpunkt für Profiler_Elapsed() oder Profiler_End(), 0 wenn ausgeschaltet
+ */
+uint64_t Profiler_Begin(void);
+
+/**
+ * @brief Berechnet die seit \p start vergangene Zeit.
+ * Darf aus jedem Thread aufgerufen werden.
+ *
+ * @param start Startzeitpunkt von Profiler_Begin()
+ *
+ * @return Dauer in Millisekunden, 0 wenn ausgeschaltet
+ */
+double Profiler_Elapsed(uint64_t start);
+
+/**
+ * @brief Speichert eine Messung.
+ * Nur aus dem Hauptthread aufrufen.
+ *
+ * @param[in] category Art des Schritts, z.B. "init", "resource" oder "scene"
+ * @param[in] name Name des Schritts
+ * @param[in] type Zusätzlicher Typ wie der Ressourcentyp, darf NULL sein
+ * @param bytes Grösse der Quelldaten, -1 falls unbekannt
+ * @param decodeMs Davon zum Dekodieren benötigte Millisekunden
+ * @param ms Gesamtdauer in Millisekunden
+ *
+ * @return 0 oder Errorcode
+ */
+int Profiler_Record(const char *category, const char *name, const char *type, long long bytes, double decodeMs, double ms);
+
+/**
+ * @brief Beendet eine mit Profiler_Begin() gestartete Messung und speichert sie.
+ * Nur aus dem Hauptthread aufrufen.
+ *
+ * @param start Startzeitpunkt von Profiler_Begin()
+ * @param[in] category Art des Schritts
+ * @param[in] name Name des Schritts
+ *
+ * @return 0 oder Errorcode
+ */
+int Profiler_End(uint64_t start, const char *category, const char *name);
+
+/**
+ * @brief Gibt die Messungen nach Dauer sortiert aus und schreibt sie als JSON.
+ * Danach werden die Messungen verworfen und der Profiler ausgeschaltet.
+ *
+ * @return 0 oder Errorcode
+ */
+int Profiler_Report(void);
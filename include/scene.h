@@ -53,8 +53,8 @@ typedef enum {
  * @brief Verlinkung aller GUI Elemente der Szene NamePlayer
  * 
  * Zum auslesen oder bearbeiten einzelner GUI Elemente dieser Szene
- * erhalten sie Zeiger darauf. Zusätzlich wird die komplette Liste
- * aller Elemente übergeben, welche dann gezeichnet werden können.
+ * erhalten sie Zeiger darauf. Zusätzlich zeigt ein Zeiger auf die komplette Liste
+ * aller Elemente, welche dann gezeichnet werden können.
  */
 typedef struct {
 	guiElement_t *bttnPlayerA;		//!< Schriftzug "Player A"
@@ -62,30 +62,30 @@ typedef struct {
 	guiElement_t *bttnPlayerB;		//!< Schriftzug "Player B"
 	guiElement_t *tiNamePlayerB;	//!< Namen Text Input Spieler B
 	guiElement_t *bttnNext;			//!< schaltet zur nächsten Szene
-	gui_t sceneNamPlaGUI;			//!< Liste mit sämtlichen GUI Elemente dieser Szene
+	gui_t *sceneNamPlaGUI;			//!< Liste mit sämtlichen GUI Elemente dieser Szene
 } sceneNamePlayer_t;
 
 /**
  * @brief Verlinkung aller GUI Elemente der Szene MainMenu
  * 
  * Zum auslesen oder bearbeiten einzelner GUI Elemente dieser Szene
- * erhalten sie Zeiger darauf. Zusätzlich wird die komplette Liste
- * aller Elemente übergeben, welche dann gezeichnet werden können.
+ * erhalten sie Zeiger darauf. Zusätzlich zeigt ein Zeiger auf die komplette Liste
+ * aller Elemente, welche dann gezeichnet werden können.
  */
 typedef struct {
 	guiElement_t *bttnNewGame;		//!< startet ein neues Spiel
 	guiElement_t *bttnControls;		//!< öffnet die Ansicht der im Spiel Steuerung
 	guiElement_t *bttnChangeName;	//!< öffnet die Szene NamePlayer erneut
 	guiElement_t *bttnQuit;			//!< Schliesst das Programm
-	gui_t sceneMainMenuGUI;			//!< Liste mit sämtlichen GUI Elemente dieser Szene
+	gui_t *sceneMainMenuGUI;			//!< Liste mit sämtlichen GUI Elemente dieser Szene
 } sceneMainMenu_t;
 
 /**
  * @brief Verlinkung aller GUI Elemente der Szene InGame
  * 
  * Zum auslesen oder bearbeiten einzelner GUI Elemente dieser Szene
- * erhalten sie Zeiger darauf. Zusätzlich wird die komplette Liste
- * aller Elemente übergeben, welche dann gezeichnet werden können.
+ * erhalten sie Zeiger darauf. Zusätzlich zeigt ein Zeiger auf die komplette Liste
+ * aller Elemente, welche dann gezeichnet werden können.
  */
 typedef struct {
 	guiElement_t *bttnPlayerNameA;	//!< Schriftzug mit dem Namen des Spielers A
@@ -95,21 +95,21 @@ typedef struct {
 	guiElement_t *bttnHPBarBGB;		//!< Hintergund des Lebensbalken, zeigt maximale Lebenspunkte an
 	guiElement_t *bttnHPBarCoverA;	//!< Abdeckung des Lebensbalken, zeigt die aktuellen Lebenspunkte des Spielers A an
 	guiElement_t *bttnHPBarCoverB;	//!< Abdeckung des Lebensbalken, zeigt die aktuellen Lebenspunkte des Spielers B an
-	gui_t sceneInGameGUI;			//!< Liste mit sämtlichen GUI Elemente dieser Szene
+	gui_t *sceneInGameGUI;			//!< Liste mit sämtlichen GUI Elemente dieser Szene
 } sceneInGame_t;
 
 /**
  * @brief Verlinkung aller GUI Elemente der Szene ChooseWorld
  * 
  * Zum auslesen oder bearbeiten einzelner GUI Elemente dieser Szene
- * erhalten sie Zeiger darauf. Zusätzlich wird die komplette Liste
- * aller Elemente übergeben, welche dann gezeichnet werden können.
+ * erhalten sie Zeiger darauf. Zusätzlich zeigt ein Zeiger auf die komplette Liste
+ * aller Elemente, welche dann gezeichnet werden können.
  */
 typedef struct {
 	guiElement_t *bttnChooseWorld;	//!< Schriftzug "Choose a World"
 	guiElement_t *bttnEvergreen;	//!< öffnet die Welt Evergreen
 	guiElement_t *bttnAquaduct;		//!< öffnet die welt Aquaduct
-	gui_t sceneChooseWorldGUI;		//!< Liste mit sämtlichen GUI Elemente dieser Szene
+	gui_t *sceneChooseWorldGUI;		//!< Liste mit sämtlichen GUI Elemente dieser Szene
 } sceneChooseWorld_t;
 
 
@@ -63,6 +63,18 @@ typedef union {
     struct worldConfig_s *world;   //!< Speicher für Welt
 } sdlwResourceUnion_t;
 
+/**
+ * @brief Handle einer geladenen Ressource.
+ * Bleibt bis zum nächsten SDLW_Quit() gültig und erlaubt einen Zugriff ohne
+ * erneute Suche nach der ID.
+ *
+ */
+typedef int sdlwHandle_t;
+
+#define SDLW_INVALID_HANDLE (-1) //!< Handle einer nicht gefundenen Ressource
+
+#define SDLW_DEFAULT_MEMORY_BUDGET (64 * 1024 * 1024) //!< Standardbudget für geladene Ressourcen in Bytes
+
 /**
  * @brief Struktur zum Speichern von Ressourcen
  *
@@ -105,6 +117,10 @@ int SDLW_Quit();
  * Die Konfigurationsdatei ist im Format [Key File Type] aufgebaut.
  * Key maximal 31 Zeichen: ID
  * File maximal 63 Zeichen: Pfad
+ * Texturen, Schriften und Sounds werden nur überprüft und erst bei der ersten
+ * Verwendung erstellt. Von Sprites verwendete Texturen und Soundeffekte werden
+ * vorab dekodiert. Mit "atlas" markierte Texturen werden dabei auf gemeinsame
+ * Atlasseiten gepackt.
  * \ref ConfigDoku
  *
  * @param[in] resourceConfigLocation Pfad der Ressourcenkonfigurationsdatei
@@ -113,9 +129,54 @@ int SDLW_Quit();
  */
 int SDLW_LoadResources(char *resourceConfigLocation);
 
+/**
+ * @brief Lädt Ressourcen aus einem mit SDLW_BuildPack() erstellten Paket.
+ * Das Paket wird in den Speicher eingeblendet, Texturen und Soundeffekte werden
+ * direkt aus den vorab dekodierten Daten erstellt. Das Paket bleibt bis
+ * SDLW_Quit() eingeblendet.
+ * Fehlt das Paket, ist es ungültig, veraltet oder passt das Audioformat nicht,
+ * so wird stattdessen SDLW_LoadResources() mit \p resourceConfigLocation
+ * aufgerufen. Veraltet ist ein Paket, wenn SDLW_HashSources() für
+ * \p resourceConfigLocation eine andere Prüfsumme ergibt als beim Erstellen.
+ *
+ * @param[in] packLocation Pfad der Paketdatei
+ * @param[in] resourceConfigLocation Pfad der Ressourcenkonfigurationsdatei
+ *
+ * @return 0 oder Errorcode
+ */
+int SDLW_LoadPack(char *packLocation, char *resourceConfigLocation);
+
+/**
+ * @brief Erstellt ein Paket aus einer Ressourcenkonfigurationsdatei.
+ * Der gesamte Konfigurationsbaum wird samt vorab dekodierter Bilder und
+ * Soundeffekte in eine Datei geschrieben. Muss nicht initialisiert sein.
+ *
+ * @param[in] resourceConfigLocation Pfad der Ressourcenkonfigurationsdatei
+ * @param[in] packLocation Pfad der zu schreibenden Paketdatei
+ *
+ * @return 0 oder Errorcode
+ */
+int SDLW_BuildPack(char *resourceConfigLocation, char *packLocation);
+
+/**
+ * @brief Berechnet die Prüfsumme der Quelldateien einer Konfiguration.
+ * Einbezogen werden Pfad, Änderungszeit und Grösse aller Konfigurationsdateien
+ * sowie der Bilder, Sounds und Schriften, die darin genannt werden. Muss nicht
+ * initialisiert sein.
+ *
+ * @param[in] resourceConfigLocation Pfad der Ressourcenkonfigurationsdatei
+ * @param[out] hash Die Prüfsumme (FNV-1a)
+ *
+ * @return 0 oder Errorcode
+ */
+int SDLW_HashSources(char *resourceConfigLocation, uint64_t *hash);
+
 /**
  * @brief Gibt eine Geladene Ressource zurück.
  * Die ID muss mit SDLW_LoadResources() per Key geladen worden sein.
+ * Texturen, Schriften und Sounds werden erst beim ersten Aufruf erstellt.
+ * Jeder erfolgreiche Aufruf zählt eine Referenz, solange diese nicht mit
+ * SDLW_ReleaseResource() freigegeben wird, bleibt die Ressource geladen.
  *
  * @param[in] id Die ID der Ressource die gesucht wird
  * @param[in] type Der Typ der Ressource die geladen werden soll
@@ -125,6 +186,127 @@ int SDLW_LoadResources(char *resourceConfigLocation);
  */
 int SDLW_GetResource(char *id, resourceType_t type, void **resource);
 
+/**
+ * @brief Gibt ein Sprite oder eine Welt zurück, ohne eine Referenz zu zählen.
+ * Für Vorlagen die kopiert werden, z.B. das Sprite jedes neuen Schusses. Nur
+ * für Typen die nie entladen werden, ansonsten SDLW_GetResource() verwenden.
+ *
+ * @param[in] id Die ID der Ressource die gesucht wird
+ * @param[in] type RESOURCETYPE_SPRITE oder RESOURCETYPE_WORLD
+ * @param[out] resource Pointer zur Ressource. Null bei nicht gefundener Ressource
+ *
+ * @return 0, ERR_PARAMETER für Typen die entladen werden können oder Errorcode
+ */
+int SDLW_PeekResource(char *id, resourceType_t type, void **resource);
+
+/**
+ * @brief Sucht das Handle einer geladenen Ressource.
+ * Das Handle kann einmalig aufgelöst und danach mit den *ByHandle Funktionen
+ * ohne weitere Suche verwendet werden.
+ *
+ * @param[in] id Die ID der Ressource die gesucht wird
+ *
+ * @return Handle der Ressource oder SDLW_INVALID_HANDLE
+ */
+sdlwHandle_t SDLW_ResolveHandle(char *id);
+
+/**
+ * @brief Gibt eine geladene Ressource anhand ihres Handles zurück.
+ * Zählt wie SDLW_GetResource() eine Referenz.
+ *
+ * @param[in] handle Handle gemäss SDLW_ResolveHandle()
+ * @param[in] type Der Typ der Ressource die geladen werden soll
+ * @param[out] resource Pointer zur Ressource. Null bei ungültigem Handle oder Typ
+ *
+ * @return 0 oder Errorcode
+ */
+int SDLW_GetResourceByHandle(sdlwHandle_t handle, resourceType_t type, void **resource);
+
+/**
+ * @brief Gibt eine Textur samt dem Bereich der Ressource darin zurück.
+ * Mit "atlas" markierte Texturen werden beim Laden auf gemeinsame Atlasseiten
+ * gepackt. Für diese wird die Seite und der Ausschnitt darauf zurückgegeben,
+ * für alle anderen die Textur und ihre gesamte Fläche.
+ * Zählt wie SDLW_GetResource() eine Referenz.
+ *
+ * @param[in] id Die ID der Textur die gesucht wird
+ * @param[out] texture Pointer zur Textur. Null bei nicht gefundener Textur
+ * @param[out] region Bereich der Ressource in \p texture
+ *
+ * @return 0 oder Errorcode
+ */
+int SDLW_GetTextureRegion(char *id, SDL_Texture **texture, SDL_Rect *region);
+
+/**
+ * @brief Gibt die Pixel einer geladenen Masken- oder Stempeltextur zurück.
+ * Von Texturen mit "blendmode" wird beim Laden eine Kopie der Pixel behalten,
+ * damit sie ohne Rücklesen von der Grafikkarte angewendet werden können.
+ * Die Surface gehört dem SDLW und bleibt gültig, solange die Textur geladen ist.
+ *
+ * @param[in] texture Die Textur, z.B. aus einem Sprite
+ * @param[out] pixels Surface im Format SDL_PIXELFORMAT_RGBA8888
+ * @param[out] type RESOURCETYPE_TEXTURE_BM_MASK oder RESOURCETYPE_TEXTURE_BM_STAMP
+ *
+ * @return 0 oder Errorcode, ERR_FAIL wenn die Textur keine Maske und kein Stempel ist
+ */
+int SDLW_GetTexturePixels(SDL_Texture *texture, SDL_Surface **pixels, resourceType_t *type);
+
+/**
+ * @brief Dekodiert die Quelle einer Textur erneut in eine Surface.
+ * Die Textur wird dazu weder geladen noch referenziert.
+ *
+ * @param[in] id Die ID der Textur
+ * @param[out] surface Neue Surface im Format SDL_PIXELFORMAT_RGBA8888, mit
+ * SDL_FreeSurface() freizugeben
+ *
+ * @return 0 oder Errorcode
+ */
+int SDLW_LoadSurface(char *id, SDL_Surface **surface);
+
+/**
+ * @brief Gibt eine mit SDLW_GetResource() erhaltene Referenz frei.
+ * Ressourcen ohne Referenz bleiben zwischengespeichert, bis das Budget gemäss
+ * SDLW_SetMemoryBudget() überschritten wird. Dann werden die am längsten
+ * unbenutzten zuerst entladen. Sprites und Welten werden nie entladen.
+ *
+ * @param[in] id Die ID der Ressource
+ *
+ * @return 0, ERR_SEQUENCE wenn keine Referenz besteht oder Errorcode
+ */
+int SDLW_ReleaseResource(char *id);
+
+/**
+ * @brief Setzt das Speicherbudget für geladene Ressourcen.
+ * Wird es überschritten, werden Ressourcen ohne Referenz entladen und bei der
+ * nächsten Verwendung neu erstellt. Ressourcen mit Referenz werden nie
+ * entladen, das Budget kann dadurch überschritten werden. Bleibt über
+ * SDLW_Quit() hinaus erhalten.
+ *
+ * @param bytes Budget in Bytes, 0 = Ressourcen ohne Referenz sofort entladen
+ *
+ * @return 0 oder Errorcode
+ */
+int SDLW_SetMemoryBudget(size_t bytes);
+
+/**
+ * @brief Gibt den geschätzten Speicherbedarf aller geladenen Ressourcen zurück.
+ *
+ * @return Speicherbedarf in Bytes
+ */
+size_t SDLW_GetMemoryUsage();
+
+/**
+ * @brief Gibt den geschätzten Speicherbedarf einer Ressource zurück.
+ * Texturen zählen mit 4 Bytes pro Pixel, Schriften und Sounds mit der Grösse
+ * ihrer Quelldaten. Eine nicht geladene Ressource belegt 0 Bytes.
+ *
+ * @param[in] id Die ID der Ressource
+ * @param[out] bytes Speicherbedarf in Bytes
+ *
+ * @return 0 oder Errorcode
+ */
+int SDLW_GetResourceBytes(char *id, size_t *bytes);
+
 /**
  * @brief Vereinfachendes Makro für \ref SDLW_GetResource.
  * Lädt die per \p id angegebene Textur.
@@ -194,6 +376,7 @@ int SDLW_Render();
  * @brief Spielt eine Musik ab.
  * Es kann nur eine Musik gleichzeitig laufen.
  * Sollte nur für Hintergrundmusik benötigt werden.
+ * Die Referenz der zuvor gespielten Musik wird freigegeben.
  * 
  * @param[in] musicid Die Id der Musik die gespielt werden soll
  * 
@@ -210,6 +393,15 @@ int SDLW_PlayMusic(char *musicid);
  */
 int SDLW_PlaySoundEffect(char *chunk);
 
+/**
+ * @brief Spielt einen Soundeffekt anhand seines Handles ab.
+ * 
+ * @param[in] handle Handle des Effekts gemäss SDLW_ResolveHandle()
+ * 
+ * @return 0 oder Errorcode
+ */
+int SDLW_PlaySoundEffectByHandle(sdlwHandle_t handle);
+
 /**
  * @brief Gibt den aktiven Renderer zurück.
  * 
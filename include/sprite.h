@@ -35,6 +35,7 @@ struct sdlwResource_s; //!< Vorwärtsdeklaration einer \ref sdlwResource_t Struk
 typedef struct {
     SDL_Texture *texture; //!< Die Sprite-Textur
     SDL_Rect source;     //!< Der Ausschnitt der gezeichnet werden soll
+    SDL_Rect region;     //!< Bereich des Sprites in der Textur, z.B. in einer Atlasseite. Leer = ganze Textur
     SDL_Rect destination; //!< Die Grösse und Offset der mit der die Textur gezeichnet werden soll, relativ zu der Position
     SDL_Point pivot;      //!< Der Rotationspivot dieses Sprites, Relativ zum Zentrum der Textur
     double rotation;       //!< Die Rotation der Textur
@@ -78,6 +79,7 @@ int Sprite_SetRelativeToPivot(sprite_t sprite, double parentRotation, SDL_Point
 /**
  * @brief Setzt das Subsprite auf den angegebenen Index.
  * Berechnet \ref sprite_t.source so, dass \p index auf das n-te Subsprite zeigt.
+ * Die Subsprites werden innerhalb von \ref sprite_t.region aufgeteilt.
  * 
  * @param[in] sprite Das Multisprite dessen Anzeige geändert wird.
  * @param[in] index Der Index auf welches Subsprite gewechselt wird.
@@ -32,13 +32,52 @@ struct entityCollision_s; // Vorwärtsdeklaration eine Kollisions-Struktur
 /**
  * @brief Struktur zum Laden einer Konfiguration
  * 
+ * Die Texturen werden nur per ID gespeichert und erst von \ref World_Load()
+ * geholt. So belegen nicht verwendete Welten keinen Texturspeicher.
  */
 typedef struct worldConfig_s {
-    SDL_Texture *foreground; //!< Vordergrundstextur
-    SDL_Texture *background; //!< Hintergrundstextur
-    char bgMusic[32];        //!< Hintergrundsmusik
+    char key[32];        //!< ID der Welt
+    char foreground[32]; //!< ID der Vordergrundstextur
+    char background[32]; //!< ID der Hintergrundstextur
+    char bgMusic[32];    //!< Hintergrundsmusik
 } worldConfig_t;
 
+/**
+ * @brief Abfrage des Distanzfeldes mit \ref World_GetDistance()
+ * 
+ */
+typedef struct {
+    float distance;    //!< Abstand zur Oberfläche in Pixel, negativ im Gelände, auf 32 Pixel begrenzt
+    SDL_FPoint normal; //!< Normale der Oberfläche, zeigt aus dem Gelände hinaus, Länge 1 oder 0 fern von Gelände
+    SDL_Point gradient; //!< Unnormierter Gradient in 1/16 Pixel, ganzzahlig und damit auf allen Plattformen gleich
+} worldDistance_t;
+
+/**
+ * @brief Ergebnis von \ref World_Raycast() und \ref World_Sweep()
+ * 
+ * Positionen sind bei einem Strahl der Pixel selbst, bei einer bewegten AABB
+ * deren linke obere Ecke.
+ */
+typedef struct {
+    int hit;            //!< 1 falls Gelände getroffen wurde, sonst 0
+    SDL_Point position; //!< Letzte freie Position vor dem Gelände, ohne Treffer das Ziel
+    SDL_Point contact;  //!< Erste Position im Gelände, ohne Treffer das Ziel
+    float fraction;     //!< Anteil der Strecke bis \p contact, 0 bis 1
+} worldHit_t;
+
+/**
+ * @brief Zustand des Vordergrunds von \ref World_Snapshot()
+ * 
+ * Enthält nur die Abweichungen vom geladenen Vordergrund als Lauflängen,
+ * Farben nur für neues Gelände. Die Daten können so in einen Spielstand
+ * geschrieben werden, gelten aber nur für dieselbe Welt und dieselbe
+ * Bytereihenfolge.
+ */
+typedef struct {
+    void *data;  //!< Kodierte Abschnitte, mit \ref World_FreeSnapshot() freigeben
+    size_t size; //!< Grösse von \p data in Bytes
+} worldSnapshot_t;
+
 
 /*
  * Öffentliche Funktionen
@@ -78,8 +117,14 @@ void World_Quit();
  * @brief Lädt die Texturen und Umgebung anhand der gegebenen worldID.
  * 
  * Die Welt wird anhand von Konfigurationsdateien aufgebaut.
- * Hintergrund und Vordergrund werden geladen. Das Kollisionsraster wird aufgebaut.
+ * Hintergrund und Vordergrund werden geladen. Der Vordergrund wird direkt aus
+ * dem Bild dekodiert, die Welt ist so gross wie dieses Bild. Die Pixel werden
+ * in Abschnitten von 128x128 im Arbeitsspeicher gehalten, jeder mit eigener
+ * Textur und eigenem Kollisionsraster. Abschnitte ohne Gelände werden nicht
+ * angelegt.
  * Muss beim Starten der GameSzene aufgerufen werden.
+ * Die Texturen einer zuvor geladenen Welt werden freigegeben und können vom
+ * SDLW bei Speicherbedarf entladen werden.
  * 
  * @param[in] worldID Die ID der Welt die geladen werden soll
  *
@@ -87,6 +132,41 @@ void World_Quit();
  */
 int World_Load(char *worldID);
 
+/**
+ * @brief Gibt die Grösse der geladenen Welt zurück.
+ * 
+ * @param[out] size Breite und Höhe in Pixel
+ * 
+ * @return 0 oder Errorcode
+ */
+int World_GetSize(SDL_Point *size);
+
+/**
+ * @brief Verschiebt den sichtbaren Ausschnitt der Welt.
+ * 
+ * Der Ausschnitt ist so gross wie der Renderer und beginnt nach
+ * \ref World_Load() links oben. Vordergrund und Entitäten werden um ihn
+ * verschoben gezeichnet, der Hintergrund füllt immer das ganze Fenster.
+ * 
+ * @param position Weltkoordinate, die links oben im Fenster erscheint
+ * 
+ * @return 0 oder Errorcode
+ */
+int World_SetViewport(SDL_Point position);
+
+/**
+ * @brief Gibt den sichtbaren Ausschnitt der Welt zurück.
+ * 
+ * Was in Weltkoordinaten liegt, wird um die linke obere Ecke des Ausschnitts
+ * verschoben gezeichnet. Ohne initialisierte Welt ist der Ausschnitt leer
+ * und liegt bei 0, 0.
+ * 
+ * @param[out] rect Ausschnitt in Weltkoordinaten
+ * 
+ * @return 0 oder Errorcode
+ */
+int World_GetViewport(SDL_Rect *rect);
+
 /**
  * @brief Zeichnet den Weltenhintergrund.
  * 
@@ -99,7 +179,8 @@ int World_DrawBackground();
 /**
  * @brief Zeichnet den Weltenvordergrund.
  * 
- * Vordergrund wird bei \ref World_Load() definiert.
+ * Vordergrund wird bei \ref World_Load() definiert. Gezeichnet werden nur die
+ * angelegten Abschnitte, die den sichtbaren Ausschnitt schneiden.
  *
  * @return 0 oder Errorcode
  */
@@ -123,13 +204,103 @@ int World_CheckCollision(SDL_Rect aabb, struct entityCollision_s *collision);
  * @brief Modifiziert die Welt.
  * 
  * Sprite Textur muss entweder vom Typ Mask oder Stamp sein!
+ * Die Modifikation wird auf die Pixel im Arbeitsspeicher angewendet. Nur der
+ * veränderte Bereich der betroffenen Abschnitte wird ins Kollisionsraster und
+ * in die Texturen übernommen. Stempel legen leere Abschnitte bei Bedarf an.
  * 
  * @param[in] sprite Das Aussehen, Position und Rotation der Modifikation
  * 
- * @return 0 oder Errorcode
+ * @return 0, ERR_PARAMETER wenn die Textur weder Maske noch Stempel ist oder anderer Errorcode
  */
 int World_Modify(sprite_t sprite);
 
+/**
+ * @brief Merkt eine Modifikation der Welt vor.
+ * 
+ * Wie \ref World_Modify(), die Modifikation wird aber erst von
+ * \ref World_ApplyModifications() zusammen mit allen anderen vorgemerkten
+ * angewendet. So wird jeder betroffene Abschnitt pro Bild nur einmal
+ * übernommen und hochgeladen. Laden einer anderen Welt verwirft die
+ * vorgemerkten Modifikationen.
+ * 
+ * @param[in] sprite Das Aussehen, Position und Rotation der Modifikation
+ * 
+ * @return 0, ERR_PARAMETER wenn die Textur weder Maske noch Stempel ist oder anderer Errorcode
+ */
+int World_QueueModify(sprite_t sprite);
+
+/**
+ * @brief Wendet alle vorgemerkten Modifikationen in Reihenfolge an.
+ * 
+ * Überschneidende Bereiche werden für das Distanzfeld zusammengefasst. Wird
+ * vom \ref EntityHandler_Update() nach der Physik aufgerufen.
+ * 
+ * @return 0 oder Errorcode, auch ohne geladene Welt 0 wenn nichts vorgemerkt ist
+ */
+int World_ApplyModifications();
+
+/**
+ * @brief Schaltet das Absetzen von losem Gelände ein oder aus.
+ * 
+ * Ist es eingeschaltet, fällt Gelände ohne Halt darunter pixelweise nach
+ * unten, bis es aufliegt. Standardmässig ist es ausgeschaltet, damit Welten
+ * wie gezeichnet bleiben. Die Einstellung gilt bis \ref World_Quit().
+ * 
+ * @param enabled 1 zum Einschalten, 0 zum Ausschalten
+ * 
+ * @return immer 0
+ */
+int World_SetSettling(int enabled);
+
+/**
+ * @brief Lässt loses Gelände um einen Pixel fallen.
+ * 
+ * Simuliert werden nur Abschnitte, die seit kurzem verändert wurden. Bewegt
+ * sich in einem Abschnitt nichts mehr, schläft er bis zur nächsten
+ * Modifikation. Die Bänder von Abschnitten werden auf mehrere Threads
+ * verteilt, Kollisionsraster, Distanzfeld und Texturen werden nur im
+ * veränderten Bereich nachgeführt. Wird vom \ref EntityHandler_Update() nach
+ * \ref World_ApplyModifications() aufgerufen.
+ * 
+ * @return 0 oder Errorcode, auch ohne geladene Welt oder wenn ausgeschaltet 0
+ */
+int World_Settle();
+
+/**
+ * @brief Hält den aktuellen Zustand des Vordergrunds fest.
+ * 
+ * Nur seit dem Laden veränderte Abschnitte werden gegenüber dem geladenen
+ * Vordergrund kodiert. Ausgeschnittene Pixel kosten so nur ihren Lauf, neue
+ * Pixel werden mit Farbe gespeichert. Eine wenig zerstörte Welt braucht
+ * damit nur einige Kilobytes.
+ * 
+ * @param[out] snapshot Der Schnappschuss, mit \ref World_FreeSnapshot() freigeben
+ * 
+ * @return 0, ERR_NULLPARAMETER, ERR_FAIL ohne geladene Welt oder ERR_MEMORY
+ */
+int World_Snapshot(worldSnapshot_t *snapshot);
+
+/**
+ * @brief Stellt einen mit \ref World_Snapshot() festgehaltenen Zustand her.
+ * 
+ * Nur tatsächlich abweichende Pixel werden übernommen und hochgeladen, ein
+ * Zurückspulen um wenige Bilder ist daher günstig. Vorgemerkte Modifikationen
+ * werden verworfen.
+ * 
+ * @param[in] snapshot Der Schnappschuss
+ * 
+ * @return 0, ERR_PARAMETER wenn der Schnappschuss nicht zur geladenen Welt
+ * passt oder beschädigt ist, oder anderer Errorcode
+ */
+int World_Restore(const worldSnapshot_t *snapshot);
+
+/**
+ * @brief Gibt die Daten eines Schnappschusses frei.
+ * 
+ * @param[in,out] snapshot Der Schnappschuss, danach leer
+ */
+void World_FreeSnapshot(worldSnapshot_t *snapshot);
+
 /**
  * @brief Überprüft ob eine Vertikale Linie vom Startpunkt nach unten die Welt schneidet.
  * 
@@ -150,3 +321,51 @@ int World_VerticalLineIntersection(SDL_Point searchStart, SDL_Point *hitPoint);
  * @return 0 oder Errorcode
  */
 int World_CreateStartLocations(SDL_Rect aabb, int count, SDL_Point *locations);
+
+/**
+ * @brief Fragt das Distanzfeld des Geländes ab.
+ * 
+ * Das Distanzfeld wird beim Laden berechnet und nach jeder Modifikation in
+ * deren Umgebung nachgeführt. Ein Pixel am Rand des Geländes hat den Abstand
+ * -0.5, ein freier Pixel daneben 0.5. Die Normale ist der Gradient des Feldes.
+ * Ausserhalb der Welt ist nichts solid. Der Gradient selbst wird zusätzlich
+ * ganzzahlig geliefert, für Winkel im deterministischen Modus der Physik.
+ * 
+ * @param point Abgefragter Pixel
+ * @param[out] sample Abstand und Normale
+ * 
+ * @return 0 oder Errorcode
+ */
+int World_GetDistance(SDL_Point point, worldDistance_t *sample);
+
+/**
+ * @brief Verfolgt einen Strahl durch die Welt bis zum ersten soliden Pixel.
+ * 
+ * Der Strahl wird Pixel für Pixel entlang der längeren Achse abgetastet, so
+ * wird auch eine ein Pixel dünne Wand getroffen. Freie Abschnitte der Strecke
+ * werden über die Summentabellen in wenigen Schritten übersprungen. Ausserhalb
+ * der Welt ist nichts solid.
+ * 
+ * @param from Startpunkt
+ * @param to Zielpunkt
+ * @param[out] hit Der Treffer
+ * 
+ * @return 0 oder Errorcode
+ */
+int World_Raycast(SDL_Point from, SDL_Point to, worldHit_t *hit);
+
+/**
+ * @brief Verschiebt eine AABB entlang einer Strecke bis zur ersten Kollision.
+ * 
+ * Wie \ref World_Raycast() aber für eine ganze Kollisionsbox. Jede
+ * abgetastete Position kollidiert genau dann, wenn auch
+ * \ref World_CheckCollision() an dieser Stelle eine Kollision meldet. Ist
+ * bereits die Startposition im Gelände, ist \p hit->fraction 0.
+ * 
+ * @param aabb Kollisionsbox an der Startposition
+ * @param delta Verschiebung in Pixel
+ * @param[out] hit Der Treffer
+ * 
+ * @return 0 oder Errorcode
+ */
+int World_Sweep(SDL_Rect aabb, SDL_Point delta, worldHit_t *hit);
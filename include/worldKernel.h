@@ -0,0 +1,82 @@
+/**
+ * @file worldKernel.h
+ * @brief Vektorisierte Schleifen für das Kollisionsraster der Welt
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * Nach einer Modifikation der Welt müssen ganze Zeilen von Pixeln in das
+ * Kollisionsraster gepackt und ganze Zeilen der Summentabelle verschoben
+ * werden. Diese Schleifen gibt es portabel, mit SSE2 und mit AVX2. Welche
+ * Variante benutzt wird, entscheidet sich beim ersten Aufruf anhand der CPU.
+ * Alle Varianten liefern bitgenau dasselbe Ergebnis.
+ */
+
+#pragma once
+
+
+/*
+ * Includes
+ *
+ */
+
+#include <stdint.h>
+
+
+/*
+ * Typdeklarationen
+ *
+ */
+
+/**
+ * @brief Varianten der Schleifen
+ *
+ */
+typedef enum {
+    WORLDKERNEL_AUTO = 0, //!< Schnellste von der CPU unterstützte Variante
+    WORLDKERNEL_SCALAR,   //!< Portable Variante ohne Vektorbefehle
+    WORLDKERNEL_SSE2,     //!< 128 Bit Vektoren mit SSE2
+    WORLDKERNEL_AVX2,     //!< 256 Bit Vektoren mit AVX2, nur mit GCC oder Clang
+} worldKernel_t;
+
+
+/*
+ * Öffentliche Funktionen
+ *
+ */
+
+/**
+ * @brief Wählt die Variante der Schleifen.
+ *
+ * @param kernel Gewünschte Variante
+ *
+ * @return 0, ERR_PARAMETER falls die Variante auf dieser CPU oder mit diesem
+ * Compiler nicht verfügbar ist
+ */
+int WorldKernel_Select(worldKernel_t kernel);
+
+/**
+ * @brief Gibt die gewählte Variante zurück.
+ *
+ * @return Die Variante, nie WORLDKERNEL_AUTO
+ */
+worldKernel_t WorldKernel_Selected(void);
+
+/**
+ * @brief Packt Pixel im Format RGBA8888 in ein Bitraster.
+ * Bit b von Wort w ist gesetzt, wenn Pixel 64 * w + b nicht durchsichtig ist.
+ * Die Bits nach dem letzten Pixel im letzten Wort sind 0.
+ *
+ * @param[in] pixels Die Pixel, Alpha im niederwertigsten Byte
+ * @param count Anzahl Pixel
+ * @param[out] words Mindestens (count + 63) / 64 Wörter
+ */
+void WorldKernel_PackAlpha(const uint32_t *pixels, int count, uint64_t *words);
+
+/**
+ * @brief Addiert eine Zeile elementweise zu einer anderen.
+ *
+ * @param[in,out] row Zeile zu der addiert wird
+ * @param[in] delta Summanden
+ * @param count Anzahl Elemente
+ */
+void WorldKernel_AddRow(int32_t *row, const int32_t *delta, int count);
@@ -0,0 +1,323 @@
+/**
+ * @file assetPack.c
+ * @brief Binäres Ressourcenpaket
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ */
+
+
+/*
+ * Includes
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <SDL.h>
+
+#include "assetPack.h"
+#include "error.h"
+
+
+/*
+ * Typdeklarationen
+ *
+ */
+
+/* ... */
+
+
+/*
+ * Variablendeklarationen
+ *
+ */
+
+static const uint8_t padding[ASSETPACK_ALIGNMENT]; //!< Nullbytes zum Auffüllen
+
+
+/*
+ * Private Funktionsprototypen
+ *
+ */
+
+/**
+ * @brief Blendet eine Datei schreibgeschützt in den Speicher ein.
+ *
+ * @param[in] packLocation Pfad der Datei
+ * @param[out] pack Paket in dem \ref assetPack_t.base, \ref assetPack_t.size
+ * und \ref assetPack_t.mapping gesetzt werden
+ *
+ * @return 0, ERR_PARAMETER falls die Datei fehlt oder ERR_FAIL
+ */
+static int mapFile(const char *packLocation, assetPack_t *pack);
+
+/**
+ * @brief Hebt die Abbildung einer Datei auf.
+ *
+ * @param[in,out] pack Das Paket
+ */
+static void unmapFile(assetPack_t *pack);
+
+/**
+ * @brief Überprüft Kopf und Eintragstabelle eines eingeblendeten Pakets.
+ *
+ * @param[in] pack Das Paket
+ *
+ * @return 0 oder ERR_FAIL
+ */
+static int validate(const assetPack_t *pack);
+
+/**
+ * @brief Füllt die Datei mit Nullbytes bis zur nächsten Ausrichtung auf.
+ *
+ * @param[in,out] writer Der Schreiber
+ *
+ * @return 0 oder ERR_FAIL
+ */
+static int writePadding(assetPackWriter_t *writer);
+
+
+/*
+ * Implementation öffentlicher Funktionen
+ *
+ */
+
+int AssetPack_Open(const char *packLocation, assetPack_t *pack) {
+    if (!packLocation || !pack) { // Fehlerüberprüfung
+        SDL_Log("Pfad oder Paket ungueltig! AssetPack_Open()\n");
+        return ERR_NULLPARAMETER;
+    }
+    memset(pack, 0, sizeof(assetPack_t));
+    int errorCode = mapFile(packLocation, pack);
+    if (errorCode)
+        return errorCode;
+    if (validate(pack)) {
+        SDL_Log("Paket %s ist ungueltig oder veraltet! AssetPack_Open()\n", packLocation);
+        AssetPack_Close(pack);
+        return ERR_FAIL;
+    }
+    pack->header = (const assetPackHeader_t *)pack->base;
+    pack->entries = (const assetPackEntry_t *)(pack->base + pack->header->entryOffset);
+    return ERR_OK;
+}
+
+const void *AssetPack_GetData(const assetPack_t *pack, int index) {
+    if (!pack || !pack->header || index < 0 || (uint32_t)index >= pack->header->entryCount)
+        return NULL;
+    const assetPackEntry_t *entry = &pack->entries[index];
+    if (entry->dataType == ASSETPACK_DATA_NONE)
+        return NULL;
+    return pack->base + entry->offset;
+}
+
+int AssetPack_Close(assetPack_t *pack) {
+    if (!pack) { // Fehlerüberprüfung
+        return ERR_NULLPARAMETER;
+    }
+    if (pack->base)
+        unmapFile(pack);
+    memset(pack, 0, sizeof(assetPack_t));
+    return ERR_OK;
+}
+
+int AssetPack_BeginWrite(assetPackWriter_t *writer, const char *packLocation, int audioFormat, int audioFrequency, int audioChannels, uint64_t sourceHash) {
+    if (!writer || !packLocation) { // Fehlerüberprüfung
+        SDL_Log("Schreiber oder Pfad ungueltig! AssetPack_BeginWrite()\n");
+        return ERR_NULLPARAMETER;
+    }
+    memset(writer, 0, sizeof(assetPackWriter_t));
+    writer->file = fopen(packLocation, "wb");
+    if (!writer->file) {
+        SDL_Log("Paket %s konnte nicht erstellt werden! AssetPack_BeginWrite()\n", packLocation);
+        return ERR_PARAMETER;
+    }
+    writer->header.magic = ASSETPACK_MAGIC;
+    writer->header.version = ASSETPACK_VERSION;
+    writer->header.audioFormat = audioFormat;
+    writer->header.audioFrequency = audioFrequency;
+    writer->header.audioChannels = audioChannels;
+    writer->header.sourceHash = sourceHash;
+    // Platz für den Kopf reservieren, dieser wird beim Abschluss geschrieben
+    if (fwrite(&writer->header, sizeof(assetPackHeader_t), 1, writer->file) != 1) {
+        fclose(writer->file);
+        writer->file = NULL;
+        remove(packLocation);
+        return ERR_FAIL;
+    }
+    writer->position = sizeof(assetPackHeader_t);
+    return ERR_OK;
+}
+
+int AssetPack_WriteEntry(assetPackWriter_t *writer, const assetPackEntry_t *entry, const void *data, uint64_t size) {
+    if (!writer || !writer->file || !entry || (size && !data)) { // Fehlerüberprüfung
+        SDL_Log("Schreiber, Eintrag oder Daten ungueltig! AssetPack_WriteEntry()\n");
+        return ERR_NULLPARAMETER;
+    }
+    // Eintragstabelle bei Bedarf vergrössern
+    if (writer->count == writer->capacity) {
+        int capacity = writer->capacity ? writer->capacity * 2 : 64;
+        assetPackEntry_t *entries = malloc(sizeof(assetPackEntry_t) * capacity);
+        if (!entries) {
+            return ERR_MEMORY;
+        }
+        if (writer->entries) {
+            memcpy(entries, writer->entries, sizeof(assetPackEntry_t) * writer->count);
+            free(writer->entries);
+        }
+        writer->entries = entries;
+        writer->capacity = capacity;
+    }
+    // Daten ausgerichtet anhängen
+    if (writePadding(writer))
+        return ERR_FAIL;
+    if (size && fwrite(data, 1, size, writer->file) != size)
+        return ERR_FAIL;
+    assetPackEntry_t *newEntry = &writer->entries[writer->count++];
+    *newEntry = *entry;
+    newEntry->offset = size ? writer->position : 0;
+    newEntry->size = size;
+    writer->position += size;
+    return ERR_OK;
+}
+
+int AssetPack_EndWrite(assetPackWriter_t *writer, const char *packLocation, int commit) {
+    if (!writer || !writer->file || !packLocation) { // Fehlerüberprüfung
+        return ERR_NULLPARAMETER;
+    }
+    int errorCode = commit ? ERR_OK : ERR_FAIL;
+    if (!errorCode && writePadding(writer))
+        errorCode = ERR_FAIL;
+    // Eintragstabelle und danach den vollständigen Kopf schreiben
+    if (!errorCode) {
+        writer->header.entryCount = writer->count;
+        writer->header.entryOffset = writer->position;
+        writer->header.fileSize = writer->position + sizeof(assetPackEntry_t) * writer->count;
+        if (writer->count && fwrite(writer->entries, sizeof(assetPackEntry_t), writer->count, writer->file) != (size_t)writer->count)
+            errorCode = ERR_FAIL;
+        else if (fseek(writer->file, 0, SEEK_SET) || fwrite(&writer->header, sizeof(assetPackHeader_t), 1, writer->file) != 1)
+            errorCode = ERR_FAIL;
+    }
+    if (fclose(writer->file))
+        errorCode = ERR_FAIL;
+    if (errorCode) // Unvollständiges Paket nicht liegen lassen
+        remove(packLocation);
+    free(writer->entries);
+    memset(writer, 0, sizeof(assetPackWriter_t));
+    return commit ? errorCode : ERR_OK;
+}
+
+
+/*
+ * Implementation privater Funktionen
+ *
+ */
+
+#ifdef _WIN32
+
+static int mapFile(const char *packLocation, assetPack_t *pack) {
+    HANDLE file = CreateFileA(packLocation, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return ERR_PARAMETER;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return ERR_FAIL;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file); // Die Abbildung hält die Datei offen
+    if (!mapping)
+        return ERR_FAIL;
+    const uint8_t *base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!base) {
+        CloseHandle(mapping);
+        return ERR_FAIL;
+    }
+    pack->base = base;
+    pack->size = size.QuadPart;
+    pack->mapping = mapping;
+    return ERR_OK;
+}
+
+static void unmapFile(assetPack_t *pack) {
+    UnmapViewOfFile(pack->base);
+    CloseHandle(pack->mapping);
+}
+
+#else
+
+static int mapFile(const char *packLocation, assetPack_t *pack) {
+    int fd = open(packLocation, O_RDONLY);
+    if (fd < 0)
+        return ERR_PARAMETER;
+    struct stat info;
+    if (fstat(fd, &info) || info.st_size == 0) {
+        close(fd);
+        return ERR_FAIL;
+    }
+    void *base = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // Die Abbildung hält die Datei offen
+    if (base == MAP_FAILED)
+        return ERR_FAIL;
+    pack->base = base;
+    pack->size = info.st_size;
+    return ERR_OK;
+}
+
+static void unmapFile(assetPack_t *pack) {
+    munmap((void *)pack->base, pack->size);
+}
+
+#endif
+
+static int validate(const assetPack_t *pack) {
+    if (pack->size < sizeof(assetPackHeader_t))
+        return ERR_FAIL;
+    const assetPackHeader_t *header = (const assetPackHeader_t *)pack->base;
+    if (header->magic != ASSETPACK_MAGIC || header->version != ASSETPACK_VERSION || header->fileSize != pack->size)
+        return ERR_FAIL;
+    // Eintragstabelle muss ausgerichtet und vollständig in der Datei liegen
+    if (header->entryOffset % ASSETPACK_ALIGNMENT || header->entryOffset > pack->size ||
+        (pack->size - header->entryOffset) / sizeof(assetPackEntry_t) < header->entryCount)
+        return ERR_FAIL;
+    const assetPackEntry_t *entries = (const assetPackEntry_t *)(pack->base + header->entryOffset);
+    for (uint32_t i = 0; i < header->entryCount; ++i) {
+        const assetPackEntry_t *entry = &entries[i];
+        // Zeichenketten müssen terminiert sein
+        if (memchr(entry->config, '\0', sizeof(entry->config)) == NULL ||
+            memchr(entry->key, '\0', sizeof(entry->key)) == NULL ||
+            memchr(entry->type, '\0', sizeof(entry->type)) == NULL)
+            return ERR_FAIL;
+        if (entry->dataType > ASSETPACK_DATA_FILE)
+            return ERR_FAIL;
+        if (entry->dataType == ASSETPACK_DATA_NONE)
+            continue;
+        // Daten müssen ausgerichtet und vollständig in der Datei liegen
+        if (entry->offset % ASSETPACK_ALIGNMENT || entry->offset > header->entryOffset ||
+            entry->size > header->entryOffset - entry->offset)
+            return ERR_FAIL;
+        if (entry->dataType == ASSETPACK_DATA_PIXELS &&
+            (entry->pitch < (uint64_t)entry->width * 4 || (uint64_t)entry->pitch * entry->height > entry->size))
+            return ERR_FAIL;
+    }
+    return ERR_OK;
+}
+
+static int writePadding(assetPackWriter_t *writer) {
+    size_t count = (ASSETPACK_ALIGNMENT - writer->position % ASSETPACK_ALIGNMENT) % ASSETPACK_ALIGNMENT;
+    if (count && fwrite(padding, 1, count, writer->file) != count)
+        return ERR_FAIL;
+    writer->position += count;
+    return ERR_OK;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file atlas.c
+ * @brief Platzierung von Texturen in einem Texturatlas
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ */
+
+
+/*
+ * Includes
+ *
+ */
+
+#include <stdlib.h>
+
+#include "atlas.h"
+#include "error.h"
+
+
+/*
+ * Typdeklarationen
+ *
+ */
+
+/* ... */
+
+
+/*
+ * Variablendeklarationen
+ *
+ */
+
+/* ... */
+
+
+/*
+ * Private Funktionsprototypen
+ *
+ */
+
+/**
+ * @brief Vergleichsfunktion für qsort, sortiert absteigend nach Höhe.
+ * Bei gleicher Höhe entscheidet die ursprüngliche Reihenfolge, damit das
+ * Ergebnis auf allen Plattformen gleich ist.
+ *
+ * @param[in] a Pointer auf einen Pointer auf \ref atlasItem_t
+ * @param[in] b Pointer auf einen Pointer auf \ref atlasItem_t
+ *
+ * @return <0, 0 oder >0
+ */
+static int compareHeight(const void *a, const void *b);
+
+
+/*
+ * Implementation öffentlicher Funktionen
+ *
+ */
+
+int Atlas_Pack(atlasItem_t *items, int count, int pageSize, int padding, int *pageCount) {
+    if (!pageCount || (count && !items)) { // Fehlerüberprüfung
+        SDL_Log("Rechtecke oder Seitenanzahl ungueltig! Atlas_Pack()\n");
+        return ERR_NULLPARAMETER;
+    }
+    if (count < 0 || pageSize <= 0 || padding < 0) {
+        SDL_Log("Parameter ausserhalb Schranken! Atlas_Pack()\n");
+        return ERR_PARAMETER;
+    }
+    (*pageCount) = 0;
+    if (!count)
+        return ERR_OK;
+
+    // Nach Höhe sortieren ohne die Reihenfolge der Rechtecke zu ändern
+    atlasItem_t **sorted = malloc(sizeof(atlasItem_t *) * count);
+    if (!sorted) {
+        SDL_Log("Memory Error! Atlas_Pack()\n");
+        return ERR_MEMORY;
+    }
+    for (int i = 0; i < count; ++i)
+        sorted[i] = &items[i];
+    qsort(sorted, count, sizeof(atlasItem_t *), compareHeight);
+
+    // Regalweise ablegen
+    int page = -1;
+    int x = 0, y = 0, shelfHeight = 0;
+    for (int i = 0; i < count; ++i) {
+        atlasItem_t *item = sorted[i];
+        int w = item->w + 2 * padding;
+        int h = item->h + 2 * padding;
+        item->page = -1;
+        item->rect = (SDL_Rect){0, 0, item->w, item->h};
+        if (item->w <= 0 || item->h <= 0 || w > pageSize || h > pageSize)
+            continue; // Passt auf keine Seite
+        if (page < 0 || x + w > pageSize) { // Neues Regal
+            y += shelfHeight;
+            x = 0;
+            shelfHeight = 0;
+        }
+        if (page < 0 || y + h > pageSize) { // Neue Seite
+            page++;
+            x = 0;
+            y = 0;
+            shelfHeight = 0;
+        }
+        item->page = page;
+        item->rect.x = x + padding;
+        item->rect.y = y + padding;
+        x += w;
+        if (h > shelfHeight)
+            shelfHeight = h;
+    }
+    free(sorted);
+
+    (*pageCount) = page + 1;
+    return ERR_OK;
+}
+
+int Atlas_PageHeight(const atlasItem_t *items, int count, int page, int padding) {
+    int height = 0;
+    for (int i = 0; items && i < count; ++i) {
+        if (items[i].page == page && items[i].rect.y + items[i].rect.h + padding > height)
+            height = items[i].rect.y + items[i].rect.h + padding;
+    }
+    return height;
+}
+
+
+/*
+ * Implementation privater Funktionen
+ *
+ */
+
+static int compareHeight(const void *a, const void *b) {
+    const atlasItem_t *itemA = *(const atlasItem_t *const *)a;
+    const atlasItem_t *itemB = *(const atlasItem_t *const *)b;
+    if (itemA->h != itemB->h)
+        return itemB->h - itemA->h;
+    return (itemA > itemB) - (itemA < itemB);
+}
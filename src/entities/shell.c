@@ -39,6 +39,7 @@ typedef struct {
     entityPart_t explosion; //!< Explosionsanimation
     sprite_t mask;          //!< Modifikationsmaske der Welt bei Kollision
     int isExploding;        //!< 0 = nicht am explodieren, 1 = explodiert gerade
+    sdlwHandle_t sound;     //!< Handle des Explosions-Soundeffekts
 } shellData_t;
 
 
@@ -143,7 +144,7 @@ int Shell_Create(entity_t **shell, player_t *player, float x, float y, float vel
     }
     // Schusstextur resp. Sprite laden und hinzufügen
     sprite_t *rawSprite;
-    SDLW_GetResource("shell", RESOURCETYPE_SPRITE, (void **)&rawSprite);
+    SDLW_PeekResource("shell", RESOURCETYPE_SPRITE, (void **)&rawSprite);
     if (!rawSprite) {
         goto errorLoadShell;
     }
@@ -153,7 +154,7 @@ int Shell_Create(entity_t **shell, player_t *player, float x, float y, float vel
         goto errorLoadShell;
     }
     // Schussanimation resp. Sprite laden und hinzufügen
-    SDLW_GetResource("shellEx", RESOURCETYPE_SPRITE, (void **)&rawSprite);
+    SDLW_PeekResource("shellEx", RESOURCETYPE_SPRITE, (void **)&rawSprite);
     if (!rawSprite) {
         goto errorLoadExplosion;
     }
@@ -169,13 +170,15 @@ int Shell_Create(entity_t **shell, player_t *player, float x, float y, float vel
         goto errorLoadExplosion;
     }
     // Weltmaske laden
-    SDLW_GetResource("shellMask", RESOURCETYPE_SPRITE, (void **)&rawSprite);
+    SDLW_PeekResource("shellMask", RESOURCETYPE_SPRITE, (void **)&rawSprite);
     if (!rawSprite) {
         goto errorLoadMask;
     }
     shellData->mask = *rawSprite;
     shellData->mask.destination.w *= SHELL_EXPLOSION_SCALE_FACTOR;
     shellData->mask.destination.h *= SHELL_EXPLOSION_SCALE_FACTOR;
+    // Soundeffekt einmalig auflösen
+    shellData->sound = SDLW_ResolveHandle("shellSound");
     // dem Aufrufer ein Pointer zurückgeben
     if (shell) {
         *shell = &shellData->shell;
@@ -190,7 +193,7 @@ errorLoadExplosion:
 errorLoadShell:
     EntityHandler_RemoveEntity(&shellData->shell);
 errorEntity:
-    free(shellData);
+    EntityHandler_FreeData(shellData);
 errorCalloc:
     if (shell) {
         *shell = NULL;
@@ -198,11 +201,26 @@ errorCalloc:
     return ERR_FAIL;
 }
 
+int Shell_CreateFixed(entity_t **shell, player_t *player, fixedVector_t position, fixed_t velocity, fixed_t angle) {
+    entity_t *created;
+    int ret = Shell_Create(&created, player, Fixed_ToFloat(position.x), Fixed_ToFloat(position.y), 0.0f, 0.0);
+    if (ret) {
+        return ret;
+    }
+    // Erst jetzt belegt der Schuss einen Slot und übernimmt die Werte exakt
+    Physics_SetPositionFixed(created, position);
+    Physics_SetVelocityFixed(created, Physics_PolarToVectorFixed(velocity, angle));
+    if (shell) {
+        *shell = created;
+    }
+    return ERR_OK;
+}
+
 int Shell_Destroy(entity_t *shell) {
     int ret = ERR_OK;
     ret |= EntityHandler_RemoveAllEntityParts(shell);
     ret |= EntityHandler_RemoveEntity(shell);
-    free(shell->data);
+    ret |= EntityHandler_FreeData(shell->data);
     return ret;
 }
 
@@ -216,9 +234,8 @@ static int updateCallback(entity_t *self, inputEvent_t *inputEvents) {
     (void)inputEvents;
     shellData_t *shellData = (shellData_t *)self->data;
     // richte Schuss der Flugbahn aus
-    double angle = atan2(-self->physics.velocity.y, self->physics.velocity.x);
-    angle = angle / M_PI * 180.0;
-    Physics_SetRotation(self, -angle);
+    SDL_FPoint velocity = Physics_GetVelocity(self);
+    Physics_SetRotation(self, Physics_VectorToAngle(velocity.x, velocity.y));
     // Wenn der Schuss momentan explodiert, dann reagiere entsprechend.
     if (shellData->isExploding) {
         // In triggerExplosion() wurde die Animation gestartet und auf den Index
@@ -237,8 +254,7 @@ static int updateCallback(entity_t *self, inputEvent_t *inputEvents) {
             // Wird AABB nicht auf 0 gesetzt wird der Panzer nochmals mit dem
             // bereits explodierenden Schuss kollidieren und sich selber erneut
             // Lebenspunkte abziehen. Verhindere dies.
-            self->physics.aabb.h = 0;
-            self->physics.aabb.w = 0;
+            Physics_SetSize(self, 0, 0);
             Sprite_NextFrame(&shellData->explosion.sprite);
             break;
         case (32): // Animation wurde zur Hälfte gespielt, zerstöre die Welt
@@ -285,7 +301,7 @@ static void triggerExplosion(entity_t *shell) {
     // gemeldet werden. Die Entität löscht sich sowieso nach der Explosion.
     shell->callbacks.onCollision = NULL;
     // Entität statisch machen, somit bewegt sie sich nicht mehr.
-    shell->physics.isStatic = 1;
+    Physics_SetStatic(shell, 1);
     // Explosion aktivieren und Frame weiterschalten, damit im Update nicht
     // bereits die Entität gelöscht wird.
     shellData_t *shellData = (shellData_t *)shell->data;
@@ -294,16 +310,17 @@ static void triggerExplosion(entity_t *shell) {
     // Schuss aus Entität entfernen
     EntityHandler_RemoveEntityPart(shell, &shellData->part);
     // Soundeffekt abspielen
-    SDLW_PlaySoundEffect("shellSound");
+    SDLW_PlaySoundEffectByHandle(shellData->sound);
 }
 
 static void destroyWorld(entity_t *shell) {
     // Nutze die zuvor geladene Explosions-Maske
     shellData_t *shellData = (shellData_t *)shell->data;
     // Setze die Position gemäss Schussposition
-    shellData->mask.position.x = shell->physics.position.x;
-    shellData->mask.position.y = shell->physics.position.y;
-    // Übergebe die Explosion der Welt, welche diese aus dem Vordergrund
-    // auschneidet.
-    World_Modify(shellData->mask);
+    SDL_FPoint position = Physics_GetPosition(shell);
+    shellData->mask.position.x = position.x;
+    shellData->mask.position.y = position.y;
+    // Übergebe die Explosion der Welt, welche diese nach der Physik zusammen
+    // mit allen anderen Explosionen des Bildes aus dem Vordergrund ausschneidet.
+    World_QueueModify(shellData->mask);
 }
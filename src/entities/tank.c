@@ -42,6 +42,7 @@ typedef struct {
     entityPart_t fire;     //!< Schussanimation
     entityPart_t arrow;    //!< Pfeil der den aktiven Spieler signalisiert
     entityPart_t velocity; //!< Indikater der aktuellen Schussgeschwindigkeit
+    sdlwHandle_t fireSound; //!< Handle des Schuss-Soundeffekts
 } tankData_t;
 
 
@@ -113,7 +114,7 @@ static int collisionCallback(entity_t *self, entityCollision_t *collision);
  * @brief Rotiere Panzer gemäss Weltuntergrund.
  * 
  * Sucht den nähesten vertikalen Punkt auf der Weltoberfläche und ermittelt
- * durch eine Kollisionsabfrage den Winkel der Kollisiosnormale.
+ * aus dem Distanzfeld der Welt den Winkel der Oberflächennormale.
  * 
  * @param tank Pointer auf Panzer der Rotiert werden soll
  * 
@@ -187,10 +188,12 @@ int Tank_Create(entity_t **tank, player_t *player, float x, float y) {
     if (EntityHandler_AddEntity(&tankData->tank)) {
         goto errorEntity;
     }
+    // Soundeffekt einmalig auflösen
+    tankData->fireSound = SDLW_ResolveHandle("tankSound");
     // Einzelteile laden und einrichten
     sprite_t *rawSprite;
     // Raupen laden
-    SDLW_GetResource("tracks", RESOURCETYPE_SPRITE, (void **)&rawSprite);
+    SDLW_PeekResource("tracks", RESOURCETYPE_SPRITE, (void **)&rawSprite);
     if (!rawSprite) {
         goto errorLoadTracks;
     }
@@ -200,7 +203,7 @@ int Tank_Create(entity_t **tank, player_t *player, float x, float y) {
         goto errorLoadTracks;
     }
     // Fahrgestell laden
-    SDLW_GetResource("chassis", RESOURCETYPE_SPRITE, (void **)&rawSprite);
+    SDLW_PeekResource("chassis", RESOURCETYPE_SPRITE, (void **)&rawSprite);
     if (!rawSprite) {
         goto errorLoadChassis;
     }
@@ -210,21 +213,22 @@ int Tank_Create(entity_t **tank, player_t *player, float x, float y) {
         goto errorLoadChassis;
     }
     // Panzerrohr laden
-    SDLW_GetResource("tube", RESOURCETYPE_SPRITE, (void **)&rawSprite);
+    SDLW_PeekResource("tube", RESOURCETYPE_SPRITE, (void **)&rawSprite);
     if (!rawSprite) {
         goto errorLoadTube;
     }
     tankData->tube.name = "Rohr";
     tankData->tube.sprite = *rawSprite;
     // Wenn der Panzer auf der rechten Spielseite spawnt, so rotiere das Rohr.
-    if (x > (1024 / 2)) {
+    SDL_Point worldSize;
+    if (World_GetSize(&worldSize) == ERR_OK && x > worldSize.x / 2) {
         tankData->tube.sprite.rotation = -180.0;
     }
     if (EntityHandler_AddEntityPart(&tankData->tank, &tankData->tube)) {
         goto errorLoadTube;
     }
     // Feuer Animation laden
-    SDLW_GetResource("tankFire", RESOURCETYPE_SPRITE, (void **)&rawSprite);
+    SDLW_PeekResource("tankFire", RESOURCETYPE_SPRITE, (void **)&rawSprite);
     if (!rawSprite) {
         goto errorLoadFire;
     }
@@ -241,7 +245,7 @@ int Tank_Create(entity_t **tank, player_t *player, float x, float y) {
         goto errorLoadFire;
     }
     // Pfeil Animation laden
-    SDLW_GetResource("arrow", RESOURCETYPE_SPRITE, (void **)&rawSprite);
+    SDLW_PeekResource("arrow", RESOURCETYPE_SPRITE, (void **)&rawSprite);
     if (!rawSprite) {
         goto errorLoadArrow;
     }
@@ -251,7 +255,7 @@ int Tank_Create(entity_t **tank, player_t *player, float x, float y) {
     // Pfeil noch nicht der Entität hinzufügen, wird im UpdateCallback gemacht.
     // So kann die Sichtbarkeit gemäss aktivem Spieler umgeschaltet werden.
     // Geschwindigkeit Animation laden
-    SDLW_GetResource("velocity", RESOURCETYPE_SPRITE, (void **)&rawSprite);
+    SDLW_PeekResource("velocity", RESOURCETYPE_SPRITE, (void **)&rawSprite);
     if (!rawSprite) {
         goto errorLoadArrow;
     }
@@ -278,7 +282,7 @@ errorLoadChassis:
 errorLoadTracks:
     EntityHandler_RemoveEntity(&tankData->tank);
 errorEntity:
-    free(tankData);
+    EntityHandler_FreeData(tankData);
 errorCalloc:
     if (tank) {
         *tank = NULL;
@@ -290,7 +294,7 @@ int Tank_Destroy(entity_t *tank) {
     int ret = ERR_OK;
     ret |= EntityHandler_RemoveAllEntityParts(tank);
     ret |= EntityHandler_RemoveEntity(tank);
-    free(tank->data);
+    ret |= EntityHandler_FreeData(tank->data);
     return ret;
 }
 
@@ -318,7 +322,7 @@ static int updateCallback(entity_t *self, inputEvent_t *inputEvents) {
             rotateTube(tankData, inputEvents->axisWASD);
             // Animation des Pfeils weiterschalten & Winkellage korrigieren
             Sprite_NextFrame(&tankData->arrow.sprite);
-            tankData->arrow.sprite.rotation = -self->physics.rotation;
+            tankData->arrow.sprite.rotation = -Physics_GetRotation(self);
             // Falls Leertaste gedrückt
             if (inputEvents->currentChar == ' ') {
                 // Pfeil-Indikator entfernen
@@ -333,7 +337,7 @@ static int updateCallback(entity_t *self, inputEvent_t *inputEvents) {
         case (PLAYER_STEP_VELOCITY): // Kann die Schussgeschw. auswählen
             // Animation des Indikators weiterschalten & Winkellage korrigieren
             Sprite_NextFrame(&tankData->velocity.sprite);
-            tankData->velocity.sprite.rotation = -self->physics.rotation;
+            tankData->velocity.sprite.rotation = -Physics_GetRotation(self);
             // Wenn Leertaste erneut gedrückt wurde
             if (inputEvents->currentChar == ' ') {
                 // Indikator entfernen
@@ -358,7 +362,7 @@ static int updateCallback(entity_t *self, inputEvent_t *inputEvents) {
     }
     // Horizontale Bewegung in jedem Zyklus um 5% dämpfen damit der Panzer nicht
     // endlos in eine Richtung fährt.
-    Physics_SetVelocity(self, self->physics.velocity.x * 0.95f, NAN);
+    Physics_SetVelocity(self, Physics_GetVelocity(self).x * 0.95f, NAN);
     // rotiere den gesamten Panzer basierend auf der Position auf der Welt
     rotateToWorld(self);
     return ERR_OK;
@@ -383,20 +387,26 @@ static int collisionCallback(entity_t *self, entityCollision_t *collision) {
 static void rotateToWorld(entity_t *tank) {
     // Suche den Punkt auf der Welt der direkt unter der Mitte der Entität ist.
     SDL_Point topOfWorld;
-    World_VerticalLineIntersection((SDL_Point){
-                                       .x = tank->physics.position.x,
-                                       .y = tank->physics.position.y},
-                                   &topOfWorld);
-    // Erhalte mittels Kollision in diesem Punkt eine Normale der Welt.
-    SDL_Rect testBox = {.x = topOfWorld.x - 10, .y = topOfWorld.y - 10, .w = 20, .h = 20};
-    entityCollision_t collision = {.partner = NULL};
-    World_CheckCollision(testBox, &collision);
-    if (collision.flags & ENTITY_COLLISION_WORLD) {
-        double angle = atan2(-collision.normal.y, collision.normal.x);
-        angle = angle / M_PI * 180.0;
-        angle -= 90.0;
-        Physics_SetRotation(tank, -angle);
+    SDL_FPoint position = Physics_GetPosition(tank);
+    if (World_VerticalLineIntersection((SDL_Point){.x = position.x, .y = position.y},
+                                       &topOfWorld)) {
+        return;
     }
+    // Die Normale der Oberfläche in diesem Punkt gibt die Neigung vor.
+    worldDistance_t surface;
+    if (World_GetDistance(topOfWorld, &surface) != ERR_OK ||
+        (surface.gradient.x == 0 && surface.gradient.y == 0)) {
+        return;
+    }
+    // Die Normale zeigt vom Boden weg, der Panzer steht senkrecht dazu
+    if (Physics_IsDeterministic()) {
+        // Der Winkel hängt nicht vom Betrag ab, der ganzzahlige Gradient
+        // erspart die Normierung in Gleitkommazahlen.
+        fixed_t angle = Fixed_Atan2(Fixed_FromInt(surface.gradient.y), Fixed_FromInt(surface.gradient.x));
+        Physics_SetRotationFixed(tank, angle + Fixed_FromInt(90));
+        return;
+    }
+    Physics_SetRotation(tank, Physics_VectorToAngle(surface.normal.x, surface.normal.y) + 90.0);
     return;
 }
 
@@ -405,35 +415,52 @@ static void fire(entity_t *tank) {
     entityPart_t *tube = &tankData->tube;
     // Der Schuss soll am Ende des Schussrohrs erscheinen, daher muss dessen
     // aktuelle Position mit Vektorgeometrie berechnet werden.
-    // Starte im Zentrum der Entität
-    float x = tank->physics.position.x;
-    float y = tank->physics.position.y;
-    // Startpunkt zum Rohransatz schieben
-    double angleRad = (tank->physics.rotation + 90.0) * (M_PI / 180.0);
-    x += tube->sprite.destination.y * cos(-angleRad);
-    y += -(tube->sprite.destination.y * sin(-angleRad));
-    // Startpunkt zum Rohrende schieben
-    angleRad = (tank->physics.rotation + tube->sprite.rotation) * (M_PI / 180.0);
-    x += tube->sprite.destination.w * cos(-angleRad);
-    y += -(tube->sprite.destination.w * sin(-angleRad));
-    // Schuss erstellen
-    double angle = tank->physics.rotation + tube->sprite.rotation;
     // Anhand Animationsindex die Geschwindigkeit ermitteln
     float velocity = tankData->velocity.sprite.multiSpriteIndex * TANK_FIRE_MULTIPLICATOR;
-    Shell_Create(NULL, tank->owner, x, y, velocity, angle);
+    if (Physics_IsDeterministic()) {
+        // Dieselbe Rechnung, die Rotation des Panzers bleibt aber durchgehend
+        // in Festkommazahlen.
+        fixedVector_t position = Physics_GetPositionFixed(tank);
+        fixed_t rotation = Physics_GetRotationFixed(tank);
+        fixed_t angle = rotation + Fixed_FromFloat((float)tube->sprite.rotation);
+        fixedVector_t offset = Physics_PolarToVectorFixed(Fixed_FromInt(tube->sprite.destination.y), rotation + Fixed_FromInt(90));
+        position.x += offset.x;
+        position.y += offset.y;
+        offset = Physics_PolarToVectorFixed(Fixed_FromInt(tube->sprite.destination.w), angle);
+        position.x += offset.x;
+        position.y += offset.y;
+        Shell_CreateFixed(NULL, tank->owner, position, Fixed_FromFloat(velocity), angle);
+    } else {
+        // Starte im Zentrum der Entität
+        SDL_FPoint position = Physics_GetPosition(tank);
+        double rotation = Physics_GetRotation(tank);
+        float x = position.x;
+        float y = position.y;
+        // Startpunkt zum Rohransatz schieben
+        SDL_FPoint offset = Physics_PolarToVector(tube->sprite.destination.y, rotation + 90.0);
+        x += offset.x;
+        y += offset.y;
+        // Startpunkt zum Rohrende schieben
+        offset = Physics_PolarToVector(tube->sprite.destination.w, rotation + tube->sprite.rotation);
+        x += offset.x;
+        y += offset.y;
+        // Schuss erstellen
+        double angle = rotation + tube->sprite.rotation;
+        Shell_Create(NULL, tank->owner, x, y, velocity, angle);
+    }
     // Feuer Animation aktivieren im aktuellen Winkel des Rohrs
     tankData->fire.sprite.rotation = tankData->tube.sprite.rotation;
     Sprite_SetFrame(&tankData->fire.sprite, 1);
     // Soundeffekt abspielen
-    SDLW_PlaySoundEffect("tankSound");
+    SDLW_PlaySoundEffectByHandle(tankData->fireSound);
 }
 
 static void moveHorizontal(entity_t *self, SDL_Point axisWASD) {
-    const float *vx = &self->physics.velocity.x;
+    float vx = Physics_GetVelocity(self).x;
     // horizontale Geschwindigkeit gemäss WASD-Tasten verändern
-    if (axisWASD.x == -1 && *vx > -TANK_MAX_HORIZONTAL_SPEED) {
+    if (axisWASD.x == -1 && vx > -TANK_MAX_HORIZONTAL_SPEED) {
         Physics_SetRelativeVelocity(self, -10.0f, NAN);
-    } else if (axisWASD.x == 1 && *vx < TANK_MAX_HORIZONTAL_SPEED) {
+    } else if (axisWASD.x == 1 && vx < TANK_MAX_HORIZONTAL_SPEED) {
         Physics_SetRelativeVelocity(self, +10.0f, NAN);
     }
 }
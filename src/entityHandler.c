@@ -16,12 +16,16 @@
  */
 
 #include "error.h"
-#include "list.h"
+#include "intrusiveList.h"
 #include "physics.h"
+#include "physicsStore.h"
 #include "entityHandler.h"
+#include "world.h"
 
-#include <assert.h>
+#include <math.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
 
 
 /*
@@ -29,7 +33,42 @@
  * 
  */
 
-/* ... */
+/**
+ * @brief Art eines aufgeschobenen Befehls
+ * 
+ */
+typedef enum {
+    COMMAND_ADD_ENTITY = 0,    //!< \ref EntityHandler_AddEntity()
+    COMMAND_REMOVE_ENTITY,     //!< \ref EntityHandler_RemoveEntity()
+    COMMAND_REMOVE_ALL,        //!< \ref EntityHandler_RemoveAllEntities()
+    COMMAND_ADD_PART,          //!< \ref EntityHandler_AddEntityPart()
+    COMMAND_REMOVE_PART,       //!< \ref EntityHandler_RemoveEntityPart()
+    COMMAND_REMOVE_ALL_PARTS,  //!< \ref EntityHandler_RemoveAllEntityParts()
+    COMMAND_FREE_DATA          //!< \ref EntityHandler_FreeData()
+} entityCommandType_t;
+
+/**
+ * @brief Aufgeschobener Befehl
+ * 
+ * Wird während einer Iteration über die Entitäten eine Entität oder ein
+ * Einzelteil hinzugefügt oder entfernt, so wird dies erst zwischen den Phasen
+ * eines Zyklus ausgeführt.
+ */
+typedef struct {
+    entityCommandType_t type; //!< Art des Befehls
+    entity_t *entity;         //!< betroffene Entität
+    entityPart_t *part;       //!< betroffenes Einzelteil
+    void *data;               //!< zu befreiende Daten
+} entityCommand_t;
+
+/**
+ * @brief Zu zeichnender Zustand einer Entität
+ * 
+ */
+typedef struct {
+    SDL_FPoint position; //!< Position [pixel]
+    double rotation;     //!< Rotation [°]
+} entityPose_t;
 
 
 /*
@@ -37,12 +76,21 @@
  * 
  */
 
+#define ENTITYHANDLER_MIN_COMMANDS 16 //!< Anzahl Befehle der ersten Allozierung
+
 /**
  * @brief Globale Variablen des EntityHandlers
  * 
  */
 static struct {
-    list_t *entityList; //!< Liste der aktiven Entitäten
+    intrusiveList_t entityList;  //!< Liste der aktiven Entitäten
+    physicsStore_t physicsStore; //!< Physikdaten der aktiven Entitäten
+    bool isIterating;            //!< Eine Phase iteriert momentan über die Entitäten
+    struct {
+        entityCommand_t *commands; //!< aufgeschobene Befehle in Reihenfolge
+        int count;                 //!< Anzahl Befehle
+        int capacity;              //!< Anzahl allozierter Befehle
+    } commandBuffer; //!< Befehle die nach der aktuellen Phase ausgeführt werden
 } entityHandler;
 
 
@@ -51,6 +99,37 @@ static struct {
  * 
  */
 
+/**
+ * @brief Führe einen Befehl aus oder schiebe ihn auf.
+ * 
+ * Läuft momentan eine Phase (Iteration über die Entitäten), so wird der Befehl
+ * dem Befehlspuffer angehängt. Ansonsten wird er direkt ausgeführt.
+ * 
+ * @param command auszuführender Befehl
+ * 
+ * @return ERR_OK, ERR_MEMORY oder Fehler des Befehls
+ */
+static int submitCommand(entityCommand_t command);
+
+/**
+ * @brief Führe einen Befehl aus.
+ * 
+ * @param command auszuführender Befehl
+ * 
+ * @return ERR_OK oder Fehler des Befehls
+ */
+static int executeCommand(entityCommand_t command);
+
+/**
+ * @brief Führe alle aufgeschobenen Befehle aus.
+ * 
+ * Wird zwischen den Phasen eines Zyklus aufgerufen. Die Befehle werden in der
+ * Reihenfolge ausgeführt, in der sie aufgegeben wurden.
+ * 
+ * @return ERR_OK oder Fehler der Befehle
+ */
+static int flushCommands(void);
+
 /**
  * @brief Validation einer Entitätsstruktur.
  * Validiert die Felder der Entitätsstruktur auf korrekte Parameter.
@@ -75,8 +154,8 @@ static int validatePart(entityPart_t *part);
 /**
  * @brief Rufe onUpdate Callbacks auf.
  *
- * Wird durch List_ForeachArg() für jede Entität der Liste aufgerufen und
- * führt dann \ref entityCallbacks_t.onUpdate aus, falls vorhanden.
+ * Wird durch IntrusiveList_ForeachArg() für jede Entität der Liste aufgerufen
+ * und führt dann \ref entityCallbacks_t.onUpdate aus, falls vorhanden.
  * 
  * @param data opaker Pointer auf eine Entität
  * @param userData opaker Pointer auf Eingabeevents
@@ -99,6 +178,20 @@ static int callOnUpdate(void *data, void *userData);
  */
 static int calculatePartsPositions(void *data);
 
+/**
+ * @brief Berechne die Positionen der Einzelteile zwischen zwei Zuständen.
+ *
+ * Wie \ref calculatePartsPositions(), aber Position und Rotation der Entität
+ * werden zwischen \ref entity_t.previous und dem aktuellen Zustand linear
+ * interpoliert. Die Rotation folgt dabei dem kürzeren Weg.
+ * 
+ * @param data opaker Pointer auf eine Entität
+ * @param userData Pointer auf den Anteil des aktuellen Zustands als float
+ *
+ * @return ERR_OK oder ERR_FAIL falls Rechnung ungültig wurde
+ */
+static int interpolatePartsPositions(void *data, void *userData);
+
 /**
  * @brief Berechne die Position eines Einzelteils.
  *
@@ -107,7 +200,7 @@ static int calculatePartsPositions(void *data);
  * Koordinaten des Einzelteils.
  * 
  * @param data opaker Pointer auf Entitätsteil
- * @param userData Pointer auf übergeordnete Entität
+ * @param userData Pointer auf den zu zeichnenden Zustand der Entität
  *
  * @return immer ERR_OK
  */
@@ -116,8 +209,8 @@ static int calculatePartPosition(void *data, void *userData);
 /**
  * @brief Rufe onDraw Callbacks auf.
  *
- * Wird durch List_Foreach() für jede Entität der Liste aufgerufen und
- * führt dann \ref entityCallbacks_t.onDraw aus, falls vorhanden. Ist der
+ * Wird durch IntrusiveList_Foreach() für jede Entität der Liste aufgerufen
+ * und führt dann \ref entityCallbacks_t.onDraw aus, falls vorhanden. Ist der
  * Callback NULL, so wird \ref defaultDrawEntity() aufgerufen.
  * 
  * @param data opaker Pointer auf eine Entität
@@ -165,78 +258,93 @@ static int defaultDrawEntityPart(void *data, void *userData);
 
 int EntityHandler_Update(inputEvent_t *inputEvents) {
     int ret = ERR_OK;
-    // Falls liste noch nicht initialissiert ist, gibts auch keine Entitäten zu
-    // behandenln.
-    if (!entityHandler.entityList) {
-        return ret;
-    }
     // Alle Entitäten aktualisieren
-    ret = List_ForeachArg(entityHandler.entityList, callOnUpdate, inputEvents);
+    entityHandler.isIterating = true;
+    ret = IntrusiveList_ForeachArg(&entityHandler.entityList, callOnUpdate, inputEvents);
+    entityHandler.isIterating = false;
+    ret |= flushCommands();
     if (ret) return ret;
     // Physik aktualisieren
-    ret = Physics_Update(entityHandler.entityList);
+    entityHandler.isIterating = true;
+    ret = Physics_Update(&entityHandler.physicsStore);
+    entityHandler.isIterating = false;
+    ret |= flushCommands();
+    if (ret) return ret;
+    // Während des Bildes vorgemerkte Modifikationen der Welt anwenden
+    ret = World_ApplyModifications();
+    if (ret) return ret;
+    // Loses Gelände absetzen, falls eingeschaltet
+    ret = World_Settle();
     if (ret) return ret;
     // Positionen der Einzelteile neu berechnen
-    ret = List_Foreach(entityHandler.entityList, calculatePartsPositions);
+    ret = IntrusiveList_Foreach(&entityHandler.entityList, calculatePartsPositions);
     return ret;
 }
 
+int EntityHandler_Interpolate(float alpha) {
+    if (!(alpha >= 0.0f && alpha <= 1.0f)) {
+        return ERR_PARAMETER;
+    }
+    return IntrusiveList_ForeachArg(&entityHandler.entityList, interpolatePartsPositions, &alpha);
+}
+
 int EntityHandler_Draw() {
-    return List_Foreach(entityHandler.entityList, callOnDraw);
+    entityHandler.isIterating = true;
+    int ret = IntrusiveList_Foreach(&entityHandler.entityList, callOnDraw);
+    entityHandler.isIterating = false;
+    ret |= flushCommands();
+    return ret;
 }
 
 int EntityHandler_AddEntity(entity_t *entity) {
     if (validateEntity(entity)) {
         return ERR_PARAMETER;
     }
-    // Lazy-Init der Liste falls diese leer ist
-    if (!entityHandler.entityList) {
-        assert(List_Create(&entityHandler.entityList) == 0);
-    }
-    return List_Add(entityHandler.entityList, entity);
+    return submitCommand((entityCommand_t){.type = COMMAND_ADD_ENTITY, .entity = entity});
 }
 
 int EntityHandler_RemoveEntity(entity_t *entity) {
-    int ret = EntityHandler_RemoveAllEntityParts(entity);
-    if (ret) {
-        return ret;
+    if (!entity) {
+        return ERR_PARAMETER;
     }
-    ret = List_Remove(entityHandler.entityList, entity);
-    return ret;
+    return submitCommand((entityCommand_t){.type = COMMAND_REMOVE_ENTITY, .entity = entity});
 }
 
 int EntityHandler_RemoveAllEntities() {
-    int ret = ERR_OK;
-    if (!entityHandler.entityList || !entityHandler.entityList->listHead) {
-        return ret;
+    int ret = submitCommand((entityCommand_t){.type = COMMAND_REMOVE_ALL});
+    // Ausserhalb eines Zyklus wird auch der Befehlspuffer befreit
+    if (!entityHandler.isIterating) {
+        free(entityHandler.commandBuffer.commands);
+        entityHandler.commandBuffer.commands = NULL;
+        entityHandler.commandBuffer.capacity = 0;
     }
-    do {
-        entity_t *entity = entityHandler.entityList->listHead->data;
-        ret |= EntityHandler_RemoveAllEntityParts(entity);
-        ret |= List_Remove(entityHandler.entityList, entity);
-    } while (entityHandler.entityList->listHead);
-    ret |= List_Destroy(&entityHandler.entityList);
     return ret;
 }
 
 int EntityHandler_AddEntityPart(entity_t *entity, entityPart_t *part) {
-    if (validatePart(part)) {
+    if (!entity || validatePart(part)) {
         return ERR_PARAMETER;
     }
-    // Lazy-Init der Liste falls diese leer ist
-    if (!entity->parts) {
-        assert(List_Create(&entity->parts) == 0);
-    }
-    return List_Add(entity->parts, part);
+    return submitCommand((entityCommand_t){.type = COMMAND_ADD_PART, .entity = entity, .part = part});
 }
 
 int EntityHandler_RemoveEntityPart(entity_t *entity, entityPart_t *part) {
-    return List_Remove(entity->parts, part);
+    if (!entity || !part) {
+        return ERR_PARAMETER;
+    }
+    return submitCommand((entityCommand_t){.type = COMMAND_REMOVE_PART, .entity = entity, .part = part});
 }
 
 int EntityHandler_RemoveAllEntityParts(entity_t *entity) {
-    if (entity && entity->parts) {
-        return List_Destroy(&entity->parts);
+    if (entity) {
+        return submitCommand((entityCommand_t){.type = COMMAND_REMOVE_ALL_PARTS, .entity = entity});
+    }
+    return ERR_OK;
+}
+
+int EntityHandler_FreeData(void *data) {
+    if (data) {
+        return submitCommand((entityCommand_t){.type = COMMAND_FREE_DATA, .data = data});
     }
     return ERR_OK;
 }
@@ -247,6 +355,89 @@ int EntityHandler_RemoveAllEntityParts(entity_t *entity) {
  * 
  */
 
+static int submitCommand(entityCommand_t command) {
+    if (!entityHandler.isIterating) {
+        return executeCommand(command);
+    }
+    // Befehlspuffer bei Bedarf vergrössern
+    if (entityHandler.commandBuffer.count == entityHandler.commandBuffer.capacity) {
+        int capacity = entityHandler.commandBuffer.capacity ? entityHandler.commandBuffer.capacity * 2 : ENTITYHANDLER_MIN_COMMANDS;
+        entityCommand_t *commands = malloc(capacity * sizeof(entityCommand_t));
+        if (!commands) {
+            return ERR_MEMORY;
+        }
+        if (entityHandler.commandBuffer.commands) {
+            memcpy(commands, entityHandler.commandBuffer.commands, entityHandler.commandBuffer.count * sizeof(entityCommand_t));
+            free(entityHandler.commandBuffer.commands);
+        }
+        entityHandler.commandBuffer.commands = commands;
+        entityHandler.commandBuffer.capacity = capacity;
+    }
+    entityHandler.commandBuffer.commands[entityHandler.commandBuffer.count++] = command;
+    return ERR_OK;
+}
+
+static int executeCommand(entityCommand_t command) {
+    entity_t *entity = command.entity;
+    int ret = ERR_OK;
+    switch (command.type) {
+    case COMMAND_ADD_ENTITY:
+        ret = IntrusiveList_Add(&entityHandler.entityList, &entity->link, entity);
+        if (ret) {
+            break;
+        }
+        ret = PhysicsStore_Add(&entityHandler.physicsStore, entity);
+        if (ret) {
+            IntrusiveList_Remove(&entityHandler.entityList, &entity->link);
+            break;
+        }
+        // Neue Entitäten werden ab ihrer Startposition interpoliert
+        entity->previous.position = Physics_GetPosition(entity);
+        entity->previous.rotation = Physics_GetRotation(entity);
+        break;
+    case COMMAND_REMOVE_ENTITY:
+        ret |= IntrusiveList_Clear(&entity->parts);
+        ret |= IntrusiveList_Remove(&entityHandler.entityList, &entity->link);
+        ret |= PhysicsStore_Remove(&entityHandler.physicsStore, entity);
+        break;
+    case COMMAND_REMOVE_ALL:
+        while (entityHandler.entityList.first) {
+            entity = entityHandler.entityList.first->data;
+            ret |= IntrusiveList_Clear(&entity->parts);
+            ret |= IntrusiveList_Remove(&entityHandler.entityList, &entity->link);
+        }
+        ret |= PhysicsStore_Destroy(&entityHandler.physicsStore);
+        break;
+    case COMMAND_ADD_PART:
+        ret = IntrusiveList_Add(&entity->parts, &command.part->link, command.part);
+        break;
+    case COMMAND_REMOVE_PART:
+        ret = IntrusiveList_Remove(&entity->parts, &command.part->link);
+        break;
+    case COMMAND_REMOVE_ALL_PARTS:
+        ret = IntrusiveList_Clear(&entity->parts);
+        break;
+    case COMMAND_FREE_DATA:
+        free(command.data);
+        break;
+    }
+    return ret;
+}
+
+static int flushCommands(void) {
+    int ret = ERR_OK;
+    for (int i = 0; i < entityHandler.commandBuffer.count; ++i) {
+        int errorVal = executeCommand(entityHandler.commandBuffer.commands[i]);
+        if (errorVal) {
+            SDL_Log("Aufgeschobener Befehl %d fehlgeschlagen: %d\n",
+                    entityHandler.commandBuffer.commands[i].type, errorVal);
+            ret |= errorVal;
+        }
+    }
+    entityHandler.commandBuffer.count = 0;
+    return ret;
+}
+
 static int validateEntity(entity_t *entity) {
     if (!entity) {
         return ERR_PARAMETER;
@@ -278,6 +469,9 @@ static int callOnUpdate(void *data, void *userData) {
     inputEvent_t *inputEvents = (inputEvent_t *)userData;
     int ret = ERR_OK;
     entity->state = ENTITY_STATE_ACTIVE;
+    // Zustand vor diesem Schritt für die Interpolation merken
+    entity->previous.position = Physics_GetPosition(entity);
+    entity->previous.rotation = Physics_GetRotation(entity);
     if (entity->callbacks.onUpdate) { // Callback darf NULL sein
         ret = entity->callbacks.onUpdate(entity, inputEvents);
     }
@@ -286,24 +480,39 @@ static int callOnUpdate(void *data, void *userData) {
 
 static int calculatePartsPositions(void *data) {
     entity_t *entity = (entity_t *)data;
-    int ret = ERR_OK;
-    if (entity->parts) {
-        ret = List_ForeachArg(entity->parts, calculatePartPosition, entity);
+    entityPose_t pose = {.position = Physics_GetPosition(entity), .rotation = Physics_GetRotation(entity)};
+    return IntrusiveList_ForeachArg(&entity->parts, calculatePartPosition, &pose);
+}
+
+static int interpolatePartsPositions(void *data, void *userData) {
+    entity_t *entity = (entity_t *)data;
+    float alpha = *(float *)userData;
+    SDL_FPoint position = Physics_GetPosition(entity);
+    entityPose_t pose;
+    pose.position.x = entity->previous.position.x + (position.x - entity->previous.position.x) * alpha;
+    pose.position.y = entity->previous.position.y + (position.y - entity->previous.position.y) * alpha;
+    // Drehung über den kürzeren Weg, z.B. von 170° nach -170° nur um 20°
+    double delta = fmod(Physics_GetRotation(entity) - entity->previous.rotation, 360.0);
+    if (delta > 180.0) {
+        delta -= 360.0;
+    } else if (delta < -180.0) {
+        delta += 360.0;
     }
-    return ret;
+    pose.rotation = entity->previous.rotation + delta * alpha;
+    return IntrusiveList_ForeachArg(&entity->parts, calculatePartPosition, &pose);
 }
 
 static int calculatePartPosition(void *data, void *userData) {
     entityPart_t *entityPart = (entityPart_t *)data;
-    entity_t *entity = (entity_t *)userData;
+    entityPose_t *pose = (entityPose_t *)userData;
     // Aktualisiere Position des Teils mit Position der gesamten Entität.
-    entityPart->sprite.position.x = entity->physics.position.x;
-    entityPart->sprite.position.y = entity->physics.position.y;
+    entityPart->sprite.position.x = pose->position.x;
+    entityPart->sprite.position.y = pose->position.y;
     // Position des Teils gemäss des eigenen Pivots & Rotation und
     // der Rotation der gesamten Entität verschieben.
     int ret = ERR_OK;
     ret = Sprite_SetRelativeToPivot(entityPart->sprite,
-                                    entity->physics.rotation,
+                                    pose->rotation,
                                     (SDL_Point){.x = 0, .y = 0},
                                     &entityPart->tempSprite);
     return ret;
@@ -324,12 +533,18 @@ static int callOnDraw(void *data) {
 }
 
 static int defaultDrawEntity(entity_t *entity) {
-    return List_ForeachArg(entity->parts, defaultDrawEntityPart, entity);
+    return IntrusiveList_ForeachArg(&entity->parts, defaultDrawEntityPart, entity);
 }
 
 static int defaultDrawEntityPart(void *data, void *userData) {
     entityPart_t *part = (entityPart_t *)data;
     entity_t *entity = (entity_t *)userData;
     (void)entity;
-    return SDLW_DrawTexture(part->tempSprite);
+    // Teile liegen in Weltkoordinaten, gezeichnet wird im sichtbaren Ausschnitt
+    sprite_t sprite = part->tempSprite;
+    SDL_Rect viewport;
+    World_GetViewport(&viewport);
+    sprite.position.x -= viewport.x;
+    sprite.position.y -= viewport.y;
+    return SDLW_DrawTexture(sprite);
 }
@@ -0,0 +1,255 @@
+/**
+ * @file fixed.c
+ * @brief Festkommazahlen im Format Q16.16
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ */
+
+
+/*
+ * Includes
+ *
+ */
+
+#include <stdint.h>
+
+#include "fixed.h"
+
+
+/*
+ * Typdeklarationen
+ *
+ */
+
+#define FIXED_TABLE_STEPS 256                        //!< Abschnitte pro Tabelle
+#define FIXED_FULL_CIRCLE (360 * (int64_t)FIXED_ONE) //!< 360° als Festkommazahl
+#define FIXED_QUARTER_CIRCLE (90 * FIXED_ONE)        //!< 90° als Festkommazahl
+
+
+/*
+ * Variablendeklarationen
+ *
+ */
+
+/**
+ * @brief Sinus von 0° bis 90° in 256 Schritten
+ *
+ * Eintrag i ist sin(i * 90° / 256) in Q16.16. Die Werte sind fest eingetragen
+ * und nicht zur Laufzeit berechnet, damit sie nicht von der
+ * Standardbibliothek abhängen.
+ */
+static const int32_t sineTable[FIXED_TABLE_STEPS + 1] = {
+    0, 402, 804, 1206, 1608, 2010, 2412, 2814,
+    3216, 3617, 4019, 4420, 4821, 5222, 5623, 6023,
+    6424, 6824, 7224, 7623, 8022, 8421, 8820, 9218,
+    9616, 10014, 10411, 10808, 11204, 11600, 11996, 12391,
+    12785, 13180, 13573, 13966, 14359, 14751, 15143, 15534,
+    15924, 16314, 16703, 17091, 17479, 17867, 18253, 18639,
+    19024, 19409, 19792, 20175, 20557, 20939, 21320, 21699,
+    22078, 22457, 22834, 23210, 23586, 23961, 24335, 24708,
+    25080, 25451, 25821, 26190, 26558, 26925, 27291, 27656,
+    28020, 28383, 28745, 29106, 29466, 29824, 30182, 30538,
+    30893, 31248, 31600, 31952, 32303, 32652, 33000, 33347,
+    33692, 34037, 34380, 34721, 35062, 35401, 35738, 36075,
+    36410, 36744, 37076, 37407, 37736, 38064, 38391, 38716,
+    39040, 39362, 39683, 40002, 40320, 40636, 40951, 41264,
+    41576, 41886, 42194, 42501, 42806, 43110, 43412, 43713,
+    44011, 44308, 44604, 44898, 45190, 45480, 45769, 46056,
+    46341, 46624, 46906, 47186, 47464, 47741, 48015, 48288,
+    48559, 48828, 49095, 49361, 49624, 49886, 50146, 50404,
+    50660, 50914, 51166, 51417, 51665, 51911, 52156, 52398,
+    52639, 52878, 53114, 53349, 53581, 53812, 54040, 54267,
+    54491, 54714, 54934, 55152, 55368, 55582, 55794, 56004,
+    56212, 56418, 56621, 56823, 57022, 57219, 57414, 57607,
+    57798, 57986, 58172, 58356, 58538, 58718, 58896, 59071,
+    59244, 59415, 59583, 59750, 59914, 60075, 60235, 60392,
+    60547, 60700, 60851, 60999, 61145, 61288, 61429, 61568,
+    61705, 61839, 61971, 62101, 62228, 62353, 62476, 62596,
+    62714, 62830, 62943, 63054, 63162, 63268, 63372, 63473,
+    63572, 63668, 63763, 63854, 63944, 64031, 64115, 64197,
+    64277, 64354, 64429, 64501, 64571, 64639, 64704, 64766,
+    64827, 64884, 64940, 64993, 65043, 65091, 65137, 65180,
+    65220, 65259, 65294, 65328, 65358, 65387, 65413, 65436,
+    65457, 65476, 65492, 65505, 65516, 65525, 65531, 65535,
+    65536,
+};
+
+/**
+ * @brief Arcustangens von 0 bis 1 in 256 Schritten
+ *
+ * Eintrag i ist atan(i / 256) in Grad und Q16.16.
+ */
+static const int32_t atanTable[FIXED_TABLE_STEPS + 1] = {
+    0, 14668, 29335, 44001, 58666, 73329, 87990, 102648,
+    117304, 131955, 146603, 161246, 175884, 190517, 205144, 219765,
+    234379, 248986, 263585, 278177, 292760, 307334, 321899, 336454,
+    350999, 365534, 380058, 394570, 409070, 423558, 438034, 452496,
+    466945, 481380, 495801, 510207, 524598, 538973, 553333, 567676,
+    582003, 596312, 610605, 624879, 639135, 653372, 667591, 681790,
+    695970, 710129, 724268, 738387, 752484, 766560, 780613, 794645,
+    808654, 822641, 836604, 850544, 864460, 878352, 892219, 906062,
+    919879, 933671, 947438, 961178, 974893, 988580, 1002241, 1015875,
+    1029481, 1043060, 1056611, 1070133, 1083627, 1097092, 1110529, 1123936,
+    1137313, 1150661, 1163979, 1177267, 1190524, 1203751, 1216947, 1230111,
+    1243245, 1256347, 1269417, 1282455, 1295461, 1308435, 1321376, 1334285,
+    1347161, 1360004, 1372813, 1385590, 1398332, 1411041, 1423717, 1436358,
+    1448965, 1461538, 1474076, 1486580, 1499049, 1511483, 1523882, 1536246,
+    1548575, 1560868, 1573127, 1585349, 1597536, 1609687, 1621803, 1633882,
+    1645926, 1657933, 1669904, 1681839, 1693738, 1705600, 1717426, 1729215,
+    1740967, 1752683, 1764362, 1776004, 1787610, 1799179, 1810710, 1822205,
+    1833663, 1845084, 1856467, 1867814, 1879123, 1890396, 1901631, 1912829,
+    1923990, 1935113, 1946200, 1957249, 1968261, 1979236, 1990173, 2001074,
+    2011937, 2022763, 2033552, 2044303, 2055018, 2065695, 2076336, 2086939,
+    2097505, 2108034, 2118526, 2128981, 2139399, 2149780, 2160125, 2170432,
+    2180703, 2190937, 2201134, 2211295, 2221419, 2231507, 2241558, 2251572,
+    2261551, 2271492, 2281398, 2291267, 2301101, 2310898, 2320659, 2330384,
+    2340074, 2349727, 2359345, 2368927, 2378474, 2387985, 2397460, 2406901,
+    2416306, 2425675, 2435010, 2444310, 2453574, 2462804, 2471999, 2481159,
+    2490285, 2499376, 2508433, 2517455, 2526443, 2535397, 2544317, 2553203,
+    2562055, 2570873, 2579658, 2588409, 2597126, 2605811, 2614461, 2623079,
+    2631664, 2640215, 2648734, 2657220, 2665673, 2674093, 2682482, 2690837,
+    2699161, 2707452, 2715711, 2723939, 2732134, 2740298, 2748430, 2756531,
+    2764600, 2772638, 2780644, 2788620, 2796564, 2804478, 2812361, 2820213,
+    2828035, 2835826, 2843587, 2851318, 2859019, 2866690, 2874330, 2881941,
+    2889523, 2897075, 2904597, 2912090, 2919554, 2926989, 2934395, 2941772,
+    2949120,
+};
+
+
+/*
+ * Private Funktionsprototypen
+ *
+ */
+
+/**
+ * @brief Begrenzt einen Wert auf den Bereich einer Festkommazahl.
+ *
+ * @param value Der Wert
+ *
+ * @return Der begrenzte Wert
+ */
+static fixed_t Saturate(int64_t value);
+
+/**
+ * @brief Interpoliert linear in einer Tabelle.
+ *
+ * @param[in] table Die Tabelle mit FIXED_TABLE_STEPS + 1 Einträgen
+ * @param position Position in Tabellenschritten als Festkommazahl, 0 bis
+ * FIXED_TABLE_STEPS
+ *
+ * @return Der interpolierte Wert
+ */
+static fixed_t Interpolate(const int32_t *table, int64_t position);
+
+
+/*
+ * Implementation öffentlicher Funktionen
+ *
+ */
+
+fixed_t Fixed_FromInt(int value) {
+    return (fixed_t)(value * FIXED_ONE);
+}
+
+fixed_t Fixed_FromFloat(float value) {
+    // Die Skalierung mit einer Zweierpotenz ist exakt, ebenso die Addition von
+    // 0.5 in double. Das Ergebnis hängt also nicht von der Plattform ab.
+    double scaled = (double)value * FIXED_ONE;
+    if (scaled != scaled) {
+        return 0;
+    }
+    if (scaled >= INT32_MAX) {
+        return INT32_MAX;
+    }
+    if (scaled <= INT32_MIN) {
+        return INT32_MIN;
+    }
+    return (fixed_t)(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
+}
+
+float Fixed_ToFloat(fixed_t value) {
+    return (float)value / FIXED_ONE;
+}
+
+int Fixed_ToInt(fixed_t value) {
+    return value / FIXED_ONE;
+}
+
+fixed_t Fixed_Mul(fixed_t a, fixed_t b) {
+    int64_t product = (int64_t)a * b;
+    // Division statt Schieben, damit negative Zahlen definiert runden
+    int64_t half = product < 0 ? -(FIXED_ONE / 2) : FIXED_ONE / 2;
+    return Saturate((product + half) / FIXED_ONE);
+}
+
+fixed_t Fixed_Div(fixed_t a, fixed_t b) {
+    if (b == 0) {
+        return a < 0 ? INT32_MIN : INT32_MAX;
+    }
+    return Saturate((int64_t)a * FIXED_ONE / b);
+}
+
+fixed_t Fixed_Sin(fixed_t degrees) {
+    int64_t angle = degrees % FIXED_FULL_CIRCLE;
+    if (angle < 0) {
+        angle += FIXED_FULL_CIRCLE;
+    }
+    // Viertelkreis und Position darin in Tabellenschritten
+    int quadrant = (int)(angle / FIXED_QUARTER_CIRCLE);
+    int64_t position = angle % FIXED_QUARTER_CIRCLE * FIXED_TABLE_STEPS * FIXED_ONE / FIXED_QUARTER_CIRCLE;
+    if (quadrant & 1) {
+        position = (int64_t)FIXED_TABLE_STEPS * FIXED_ONE - position;
+    }
+    fixed_t sine = Interpolate(sineTable, position);
+    return quadrant & 2 ? -sine : sine;
+}
+
+fixed_t Fixed_Cos(fixed_t degrees) {
+    int64_t angle = degrees % FIXED_FULL_CIRCLE + FIXED_QUARTER_CIRCLE;
+    return Fixed_Sin((fixed_t)(angle % FIXED_FULL_CIRCLE));
+}
+
+fixed_t Fixed_Atan2(fixed_t y, fixed_t x) {
+    int64_t absX = x < 0 ? -(int64_t)x : x;
+    int64_t absY = y < 0 ? -(int64_t)y : y;
+    if (absX == 0 && absY == 0) {
+        return 0;
+    }
+    // Auf den ersten Achtelkreis zurückführen, dort ist das Verhältnis <= 1
+    fixed_t angle;
+    if (absY <= absX) {
+        angle = Interpolate(atanTable, absY * FIXED_TABLE_STEPS * FIXED_ONE / absX);
+    } else {
+        angle = FIXED_QUARTER_CIRCLE - Interpolate(atanTable, absX * FIXED_TABLE_STEPS * FIXED_ONE / absY);
+    }
+    if (x < 0) {
+        angle = 180 * FIXED_ONE - angle;
+    }
+    return y < 0 ? -angle : angle;
+}
+
+
+/*
+ * Implementation privater Funktionen
+ *
+ */
+
+static fixed_t Saturate(int64_t value) {
+    if (value > INT32_MAX) {
+        return INT32_MAX;
+    }
+    if (value < INT32_MIN) {
+        return INT32_MIN;
+    }
+    return (fixed_t)value;
+}
+
+static fixed_t Interpolate(const int32_t *table, int64_t position) {
+    int index = (int)(position / FIXED_ONE);
+    if (index >= FIXED_TABLE_STEPS) {
+        return table[FIXED_TABLE_STEPS];
+    }
+    int64_t fraction = position % FIXED_ONE;
+    return (fixed_t)(table[index] + (table[index + 1] - table[index]) * fraction / FIXED_ONE);
+}
@@ -17,7 +17,7 @@
 
 #include "SDL_ttf.h"
 #include "sdlWrapper.h"
-#include "list.h"
+#include "intrusiveList.h"
 #include "error.h"
 #include "gui.h"
 
@@ -80,7 +80,7 @@ int GUI_Init(gui_t *gui) {
         return ERR_NULLPARAMETER;
     }
 
-    if (List_Init(&gui->element) != ERR_OK) { // Verifizierung
+    if (IntrusiveList_Init(&gui->element) != ERR_OK) { // Verifizierung
         return ERR_FAIL;
     }
     return ERR_OK;
@@ -92,7 +92,7 @@ int GUI_Update(inputEvent_t *inputEvents, gui_t *gui) {
         return ERR_NULLPARAMETER;
     }
 
-    List_ForeachArg(&gui->element, (fnPntrDataCallbackArg)UpdateElement, inputEvents);
+    IntrusiveList_ForeachArg(&gui->element, (fnPntrDataCallbackArg)UpdateElement, inputEvents);
     return ERR_OK;
 }
 
@@ -102,7 +102,7 @@ int GUI_Draw(gui_t *gui) {
         return ERR_NULLPARAMETER;
     }
 
-    List_Foreach(&gui->element, (fnPntrDataCallback)DrawElement);
+    IntrusiveList_Foreach(&gui->element, (fnPntrDataCallback)DrawElement);
 
     (void)gui;
     return ERR_OK;
@@ -113,7 +113,10 @@ int GUI_AddElement(guiElement_t *element, gui_t *gui) {
 
         return ERR_NULLPARAMETER;
     }
-    if (List_Add(&gui->element, element) != ERR_OK) { // Ist das Hinzufügen von gui Elemente fehlgeschlagen wird eine Fehlermeldung ausgegeben.
+    if (IntrusiveList_IsLinked(&element->link)) { // Bereits in der Liste, Position und damit Zeichenreihenfolge beibehalten
+        return ERR_OK;
+    }
+    if (IntrusiveList_Add(&gui->element, &element->link, element) != ERR_OK) { // Ist das Hinzufügen von gui Elemente fehlgeschlagen wird eine Fehlermeldung ausgegeben.
         SDL_Log("Hinzufügen des Elements fehlgeschlagen");
     }
     return ERR_OK;
@@ -124,7 +127,7 @@ int GUI_RemoveElement(guiElement_t *element, gui_t *gui) {
 
         return ERR_NULLPARAMETER;
     }
-    List_Remove(&gui->element, element);
+    IntrusiveList_Remove(&gui->element, &element->link);
     return ERR_OK;
 }
 
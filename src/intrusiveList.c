@@ -0,0 +1,161 @@
+/**
+ * @file intrusiveList.c
+ * @brief Doppelt verlinkte intrusive Liste
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ */
+
+
+/*
+ * Includes
+ *
+ */
+
+#include <SDL.h>
+
+#include "intrusiveList.h"
+#include "error.h"
+
+
+/*
+ * Typdeklarationen
+ *
+ */
+
+/* ... */
+
+
+/*
+ * Variablendeklarationen
+ *
+ */
+
+/* ... */
+
+
+/*
+ * Private Funktionsprototypen
+ *
+ */
+
+/* ... */
+
+
+/*
+ * Implementation öffentlicher Funktionen
+ *
+ */
+
+int IntrusiveList_Init(intrusiveList_t *list) {
+    if (!list) { // Fehlerüberprüfung
+        SDL_Log("Liste ungueltig! IntrusiveList_Init()\n");
+        return ERR_NULLPARAMETER;
+    }
+    list->first = NULL;
+    list->elementCount = 0;
+    return ERR_OK;
+}
+
+int IntrusiveList_Add(intrusiveList_t *list, listLink_t *link, void *data) {
+    if (!list || !link) { // Fehlerüberprüfung
+        SDL_Log("Liste oder Glied ungueltig! IntrusiveList_Add()\n");
+        return ERR_NULLPARAMETER;
+    }
+    if (link->pprev) { // Ein Glied kann nicht doppelt verkettet werden
+        return ERR_SEQUENCE;
+    }
+    // Einfügen am Anfang der Liste
+    link->data = data;
+    link->next = list->first;
+    if (list->first)
+        list->first->pprev = &link->next;
+    list->first = link;
+    link->pprev = &list->first;
+    list->elementCount++;
+    return ERR_OK;
+}
+
+int IntrusiveList_Remove(intrusiveList_t *list, listLink_t *link) {
+    if (!list || !link) { // Fehlerüberprüfung
+        SDL_Log("Liste oder Glied ungueltig! IntrusiveList_Remove()\n");
+        return ERR_NULLPARAMETER;
+    }
+    if (!link->pprev) { // Nicht verkettet, nichts zu tun
+        return ERR_OK;
+    }
+    // Vorgänger direkt auf den Nachfolger zeigen lassen
+    *link->pprev = link->next;
+    if (link->next)
+        link->next->pprev = link->pprev;
+    link->next = NULL;
+    link->pprev = NULL;
+    list->elementCount--;
+    return ERR_OK;
+}
+
+int IntrusiveList_Clear(intrusiveList_t *list) {
+    if (!list) { // Fehlerüberprüfung
+        SDL_Log("Liste ungueltig! IntrusiveList_Clear()\n");
+        return ERR_NULLPARAMETER;
+    }
+    // Alle Glieder als nicht verkettet markieren
+    listLink_t *link = list->first;
+    while (link) {
+        listLink_t *next = link->next;
+        link->next = NULL;
+        link->pprev = NULL;
+        link = next;
+    }
+    list->first = NULL;
+    list->elementCount = 0;
+    return ERR_OK;
+}
+
+int IntrusiveList_IsLinked(const listLink_t *link) {
+    return link && link->pprev;
+}
+
+int IntrusiveList_Foreach(intrusiveList_t *list, fnPntrDataCallback callback) {
+    if (!list || !callback) { // Fehlerüberprüfung
+        SDL_Log("Liste oder Callback ungueltig! IntrusiveList_Foreach()\n");
+        return ERR_NULLPARAMETER;
+    }
+    listLink_t *link = list->first;
+    while (link) {
+        // Nächstes Glied vor Callback abfragen, der Callback darf das aktuelle
+        // Glied entfernen.
+        listLink_t *next = link->next;
+        int errorVal = callback(link->data);
+        if (errorVal)
+            return errorVal;
+        link = next;
+    }
+    return ERR_OK;
+}
+
+int IntrusiveList_ForeachArg(intrusiveList_t *list, fnPntrDataCallbackArg callback, void *userData) {
+    if (!list || !callback) { // Fehlerüberprüfung
+        SDL_Log("Liste oder Callback ungueltig! IntrusiveList_ForeachArg()\n");
+        return ERR_NULLPARAMETER;
+    }
+    listLink_t *link = list->first;
+    while (link) {
+        // Nächstes Glied vor Callback abfragen, der Callback darf das aktuelle
+        // Glied entfernen.
+        listLink_t *next = link->next;
+        int errorVal = callback(link->data, userData);
+        if (errorVal)
+            return errorVal;
+        link = next;
+    }
+    return ERR_OK;
+}
+
+
+/*
+ * Implementation privater Funktionen
+ *
+ */
+
+/* ... */
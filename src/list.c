@@ -20,6 +20,32 @@
 #include "list.h"
 #include "error.h"
 
+
+/*
+ * Private Funktionsprototypen
+ *
+ */
+
+/**
+ * @brief Bezieht ein neues Element.
+ * Stammt aus dem Pool der Liste, falls vorhanden, sonst vom Heap.
+ *
+ * @param[in] list Die Liste für die das Element bestimmt ist
+ *
+ * @return Element oder NULL bei zu wenig Speicher
+ */
+static listElement_t *allocElement(list_t *list);
+
+/**
+ * @brief Gibt ein Element zurück.
+ * Elemente einer Liste mit Pool werden in dessen Freiliste gelegt.
+ *
+ * @param[in] list Die Liste zu der das Element gehörte
+ * @param[in] element Das zurückzugebende Element
+ */
+static void freeElement(list_t *list, listElement_t *element);
+
+
 /*
  * Implementation öffentlicher Funktionen
  *
@@ -51,6 +77,55 @@ int List_Init(list_t *list) {
     list->dataAutoFree = NULL;
     list->elementCount = 0;
     list->listHead = NULL;
+    list->pool = NULL;
+    return ERR_OK;
+}
+
+int List_InitPooled(list_t *list, int capacityHint) {
+    if (!list) { // Fehlerüberprüfung
+        SDL_Log("Liste ungueltig! List_InitPooled()\n");
+        return ERR_NULLPARAMETER;
+    }
+    if (capacityHint < 1 || capacityHint > 65536) { // Boundcheck der Poolgrösse
+        SDL_Log("Poolgroesse ausserhalb Schranken! [%d] List_InitPooled()\n", capacityHint);
+        return ERR_PARAMETER;
+    }
+
+    int errCode = List_ReleasePool(list); // Vorhandene Elemente und Pool befreien
+    if (errCode)
+        return errCode;
+
+    list->pool = malloc(sizeof(listPool_t)); // Erstellen des Pools, Blöcke folgen beim ersten Hinzufügen
+    if (!list->pool) {                       // Fehlerüberprüfung
+        SDL_Log("Pool konnte nicht alloziert werden! List_InitPooled()\n");
+        return ERR_MEMORY;
+    }
+    list->pool->chunks = NULL;
+    list->pool->freeElements = NULL;
+    list->pool->chunkCapacity = capacityHint;
+    return ERR_OK;
+}
+
+int List_ReleasePool(list_t *list) {
+    if (!list) { // Fehlerüberprüfung
+        SDL_Log("Liste ungueltig! List_ReleasePool()\n");
+        return ERR_NULLPARAMETER;
+    }
+
+    int errCode = List_Clear(list); // Alle Elemente zurück in den Pool
+    if (errCode)
+        return errCode;
+
+    if (list->pool) { // Deallozierung aller Blöcke
+        listPoolChunk_t *chunk = list->pool->chunks;
+        while (chunk) {
+            listPoolChunk_t *next = chunk->nextChunk;
+            free(chunk);
+            chunk = next;
+        }
+        free(list->pool);
+        list->pool = NULL;
+    }
     return ERR_OK;
 }
 
@@ -60,7 +135,7 @@ int List_Destroy(list_t **list) {
         return ERR_NULLPARAMETER;
     }
 
-    List_Clear(*list); // Deallozierung aller Elemente
+    List_ReleasePool(*list); // Deallozierung aller Elemente und des Pools
     free(*list);
     *list = NULL;
     return ERR_OK;
@@ -72,8 +147,8 @@ int List_Add(list_t *list, void *data) {
         return ERR_NULLPARAMETER;
     }
 
-    listElement_t *element = malloc(sizeof(listElement_t)); // Erstellen eines neuen Elementes
-    if (!element) {                                         // Fehlerüberprüfung
+    listElement_t *element = allocElement(list); // Erstellen eines neuen Elementes
+    if (!element) {                              // Fehlerüberprüfung
         SDL_Log("Element konnte nicht alloziert werden! List_Add()\n");
         return ERR_MEMORY;
     }
@@ -111,7 +186,7 @@ int List_Remove(list_t *list, void *data) {
                 list->listHead = element->nextElement;
 
             list->elementCount--;
-            free(element);
+            freeElement(list, element);
             break;
         }
 
@@ -246,3 +321,41 @@ int List_SearchArg(list_t *list, fnPntrDataCallbackArg searchCmpFn, void *userDa
     }
     return ERR_OK;
 }
+
+
+/*
+ * Implementation privater Funktionen
+ *
+ */
+
+static listElement_t *allocElement(list_t *list) {
+    listPool_t *pool = list->pool;
+    if (!pool) // Ohne Pool wird jedes Element einzeln alloziert
+        return malloc(sizeof(listElement_t));
+
+    if (!pool->freeElements) { // Pool ist erschöpft, neuen Block allozieren
+        listPoolChunk_t *chunk = malloc(sizeof(listPoolChunk_t) + sizeof(listElement_t) * pool->chunkCapacity);
+        if (!chunk)
+            return NULL;
+        chunk->nextChunk = pool->chunks;
+        pool->chunks = chunk;
+        // Alle Elemente des Blocks in die Freiliste einfügen
+        for (int i = 0; i < pool->chunkCapacity; ++i) {
+            chunk->elements[i].nextElement = pool->freeElements;
+            pool->freeElements = &chunk->elements[i];
+        }
+    }
+
+    listElement_t *element = pool->freeElements;
+    pool->freeElements = element->nextElement;
+    return element;
+}
+
+static void freeElement(list_t *list, listElement_t *element) {
+    if (!list->pool) {
+        free(element);
+        return;
+    }
+    element->nextElement = list->pool->freeElements;
+    list->pool->freeElements = element;
+}
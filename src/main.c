@@ -17,13 +17,16 @@
 
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "sdlWrapper.h"
 #include "error.h"
 #include "scene.h"
 #include "entity.h"
 #include "entityHandler.h"
+#include "physics.h"
 #include "entities/tank.h"
+#include "profiler.h"
 
 /*
  * Typdeklarationen
@@ -40,23 +43,25 @@
 /**
  * @brief Main
  * 
+ * Mit "--profile[=datei]" wird der Start gemessen, siehe profiler.h. Mit
+ * "--deterministic" rechnet die Physik in Festkommazahlen, siehe
+ * Physics_SetDeterministic().
+ * 
  * @param argc Anzahl Befehlszeilenargumente
  * @param argv Array der Argumente
  * @return int immer 0
  */
 int main(int argc, char *argv[]) {
-    (void)argc;
-    (void)argv;
     static gui_t sceneStartUp;             //!< GUI Elemente Liste
     static sceneNamePlayer_t sceneNamPla;  //!< Struktur mit allen Elementen der Szene
-    static gui_t sceneNamePlayer;          //!< GUI Elemente Liste
+    static gui_t *sceneNamePlayer;         //!< GUI Elemente Liste
     static sceneMainMenu_t sceneMaiMen;    //!< Struktur mit allen Elementen der Szene
-    static gui_t sceneMainMenu;            //!< GUI Elemente Liste
+    static gui_t *sceneMainMenu;           //!< GUI Elemente Liste
     static gui_t sceneControls;            //!< GUI Elemente Liste
     static sceneInGame_t sceneInGam;       //!< Struktur mit allen Elementen der Szene
-    static gui_t sceneInGame;              //!< GUI Elemente Liste
+    static gui_t *sceneInGame;             //!< GUI Elemente Liste
     static sceneChooseWorld_t sceneChoWor; //!< Struktur mit allen Elementen der Szene
-    static gui_t sceneChooseWorld;         //!< GUI Elemente Liste
+    static gui_t *sceneChooseWorld;        //!< GUI Elemente Liste
     static gui_t sceneVictory;             //!< GUI Elemente Liste
     static gui_t sceneErrFail;             //!< GUI Elemente Liste
     static gui_t *sceneCurrent;            //!< Zeiger auf aktuelle GUI Elemente Liste
@@ -67,13 +72,22 @@ int main(int argc, char *argv[]) {
     static int startUpLoop = 0;            //!< Delay beim StartUp
 
 
+    // Optionale Zeitmessung des Starts
+    Profiler_Init(argc, argv);
+    // Optional plattformunabhängige Physik
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--deterministic")) {
+            Physics_SetDeterministic(1);
+        }
+    }
+
     // SDL Init mit Fenster Grösse 1024x576
     if (ERR_OK != SDLW_Init(1024, 576)) {
         currentSceneID = SCENE_ERR_FAIL;
     }
 
-    // SDL lädt Config File
-    if (ERR_OK != SDLW_LoadResources("assets/config.cfg")) {
+    // SDL lädt Paket oder ohne Paket das Config File
+    if (ERR_OK != SDLW_LoadPack("assets.pack", "assets/config.cfg")) {
         currentSceneID = SCENE_ERR_FAIL;
     }
 
@@ -97,7 +111,9 @@ int main(int argc, char *argv[]) {
     if (ERR_OK != Scene_Draw(&sceneStartUp)) {
         currentSceneID = SCENE_ERR_FAIL;
     }
-    // GUI Listen and die entsprechenden Variablen, von der Struktur übergeben
+    // Das erste Bild ist gezeichnet, der Start ist abgeschlossen
+    Profiler_Report();
+    // Zeiger auf die GUI Listen aus den Strukturen übernehmen
     sceneNamePlayer = sceneNamPla.sceneNamPlaGUI;
     sceneMainMenu = sceneMaiMen.sceneMainMenuGUI;
     sceneInGame = sceneInGam.sceneInGameGUI;
@@ -123,10 +139,10 @@ int main(int argc, char *argv[]) {
             }
             break;
         case SCENE_NAMEPLAYER:
-            sceneCurrent = &sceneNamePlayer;
+            sceneCurrent = sceneNamePlayer;
             break;
         case SCENE_MAINMENU:
-            sceneCurrent = &sceneMainMenu;
+            sceneCurrent = sceneMainMenu;
             break;
         case SCENE_CONTROLS:
             sceneCurrent = &sceneControls;
@@ -158,7 +174,6 @@ int main(int argc, char *argv[]) {
             if (ERR_OK != sceneInGame_Update(&sceneInGam, playerA, playerB, inputEvent)) {
                 currentSceneID = SCENE_ERR_FAIL;
             }
-            sceneInGame = sceneInGam.sceneInGameGUI;
 
             // Fünf Startpositionen erstellen aber nur die äusseren zwei
             // verwenden. So sind die Panzer weit voneinander entfernt.
@@ -174,7 +189,7 @@ int main(int argc, char *argv[]) {
             currentSceneID = SCENE_INGAME;
             break;
         case SCENE_CHOOSEWORLD:
-            sceneCurrent = &sceneChooseWorld;
+            sceneCurrent = sceneChooseWorld;
             break;
         case SCENE_INGAME:
             // Aktiven Spieler umschalten
@@ -184,7 +199,6 @@ int main(int argc, char *argv[]) {
                 if (ERR_OK != sceneInGame_Update(&sceneInGam, playerA, playerB, inputEvent)) {
                     currentSceneID = SCENE_ERR_FAIL;
                 }
-                sceneInGame = sceneInGam.sceneInGameGUI;
             }
             // Lebenspunkte Abfrage, falls ein Spieler Lebenspunkte
             // gleich 0 oder unter 0 hat, wird das Spiel beendet
@@ -204,7 +218,7 @@ int main(int argc, char *argv[]) {
                 }
                 World_Quit();
             }
-            sceneCurrent = &sceneInGame;
+            sceneCurrent = sceneInGame;
             break;
         case SCENE_VICTORY:
             sceneCurrent = &sceneVictory;
@@ -213,7 +227,7 @@ int main(int argc, char *argv[]) {
             sceneCurrent = &sceneErrFail;
             break;
         default:
-            sceneCurrent = &sceneMainMenu;
+            sceneCurrent = sceneMainMenu;
             break;
         }
         // Aktuelle Szene aktualisieren, mit allen enthaltenen Elementen
@@ -0,0 +1,44 @@
+/**
+ * @file packmain.c
+ * @brief Packer für Ressourcenpakete
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * Erstellt aus einer Ressourcenkonfigurationsdatei ein Paket für
+ * SDLW_LoadPack(). Aufruf: tanks_pack <config.cfg> <paket>
+ */
+
+
+/*
+ * Includes
+ *
+ */
+
+#include <stdio.h>
+
+#include "sdlWrapper.h"
+#include "error.h"
+
+
+/**
+ * @brief Main
+ *
+ * @param argc Anzahl Befehlszeilenargumente
+ * @param argv Array der Argumente
+ * @return int 0 oder 1 bei einem Fehler
+ */
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        printf("Aufruf: %s <config.cfg> <paket>\n", argv[0]);
+        return 1;
+    }
+    SDL_SetMainReady();
+    IMG_Init(IMG_INIT_JPG | IMG_INIT_PNG);
+    int errorCode = SDLW_BuildPack(argv[1], argv[2]);
+    IMG_Quit();
+    if (errorCode) {
+        printf("Paket konnte nicht erstellt werden! [%d]\n", errorCode);
+        return 1;
+    }
+    return 0;
+}
@@ -21,10 +21,12 @@
  */
 
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include "error.h"
-#include "list.h"
+#include "fixed.h"
 #include "physics.h"
 #include "world.h"
 
@@ -42,7 +44,8 @@
  * 
  */
 
-#define DELTA_TIME (1.0f / 60.0f) //!< Updateintervall [s]
+#define DELTA_TIME PHYSICS_STEP_TIME                      //!< Updateintervall [s]
+#define DELTA_TIME_FIXED (FIXED_ONE / PHYSICS_STEP_RATE) //!< Updateintervall in Q16.16 [s]
 #define GRAVITY 40.0f             //!< Erdbeschleunigung [pixel / s2]
 #define NEAR_ZERO 0.1f            //!< Werte die kleiner sind zählen als 0
 #define DAMPENING_FACTOR_X 1.0f   //!< Dämpffaktor für Bewegungen nach oben
@@ -69,6 +72,14 @@
  */
 #define ENTITY_SCALE_FACTOR 200.0f
 
+#define LIFT_SAMPLE_SPACING 8 //!< Abstand der Abtastpunkte an der Unterkante beim Befreien [pixel]
+
+#define BROAD_PHASE_CELL 64        //!< Kantenlänge einer Zelle der Breitphase [pixel]
+#define BROAD_PHASE_BUCKETS 4096   //!< Anzahl Eimer des räumlichen Hashs, Zweierpotenz
+#define BROAD_PHASE_MAX_CELLS 16   //!< Entitäten mit mehr Zellen werden mit allen geprüft
+
+static int deterministic = 0; //!< Physik wird in Festkommazahlen gerechnet
+
 
 /*
  * Private Funktionsprototypen
@@ -76,16 +87,60 @@
  */
 
 /**
- * @brief Berechne Physikschritt für eine Entität.
+ * @brief Setze die Position im Speicher oder in der Entität.
+ * 
+ * Im Speicher wird auch der Festkommawert gesetzt, aber nur für die veränderte
+ * Komponente. Die andere bleibt so im deterministischen Modus bitgenau.
+ * 
+ * @param[in,out] entity Die Entität
+ * @param x x-Koordinate, NAN = unverändert
+ * @param y y-Koordinate, NAN = unverändert
+ */
+static void setPosition(entity_t *entity, float x, float y);
+
+/**
+ * @brief Setze die Geschwindigkeit im Speicher oder in der Entität.
+ * 
+ * Wie \ref setPosition().
+ * 
+ * @param[in,out] entity Die Entität
+ * @param x Horizontale Geschwindigkeit, NAN = unverändert
+ * @param y Vertikale Geschwindigkeit, NAN = unverändert
+ */
+static void setVelocity(entity_t *entity, float x, float y);
+
+/**
+ * @brief Übernehme die Gleitkommawerte aller Slots als Festkommawerte.
+ * 
+ * Wird nur beim Einschalten des deterministischen Modus benötigt, danach
+ * halten die Physics_Set*() Funktionen beide aktuell.
+ * 
+ * @param[in,out] store Physikspeicher
+ */
+static void syncFixed(physicsStore_t *store);
+
+/**
+ * @brief Berechne Physikschritt für alle Entitäten.
  *
- * Wird durch List_ForeachArg() für jede Entität der Liste aufgerufen und
- * berechnet einen Physikschritt.
+ * Iteriert linear über die Arrays des Speichers und berechnet einen
+ * Physikschritt für alle nicht statischen Entitäten. Bewegt sich eine
+ * Entität in einem Schritt weiter als ihre AABB gross ist, wird die Strecke
+ * per \ref World_Sweep() geprüft und die Entität am ersten Kontakt mit der
+ * Welt angehalten.
  * 
- * @param data opaker Pointer auf eine Entität
+ * @param[in,out] store Physikspeicher
+ */
+static void updateEntities(physicsStore_t *store);
+
+/**
+ * @brief Berechne Physikschritt für alle Entitäten in Festkommazahlen.
  *
- * @return ERR_OK oder ERR_FAIL
+ * Wie \ref updateEntities(), aber auf \ref physicsStore_t.fixed. Die
+ * Gleitkommawerte werden danach aus den Festkommawerten gesetzt.
+ * 
+ * @param[in,out] store Physikspeicher
  */
-static int updateEntity(void *data);
+static void updateEntitiesFixed(physicsStore_t *store);
 
 /**
  * @brief Bereinige Physikdaten.
@@ -93,39 +148,140 @@ static int updateEntity(void *data);
  * Da sehr kleine Beschleunigungen mühsam berechnet werden müssen, aber keinen
  * nennenswerten einfluss auf die Position haben, werden diese auf 0 gesetzt.
  * 
- * @param[in,out] physics Physikdaten welche berenigt werden sollen
+ * @param[in,out] store Physikspeicher dessen Daten berenigt werden sollen
  */
-static void clearNearToZero(entityPhysics_t *physics);
+static void clearNearToZero(physicsStore_t *store);
 
 /**
- * @brief Überprüfe auf Kollision einer Entität mit allen anderen und der Welt.
+ * @brief Bereinige Physikdaten in Festkommazahlen, siehe \ref clearNearToZero().
  * 
- * Überprüft zuerst auf eine Kollision mit der Welt und danach iteriert es über
- * die Liste an Entitäten und prüft abermals auf Kollisionen. Die Kollision mit
- * der Welt wird hier dem Callback mitgeteilt.
+ * @param[in,out] store Physikspeicher dessen Daten berenigt werden sollen
+ */
+static void clearNearToZeroFixed(physicsStore_t *store);
+
+/**
+ * @brief Überprüfe auf Kollision einer Entität mit der Welt und anderen.
  * 
- * @note Komplexität ist O(n^2)
+ * Überprüft zuerst auf eine Kollision mit der Welt und danach mit den
+ * Entitäten, welche die Breitphase als mögliche Partner liefert. Da Slots
+ * absteigend geprüft werden, sind das nur Entitäten mit kleinerem Slot. Jedes
+ * Paar wird so nur einmal geprüft. Die Kollision mit der Welt wird hier dem
+ * Callback mitgeteilt.
  * 
- * @param data opaker Pointer auf eine Entität
- * @param userData opaker Pointer auf Entitätsliste
+ * @param[in,out] store Physikspeicher
+ * @param slot Slot der Entität die geprüft wird
  * 
  * @return ERR_OK oder ERR_FAIL
  */
-static int checkForAllCollisions(void *data, void *userData);
+static int checkForAllCollisions(physicsStore_t *store, int slot);
 
 /**
  * @brief Überprüfe auf Kollision zwischen zwei Entitäten.
  *
- * Wird durch List_ForeachArg() aufgerufen und prüft mittels SDL auf Kollision.
- * Falls eine existiert so wird die Kollisionsnormale gesetzt und der Callback
- * der Entität aufgerufen.
+ * Prüft die AABBs auf Überlappung. Falls eine existiert, so wird für beide
+ * Entitäten die Kollisionsnormale ermittelt und deren Callback aufgerufen,
+ * zuerst für \p sourceSlot.
  * 
- * @param data opaker Pointer auf eine Entität für die momentan geprüft wird
- * @param userData opaker Pointer auf Entität gegen die geprüft wird
+ * @param[in,out] store Physikspeicher
+ * @param targetSlot Slot der Entität gegen die geprüft wird
+ * @param sourceSlot Slot der Entität für die momentan geprüft wird
  *
  * @return ERR_OK oder ERR_FAIL
  */
-static int checkForEntityCollision(void *data, void *userData);
+static int checkForEntityCollision(physicsStore_t *store, int targetSlot, int sourceSlot);
+
+/**
+ * @brief Ermittle die Kollisionsnormale einer Entität.
+ * 
+ * Gesucht wird die kürzere Seite der Überlappung. Als Vektorlänge wird die
+ * Breite bez. Höhe der Überlappung genommen und mit einem Faktor gewichtet.
+ * 
+ * @param self AABB der Entität für welche die Normale gilt
+ * @param intersection Überlappung mit dem Partner
+ * 
+ * @return Die Kollisionsnormale
+ */
+static SDL_FPoint entityNormal(const SDL_Rect *self, const SDL_Rect *intersection);
+
+/**
+ * @brief Baue die Breitphase aus den AABBs aller Slots auf.
+ * 
+ * Jede Entität wird in alle Zellen eines gleichmässigen Rasters eingetragen,
+ * die ihre AABB berührt. Die Zellen werden in einen räumlichen Hash mit
+ * \ref BROAD_PHASE_BUCKETS Eimern abgebildet und per Counting Sort nach Eimer
+ * sortiert.
+ * 
+ * @param[in,out] store Physikspeicher
+ * 
+ * @return ERR_OK oder ERR_MEMORY
+ */
+static int buildBroadPhase(physicsStore_t *store);
+
+/**
+ * @brief Suche mögliche Kollisionspartner einer Entität.
+ * 
+ * Geprüft wird die aktuelle AABB des Slots gegen die beim Aufbau eingetragenen
+ * AABBs. Die Partner landen absteigend sortiert und ohne Duplikate in
+ * \ref physicsBroadPhase_t.candidates.
+ * 
+ * @param[in,out] store Physikspeicher
+ * @param slot Slot der Entität, nur kleinere Slots werden geliefert
+ * 
+ * @return Anzahl möglicher Partner
+ */
+static int queryBroadPhase(physicsStore_t *store, int slot);
+
+/**
+ * @brief Ermittle die Zellen der Breitphase, die eine AABB berührt.
+ * 
+ * @param aabb Die AABB
+ * @param[out] cells Zellen als Rechteck im Raster
+ * 
+ * @return Anzahl Zellen, 0 für leere AABBs, mehr als
+ * \ref BROAD_PHASE_MAX_CELLS für sehr grosse
+ */
+static int cellRange(const SDL_Rect *aabb, SDL_Rect *cells);
+
+/**
+ * @brief Vergleiche zwei Slots absteigend für qsort().
+ * 
+ * @param a erster Slot
+ * @param b zweiter Slot
+ * 
+ * @return negativ falls \p a grösser ist
+ */
+static int compareDescending(const void *a, const void *b);
+
+/**
+ * @brief Ermittle die Zelle des Rasters einer Koordinate.
+ * 
+ * @param coordinate x- oder y-Koordinate [pixel]
+ * 
+ * @return Spalte oder Zeile der Zelle
+ */
+static inline int cellOf(int coordinate);
+
+/**
+ * @brief Bilde eine Zelle des Rasters auf einen Eimer ab.
+ * 
+ * @param x Spalte der Zelle
+ * @param y Zeile der Zelle
+ * 
+ * @return Index des Eimers
+ */
+static inline int bucketOf(int x, int y);
+
+/**
+ * @brief Prüfe ob sich zwei AABBs überlappen.
+ * 
+ * Schnelle Vorprüfung mit identischem Ergebnis wie SDL_HasIntersection().
+ * 
+ * @param a erste AABB
+ * @param b zweite AABB
+ * 
+ * @return true falls sich die AABBs überlappen
+ */
+static inline bool aabbOverlap(const SDL_Rect *a, const SDL_Rect *b);
 
 /**
  * @brief Reagiere mit Standardaktion auf Kollision.
@@ -136,37 +292,206 @@ static int checkForEntityCollision(void *data, void *userData);
  * der Normale die Geschwindigkeit erhöht. Die restlichen Kollisionen setzen die
  * Geschwindigkeit zurück auf 0.
  * 
- * @param entity Entität die an der Kollision beteiligt ist
+ * @param[in,out] store Physikspeicher
+ * @param slot Slot der Entität die an der Kollision beteiligt ist
  * @param collision Infos der Kollision
+ */
+static void handleCollision(physicsStore_t *store, int slot, const entityCollision_t *collision);
+
+/**
+ * @brief Reagiere in Festkommazahlen mit Standardaktion auf Kollision.
+ * 
+ * Wie \ref handleCollision(), aber auf den Festkommawerten des Slots. Die
+ * Gleitkommawerte des Slots werden danach aus den Festkommawerten gesetzt.
+ * 
+ * @param[in,out] store Physikspeicher
+ * @param slot Slot der Entität die an der Kollision beteiligt ist
+ * @param collision Infos der Kollision
+ */
+static void handleCollisionFixed(physicsStore_t *store, int slot, const entityCollision_t *collision);
+
+/**
+ * @brief Reagiere nach dem Callback einer Entität auf eine Kollision.
+ * 
+ * Wendet je nach Modus \ref handleCollision() oder
+ * \ref handleCollisionFixed() an. Änderungen des Callbacks über die
+ * Physics_Set*() Funktionen liegen bereits im Speicher.
+ * 
+ * @param[in,out] store Physikspeicher
+ * @param slot Slot der Entität die an der Kollision beteiligt ist
+ * @param collision Infos der Kollision
+ */
+static void respondToCollision(physicsStore_t *store, int slot, entityCollision_t *collision);
+
+/**
+ * @brief Suche die kleinste freie Position oberhalb einer AABB.
+ * 
+ * Zuerst wird die Höhe der letzten Befreiung \p hint und die Höhe darunter
+ * geprüft, eine ruhende Entität braucht so meist nur eine oder zwei Abfragen.
+ * Passt diese nicht, wird ab der Schätzung von \ref liftHeight() mit
+ * verdoppelter Schrittweite nach oben gesucht und die Grenze zwischen
+ * kollidierender und freier Höhe danach binär eingegrenzt.
+ * 
+ * @param aabb Die AABB der Entität, kollidiert mit der Welt
+ * @param maxHeight Maximale Höhe [pixel]
+ * @param[in,out] hint Höhe der letzten Befreiung, wird auf das Ergebnis gesetzt
  * 
- * @return ERR_OK
+ * @return Höhe in Pixel, 0 falls innerhalb von \p maxHeight keine freie Position existiert
  */
-static int handleCollision(entity_t *entity, entityCollision_t *collision);
+static int findLift(SDL_Rect aabb, float maxHeight, int *hint);
+
+/**
+ * @brief Prüfe ob eine angehobene AABB frei von der Welt ist.
+ * 
+ * @param aabb Die AABB der Entität
+ * @param height Höhe um welche die AABB angehoben wird [pixel]
+ * 
+ * @return true falls die AABB auf dieser Höhe nicht mit der Welt kollidiert
+ */
+static bool liftIsFree(SDL_Rect aabb, int height);
+
+/**
+ * @brief Ermittle wie weit eine AABB angehoben werden muss, um frei zu sein.
+ * 
+ * Entlang der Unterkante wird in Abständen von \ref LIFT_SAMPLE_SPACING das
+ * Distanzfeld der Welt abgetastet. Von jedem Punkt aus wird senkrecht nach
+ * oben um den Abstand zum freien Raum gesprungen, bis der Punkt frei ist. Da
+ * in diesem Umkreis alles solid ist, wird der erste freie Pixel nie
+ * übersprungen.
+ * 
+ * @param aabb Die AABB der Entität
+ * 
+ * @return Höhe in Pixel, 0 falls die Unterkante frei oder keine Welt geladen ist
+ */
+static int liftHeight(SDL_Rect aabb);
 
 /*
  * Implementation Öffentlicher Funktionen
  * 
  */
 
-int Physics_Update(list_t *entityList) {
-    int ret = ERR_OK;
+int Physics_Update(physicsStore_t *store) {
+    if (!store) {
+        return ERR_PARAMETER;
+    }
+    // Freie Slots der seit dem letzten Schritt entfernten Entitäten schliessen
+    int ret = PhysicsStore_Compact(store);
     // Alle Entitäten aktualisieren
-    ret = List_Foreach(entityList, updateEntity);
-    // Alle Kollision der Entitäten prüfen
-    ret |= List_ForeachArg(entityList, checkForAllCollisions, entityList);
+    if (deterministic) {
+        if (!store->fixedValid) {
+            syncFixed(store);
+        }
+        clearNearToZeroFixed(store);
+        updateEntitiesFixed(store);
+    } else {
+        clearNearToZero(store);
+        updateEntities(store);
+    }
+    store->fixedValid = deterministic;
+    ret = buildBroadPhase(store);
+    // Alle Kollision der Entitäten prüfen, in umgekehrter Reihenfolge des
+    // Hinzufügens. Die zuletzt hinzugefügte Entität wird zuerst geprüft.
+    for (int slot = store->count - 1; slot >= 0 && !ret; --slot) {
+        ret = checkForAllCollisions(store, slot);
+    }
     return ret;
 }
 
-int Physics_SetPosition(entity_t *entity, float x, float y) {
+int Physics_SetDeterministic(int enabled) {
+    deterministic = enabled != 0;
+    return ERR_OK;
+}
+
+int Physics_IsDeterministic(void) {
+    return deterministic;
+}
+
+double Physics_VectorToAngle(float x, float y) {
+    if (deterministic) {
+        return Fixed_ToFloat(Fixed_Atan2(Fixed_FromFloat(y), Fixed_FromFloat(x)));
+    }
+    return atan2(y, x) * (180.0 / M_PI);
+}
+
+SDL_FPoint Physics_PolarToVector(float length, double angle) {
+    if (deterministic) {
+        fixedVector_t vector = Physics_PolarToVectorFixed(Fixed_FromFloat(length), Fixed_FromFloat((float)angle));
+        return (SDL_FPoint){Fixed_ToFloat(vector.x), Fixed_ToFloat(vector.y)};
+    }
+    double angleRad = angle * (M_PI / 180.0);
+    return (SDL_FPoint){length * cos(angleRad), length * sin(angleRad)};
+}
+
+fixedVector_t Physics_PolarToVectorFixed(fixed_t length, fixed_t angle) {
+    return (fixedVector_t){Fixed_Mul(length, Fixed_Cos(angle)), Fixed_Mul(length, Fixed_Sin(angle))};
+}
+
+SDL_FPoint Physics_GetPosition(const entity_t *entity) {
     if (!entity) {
-        return ERR_PARAMETER;
+        return (SDL_FPoint){0.0f, 0.0f};
     }
-    if (!isnan(x)) {
-        entity->physics.position.x = x;
+    if (entity->physicsStore) {
+        return entity->physicsStore->position[entity->physicsSlot];
     }
-    if (!isnan(y)) {
-        entity->physics.position.y = y;
+    return entity->physics.position;
+}
+
+SDL_FPoint Physics_GetVelocity(const entity_t *entity) {
+    if (!entity) {
+        return (SDL_FPoint){0.0f, 0.0f};
+    }
+    if (entity->physicsStore) {
+        return entity->physicsStore->velocity[entity->physicsSlot];
+    }
+    return entity->physics.velocity;
+}
+
+double Physics_GetRotation(const entity_t *entity) {
+    if (!entity) {
+        return 0.0;
+    }
+    if (entity->physicsStore) {
+        return entity->physicsStore->rotation[entity->physicsSlot];
+    }
+    return entity->physics.rotation;
+}
+
+fixedVector_t Physics_GetPositionFixed(const entity_t *entity) {
+    if (!entity) {
+        return (fixedVector_t){0, 0};
+    }
+    if (entity->physicsStore && deterministic) {
+        return entity->physicsStore->fixed[entity->physicsSlot].position;
+    }
+    SDL_FPoint position = Physics_GetPosition(entity);
+    return (fixedVector_t){Fixed_FromFloat(position.x), Fixed_FromFloat(position.y)};
+}
+
+fixed_t Physics_GetRotationFixed(const entity_t *entity) {
+    if (!entity) {
+        return 0;
     }
+    if (entity->physicsStore) {
+        return entity->physicsStore->fixed[entity->physicsSlot].rotation;
+    }
+    return Fixed_FromFloat((float)entity->physics.rotation);
+}
+
+SDL_Rect Physics_GetAABB(const entity_t *entity) {
+    if (!entity) {
+        return (SDL_Rect){0, 0, 0, 0};
+    }
+    if (entity->physicsStore) {
+        return entity->physicsStore->aabb[entity->physicsSlot];
+    }
+    return entity->physics.aabb;
+}
+
+int Physics_SetPosition(entity_t *entity, float x, float y) {
+    if (!entity) {
+        return ERR_PARAMETER;
+    }
+    setPosition(entity, x, y);
     return ERR_OK;
 }
 
@@ -174,12 +499,9 @@ int Physics_SetRelativePosition(entity_t *entity, float x, float y) {
     if (!entity) {
         return ERR_PARAMETER;
     }
-    if (!isnan(x)) {
-        entity->physics.position.x += x;
-    }
-    if (!isnan(y)) {
-        entity->physics.position.y += y;
-    }
+    // NAN bleibt bei der Addition NAN, die Komponente also unverändert
+    SDL_FPoint position = Physics_GetPosition(entity);
+    setPosition(entity, position.x + x, position.y + y);
     return ERR_OK;
 }
 
@@ -187,12 +509,7 @@ int Physics_SetVelocity(entity_t *entity, float x, float y) {
     if (!entity) {
         return ERR_PARAMETER;
     }
-    if (!isnan(x)) {
-        entity->physics.velocity.x = x;
-    }
-    if (!isnan(y)) {
-        entity->physics.velocity.y = y;
-    }
+    setVelocity(entity, x, y);
     return ERR_OK;
 }
 
@@ -200,34 +517,66 @@ int Physics_SetRelativeVelocity(entity_t *entity, float x, float y) {
     if (!entity) {
         return ERR_PARAMETER;
     }
-    if (!isnan(x)) {
-        entity->physics.velocity.x += x;
-    }
-    if (!isnan(y)) {
-        entity->physics.velocity.y += y;
-    }
+    SDL_FPoint velocity = Physics_GetVelocity(entity);
+    setVelocity(entity, velocity.x + x, velocity.y + y);
     return ERR_OK;
 }
 
 int Physics_SetVelocityPolar(entity_t *entity, float velocity, double angle) {
-    double angleRad = angle * (M_PI / 180.0);
     // Gegebener Betrag und Winkel in Kartesische Form umrechnen
-    return Physics_SetVelocity(entity, velocity * cos(-angleRad),
-                               -(velocity * sin(-angleRad)));
+    SDL_FPoint vector = Physics_PolarToVector(velocity, angle);
+    return Physics_SetVelocity(entity, vector.x, vector.y);
 }
 
 int Physics_SetRelativeVelocityPolar(entity_t *entity, float velocity, double angle) {
-    double angleRad = angle * (M_PI / 180.0);
     // Gegebener Betrag und Winkel in Kartesische Form umrechnen
-    return Physics_SetRelativeVelocity(entity, velocity * cos(-angleRad),
-                                       -(velocity * sin(-angleRad)));
+    SDL_FPoint vector = Physics_PolarToVector(velocity, angle);
+    return Physics_SetRelativeVelocity(entity, vector.x, vector.y);
 }
 
 int Physics_SetRotation(entity_t *entity, double rotation) {
     if (!entity) {
         return ERR_PARAMETER;
     }
-    entity->physics.rotation = rotation;
+    if (entity->physicsStore) {
+        entity->physicsStore->rotation[entity->physicsSlot] = rotation;
+        entity->physicsStore->fixed[entity->physicsSlot].rotation = Fixed_FromFloat((float)rotation);
+    } else {
+        entity->physics.rotation = rotation;
+    }
+    return ERR_OK;
+}
+
+int Physics_SetPositionFixed(entity_t *entity, fixedVector_t position) {
+    if (!entity) {
+        return ERR_PARAMETER;
+    }
+    setPosition(entity, Fixed_ToFloat(position.x), Fixed_ToFloat(position.y));
+    if (entity->physicsStore) {
+        entity->physicsStore->fixed[entity->physicsSlot].position = position;
+    }
+    return ERR_OK;
+}
+
+int Physics_SetVelocityFixed(entity_t *entity, fixedVector_t velocity) {
+    if (!entity) {
+        return ERR_PARAMETER;
+    }
+    setVelocity(entity, Fixed_ToFloat(velocity.x), Fixed_ToFloat(velocity.y));
+    if (entity->physicsStore) {
+        entity->physicsStore->fixed[entity->physicsSlot].velocity = velocity;
+    }
+    return ERR_OK;
+}
+
+int Physics_SetRotationFixed(entity_t *entity, fixed_t rotation) {
+    if (!entity) {
+        return ERR_PARAMETER;
+    }
+    Physics_SetRotation(entity, Fixed_ToFloat(rotation));
+    if (entity->physicsStore) {
+        entity->physicsStore->fixed[entity->physicsSlot].rotation = rotation;
+    }
     return ERR_OK;
 }
 
@@ -235,7 +584,32 @@ int Physics_SetRelativeRotation(entity_t *entity, double rotation) {
     if (!entity) {
         return ERR_PARAMETER;
     }
-    entity->physics.rotation += rotation;
+    return Physics_SetRotation(entity, Physics_GetRotation(entity) + rotation);
+}
+
+int Physics_SetStatic(entity_t *entity, int isStatic) {
+    if (!entity) {
+        return ERR_PARAMETER;
+    }
+    if (entity->physicsStore) {
+        entity->physicsStore->isStatic[entity->physicsSlot] = isStatic;
+    } else {
+        entity->physics.isStatic = isStatic;
+    }
+    return ERR_OK;
+}
+
+int Physics_SetSize(entity_t *entity, int w, int h) {
+    if (!entity) {
+        return ERR_PARAMETER;
+    }
+    SDL_FPoint position = Physics_GetPosition(entity);
+    SDL_Rect aabb = {position.x - w / 2, position.y - h / 2, w, h};
+    if (entity->physicsStore) {
+        entity->physicsStore->aabb[entity->physicsSlot] = aabb;
+    } else {
+        entity->physics.aabb = aabb;
+    }
     return ERR_OK;
 }
 
@@ -245,55 +619,188 @@ int Physics_SetRelativeRotation(entity_t *entity, double rotation) {
  * 
  */
 
-static int updateEntity(void *data) {
-    entity_t *entity = (entity_t *)data;
-    // Werte die nahezu 0 sind auf 0 setzen
-    clearNearToZero(&entity->physics);
-    // Falls Entität keine Bewegung wünscht, dann breche hier ab.
-    if (entity->physics.isStatic == 1) {
-        return ERR_OK;
+static void setPosition(entity_t *entity, float x, float y) {
+    physicsStore_t *store = entity->physicsStore;
+    SDL_FPoint *position = store ? &store->position[entity->physicsSlot] : &entity->physics.position;
+    if (!isnan(x)) {
+        position->x = x;
+    }
+    if (!isnan(y)) {
+        position->y = y;
+    }
+    if (!store) {
+        return;
+    }
+    fixedVector_t *fixed = &store->fixed[entity->physicsSlot].position;
+    if (!isnan(x)) {
+        fixed->x = Fixed_FromFloat(x);
+    }
+    if (!isnan(y)) {
+        fixed->y = Fixed_FromFloat(y);
+    }
+}
+
+static void setVelocity(entity_t *entity, float x, float y) {
+    physicsStore_t *store = entity->physicsStore;
+    SDL_FPoint *velocity = store ? &store->velocity[entity->physicsSlot] : &entity->physics.velocity;
+    if (!isnan(x)) {
+        velocity->x = x;
+    }
+    if (!isnan(y)) {
+        velocity->y = y;
+    }
+    if (!store) {
+        return;
+    }
+    fixedVector_t *fixed = &store->fixed[entity->physicsSlot].velocity;
+    if (!isnan(x)) {
+        fixed->x = Fixed_FromFloat(x);
+    }
+    if (!isnan(y)) {
+        fixed->y = Fixed_FromFloat(y);
     }
-    // Erdbeschleunigung anwenden
-    entity->physics.velocity.y += GRAVITY * DELTA_TIME;
-    // Dämpfen der nach oben gerichteten Geschwindigkeit. Bewirkt, dass nach
-    // Kollision die Entität nicht endlos auf und ab hüpft sondern irgendwann
-    // zur ruhe kommt.
-    if (entity->physics.velocity.y < 0.0f) {
-        entity->physics.velocity.y *= DAMPENING_FACTOR_X;
-    }
-    // Geschwindigkeit anwenden
-    entity->physics.position.x += entity->physics.velocity.x * DELTA_TIME;
-    entity->physics.position.y += entity->physics.velocity.y * DELTA_TIME;
-    // Position auf AABB übertragen
-    entity->physics.aabb.x = entity->physics.position.x - entity->physics.aabb.w / 2;
-    entity->physics.aabb.y = entity->physics.position.y - entity->physics.aabb.h / 2;
-    return ERR_OK;
 }
 
-static void clearNearToZero(entityPhysics_t *physics) {
-    if (fabs(physics->velocity.x) <= NEAR_ZERO || isnan(physics->velocity.x)) {
-        physics->velocity.x = 0.0f;
+static void syncFixed(physicsStore_t *store) {
+    for (int i = 0; i < store->count; ++i) {
+        store->fixed[i].position = (fixedVector_t){Fixed_FromFloat(store->position[i].x), Fixed_FromFloat(store->position[i].y)};
+        store->fixed[i].velocity = (fixedVector_t){Fixed_FromFloat(store->velocity[i].x), Fixed_FromFloat(store->velocity[i].y)};
     }
-    if (fabs(physics->velocity.y) <= NEAR_ZERO || isnan(physics->velocity.y)) {
-        physics->velocity.y = 0.0f;
+}
+
+static void updateEntities(physicsStore_t *store) {
+    SDL_FPoint *position = store->position;
+    SDL_FPoint *velocity = store->velocity;
+    SDL_Rect *aabb = store->aabb;
+    for (int i = 0; i < store->count; ++i) {
+        // Falls Entität keine Bewegung wünscht, dann überspringen.
+        if (store->isStatic[i] == 1) {
+            continue;
+        }
+        // Erdbeschleunigung anwenden
+        velocity[i].y += GRAVITY * DELTA_TIME;
+        // Dämpfen der nach oben gerichteten Geschwindigkeit. Bewirkt, dass nach
+        // Kollision die Entität nicht endlos auf und ab hüpft sondern
+        // irgendwann zur ruhe kommt.
+        if (velocity[i].y < 0.0f) {
+            velocity[i].y *= DAMPENING_FACTOR_X;
+        }
+        // Geschwindigkeit anwenden
+        SDL_Rect start = aabb[i];
+        start.x = position[i].x - aabb[i].w / 2;
+        start.y = position[i].y - aabb[i].h / 2;
+        position[i].x += velocity[i].x * DELTA_TIME;
+        position[i].y += velocity[i].y * DELTA_TIME;
+        // Position auf AABB übertragen
+        aabb[i].x = position[i].x - aabb[i].w / 2;
+        aabb[i].y = position[i].y - aabb[i].h / 2;
+        // Schnelle Entitäten könnten durch dünnes Gelände tunneln, sie werden
+        // an der ersten Position im Gelände angehalten. Die Kollision wird
+        // danach wie gewohnt von checkForAllCollisions() erkannt.
+        SDL_Point delta = {aabb[i].x - start.x, aabb[i].y - start.y};
+        if (abs(delta.x) < start.w && abs(delta.y) < start.h) {
+            continue;
+        }
+        worldHit_t hit;
+        if (World_Sweep(start, delta, &hit) == ERR_OK && hit.hit && hit.fraction > 0.0f) {
+            position[i].x += hit.contact.x - aabb[i].x;
+            position[i].y += hit.contact.y - aabb[i].y;
+            aabb[i].x = hit.contact.x;
+            aabb[i].y = hit.contact.y;
+        }
     }
-    if (fabs(physics->position.x) <= NEAR_ZERO || isnan(physics->position.x)) {
-        physics->position.x = 0.0f;
+}
+
+static void updateEntitiesFixed(physicsStore_t *store) {
+    physicsFixed_t *fixed = store->fixed;
+    SDL_Rect *aabb = store->aabb;
+    const fixed_t gravity = Fixed_Mul(Fixed_FromFloat(GRAVITY), DELTA_TIME_FIXED);
+    const fixed_t dampening = Fixed_FromFloat(DAMPENING_FACTOR_X);
+    for (int i = 0; i < store->count; ++i) {
+        // Falls Entität keine Bewegung wünscht, dann überspringen.
+        if (store->isStatic[i] == 1) {
+            continue;
+        }
+        fixedVector_t *position = &fixed[i].position;
+        fixedVector_t *velocity = &fixed[i].velocity;
+        // Erdbeschleunigung anwenden und nach oben gerichtete Geschwindigkeit
+        // dämpfen, wie in updateEntities()
+        velocity->y += gravity;
+        if (velocity->y < 0) {
+            velocity->y = Fixed_Mul(velocity->y, dampening);
+        }
+        // Geschwindigkeit anwenden
+        SDL_Rect start = aabb[i];
+        start.x = Fixed_ToInt(position->x) - aabb[i].w / 2;
+        start.y = Fixed_ToInt(position->y) - aabb[i].h / 2;
+        position->x += Fixed_Mul(velocity->x, DELTA_TIME_FIXED);
+        position->y += Fixed_Mul(velocity->y, DELTA_TIME_FIXED);
+        aabb[i].x = Fixed_ToInt(position->x) - aabb[i].w / 2;
+        aabb[i].y = Fixed_ToInt(position->y) - aabb[i].h / 2;
+        // Tunneln durch dünnes Gelände verhindern
+        SDL_Point delta = {aabb[i].x - start.x, aabb[i].y - start.y};
+        worldHit_t hit;
+        if ((abs(delta.x) >= start.w || abs(delta.y) >= start.h) &&
+            World_Sweep(start, delta, &hit) == ERR_OK && hit.hit && hit.fraction > 0.0f) {
+            position->x += Fixed_FromInt(hit.contact.x - aabb[i].x);
+            position->y += Fixed_FromInt(hit.contact.y - aabb[i].y);
+            aabb[i].x = hit.contact.x;
+            aabb[i].y = hit.contact.y;
+        }
+        store->position[i] = (SDL_FPoint){Fixed_ToFloat(position->x), Fixed_ToFloat(position->y)};
+        store->velocity[i] = (SDL_FPoint){Fixed_ToFloat(velocity->x), Fixed_ToFloat(velocity->y)};
     }
-    if (fabs(physics->position.y) <= NEAR_ZERO || isnan(physics->position.y)) {
-        physics->position.y = 0.0f;
+}
+
+static void clearNearToZero(physicsStore_t *store) {
+    for (int i = 0; i < store->count; ++i) {
+        SDL_FPoint *velocity = &store->velocity[i];
+        SDL_FPoint *position = &store->position[i];
+        if (fabs(velocity->x) <= NEAR_ZERO || isnan(velocity->x)) {
+            velocity->x = 0.0f;
+        }
+        if (fabs(velocity->y) <= NEAR_ZERO || isnan(velocity->y)) {
+            velocity->y = 0.0f;
+        }
+        if (fabs(position->x) <= NEAR_ZERO || isnan(position->x)) {
+            position->x = 0.0f;
+        }
+        if (fabs(position->y) <= NEAR_ZERO || isnan(position->y)) {
+            position->y = 0.0f;
+        }
+        if (fabs(store->rotation[i]) <= NEAR_ZERO || isnan(store->rotation[i])) {
+            store->rotation[i] = 0.0f;
+            store->fixed[i].rotation = 0;
+        }
     }
-    if (fabs(physics->rotation) <= NEAR_ZERO || isnan(physics->rotation)) {
-        physics->rotation = 0.0f;
+}
+
+static void clearNearToZeroFixed(physicsStore_t *store) {
+    const fixed_t nearZero = Fixed_FromFloat(NEAR_ZERO);
+    for (int i = 0; i < store->count; ++i) {
+        fixed_t *values[] = {&store->fixed[i].velocity.x, &store->fixed[i].velocity.y,
+                             &store->fixed[i].position.x, &store->fixed[i].position.y};
+        for (int v = 0; v < 4; ++v) {
+            if (*values[v] >= -nearZero && *values[v] <= nearZero) {
+                *values[v] = 0;
+            }
+        }
+        fixed_t rotation = store->fixed[i].rotation;
+        if ((rotation >= -nearZero && rotation <= nearZero) || isnan(store->rotation[i])) {
+            store->rotation[i] = 0.0f;
+            store->fixed[i].rotation = 0;
+        }
     }
 }
 
-static int checkForAllCollisions(void *data, void *userData) {
-    entity_t *entity = (entity_t *)data;
-    list_t *entityList = (list_t *)userData;
+static int checkForAllCollisions(physicsStore_t *store, int slot) {
+    entity_t *entity = store->entity[slot];
+    if (!entity) { // In einem Callback dieses Schrittes entfernt
+        return ERR_OK;
+    }
     int ret = ERR_OK;
     entityCollision_t worldCollision = {.partner = NULL};
-    ret = World_CheckCollision(entity->physics.aabb, &worldCollision);
+    ret = World_CheckCollision(store->aabb[slot], &worldCollision);
     if (ret) {
         // Fehler bei der Kollisionerkennung
         return ret;
@@ -304,91 +811,275 @@ static int checkForAllCollisions(void *data, void *userData) {
         // eine art "volumetrische" Normale zurück, also in welcher Richtung wie
         // viel Volumen ist. Grössere Entitäten besitzen grösseres Volumen und
         // würden ohne Korrektur eine zu grosse Normale erfahren.
-        worldCollision.normal.x *= (WORLD_SCALE_FACTOR / entity->physics.aabb.w);
-        worldCollision.normal.y *= (WORLD_SCALE_FACTOR / entity->physics.aabb.h);
+        if (deterministic) {
+            fixed_t scale = Fixed_FromFloat(WORLD_SCALE_FACTOR);
+            fixed_t x = Fixed_Mul(Fixed_FromFloat(worldCollision.normal.x), Fixed_Div(scale, Fixed_FromInt(store->aabb[slot].w)));
+            fixed_t y = Fixed_Mul(Fixed_FromFloat(worldCollision.normal.y), Fixed_Div(scale, Fixed_FromInt(store->aabb[slot].h)));
+            worldCollision.normal = (SDL_FPoint){Fixed_ToFloat(x), Fixed_ToFloat(y)};
+        } else {
+            worldCollision.normal.x *= (WORLD_SCALE_FACTOR / store->aabb[slot].w);
+            worldCollision.normal.y *= (WORLD_SCALE_FACTOR / store->aabb[slot].h);
+        }
         if (entity->callbacks.onCollision) {
             // Callback der Entität aufrufen
             entity->callbacks.onCollision(entity, &worldCollision);
-            handleCollision(entity, &worldCollision);
+            respondToCollision(store, slot, &worldCollision);
+        }
+    }
+    int candidates = queryBroadPhase(store, slot);
+    for (int i = 0; i < candidates; ++i) {
+        ret = checkForEntityCollision(store, store->broadPhase.candidates[i], slot);
+        if (ret) {
+            break;
         }
     }
-    ret = List_ForeachArg(entityList, checkForEntityCollision, entity);
     // Position erneut auf AABB übertragen, wurde ev. von Kollision verändert
-    entity->physics.aabb.x = entity->physics.position.x - entity->physics.aabb.w / 2;
-    entity->physics.aabb.y = entity->physics.position.y - entity->physics.aabb.h / 2;
+    if (deterministic) {
+        store->aabb[slot].x = Fixed_ToInt(store->fixed[slot].position.x) - store->aabb[slot].w / 2;
+        store->aabb[slot].y = Fixed_ToInt(store->fixed[slot].position.y) - store->aabb[slot].h / 2;
+    } else {
+        store->aabb[slot].x = store->position[slot].x - store->aabb[slot].w / 2;
+        store->aabb[slot].y = store->position[slot].y - store->aabb[slot].h / 2;
+    }
     return ret;
 }
 
-static int checkForEntityCollision(void *data, void *userData) {
-    entity_t *targetEntity = (entity_t *)data;
-    entity_t *sourceEntity = (entity_t *)userData;
-    // keine Kollision mit sich selbst
-    if (targetEntity == sourceEntity) {
+static int checkForEntityCollision(physicsStore_t *store, int targetSlot, int sourceSlot) {
+    // keine Kollision mit sich selbst oder in diesem Schritt entfernten
+    if (targetSlot == sourceSlot || !store->entity[targetSlot] || !store->entity[sourceSlot]) {
         return ERR_OK;
     }
-    // Kollision der AABBs prüfen
-    bool collision;
-    SDL_Rect intersection;
-    collision = SDL_IntersectRect(&targetEntity->physics.aabb,
-                                  &sourceEntity->physics.aabb,
-                                  &intersection);
-    if (!collision) {
+    const SDL_Rect *targetAabb = &store->aabb[targetSlot];
+    const SDL_Rect *sourceAabb = &store->aabb[sourceSlot];
+    // Kollision der AABBs prüfen, die meisten Paare überlappen sich nicht
+    if (!aabbOverlap(targetAabb, sourceAabb)) {
         return ERR_OK;
     }
-    entityCollision_t entityCollision = {
-        .flags = ENTITY_COLLISION_ENTITY,
-        .partner = targetEntity
+    SDL_Rect intersection;
+    SDL_IntersectRect(targetAabb, sourceAabb, &intersection);
+    // Beide Partner werden informiert, jeder mit seiner eigenen Normale
+    const int slots[2] = {sourceSlot, targetSlot};
+    entityCollision_t collisions[2] = {
+        {.flags = ENTITY_COLLISION_ENTITY, .partner = store->entity[targetSlot], .normal = entityNormal(sourceAabb, &intersection)},
+        {.flags = ENTITY_COLLISION_ENTITY, .partner = store->entity[sourceSlot], .normal = entityNormal(targetAabb, &intersection)}
     };
-    // Kollisionsnormale ermitteln: suche die Kürzere Seite der Überlappung und
-    // ermittle die Vorzeichen des Vektors. Als Vektorlänge wird die Breite bez.
-    // Höhe der Überlappung genommen und mit einem Faktor gewichtet.
-    if (intersection.w > intersection.h) {
+    for (int i = 0; i < 2; ++i) {
+        entity_t *entity = store->entity[slots[i]];
+        // Callback der Entität aufrufen, Kollision mit anderer Entität
+        if (entity && entity->callbacks.onCollision) {
+            entity->callbacks.onCollision(entity, &collisions[i]);
+            respondToCollision(store, slots[i], &collisions[i]);
+        }
+    }
+    return ERR_OK;
+}
+
+static SDL_FPoint entityNormal(const SDL_Rect *self, const SDL_Rect *intersection) {
+    SDL_FPoint normal = {0.0f, 0.0f};
+    // Suche die kürzere Seite der Überlappung und ermittle die Vorzeichen des
+    // Vektors.
+    if (intersection->w > intersection->h) {
         // Breiter als Hoch = Vektor auf y-Achse
-        entityCollision.normal.y = intersection.h * ENTITY_SCALE_FACTOR;
-        if (sourceEntity->physics.aabb.y < intersection.y) {
-            entityCollision.normal.y *= -1.0f;
+        normal.y = intersection->h * ENTITY_SCALE_FACTOR;
+        if (self->y < intersection->y) {
+            normal.y *= -1.0f;
         }
     } else {
         // Höher als Breit = Vektor auf x-Achse
-        entityCollision.normal.x = intersection.w * ENTITY_SCALE_FACTOR;
-        if (sourceEntity->physics.aabb.x < intersection.x) {
-            entityCollision.normal.x *= -1.0f;
+        normal.x = intersection->w * ENTITY_SCALE_FACTOR;
+        if (self->x < intersection->x) {
+            normal.x *= -1.0f;
+        }
+    }
+    return normal;
+}
+
+static int buildBroadPhase(physicsStore_t *store) {
+    physicsBroadPhase_t *broad = &store->broadPhase;
+    // Puffer pro Slot wachsen mit dem Speicher, Inhalt muss nicht erhalten
+    // bleiben
+    if (!broad->bucketStart) {
+        broad->bucketStart = malloc(sizeof(int) * (BROAD_PHASE_BUCKETS + 1));
+        if (!broad->bucketStart) {
+            return ERR_MEMORY;
+        }
+    }
+    if (broad->slotCapacity < store->capacity) {
+        int *visited = malloc(sizeof(int) * store->capacity);
+        int *candidates = malloc(sizeof(int) * store->capacity);
+        int *oversized = malloc(sizeof(int) * store->capacity);
+        if (!visited || !candidates || !oversized) {
+            free(visited);
+            free(candidates);
+            free(oversized);
+            return ERR_MEMORY;
+        }
+        free(broad->visited);
+        free(broad->candidates);
+        free(broad->oversized);
+        broad->visited = visited;
+        broad->candidates = candidates;
+        broad->oversized = oversized;
+        broad->slotCapacity = store->capacity;
+    }
+    // Einträge pro Eimer zählen
+    memset(broad->bucketStart, 0, sizeof(int) * (BROAD_PHASE_BUCKETS + 1));
+    broad->oversizedCount = 0;
+    int total = 0;
+    SDL_Rect cells;
+    for (int slot = 0; slot < store->count; ++slot) {
+        int count = cellRange(&store->aabb[slot], &cells);
+        if (count > BROAD_PHASE_MAX_CELLS) {
+            broad->oversized[broad->oversizedCount++] = slot;
+            continue;
+        }
+        for (int y = cells.y; y < cells.y + cells.h; ++y) {
+            for (int x = cells.x; x < cells.x + cells.w; ++x) {
+                broad->bucketStart[bucketOf(x, y) + 1]++;
+            }
+        }
+        total += count;
+    }
+    if (broad->entryCapacity < total) {
+        int capacity = broad->entryCapacity ? broad->entryCapacity : store->capacity;
+        while (capacity < total) {
+            capacity *= 2;
+        }
+        int *entries = malloc(sizeof(int) * capacity);
+        if (!entries) {
+            return ERR_MEMORY;
         }
+        free(broad->entries);
+        broad->entries = entries;
+        broad->entryCapacity = capacity;
     }
-    // Callback der Entität aufrufen, Kollision mit anderer Entität
-    if (sourceEntity->callbacks.onCollision) {
-        sourceEntity->callbacks.onCollision(sourceEntity, &entityCollision);
-        handleCollision(sourceEntity, &entityCollision);
+    // Anfang jedes Eimers, danach einsortieren. Dabei wandert jeder Anfang an
+    // das Ende seines Eimers und muss wieder um einen Eimer verschoben werden.
+    for (int b = 0; b < BROAD_PHASE_BUCKETS; ++b) {
+        broad->bucketStart[b + 1] += broad->bucketStart[b];
     }
+    for (int slot = 0; slot < store->count; ++slot) {
+        if (cellRange(&store->aabb[slot], &cells) > BROAD_PHASE_MAX_CELLS) {
+            continue;
+        }
+        for (int y = cells.y; y < cells.y + cells.h; ++y) {
+            for (int x = cells.x; x < cells.x + cells.w; ++x) {
+                broad->entries[broad->bucketStart[bucketOf(x, y)]++] = slot;
+            }
+        }
+    }
+    memmove(broad->bucketStart + 1, broad->bucketStart, sizeof(int) * BROAD_PHASE_BUCKETS);
+    broad->bucketStart[0] = 0;
+    // Neue Abfragenummern
+    memset(broad->visited, 0, sizeof(int) * store->count);
+    broad->query = 0;
     return ERR_OK;
 }
 
-static int handleCollision(entity_t *entity, entityCollision_t *collision) {
-    if (!entity || !collision) {
-        return ERR_PARAMETER;
+static int queryBroadPhase(physicsStore_t *store, int slot) {
+    physicsBroadPhase_t *broad = &store->broadPhase;
+    int query = ++broad->query;
+    int found = 0;
+    SDL_Rect cells;
+    int count = cellRange(&store->aabb[slot], &cells);
+    if (count == 0) {
+        return 0;
+    }
+    if (count > BROAD_PHASE_MAX_CELLS) {
+        // Sehr grosse Entitäten werden mit allen geprüft
+        for (int i = slot - 1; i >= 0; --i) {
+            broad->candidates[found++] = i;
+        }
+        return found;
+    }
+    for (int y = cells.y; y < cells.y + cells.h; ++y) {
+        for (int x = cells.x; x < cells.x + cells.w; ++x) {
+            int bucket = bucketOf(x, y);
+            for (int e = broad->bucketStart[bucket]; e < broad->bucketStart[bucket + 1]; ++e) {
+                int i = broad->entries[e];
+                if (i < slot && broad->visited[i] != query) {
+                    broad->visited[i] = query;
+                    broad->candidates[found++] = i;
+                }
+            }
+        }
+    }
+    for (int o = 0; o < broad->oversizedCount; ++o) {
+        int i = broad->oversized[o];
+        if (i < slot) {
+            broad->candidates[found++] = i;
+        }
+    }
+    // Reihenfolge wie ohne Breitphase, der zuletzt hinzugefügte zuerst
+    qsort(broad->candidates, found, sizeof(int), compareDescending);
+    return found;
+}
+
+static int compareDescending(const void *a, const void *b) {
+    return *(const int *)b - *(const int *)a;
+}
+
+static int cellRange(const SDL_Rect *aabb, SDL_Rect *cells) {
+    if (aabb->w <= 0 || aabb->h <= 0) {
+        return 0;
+    }
+    int x1 = cellOf(aabb->x);
+    int y1 = cellOf(aabb->y);
+    int x2 = cellOf(aabb->x + aabb->w - 1);
+    int y2 = cellOf(aabb->y + aabb->h - 1);
+    *cells = (SDL_Rect){x1, y1, x2 - x1 + 1, y2 - y1 + 1};
+    if (cells->w > BROAD_PHASE_MAX_CELLS || cells->h > BROAD_PHASE_MAX_CELLS) {
+        return BROAD_PHASE_MAX_CELLS + 1;
+    }
+    return cells->w * cells->h;
+}
+
+static inline int cellOf(int coordinate) {
+    // Abrunden, auch für negative Koordinaten
+    if (coordinate < 0) {
+        return -((-coordinate + BROAD_PHASE_CELL - 1) / BROAD_PHASE_CELL);
+    }
+    return coordinate / BROAD_PHASE_CELL;
+}
+
+static inline int bucketOf(int x, int y) {
+    // Grosse Primzahlen verteilen benachbarte Zellen über alle Eimer
+    return (int)(((unsigned int)x * 73856093u ^ (unsigned int)y * 19349663u) & (BROAD_PHASE_BUCKETS - 1));
+}
+
+static inline bool aabbOverlap(const SDL_Rect *a, const SDL_Rect *b) {
+    if (a->w <= 0 || a->h <= 0 || b->w <= 0 || b->h <= 0) {
+        return false;
     }
+    return a->x < b->x + b->w && b->x < a->x + a->w &&
+           a->y < b->y + b->h && b->y < a->y + a->h;
+}
+
+static void handleCollision(physicsStore_t *store, int slot, const entityCollision_t *collision) {
+    SDL_FPoint *position = &store->position[slot];
+    SDL_FPoint *velocity = &store->velocity[slot];
     // Kollision mit dem linken oder rechten Bildrand
     if (collision->flags & ENTITY_COLLISION_BORDER_LEFT ||
         collision->flags & ENTITY_COLLISION_BORDER_RIGHT) {
         // horizontale Bewegung rückgängig machen
-        entity->physics.position.x -= entity->physics.velocity.x * DELTA_TIME;
+        position->x -= velocity->x * DELTA_TIME;
         // und Geschwindigkeit 0 setzen
-        entity->physics.velocity.x = 0.0f;
+        velocity->x = 0.0f;
     }
     // Kollision mit dem oberen oder unteren Bildrand
     if (collision->flags & ENTITY_COLLISION_BORDER_TOP ||
         collision->flags & ENTITY_COLLISION_BORDER_BOTTOM) {
         // vertikale Bewegung rückgängig machen
-        entity->physics.position.y -= entity->physics.velocity.y * DELTA_TIME;
+        position->y -= velocity->y * DELTA_TIME;
         // und Geschwindigkeit 0 setzen
-        entity->physics.velocity.y = 0.0f;
+        velocity->y = 0.0f;
     }
     // Kollision mit einer anderen Entität
     if (collision->flags & ENTITY_COLLISION_ENTITY) {
         // Korrigiere die Geschwindigkeit der Entität anhand der gegebenen
         // Kollisionsnormalen.
-        entity->physics.velocity.x += collision->normal.x * DELTA_TIME;
-        entity->physics.velocity.y += collision->normal.y * DELTA_TIME;
+        velocity->x += collision->normal.x * DELTA_TIME;
+        velocity->y += collision->normal.y * DELTA_TIME;
     }
     // Kollision mit der Welt
     if (collision->flags & ENTITY_COLLISION_WORLD) {
@@ -396,28 +1087,144 @@ static int handleCollision(entity_t *entity, entityCollision_t *collision) {
         // Versuche nach oben hin zu befreien. Die maximale Höhe die befreit
         // werden kann ist durch die Geschwindigkeit gegeben. So können
         // schneller bewegende Entitäten eine grössere Steigung zurücklegen.
-        float dX = entity->physics.velocity.x * DELTA_TIME;
-        float dY = entity->physics.velocity.y * DELTA_TIME;
+        float dX = velocity->x * DELTA_TIME;
+        float dY = velocity->y * DELTA_TIME;
         float maxHeight = dX > dY ? dX : dY;
         maxHeight += 2; // 2 Pixel Spielraum
-        for (int i = 1; i <= maxHeight; ++i) {
-            SDL_Rect aabb = entity->physics.aabb;
-            aabb.y -= i;
-            entityCollision_t worldCollision = {.partner = NULL};
-            World_CheckCollision(aabb, &worldCollision);
-            if (!(worldCollision.flags & ENTITY_COLLISION_WORLD)) {
-                // Befreiungshöhe gefunden, Position entsprechend setzen
-                freed = true;
-                entity->physics.position.y -= i;
-                entity->physics.velocity.y = 0.0f;
-                break;
-            }
+        int height = findLift(store->aabb[slot], maxHeight, &store->liftHint[slot]);
+        if (height) {
+            // Befreiungshöhe gefunden, Position entsprechend setzen
+            freed = true;
+            position->y -= height;
+            velocity->y = 0.0f;
         }
         // Ansonsten gemäss Normale die Geschwindigkeit erhöhen
         if (!freed) {
-            entity->physics.velocity.x += collision->normal.x * DELTA_TIME;
-            entity->physics.velocity.y += collision->normal.y * DELTA_TIME;
+            velocity->x += collision->normal.x * DELTA_TIME;
+            velocity->y += collision->normal.y * DELTA_TIME;
         }
     }
-    return ERR_OK;
+}
+
+static void handleCollisionFixed(physicsStore_t *store, int slot, const entityCollision_t *collision) {
+    fixedVector_t *position = &store->fixed[slot].position;
+    fixedVector_t *velocity = &store->fixed[slot].velocity;
+    fixedVector_t normal = {Fixed_FromFloat(collision->normal.x), Fixed_FromFloat(collision->normal.y)};
+    // Kollision mit dem linken oder rechten Bildrand
+    if (collision->flags & ENTITY_COLLISION_BORDER_LEFT ||
+        collision->flags & ENTITY_COLLISION_BORDER_RIGHT) {
+        position->x -= Fixed_Mul(velocity->x, DELTA_TIME_FIXED);
+        velocity->x = 0;
+    }
+    // Kollision mit dem oberen oder unteren Bildrand
+    if (collision->flags & ENTITY_COLLISION_BORDER_TOP ||
+        collision->flags & ENTITY_COLLISION_BORDER_BOTTOM) {
+        position->y -= Fixed_Mul(velocity->y, DELTA_TIME_FIXED);
+        velocity->y = 0;
+    }
+    // Kollision mit einer anderen Entität
+    if (collision->flags & ENTITY_COLLISION_ENTITY) {
+        velocity->x += Fixed_Mul(normal.x, DELTA_TIME_FIXED);
+        velocity->y += Fixed_Mul(normal.y, DELTA_TIME_FIXED);
+    }
+    // Kollision mit der Welt, zuerst nach oben befreien
+    if (collision->flags & ENTITY_COLLISION_WORLD) {
+        fixed_t dX = Fixed_Mul(velocity->x, DELTA_TIME_FIXED);
+        fixed_t dY = Fixed_Mul(velocity->y, DELTA_TIME_FIXED);
+        fixed_t maxHeight = (dX > dY ? dX : dY) + Fixed_FromInt(2);
+        int height = findLift(store->aabb[slot], Fixed_ToFloat(maxHeight), &store->liftHint[slot]);
+        if (height) {
+            position->y -= Fixed_FromInt(height);
+            velocity->y = 0;
+        } else {
+            velocity->x += Fixed_Mul(normal.x, DELTA_TIME_FIXED);
+            velocity->y += Fixed_Mul(normal.y, DELTA_TIME_FIXED);
+        }
+    }
+    store->position[slot] = (SDL_FPoint){Fixed_ToFloat(position->x), Fixed_ToFloat(position->y)};
+    store->velocity[slot] = (SDL_FPoint){Fixed_ToFloat(velocity->x), Fixed_ToFloat(velocity->y)};
+}
+
+static void respondToCollision(physicsStore_t *store, int slot, entityCollision_t *collision) {
+    if (deterministic) {
+        handleCollisionFixed(store, slot, collision);
+    } else {
+        handleCollision(store, slot, collision);
+    }
+}
+
+static int findLift(SDL_Rect aabb, float maxHeight, int *hint) {
+    // Höher als bis zum oberen Rand der Welt muss nie angehoben werden
+    int bottom = aabb.y + aabb.h;
+    int limit = maxHeight < bottom ? (int)maxHeight : bottom;
+    int blocked = 0; // Höchste bekannte kollidierende Höhe, 0 kollidiert immer
+    int clear = 0;   // Kleinste bekannte freie Höhe, 0 = noch keine gefunden
+    if (*hint > 0 && *hint <= limit) {
+        // Eine ruhende Entität braucht meist wieder dieselbe Höhe
+        if (liftIsFree(aabb, *hint)) {
+            clear = *hint;
+            // Ist auch die Höhe darunter frei, wird unten binär weitergesucht
+            if (clear > 1 && liftIsFree(aabb, clear - 1)) {
+                clear -= 1;
+            } else {
+                blocked = clear - 1;
+            }
+        } else {
+            blocked = *hint;
+        }
+    }
+    if (!clear) {
+        // Unterhalb der Schätzung aus dem Distanzfeld ist sicher alles solid
+        int lift = liftHeight(aabb);
+        if (lift - 1 > blocked) {
+            blocked = lift - 1;
+        }
+        // Mit verdoppelter Schrittweite nach oben suchen
+        for (int step = 1; !clear && blocked < limit; step *= 2) {
+            int height = blocked + step < limit ? blocked + step : limit;
+            if (liftIsFree(aabb, height)) {
+                clear = height;
+            } else {
+                blocked = height;
+            }
+        }
+    }
+    // Grenze zwischen kollidierender und freier Höhe binär eingrenzen
+    while (clear && clear - blocked > 1) {
+        int height = blocked + (clear - blocked) / 2;
+        if (liftIsFree(aabb, height)) {
+            clear = height;
+        } else {
+            blocked = height;
+        }
+    }
+    *hint = clear;
+    return clear;
+}
+
+static bool liftIsFree(SDL_Rect aabb, int height) {
+    aabb.y -= height;
+    entityCollision_t worldCollision = {.partner = NULL};
+    World_CheckCollision(aabb, &worldCollision);
+    return !(worldCollision.flags & ENTITY_COLLISION_WORLD);
+}
+
+static int liftHeight(SDL_Rect aabb) {
+    int lift = 0;
+    int bottom = aabb.y + aabb.h - 1;
+    for (int offset = 0; offset < aabb.w + LIFT_SAMPLE_SPACING - 1; offset += LIFT_SAMPLE_SPACING) {
+        // Letzter Punkt liegt immer auf der rechten Ecke
+        SDL_Point point = {aabb.x + (offset < aabb.w ? offset : aabb.w - 1), bottom};
+        worldDistance_t sample;
+        while (World_GetDistance(point, &sample) == ERR_OK && sample.distance < 0.0f) {
+            // Im Umkreis von -distance + 0.5 ist alles solid, abzüglich der
+            // Rundung des Distanzfeldes
+            int step = (int)(0.5f - sample.distance - 0.05f);
+            point.y -= step > 1 ? step : 1;
+        }
+        if (bottom - point.y > lift) {
+            lift = bottom - point.y;
+        }
+    }
+    return lift;
 }
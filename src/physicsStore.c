@@ -0,0 +1,243 @@
+/**
+ * @file physicsStore.c
+ * @brief Dichter Speicher der Physikdaten aller Entitäten
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ */
+
+
+/*
+ * Includes
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "error.h"
+#include "entity.h"
+#include "physicsStore.h"
+
+
+/*
+ * Typdeklarationen
+ *
+ */
+
+/* ... */
+
+
+/*
+ * Variablendeklarationen
+ *
+ */
+
+#define PHYSICSSTORE_MIN_CAPACITY 16 //!< Anzahl Slots der ersten Allozierung
+
+
+/*
+ * Private Funktionsprototypen
+ *
+ */
+
+/**
+ * @brief Vergrössert ein Array.
+ *
+ * Bei einem Fehler bleibt das alte Array unverändert.
+ *
+ * @param[in,out] array Pointer auf das Array
+ * @param size Grösse eines Elements in Bytes
+ * @param count Anzahl gültiger Elemente die übernommen werden
+ * @param capacity Neue Anzahl Elemente
+ *
+ * @return 0 oder ERR_MEMORY
+ */
+static int growArray(void **array, size_t size, int count, int capacity);
+
+/**
+ * @brief Verschiebt die Daten eines Slots in einen freien Slot.
+ *
+ * @param[in,out] store Der Physikspeicher
+ * @param from Belegter Slot
+ * @param to Freier Slot vor \p from
+ */
+static void moveSlot(physicsStore_t *store, int from, int to);
+
+/**
+ * @brief Vergrössert alle Arrays des Speichers auf die doppelte Kapazität.
+ *
+ * @param[in,out] store Der Physikspeicher
+ *
+ * @return 0 oder ERR_MEMORY
+ */
+static int grow(physicsStore_t *store);
+
+
+/*
+ * Implementation öffentlicher Funktionen
+ *
+ */
+
+int PhysicsStore_Add(physicsStore_t *store, entity_t *entity) {
+    if (!store || !entity) { // Fehlerüberprüfung
+        return ERR_NULLPARAMETER;
+    }
+    if (entity->physicsStore) {
+        return ERR_SEQUENCE;
+    }
+    if (store->count == store->capacity && grow(store)) {
+        return ERR_MEMORY;
+    }
+    int slot = store->count++;
+    store->entity[slot] = entity;
+    store->position[slot] = entity->physics.position;
+    store->velocity[slot] = entity->physics.velocity;
+    store->rotation[slot] = entity->physics.rotation;
+    store->aabb[slot] = entity->physics.aabb;
+    store->isStatic[slot] = entity->physics.isStatic;
+    store->fixed[slot] = (physicsFixed_t){
+        .position = {Fixed_FromFloat(entity->physics.position.x), Fixed_FromFloat(entity->physics.position.y)},
+        .velocity = {Fixed_FromFloat(entity->physics.velocity.x), Fixed_FromFloat(entity->physics.velocity.y)},
+        .rotation = Fixed_FromFloat((float)entity->physics.rotation)};
+    store->liftHint[slot] = 0;
+    entity->physicsStore = store;
+    entity->physicsSlot = slot;
+    return ERR_OK;
+}
+
+int PhysicsStore_Remove(physicsStore_t *store, entity_t *entity) {
+    if (!store || !entity) { // Fehlerüberprüfung
+        return ERR_NULLPARAMETER;
+    }
+    if (!PhysicsStore_Contains(store, entity)) {
+        return ERR_OK;
+    }
+    // Physikdaten gelten ab jetzt wieder in der Entität
+    int slot = entity->physicsSlot;
+    entity->physics.position = store->position[slot];
+    entity->physics.velocity = store->velocity[slot];
+    entity->physics.rotation = store->rotation[slot];
+    entity->physics.aabb = store->aabb[slot];
+    entity->physics.isStatic = store->isStatic[slot];
+    entity->physicsStore = NULL;
+    entity->physicsSlot = 0;
+    // Slot nur freigeben, geschlossen wird er in PhysicsStore_Compact()
+    store->entity[slot] = NULL;
+    if (slot == store->count - 1) {
+        store->count--;
+    } else {
+        store->freeCount++;
+    }
+    return ERR_OK;
+}
+
+int PhysicsStore_Compact(physicsStore_t *store) {
+    if (!store) { // Fehlerüberprüfung
+        return ERR_NULLPARAMETER;
+    }
+    if (!store->freeCount) {
+        return ERR_OK;
+    }
+    // Belegte Slots in einem Durchgang nach vorne schieben
+    int count = 0;
+    for (int slot = 0; slot < store->count; ++slot) {
+        if (!store->entity[slot]) {
+            continue;
+        }
+        if (slot != count) {
+            moveSlot(store, slot, count);
+        }
+        count++;
+    }
+    store->count = count;
+    store->freeCount = 0;
+    return ERR_OK;
+}
+
+int PhysicsStore_Contains(const physicsStore_t *store, const entity_t *entity) {
+    if (!store || !entity) {
+        return 0;
+    }
+    return entity->physicsStore == store;
+}
+
+int PhysicsStore_Destroy(physicsStore_t *store) {
+    if (!store) { // Fehlerüberprüfung
+        return ERR_NULLPARAMETER;
+    }
+    // Entitäten lösen, freie Slots überspringen
+    for (int slot = store->count - 1; slot >= 0; --slot) {
+        if (store->entity[slot]) {
+            PhysicsStore_Remove(store, store->entity[slot]);
+        }
+    }
+    free(store->entity);
+    free(store->position);
+    free(store->velocity);
+    free(store->rotation);
+    free(store->aabb);
+    free(store->isStatic);
+    free(store->fixed);
+    free(store->liftHint);
+    free(store->broadPhase.bucketStart);
+    free(store->broadPhase.entries);
+    free(store->broadPhase.visited);
+    free(store->broadPhase.candidates);
+    free(store->broadPhase.oversized);
+    memset(store, 0, sizeof(physicsStore_t));
+    return ERR_OK;
+}
+
+
+/*
+ * Implementation privater Funktionen
+ *
+ */
+
+static int growArray(void **array, size_t size, int count, int capacity) {
+    void *newArray = malloc(size * capacity);
+    if (!newArray) {
+        return ERR_MEMORY;
+    }
+    if (*array) {
+        memcpy(newArray, *array, size * count);
+        free(*array);
+    }
+    *array = newArray;
+    return ERR_OK;
+}
+
+static void moveSlot(physicsStore_t *store, int from, int to) {
+    store->entity[to] = store->entity[from];
+    store->position[to] = store->position[from];
+    store->velocity[to] = store->velocity[from];
+    store->rotation[to] = store->rotation[from];
+    store->aabb[to] = store->aabb[from];
+    store->isStatic[to] = store->isStatic[from];
+    store->fixed[to] = store->fixed[from];
+    store->liftHint[to] = store->liftHint[from];
+    store->entity[to]->physicsSlot = to;
+    store->entity[from] = NULL;
+}
+
+static int grow(physicsStore_t *store) {
+    int capacity = store->capacity ? store->capacity * 2 : PHYSICSSTORE_MIN_CAPACITY;
+    int count = store->count;
+    int ret = ERR_OK;
+    ret |= growArray((void **)&store->entity, sizeof(*store->entity), count, capacity);
+    ret |= growArray((void **)&store->position, sizeof(*store->position), count, capacity);
+    ret |= growArray((void **)&store->velocity, sizeof(*store->velocity), count, capacity);
+    ret |= growArray((void **)&store->rotation, sizeof(*store->rotation), count, capacity);
+    ret |= growArray((void **)&store->aabb, sizeof(*store->aabb), count, capacity);
+    ret |= growArray((void **)&store->isStatic, sizeof(*store->isStatic), count, capacity);
+    ret |= growArray((void **)&store->fixed, sizeof(*store->fixed), count, capacity);
+    ret |= growArray((void **)&store->liftHint, sizeof(*store->liftHint), count, capacity);
+    if (ret) {
+        // Bereits vergrösserte Arrays bleiben gültig, die Kapazität gilt aber
+        // erst wenn alle erfolgreich vergrössert wurden.
+        return ERR_MEMORY;
+    }
+    store->capacity = capacity;
+    return ERR_OK;
+}
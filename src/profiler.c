@@ -0,0 +1,259 @@
+/**
+ * @file profiler.c
+ * @brief Zeitmessung des Programmstarts
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ */
+
+
+/*
+ * Includes
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL.h>
+
+#include "profiler.h"
+#include "error.h"
+
+
+/*
+ * Typdeklarationen
+ *
+ */
+
+#define PROFILER_DEFAULT_FILE "startup_profile.json" //!< Standardname der JSON-Ausgabe
+
+/**
+ * @brief Eine gespeicherte Messung
+ *
+ */
+typedef struct {
+    char category[16]; //!< Art des Schritts
+    char name[64];     //!< Name des Schritts
+    char type[16];     //!< Zusätzlicher Typ, leer falls keiner
+    long long bytes;   //!< Grösse der Quelldaten, -1 falls unbekannt
+    double decodeMs;   //!< Davon Dekodierzeit in Millisekunden
+    double ms;         //!< Gesamtdauer in Millisekunden
+} profilerSample_t;
+
+
+/*
+ * Variablendeklarationen
+ *
+ */
+
+static int enabled;                        //!< Profiler eingeschaltet
+static char reportFile[256];               //!< Pfad der JSON-Ausgabe
+static uint64_t startTime;                 //!< Zeitpunkt von Profiler_Init()
+static profilerSample_t *samples;          //!< Gespeicherte Messungen
+static int sampleCount;                    //!< Anzahl Messungen
+static int sampleCapacity;                 //!< Anzahl allozierter Messungen
+
+
+/*
+ * Private Funktionsprototypen
+ *
+ */
+
+/**
+ * @brief Vergleichsfunktion für qsort, sortiert absteigend nach Dauer.
+ *
+ * @param[in] a Pointer auf \ref profilerSample_t
+ * @param[in] b Pointer auf \ref profilerSample_t
+ *
+ * @return <0, 0 oder >0
+ */
+static int compareDuration(const void *a, const void *b);
+
+/**
+ * @brief Schreibt eine Zeichenkette als JSON-String.
+ *
+ * @param[in] file Ausgabedatei
+ * @param[in] string Zeichenkette
+ */
+static void writeJsonString(FILE *file, const char *string);
+
+/**
+ * @brief Schreibt die sortierten Messungen als JSON-Datei.
+ *
+ * @param totalMs Gesamtdauer seit Profiler_Init()
+ *
+ * @return 0 oder Errorcode
+ */
+static int writeJson(double totalMs);
+
+
+/*
+ * Implementation öffentlicher Funktionen
+ *
+ */
+
+int Profiler_Init(int argc, char *argv[]) {
+    if (argc > 0 && !argv) { // Fehlerüberprüfung
+        SDL_Log("Argumente ungueltig! Profiler_Init()\n");
+        return ERR_NULLPARAMETER;
+    }
+
+    // Umgebungsvariable, der Wert ist optional der Pfad der Ausgabe
+    const char *file = NULL;
+    const char *env = getenv("TANKS_PROFILE");
+    if (env) {
+        enabled = 1;
+        if (*env && strcmp(env, "1"))
+            file = env;
+    }
+    // Befehlszeile hat Vorrang
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--profile")) {
+            enabled = 1;
+        } else if (!strncmp(argv[i], "--profile=", 10)) {
+            enabled = 1;
+            file = argv[i] + 10;
+        }
+    }
+    if (!enabled)
+        return ERR_OK;
+
+    snprintf(reportFile, sizeof(reportFile), "%s", file ? file : PROFILER_DEFAULT_FILE);
+    startTime = SDL_GetPerformanceCounter();
+    return ERR_OK;
+}
+
+int Profiler_IsEnabled(void) {
+    return enabled;
+}
+
+uint64_t Profiler_Begin(void) {
+    return enabled ? SDL_GetPerformanceCounter() : 0;
+}
+
+double Profiler_Elapsed(uint64_t start) {
+    if (!enabled || !start)
+        return 0.0;
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+int Profiler_Record(const char *category, const char *name, const char *type, long long bytes, double decodeMs, double ms) {
+    if (!enabled)
+        return ERR_OK;
+    if (!category || !name) { // Fehlerüberprüfung
+        SDL_Log("Kategorie oder Name ungueltig! Profiler_Record()\n");
+        return ERR_NULLPARAMETER;
+    }
+
+    // Liste bei Bedarf vergrössern
+    if (sampleCount == sampleCapacity) {
+        int capacity = sampleCapacity ? sampleCapacity * 2 : 64;
+        profilerSample_t *grown = malloc(sizeof(profilerSample_t) * capacity);
+        if (!grown) {
+            SDL_Log("Memory Error! Profiler_Record()\n");
+            return ERR_MEMORY;
+        }
+        if (samples)
+            memcpy(grown, samples, sizeof(profilerSample_t) * sampleCount);
+        free(samples);
+        samples = grown;
+        sampleCapacity = capacity;
+    }
+
+    profilerSample_t *sample = &samples[sampleCount++];
+    snprintf(sample->category, sizeof(sample->category), "%s", category);
+    snprintf(sample->name, sizeof(sample->name), "%s", name);
+    snprintf(sample->type, sizeof(sample->type), "%s", type ? type : "");
+    sample->bytes = bytes;
+    sample->decodeMs = decodeMs;
+    sample->ms = ms;
+    return ERR_OK;
+}
+
+int Profiler_End(uint64_t start, const char *category, const char *name) {
+    if (!enabled)
+        return ERR_OK;
+    return Profiler_Record(category, name, NULL, -1, 0.0, Profiler_Elapsed(start));
+}
+
+int Profiler_Report(void) {
+    if (!enabled)
+        return ERR_OK;
+    double totalMs = Profiler_Elapsed(startTime);
+    if (sampleCount)
+        qsort(samples, sampleCount, sizeof(profilerSample_t), compareDuration);
+
+    // Tabelle ins Log, Dekodierung läuft parallel und kann die Gesamtdauer übersteigen
+    SDL_Log("Startprofil: %.2f ms seit Programmstart, %d Messungen\n", totalMs, sampleCount);
+    SDL_Log("%10s %6s %10s  %-9s %-24s %-8s %10s\n", "ms", "%", "dekod. ms", "Kategorie", "Name", "Typ", "Bytes");
+    for (int i = 0; i < sampleCount; ++i) {
+        profilerSample_t *sample = &samples[i];
+        SDL_Log("%10.3f %6.2f %10.3f  %-9s %-24s %-8s %10lld\n", sample->ms,
+                totalMs > 0.0 ? 100.0 * sample->ms / totalMs : 0.0, sample->decodeMs,
+                sample->category, sample->name, sample->type, sample->bytes);
+    }
+
+    int errorCode = writeJson(totalMs);
+
+    // Messungen verwerfen
+    free(samples);
+    samples = NULL;
+    sampleCount = 0;
+    sampleCapacity = 0;
+    enabled = 0;
+    return errorCode;
+}
+
+
+/*
+ * Implementation privater Funktionen
+ *
+ */
+
+static int compareDuration(const void *a, const void *b) {
+    const profilerSample_t *sampleA = (const profilerSample_t *)a;
+    const profilerSample_t *sampleB = (const profilerSample_t *)b;
+    return (sampleA->ms < sampleB->ms) - (sampleA->ms > sampleB->ms);
+}
+
+static void writeJsonString(FILE *file, const char *string) {
+    fputc('"', file);
+    for (; *string; ++string) {
+        unsigned char c = (unsigned char)*string;
+        if (c == '"' || c == '\\')
+            fprintf(file, "\\%c", c);
+        else if (c < 0x20)
+            fprintf(file, "\\u%04x", c);
+        else
+            fputc(c, file);
+    }
+    fputc('"', file);
+}
+
+static int writeJson(double totalMs) {
+    FILE *file = fopen(reportFile, "w");
+    if (!file) {
+        SDL_Log("Startprofil konnte nicht geschrieben werden! [%s]\n", reportFile);
+        return ERR_FAIL;
+    }
+
+    fprintf(file, "{\n  \"totalMs\": %.3f,\n  \"samples\": [", totalMs);
+    for (int i = 0; i < sampleCount; ++i) {
+        profilerSample_t *sample = &samples[i];
+        fprintf(file, "%s\n    {\"category\": ", i ? "," : "");
+        writeJsonString(file, sample->category);
+        fprintf(file, ", \"name\": ");
+        writeJsonString(file, sample->name);
+        fprintf(file, ", \"type\": ");
+        writeJsonString(file, sample->type);
+        fprintf(file, ", \"bytes\": %lld, \"decodeMs\": %.3f, \"ms\": %.3f}", sample->bytes, sample->decodeMs, sample->ms);
+    }
+    fprintf(file, "\n  ]\n}\n");
+
+    int errorCode = ferror(file) ? ERR_FAIL : ERR_OK;
+    fclose(file);
+    SDL_Log("Startprofil geschrieben nach %s\n", reportFile);
+    return errorCode;
+}
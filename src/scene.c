@@ -17,6 +17,8 @@
 
 #include "scene.h"
 #include "entityHandler.h"
+#include "physics.h"
+#include "profiler.h"
 
 
 /*
@@ -24,7 +26,21 @@
  * 
  */
 
-/* ... */
+/**
+ * @brief Initialisiert eine Szene und misst die Dauer mit dem Profiler.
+ * Nach einem Fehler werden die weiteren Szenen übersprungen.
+ * 
+ */
+#define SCENE_INIT_PROFILED(errorCode, function, arguments) \
+    do {                                                    \
+        if (!(errorCode)) {                                 \
+            uint64_t start = Profiler_Begin();              \
+            (errorCode) = function arguments;               \
+            Profiler_End(start, "scene", #function);        \
+        }                                                   \
+    } while (0)
+
+#define SCENE_MAX_STEPS 5 //!< Maximale Anzahl Simulationsschritte pro Bild
 
 
 /*
@@ -35,6 +51,10 @@
 int gameloop;           //!< Globale Variable, 1=Programm läuft, 0=Programm wird beendet
 SceneID currentSceneID; //!< Globale Variable, enthält die aktuell aktive Szene ID
 
+static Uint64 lastCounter = 0;    //!< Zeitstempel des letzten Bildes, 0 vor dem ersten Bild
+static double accumulator = 0.0;  //!< Noch nicht simulierte Zeit [s]
+static inputEvent_t pendingInput; //!< Eingaben, die noch kein Simulationsschritt verarbeitet hat
+
 
 /*
  * Private Funktionsprototypen
@@ -69,6 +89,33 @@ static void identifieKey(SDL_Event *inputEvent, inputEvent_t *convertedInputEven
  */
 static void identifieChar(SDL_Event *inputEvent, inputEvent_t *convertedInputEvent);
 
+/**
+ * @brief Führt die seit dem letzten Bild fälligen Simulationsschritte aus.
+ * 
+ * Die verstrichene Echtzeit wird gesammelt und in Schritten fester Dauer
+ * \ref PHYSICS_STEP_TIME abgearbeitet. Pro Bild laufen so null oder mehrere
+ * Schritte, unabhängig von der Bildwiederholrate des Bildschirms. Nach einem
+ * Hänger werden höchstens \ref SCENE_MAX_STEPS Schritte nachgeholt.
+ * 
+ * @param[in] inputEvent Eingaben des aktuellen Bildes
+ * 
+ * @return Anteil des angebrochenen Schritts für die Interpolation, 0.0 bis 1.0
+ */
+static float stepSimulation(const inputEvent_t *inputEvent);
+
+/**
+ * @brief Sammelt die Eingaben eines Bildes für die Simulation.
+ * 
+ * Läuft in einem Bild kein Simulationsschritt, dürfen Eingaben wie ein
+ * Tastendruck nicht verloren gehen. Sie werden gesammelt, bis ein Schritt sie
+ * verarbeitet hat. Richtungen und Maus gelten dagegen nur für das aktuelle
+ * Bild, eine losgelassene Richtung wirkt so nicht nach.
+ * 
+ * @param[in] inputEvent Eingaben des aktuellen Bildes
+ * @param[in,out] pending gesammelte Eingaben
+ */
+static void mergeInputEvent(const inputEvent_t *inputEvent, inputEvent_t *pending);
+
 
 /*
  * Implementation Öffentlicher Funktionen
@@ -83,17 +130,17 @@ int Scene_Init(player_t playerA, player_t playerB, inputEvent_t input,
     if (input.currentPlayer == NULL) {
         return ERR_PARAMETER;
     }
-    if (ERR_OK != sceneStartup_Init(sceneStartUp) ||
-        ERR_OK != sceneMainMenu_Init(sceneMainMenu) ||
-        ERR_OK != sceneNamePlayer_Init(sceneNamePlayer) ||
-        ERR_OK != sceneControls_Init(sceneControls) ||
-        ERR_OK != sceneChooseWorld_Init(sceneChooseWorld) ||
-        ERR_OK != sceneInGame_Init(sceneInGame, playerA, playerB, input) ||
-        ERR_OK != sceneVictory_Init(sceneVictory) ||
-        ERR_OK != sceneErrFail_Init(sceneErrFail)) {
-        return ERR_FAIL;
-    }
-    return ERR_OK;
+    // Jede Szene einzeln initialisieren, damit der Profiler sie messen kann
+    int errorCode = ERR_OK;
+    SCENE_INIT_PROFILED(errorCode, sceneStartup_Init, (sceneStartUp));
+    SCENE_INIT_PROFILED(errorCode, sceneMainMenu_Init, (sceneMainMenu));
+    SCENE_INIT_PROFILED(errorCode, sceneNamePlayer_Init, (sceneNamePlayer));
+    SCENE_INIT_PROFILED(errorCode, sceneControls_Init, (sceneControls));
+    SCENE_INIT_PROFILED(errorCode, sceneChooseWorld_Init, (sceneChooseWorld));
+    SCENE_INIT_PROFILED(errorCode, sceneInGame_Init, (sceneInGame, playerA, playerB, input));
+    SCENE_INIT_PROFILED(errorCode, sceneVictory_Init, (sceneVictory));
+    SCENE_INIT_PROFILED(errorCode, sceneErrFail_Init, (sceneErrFail));
+    return errorCode ? ERR_FAIL : ERR_OK;
 }
 /****************************************************************************/
 int Scene_Update(SDL_Event *event, inputEvent_t *inputEvent, gui_t *scene) {
@@ -108,8 +155,10 @@ int Scene_Update(SDL_Event *event, inputEvent_t *inputEvent, gui_t *scene) {
         convertInputEvent(event, inputEvent);
     }
     inputEvent->mouseButtons = SDL_GetMouseState(&inputEvent->mousePosition.x, &inputEvent->mousePosition.y);
-	// Gebe die Events den einzelnen Modulen weiter
-    EntityHandler_Update(inputEvent);
+	// Gebe die Events den einzelnen Modulen weiter, die Entitäten werden in
+	// Schritten fester Dauer simuliert und dazwischen interpoliert gezeichnet
+    float alpha = stepSimulation(inputEvent);
+    EntityHandler_Interpolate(alpha);
     SDLW_Clear(COLORBACKGROUND);
     if (currentSceneID == SCENE_INGAME) {
         Scene_DrawGame(scene);
@@ -210,4 +259,42 @@ static void identifieChar(SDL_Event *inputEvent, inputEvent_t *convertedInputEve
     if (inputEvent->text.text[1] == '\0') {
         convertedInputEvent->currentChar = inputEvent->text.text[0];
     }
-}
\ No newline at end of file
+}
+/****************************************************************************/
+static float stepSimulation(const inputEvent_t *inputEvent) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (lastCounter) {
+        double elapsed = (double)(now - lastCounter) / (double)SDL_GetPerformanceFrequency();
+        // Nach einem Hänger nicht alles nachholen, das Spiel läuft dann kurz langsamer
+        accumulator += SDL_min(elapsed, SCENE_MAX_STEPS * PHYSICS_STEP_TIME);
+    }
+    lastCounter = now;
+    mergeInputEvent(inputEvent, &pendingInput);
+    int steps = 0;
+    while (accumulator >= PHYSICS_STEP_TIME) {
+        EntityHandler_Update(&pendingInput);
+        accumulator -= PHYSICS_STEP_TIME;
+        steps++;
+        // Tastendrücke nur im ersten Schritt, Richtungen gelten in allen
+        pendingInput.currentChar = '\0';
+        pendingInput.lastKey = SDLK_UNKNOWN;
+    }
+    if (steps) {
+        pendingInput = (inputEvent_t){.currentPlayer = inputEvent->currentPlayer};
+    }
+    return (float)(accumulator / PHYSICS_STEP_TIME);
+}
+/****************************************************************************/
+static void mergeInputEvent(const inputEvent_t *inputEvent, inputEvent_t *pending) {
+    pending->currentPlayer = inputEvent->currentPlayer;
+    pending->mousePosition = inputEvent->mousePosition;
+    pending->mouseButtons = inputEvent->mouseButtons;
+    if (inputEvent->lastKey != SDLK_UNKNOWN) {
+        pending->lastKey = inputEvent->lastKey;
+    }
+    if (inputEvent->currentChar != '\0') {
+        pending->currentChar = inputEvent->currentChar;
+    }
+    pending->axisWASD = inputEvent->axisWASD;
+    pending->axisArrow = inputEvent->axisArrow;
+}
@@ -94,7 +94,7 @@ int sceneChooseWorld_Init(sceneChooseWorld_t *sceneChooseWorld) {
     sceneChooseWorld->bttnChooseWorld = &bttnChooseWorld;
     sceneChooseWorld->bttnEvergreen = &bttnEvergreen;
     sceneChooseWorld->bttnAquaduct = &bttnAquaduct;
-    sceneChooseWorld->sceneChooseWorldGUI = sceneChooseWorldGUI;
+    sceneChooseWorld->sceneChooseWorldGUI = &sceneChooseWorldGUI;
 
     return ERR_OK;
 }
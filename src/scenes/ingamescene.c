@@ -61,8 +61,8 @@ int sceneInGame_Init(sceneInGame_t *sceneInGame, player_t playerA, player_t play
     bttnPlayerNameB = Scene_ButtonPrototyp();
     bttnHPBarBGA = Scene_ButtonPrototyp();
     bttnHPBarBGB = Scene_ButtonPrototyp();
-    bttnHPBarCoverA = Scene_ButtonPrototyp();
-    bttnHPBarCoverB = Scene_ButtonPrototyp();
+    bttnHPBarCoverA.elementData = Scene_ButtonPrototyp().elementData;
+    bttnHPBarCoverB.elementData = Scene_ButtonPrototyp().elementData;
     bttnBackToMainMenu = Scene_ButtonPrototyp();
 
     // Button PlayerNameA modifizieren
@@ -159,7 +159,7 @@ int sceneInGame_Init(sceneInGame_t *sceneInGame, player_t playerA, player_t play
     sceneInGame->bttnHPBarCoverA = &bttnHPBarCoverA;
     sceneInGame->bttnHPBarCoverB = &bttnHPBarCoverB;
     sceneInGame->bttnBackToMaiMen = &bttnBackToMainMenu;
-    sceneInGame->sceneInGameGUI = sceneInGameGUI;
+    sceneInGame->sceneInGameGUI = &sceneInGameGUI;
 
     return ERR_OK;
 }
@@ -173,8 +173,8 @@ int sceneInGame_Update(sceneInGame_t *sceneInGame, player_t playerA, player_t pl
     SDL_DestroyTexture(bttnHPBarCoverB.elementData.button.textTextur.texture);
 
     // Allen Buttons die Vorlage übergeben
-    bttnHPBarCoverA = Scene_ButtonPrototyp();
-    bttnHPBarCoverB = Scene_ButtonPrototyp();
+    bttnHPBarCoverA.elementData = Scene_ButtonPrototyp().elementData;
+    bttnHPBarCoverB.elementData = Scene_ButtonPrototyp().elementData;
 
     // Button PlayerNameA modifizieren
     if (input.currentPlayer->name == playerA.name) {
@@ -229,16 +229,13 @@ int sceneInGame_Update(sceneInGame_t *sceneInGame, player_t playerA, player_t pl
     }
 
     // GUI Elemente der Liste hinzufügen mit Fehlerkontrolle
-    if (ERR_OK != GUI_AddElement(&bttnPlayerNameA, &sceneInGameGUI) ||
-        ERR_OK != GUI_AddElement(&bttnPlayerNameB, &sceneInGameGUI) ||
-        ERR_OK != GUI_AddElement(&bttnHPBarCoverA, &sceneInGameGUI) ||
-        ERR_OK != GUI_AddElement(&bttnHPBarCoverB, &sceneInGameGUI)) {
+    if (ERR_OK != GUI_AddElement(sceneInGame->bttnPlayerNameA, sceneInGame->sceneInGameGUI) ||
+        ERR_OK != GUI_AddElement(sceneInGame->bttnPlayerNameB, sceneInGame->sceneInGameGUI) ||
+        ERR_OK != GUI_AddElement(sceneInGame->bttnHPBarCoverA, sceneInGame->sceneInGameGUI) ||
+        ERR_OK != GUI_AddElement(sceneInGame->bttnHPBarCoverB, sceneInGame->sceneInGameGUI)) {
         return ERR_FAIL;
     }
 
-    // Alle Elemente an die Struktur übergeben
-    sceneInGame->sceneInGameGUI = sceneInGameGUI;
-
     return ERR_OK;
 }
 
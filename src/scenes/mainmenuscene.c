@@ -104,7 +104,7 @@ int sceneMainMenu_Init(sceneMainMenu_t *sceneMainMenu) {
     sceneMainMenu->bttnControls = &bttnControls;
     sceneMainMenu->bttnNewGame = &bttnNewGame;
     sceneMainMenu->bttnQuit = &bttnQuit;
-    sceneMainMenu->sceneMainMenuGUI = sceneMainMenuGUI;
+    sceneMainMenu->sceneMainMenuGUI = &sceneMainMenuGUI;
 
     return ERR_OK;
 }
@@ -112,7 +112,7 @@ int sceneNamePlayer_Init(sceneNamePlayer_t *sceneNamePlayer) {
     sceneNamePlayer->bttnPlayerB = &bttnPlayerB;
     sceneNamePlayer->tiNamePlayerB = &tiNamePlayerB;
     sceneNamePlayer->bttnNext = &bttnNext;
-    sceneNamePlayer->sceneNamPlaGUI = sceneNamePlayerGUI;
+    sceneNamePlayer->sceneNamPlaGUI = &sceneNamePlayerGUI;
 
     return ERR_OK;
 }
@@ -17,6 +17,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 
 #include <SDL.h>
 #include <SDL_image.h>
@@ -24,8 +25,10 @@
 #include <SDL_net.h>
 #include <SDL_ttf.h>
 
-#include "list.h"
 #include "sdlWrapper.h"
+#include "assetPack.h"
+#include "atlas.h"
+#include "profiler.h"
 #include "error.h"
 #include "sprite.h"
 #include "world.h"
@@ -36,7 +39,53 @@
  * 
  */
 
-/* ... */
+/**
+ * @brief Eine zu ladende Ressource.
+ *
+ * Beim Laden wird zuerst der gesamte Konfigurationsbaum in eine Liste solcher
+ * Aufträge gelesen. Bilder und Soundeffekte werden danach parallel dekodiert.
+ */
+typedef struct {
+    char config[256];  //!< Konfigurationszeile
+    char key[64];      //!< Die ID der zu ladenen Ressource
+    char type[32];     //!< Der Typ der zu ladenen Ressource
+    void *decoded;     //!< Dekodierte Daten, SDL_Surface oder Mix_Chunk, sonst NULL
+    SDL_RWops *source; //!< Dateiinhalt aus einem Paket, sonst NULL
+    int packIndex;     //!< Index des Eintrags im Paket, sonst -1
+    int preload;       //!< Bild vorab dekodieren, da es von einem Sprite verwendet wird
+    int atlasPage;     //!< Handle der Atlasseite auf der das Bild liegt, sonst SDLW_INVALID_HANDLE
+    SDL_Rect region;   //!< Bereich des Bildes auf der Atlasseite
+    double decodeMs;   //!< Dauer des Dekodierens für den Profiler
+    SDL_Surface *pixels; //!< Pixel von Masken und Stempeln im Format RGBA8888, sonst NULL
+} sdlwLoadJob_t;
+
+/**
+ * @brief Auftragsliste eines Ladevorgangs.
+ *
+ */
+typedef struct {
+    sdlwLoadJob_t *jobs; //!< Aufträge in Reihenfolge der Konfiguration
+    int count;           //!< Anzahl Aufträge
+    int capacity;        //!< Grösse von \ref jobs
+    SDL_atomic_t next;   //!< Nächster zu dekodierender Auftrag der Worker
+    uint64_t sources;    //!< Prüfsumme der gelesenen Konfigurationsdateien, siehe SDLW_HashSources()
+} sdlwLoadQueue_t;
+
+/**
+ * @brief Eintrag des Registers.
+ *
+ * Neben der Ressource wird der Auftrag behalten, aus dem sie erstellt wurde.
+ * Texturen, Schriften und Sounds werden so erst bei der ersten Verwendung
+ * erstellt und können bei überschrittenem Budget wieder entladen werden.
+ */
+typedef struct {
+    sdlwResource_t resource; //!< Die Ressource, resource.any = NULL solange nicht geladen
+    sdlwLoadJob_t job;       //!< Auftrag aus dem die Ressource (erneut) erstellt wird
+    resourceType_t kind;     //!< Mögliche Typen gemäss Konfiguration, auch ungeladen bekannt
+    int refCount;            //!< Anzahl nicht freigegebener Referenzen
+    size_t bytes;            //!< Geschätzter Speicherbedarf, 0 solange nicht geladen
+    unsigned int lastUse;    //!< Zeitpunkt der letzten Verwendung, für LRU
+} sdlwEntry_t;
 
 
 /*
@@ -48,7 +97,35 @@ static int initialized = 0;           //!< Ist der SDLWrapper initialisiert
 static SDL_Window *window = NULL;     //!< Das geöffnete Fenster
 static SDL_Renderer *renderer = NULL; //!< Der Benutzte Renderer
 
-static list_t resourceList; //!< Liste aller geladenen Ressourcen
+/**
+ * @brief Register aller geladenen Ressourcen.
+ *
+ * Die Ressourcen werden in einem Array gespeichert, der Index entspricht dem
+ * Handle der Ressource. Zusätzlich zeigt eine Hashtabelle mit offener
+ * Adressierung vom Schlüssel auf das Handle. Somit ist jede Suche nach einer ID
+ * unabhängig von der Anzahl geladener Ressourcen.
+ */
+static struct {
+    sdlwEntry_t **entries; //!< Einträge, Index = Handle
+    int count;             //!< Anzahl registrierter Ressourcen
+    int capacity;          //!< Grösse von \ref entries
+    sdlwHandle_t *slots;   //!< Hashtabelle mit Handles, SDLW_INVALID_HANDLE = leer
+    int slotCount;         //!< Grösse der Hashtabelle, immer eine Zweierpotenz
+    size_t usage;          //!< Summe von \ref sdlwEntry_t.bytes aller Einträge
+    unsigned int useTick;  //!< Zähler für \ref sdlwEntry_t.lastUse
+} registry;
+
+static size_t memoryBudget = SDLW_DEFAULT_MEMORY_BUDGET;  //!< Budget gemäss SDLW_SetMemoryBudget()
+static sdlwHandle_t playingMusic = SDLW_INVALID_HANDLE; //!< Referenzierte Musik von SDLW_PlayMusic()
+static assetPack_t pack;                                //!< Eingeblendetes Ressourcenpaket, siehe SDLW_LoadPack()
+
+#define SDLW_MAX_LOADER_THREADS 8 //!< Maximale Anzahl Worker zum Dekodieren
+#define SDLW_ATLAS_PAGE_SIZE 1024 //!< Breite und maximale Höhe einer Atlasseite in Pixel
+#define SDLW_ATLAS_PADDING 1      //!< Transparenter Rand um jedes Bild einer Atlasseite
+#define SDLW_SOURCES_BASIS 14695981039346656037ull //!< Startwert der Prüfsumme über die Quelldateien (FNV-1a)
+
+//! Ressourcentypen die bei überschrittenem Budget entladen werden dürfen
+#define SDLW_EVICTABLE_TYPES (RESOURCETYPE_TEXTURE | RESOURCETYPE_FONT | RESOURCETYPE_SOUND_EFFECT | RESOURCETYPE_SOUND_MUSIC)
 
 
 /*
@@ -57,52 +134,292 @@ static list_t resourceList; //!< Liste aller geladenen Ressourcen
  */
 
 /**
- * @brief Vergleiche Ressourcenschlüssel.
- * Vergleicht ob das gegebene Element gesucht wird.
- * \p searchKey muss Null terminated sein!
+ * @brief Berechnet den Hash eines Ressourcenschlüssels (FNV-1a).
+ *
+ * @param[in] key Null terminierter Schlüssel
+ *
+ * @return Hashwert
+ */
+static unsigned int SDLW_HashKey(const char *key);
+
+/**
+ * @brief Sucht den Platz eines Schlüssels in der Hashtabelle.
+ * Ist der Schlüssel nicht vorhanden, wird der erste freie Platz zurückgegeben.
+ *
+ * @param[in] key Null terminierter Schlüssel
+ *
+ * @return Index in der Hashtabelle
+ */
+static int SDLW_FindSlot(const char *key);
+
+/**
+ * @brief Nimmt einen Eintrag ins Register auf.
+ * Ist der Schlüssel bereits vorhanden, zeigt er danach auf den neuen Eintrag.
+ * Der alte Eintrag bleibt über sein Handle erreichbar.
+ *
+ * @param[in] entry Der aufzunehmende Eintrag
+ *
+ * @return 0 oder Errorcode
+ */
+static int SDLW_RegisterResource(sdlwEntry_t *entry);
+
+/**
+ * @brief Gibt eine Ressource zurück und erstellt sie bei Bedarf.
+ * Im Gegensatz zu SDLW_GetResourceByHandle() wird keine Referenz gezählt, der
+ * Pointer darf daher nur kurzfristig verwendet werden.
+ *
+ * @param[in] handle Gültiges Handle
+ * @param[in] type Der Typ der Ressource die geladen werden soll
+ * @param[out] resource Pointer zur Ressource
+ *
+ * @return 0 oder Errorcode
+ */
+static int SDLW_UseResource(sdlwHandle_t handle, resourceType_t type, void **resource);
+
+/**
+ * @brief Gibt eine Referenz eines Eintrags frei.
+ *
+ * @param[in,out] entry Der Eintrag
+ *
+ * @return 0 oder ERR_SEQUENCE wenn keine Referenz besteht
+ */
+static int SDLW_ReleaseEntry(sdlwEntry_t *entry);
+
+/**
+ * @brief Überprüft die Konfigurationszeile eines Eintrags.
+ * Setzt \ref sdlwEntry_t.kind. Texturen, Schriften und Sounds werden erst bei
+ * Bedarf geladen, Fehler in der Zeile werden aber bereits hier gemeldet.
+ *
+ * @param[in,out] entry Der Eintrag
+ *
+ * @return 0 oder Errorcode
+ */
+static int SDLW_CheckEntry(sdlwEntry_t *entry);
+
+/**
+ * @brief Erstellt die Ressource eines Eintrags aus dessen Auftrag.
+ * Der Speicherbedarf wird ermittelt und zum Register gezählt.
+ *
+ * @param[in,out] entry Ein nicht geladener Eintrag
+ *
+ * @return 0 oder Errorcode
+ */
+static int SDLW_LoadEntry(sdlwEntry_t *entry);
+
+/**
+ * @brief Entlädt die Ressource eines Eintrags, der Eintrag selbst bleibt.
+ *
+ * @param[in,out] entry Der Eintrag
+ */
+static void SDLW_UnloadEntry(sdlwEntry_t *entry);
+
+/**
+ * @brief Entlädt unreferenzierte Ressourcen bis das Budget eingehalten ist.
+ * Die am längsten nicht verwendeten Ressourcen werden zuerst entladen.
+ *
+ * @param[in] keep Eintrag der nicht entladen werden darf, darf NULL sein
+ */
+static void SDLW_EnforceBudget(sdlwEntry_t *keep);
+
+/**
+ * @brief Schätzt den Speicherbedarf einer geladenen Ressource.
+ *
+ * @param[in] entry Der Eintrag
+ *
+ * @return Speicherbedarf in Bytes
+ */
+static size_t SDLW_EntryBytes(sdlwEntry_t *entry);
+
+/**
+ * @brief Ermittelt die Grösse der Quelldaten eines Auftrags.
+ * Im Paket die Grösse des Eintrags, sonst die der Datei.
+ *
+ * @param[in] job Auftrag
+ *
+ * @return Grösse in Bytes, 0 falls keine Quelldatei existiert
+ */
+static size_t SDLW_SourceBytes(const sdlwLoadJob_t *job);
+
+/**
+ * @brief Befreit alle Ressourcen und den Speicher des Registers.
+ *
+ */
+static void SDLW_ClearRegistry(void);
+
+/**
+ * @brief Liest eine Konfigurationsdatei samt eingebundener Dateien.
+ * Jede Ressourcenzeile wird als Auftrag an \p queue angehängt.
+ *
+ * @param[in] resourceConfigLocation Pfad der Ressourcenkonfigurationsdatei
+ * @param[in,out] queue Auftragsliste
+ *
+ * @return 0 oder Errorcode
+ */
+static int SDLW_ParseConfig(char *resourceConfigLocation, sdlwLoadQueue_t *queue);
+
+/**
+ * @brief Nimmt Pfad, Änderungszeit und Grösse einer Datei in eine Prüfsumme auf.
+ * Fehlende Dateien werden mit Änderungszeit und Grösse -1 aufgenommen.
+ *
+ * @param[in,out] hash Die Prüfsumme
+ * @param[in] fileLocation Pfad der Datei
+ */
+static void SDLW_HashFile(uint64_t *hash, const char *fileLocation);
+
+/**
+ * @brief Markiert die von Sprites verwendeten Texturen zum Vorabdekodieren.
+ * Die übrigen Texturen werden erst bei Bedarf dekodiert.
+ *
+ * @param[in,out] queue Auftragsliste
+ */
+static void SDLW_MarkPreload(sdlwLoadQueue_t *queue);
+
+/**
+ * @brief Prüft ob ein Auftrag eine mit "atlas" markierte Textur ist.
+ *
+ * @param[in] job Auftrag
+ *
+ * @return 1 wenn die Textur in einen Atlas gepackt werden darf, sonst 0
+ */
+static int SDLW_IsAtlasJob(const sdlwLoadJob_t *job);
+
+/**
+ * @brief Packt die dekodierten, mit "atlas" markierten Texturen auf Atlasseiten.
+ * Die Seiten werden als eigene Texturen registriert. Die Aufträge verweisen
+ * danach auf ihre Seite, die dekodierten Bilder werden befreit. Bilder die auf
+ * keine Seite passen, bleiben eigenständige Texturen.
+ *
+ * @param[in,out] queue Auftragsliste
+ *
+ * @return 0 oder Errorcode
+ */
+static int SDLW_BuildAtlas(sdlwLoadQueue_t *queue);
+
+/**
+ * @brief Erstellt und registriert eine Atlasseite.
+ *
+ * @param[in] items Mit Atlas_Pack() platzierte Bilder
+ * @param[in,out] jobs Aufträge der Bilder, gleiche Reihenfolge wie \p items
+ * @param count Anzahl Bilder
+ * @param page Die zu erstellende Seite
+ *
+ * @return 0 oder Errorcode
+ */
+static int SDLW_CreateAtlasPage(const atlasItem_t *items, sdlwLoadJob_t **jobs, int count, int page);
+
+/**
+ * @brief Dekodiert Bilder und Soundeffekte der Auftragsliste.
+ * Verteilt die Arbeit auf mehrere Threads, die Reihenfolge bleibt erhalten.
+ *
+ * @param[in,out] queue Auftragsliste
+ */
+static void SDLW_DecodeJobs(sdlwLoadQueue_t *queue);
+
+/**
+ * @brief Threadfunktion eines Workers.
+ * Dekodiert Aufträge bis keine mehr vorhanden sind.
+ *
+ * @param[in,out] data Pointer auf \ref sdlwLoadQueue_t
+ *
+ * @return immer 0
+ */
+static int SDLCALL SDLW_DecodeWorker(void *data);
+
+/**
+ * @brief Dekodiert einen Auftrag, falls dieser ein vorab benötigtes Bild oder
+ * ein Soundeffekt ist.
+ * Kommt ohne Renderer aus und darf daher ausserhalb des Hauptthreads laufen.
+ *
+ * @param[in,out] job Auftrag
+ */
+static void SDLW_DecodeJob(sdlwLoadJob_t *job);
+
+/**
+ * @brief Befreit die dekodierten Daten eines nicht verwendeten Auftrags.
+ *
+ * @param[in,out] job Auftrag
+ */
+static void SDLW_FreeDecoded(sdlwLoadJob_t *job);
+
+/**
+ * @brief Registriert die Einträge aller Aufträge.
+ * Sprites, Welten und bereits dekodierte Aufträge werden sofort erstellt, die
+ * übrigen erst bei Bedarf. Die Reihenfolge der Konfiguration bleibt erhalten.
+ * Die Auftragsliste wird danach befreit.
+ *
+ * @param[in,out] queue Auftragsliste
+ *
+ * @return 0 oder Errorcode
+ */
+static int SDLW_CreateResources(sdlwLoadQueue_t *queue);
+
+/**
+ * @brief Füllt die Auftragsliste mit den Einträgen des eingeblendeten Pakets.
+ * Die Daten werden erst beim Erstellen der Ressource mit SDLW_OpenPackData()
+ * aus der Abbildung gelesen.
+ *
+ * @param[out] queue Auftragsliste
+ *
+ * @return 0 oder Errorcode
+ */
+static int SDLW_QueuePack(sdlwLoadQueue_t *queue);
+
+/**
+ * @brief Bereitet die Daten eines Paketeintrags für einen Auftrag vor.
+ * Bilder und Samples werden direkt aus der Abbildung verwendet.
  *
- * @param[in] resource Die zu überprüfende Ressource
- * @param[in] searchKey Nach welchem Ressourcenschlüssel gesucht wird
+ * @param[in,out] job Auftrag mit gültigem \ref sdlwLoadJob_t.packIndex
  *
- * @return 0 = false, 1 = true
+ * @return 0 oder Errorcode
  */
-static int SDLW_CmpKey(sdlwResource_t *resource, char *searchKey);
+static int SDLW_OpenPackData(sdlwLoadJob_t *job);
+
+/**
+ * @brief Schreibt einen Auftrag mit vorab dekodierten Daten in ein Paket.
+ *
+ * @param[in,out] writer Schreiber des Pakets
+ * @param[in] job Auftrag
+ *
+ * @return 0 oder Errorcode
+ */
+static int SDLW_PackJob(assetPackWriter_t *writer, sdlwLoadJob_t *job);
 
 /**
  * @brief Lädt die angegebene Datei in die Ressource als eine Textur
  *
- * @param[in] config Zeile aus Konfigurationsdatei mit Argumenten
+ * @param[in,out] job Auftrag, eine bereits dekodierte Surface wird übernommen
  * @param[out] resource Wohin die Ressource geladen werden soll
  *
  * @return 0 oder Errorcode
  */
-static int SDLW_LoadTexture(char *config, sdlwResource_t *resource);
+static int SDLW_LoadTexture(sdlwLoadJob_t *job, sdlwResource_t *resource);
 
 /**
  * @brief Lädt die angegebene Datei in die Ressource als eine Schrift
  *
- * @param[in] config Zeile aus Konfigurationsdatei mit Argumenten
+ * @param[in,out] job Auftrag, ein Dateiinhalt aus einem Paket wird übernommen
  * @param[out] resource Wohin die Ressource geladen werden soll
  *
  * @return 0 oder Errorcode
  */
-static int SDLW_LoadFont(char *config, sdlwResource_t *resource);
+static int SDLW_LoadFont(sdlwLoadJob_t *job, sdlwResource_t *resource);
 
 /**
  * @brief Lädt die angegebene Datei in die Resource als einen Sound
  *
- * @param[in] config Zeile aus Konfigurationsdatei mit Argumenten
+ * @param[in,out] job Auftrag, ein bereits dekodierter Soundeffekt oder ein
+ * Dateiinhalt aus einem Paket wird übernommen
  * @param[out] resource Wohin die Ressource geladen werden soll
  *
  * @return 0 oder Errorcode
  */
-static int SDLW_LoadSound(char *config, sdlwResource_t *resource);
+static int SDLW_LoadSound(sdlwLoadJob_t *job, sdlwResource_t *resource);
 
 /**
- * @brief Befreit allozierte Ressource.
- * Wird von SDLW_Quit() aufgerufen.
+ * @brief Befreit eine allozierte Ressource.
+ * Die Struktur selbst bleibt bestehen, \ref sdlwResource_t.resource wird NULL.
  * 
- * @param[in] resource Eine Ressource von \p resourceList
+ * @param[in,out] resource Eine Ressource aus dem Register
  *
  * @return 0 oder Errorcode
  */
@@ -125,66 +442,74 @@ int SDLW_Init(int windowWidth, int windowHeight) {
         return ERR_PARAMETER;
     }
 
-    // Initialisierung der verschiedenen SDL Bibliotheken
+    // Initialisierung der verschiedenen SDL Bibliotheken, jeweils gemessen
+    uint64_t start = Profiler_Begin();
     if (SDL_Init(SDL_INIT_EVERYTHING & ~SDL_INIT_SENSOR)) { // ohne Sensor-System
         SDLW_Quit();
         SDL_Log("SDL Error beim initialisieren! [%s] SDLW_Init()\n", SDL_GetError());
         return ERR_FAIL;
     }
+    Profiler_End(start, "init", "SDL_Init");
 
-    if (Mix_OpenAudio(MIX_DEFAULT_FREQUENCY, MIX_DEFAULT_FORMAT, 2, 1024) < 0) {
+    start = Profiler_Begin();
+    if (Mix_OpenAudio(MIX_DEFAULT_FREQUENCY, MIX_DEFAULT_FORMAT, MIX_DEFAULT_CHANNELS, 1024) < 0) {
         SDL_Log("Mix Error beim Audio oeffnen! [%s] SDLW_Init()\n", Mix_GetError());
         SDLW_Quit();
         return ERR_FAIL;
     }
+    Profiler_End(start, "init", "Mix_OpenAudio");
 
+    start = Profiler_Begin();
     if (!Mix_Init(MIX_INIT_FLAC | MIX_INIT_MOD | MIX_INIT_MP3 | MIX_INIT_OGG | MIX_INIT_MID | MIX_INIT_OPUS)) { // Initialisierung Sound
         SDLW_Quit();
         SDL_Log("Mix Error beim initialisieren! [%s] SDLW_Init()\n", Mix_GetError());
         return ERR_FAIL;
     }
+    Profiler_End(start, "init", "Mix_Init");
 
+    start = Profiler_Begin();
     if (!IMG_Init(IMG_INIT_JPG | IMG_INIT_PNG)) { // Initialisierung IMG
         SDLW_Quit();
         SDL_Log("SDL_image Error beim initialisieren! [%s] SDLW_Init()\n", IMG_GetError());
         return ERR_FAIL;
     }
+    Profiler_End(start, "init", "IMG_Init");
 
+    start = Profiler_Begin();
     if (TTF_Init()) { // Initialisierung Fonts
         SDLW_Quit();
         SDL_Log("TTF Error beim initialisieren! [%s] SDLW_Init()\n", TTF_GetError());
         return ERR_FAIL;
     }
+    Profiler_End(start, "init", "TTF_Init");
 
+    start = Profiler_Begin();
     if (SDLNet_Init()) { // Initialisierung Networking
         SDLW_Quit();
         SDL_Log("SDLNet Error beim initialisieren! [%s] SDLW_Init()\n", SDLNet_GetError());
         return ERR_FAIL;
     }
+    Profiler_End(start, "init", "SDLNet_Init");
 
     // Erstellen eines Fensters
+    start = Profiler_Begin();
     window = SDL_CreateWindow("Tanks", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, windowWidth, windowHeight, SDL_WINDOW_SHOWN);
     if (!window) {
         SDLW_Quit();
         SDL_Log("SDL_CreateWindow Error! [%s] SDLW_Init()\n", SDL_GetError());
         return ERR_FAIL;
     }
+    Profiler_End(start, "init", "SDL_CreateWindow");
 
     // Erstellen des Graphikrenderers
+    start = Profiler_Begin();
     renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
     if (!renderer) {
         SDLW_Quit();
         SDL_Log("SDL_CreateRenderer Error! [%s] SDLW_Init()\n", SDL_GetError());
         return ERR_FAIL;
     }
-
-    // Initialisierung der Ressourcenliste
-    if (List_Init(&resourceList)) {
-        SDLW_Quit();
-        SDL_Log("Ressourcenliste konnte nicht initialisiert werden! SDLW_Init()\n");
-        return ERR_FAIL;
-    }
-    resourceList.dataAutoFree = (fnPntrDataCallback)FreeSDLWResource;
+    Profiler_End(start, "init", "SDL_CreateRenderer");
 
     // Abschluss der Initialisierung
     initialized = 1;
@@ -196,7 +521,8 @@ int SDLW_Quit() {
 
     // Löschen der geladenen Ressourcen
     if (initialized)
-        errorCode = List_Clear(&resourceList);
+        SDLW_ClearRegistry();
+    AssetPack_Close(&pack); // Erst nach den Ressourcen die darauf verweisen
 
     // Schliessen des Fensters
     if (renderer)
@@ -233,80 +559,151 @@ int SDLW_LoadResources(char *resourceConfigLocation) {
         return ERR_NULLPARAMETER;
     }
 
-    // Öffnen der Konfigurationsdatei
-    FILE *file;
-    file = fopen(resourceConfigLocation, "r");
+    // Gesamten Konfigurationsbaum einlesen
+    uint64_t start = Profiler_Begin();
+    sdlwLoadQueue_t queue = {0};
+    int errorCode = SDLW_ParseConfig(resourceConfigLocation, &queue);
+    if (errorCode) {
+        free(queue.jobs);
+        return errorCode;
+    }
+    Profiler_End(start, "load", "SDLW_ParseConfig");
+
+    // Von Sprites verwendete Bilder und Soundeffekte parallel dekodieren
+    start = Profiler_Begin();
+    SDLW_MarkPreload(&queue);
+    SDLW_DecodeJobs(&queue);
+    Profiler_End(start, "load", "SDLW_DecodeJobs");
+
+    // Markierte Texturen auf gemeinsame Seiten packen
+    errorCode = SDLW_BuildAtlas(&queue);
+    if (errorCode) {
+        for (int i = 0; i < queue.count; ++i)
+            SDLW_FreeDecoded(&queue.jobs[i]);
+        free(queue.jobs);
+        return errorCode;
+    }
 
-    if (!file) { // Fehlerüberprüfungs
-        SDL_Log("Fehler beim öffnen des Dokuments %s! SDLW_LoadRessource()\n", resourceConfigLocation);
-        return ERR_PARAMETER;
+    return SDLW_CreateResources(&queue);
+}
+
+int SDLW_LoadPack(char *packLocation, char *resourceConfigLocation) {
+    // Fehlerüberprüfung
+    if (!initialized) {
+        SDL_Log("SLDW nicht initialisiert! SDLW_LoadPack()\n");
+        return ERR_FAIL;
     }
 
-    char config[256] = {0};
-    char key[64] = {0};  // Die ID der zu ladenen Ressource
-    char type[32] = {0}; // Der Typ der zu ladenen Ressource
+    if (!packLocation || !resourceConfigLocation) {
+        SDL_Log("Dateipfad ist ungueltig! SDLW_LoadPack()\n");
+        return ERR_NULLPARAMETER;
+    }
 
-    int line = 0;
+    if (pack.base) { // Es kann nur ein Paket eingeblendet sein
+        SDL_Log("Es ist bereits ein Paket geladen! SDLW_LoadPack()\n");
+        return ERR_SEQUENCE;
+    }
 
-    while (fgets(config, 255, file)) { // Lesen der Konfigurationszeilen
-        line++;
+    // Ohne gültiges Paket wird die Konfiguration geladen
+    uint64_t start = Profiler_Begin();
+    if (AssetPack_Open(packLocation, &pack)) {
+        SDL_Log("Kein gueltiges Paket %s, lade %s\n", packLocation, resourceConfigLocation);
+        return SDLW_LoadResources(resourceConfigLocation);
+    }
+    Profiler_End(start, "load", "AssetPack_Open");
+
+    // Nach Änderungen an den Quelldateien ist das Paket veraltet
+    uint64_t sources = 0;
+    if (SDLW_HashSources(resourceConfigLocation, &sources) || sources != pack.header->sourceHash) {
+        SDL_Log("Paket %s ist veraltet, lade %s\n", packLocation, resourceConfigLocation);
+        AssetPack_Close(&pack);
+        return SDLW_LoadResources(resourceConfigLocation);
+    }
 
-        int count = sscanf(config, "%63s %31s", key, type);
-        if (count == 0)
-            continue;
-        if (!strcmp(key, "#")) // Kommentar
-            continue;
+    // Samples sind nur im Audioformat des Geräts verwendbar
+    int frequency = 0, channels = 0;
+    Uint16 format = 0;
+    Mix_QuerySpec(&frequency, &format, &channels);
+    if ((uint32_t)frequency != pack.header->audioFrequency || format != pack.header->audioFormat ||
+        (uint32_t)channels != pack.header->audioChannels) {
+        SDL_Log("Audioformat von %s passt nicht, lade %s\n", packLocation, resourceConfigLocation);
+        AssetPack_Close(&pack);
+        return SDLW_LoadResources(resourceConfigLocation);
+    }
 
-        if(count < 2){ // Zu wenig Argumente in der Konfigurationszeile
-            SDL_Log("Konfigurationszeile %d ungueltig! [%s]\n", line, resourceConfigLocation);
-            fclose(file);
-            return ERR_FAIL;
-        }
+    sdlwLoadQueue_t queue = {0};
+    int errorCode = SDLW_QueuePack(&queue);
+    if (!errorCode)
+        errorCode = SDLW_BuildAtlas(&queue);
+    if (errorCode) {
+        for (int i = 0; i < queue.count; ++i)
+            SDLW_FreeDecoded(&queue.jobs[i]);
+        free(queue.jobs);
+        AssetPack_Close(&pack);
+        return errorCode;
+    }
+    // Erstellte Ressourcen verweisen in die Abbildung, das Paket bleibt bis
+    // SDLW_Quit() eingeblendet.
+    return SDLW_CreateResources(&queue);
+}
 
-        sdlwResource_t *resource = malloc(sizeof(sdlwResource_t));
-        if (!resource) { // Allozierung überprüfen
-            SDL_Log("Ressource konnte nicht alloziert werden! SDLW_LoadRessource()!\n");
-            fclose(file);
-            return ERR_MEMORY;
-        }
+int SDLW_BuildPack(char *resourceConfigLocation, char *packLocation) {
+    if (!resourceConfigLocation || !packLocation) { // Fehlerüberprüfung
+        SDL_Log("Dateipfad ist ungueltig! SDLW_BuildPack()\n");
+        return ERR_NULLPARAMETER;
+    }
 
-        strcpy(resource->key, key); // Setzen des Schlüssels der Ressource
-
-        // Lesen und überprüfen der verschiedenen Ressourcentypen
-        int errorCode = ERR_FAIL;
-        if (!strcmp(type, "texture")) // Textur
-            errorCode = SDLW_LoadTexture(config, resource);
-        else if (!strcmp(type, "font")) // Font
-            errorCode = SDLW_LoadFont(config, resource);
-        else if (!strcmp(type, "sound"))
-            errorCode = SDLW_LoadSound(config, resource);
-        else if (!strcmp(type, "sprite"))
-            errorCode = Sprite_Load(config, resource);
-        else if (!strcmp(type, "world"))
-            errorCode = World_LoadConfig(config, resource);
-        else if (!strcmp(type, "config")) { // Weitere Konfigurationsdatei
-            free(resource);
-            errorCode = SDLW_LoadResources(key);
-            if (errorCode) {
-                fclose(file);
-                return errorCode;
-            }
-            continue;
-        }
+    // Prüfsumme vor dem Packen, spätere Änderungen machen das Paket veraltet
+    uint64_t sources = 0;
+    int errorCode = SDLW_HashSources(resourceConfigLocation, &sources);
+
+    // Gesamten Konfigurationsbaum einlesen
+    sdlwLoadQueue_t queue = {0};
+    if (!errorCode)
+        errorCode = SDLW_ParseConfig(resourceConfigLocation, &queue);
+
+    assetPackWriter_t writer;
+    if (!errorCode)
+        errorCode = AssetPack_BeginWrite(&writer, packLocation, MIX_DEFAULT_FORMAT, MIX_DEFAULT_FREQUENCY, MIX_DEFAULT_CHANNELS, sources);
+    if (errorCode) {
+        free(queue.jobs);
+        return errorCode;
+    }
 
-        if (errorCode) { // Fehlerüberprüfung
-            free(resource);
-            fclose(file);
-            return errorCode;
-        }
+    // Jeden Auftrag vorab dekodieren und ins Paket schreiben
+    for (int i = 0; i < queue.count && !errorCode; ++i) {
+        errorCode = SDLW_PackJob(&writer, &queue.jobs[i]);
+        if (!errorCode)
+            SDL_Log("Gepackt %s als %s\n", queue.jobs[i].key, queue.jobs[i].type);
+    }
+    free(queue.jobs);
 
-        // Hinzufügen der geladenen Ressource
-        SDL_Log("Geladen %s als %s\n", key, type);
-        List_Add(&resourceList, resource);
-    }    
-    // Abschluss
-    fclose(file);
-    return ERR_OK;
+    int endCode = AssetPack_EndWrite(&writer, packLocation, !errorCode);
+    return errorCode ? errorCode : endCode;
+}
+
+int SDLW_HashSources(char *resourceConfigLocation, uint64_t *hash) {
+    if (!resourceConfigLocation || !hash) { // Fehlerüberprüfung
+        SDL_Log("Dateipfad oder Rueckgabespeicher ungueltig! SDLW_HashSources()\n");
+        return ERR_NULLPARAMETER;
+    }
+
+    // Konfigurationsdateien werden beim Einlesen aufgenommen
+    sdlwLoadQueue_t queue = {.sources = SDLW_SOURCES_BASIS};
+    int errorCode = SDLW_ParseConfig(resourceConfigLocation, &queue);
+
+    // Danach die Dateien der Bilder, Sounds und Schriften
+    for (int i = 0; i < queue.count && !errorCode; ++i) {
+        const sdlwLoadJob_t *job = &queue.jobs[i];
+        char fileName[64] = {0};
+        if (strcmp(job->type, "texture") && strcmp(job->type, "sound") && strcmp(job->type, "font"))
+            continue;
+        if (sscanf(job->config, "%*s %*s %63s", fileName) == 1)
+            SDLW_HashFile(&queue.sources, fileName);
+    }
+    free(queue.jobs);
+    *hash = queue.sources;
+    return errorCode;
 }
 
 int SDLW_GetResource(char *id, resourceType_t type, void **resource) {
@@ -327,18 +724,199 @@ int SDLW_GetResource(char *id, resourceType_t type, void **resource) {
         return ERR_NULLPARAMETER;
     }
 
-    sdlwResource_t *foundResource; // Suche initialisieren
-
     // Ressource nach id = key suchen
-    List_SearchArg(&resourceList, (fnPntrDataCallbackArg)SDLW_CmpKey, id, (void **)&foundResource);
-    if (foundResource && (foundResource->type & type)) {
-        (*resource) = foundResource->resource.any;
+    sdlwHandle_t handle = SDLW_ResolveHandle(id);
+    if (handle != SDLW_INVALID_HANDLE && !SDLW_GetResourceByHandle(handle, type, resource)) {
         return ERR_OK;
     }
     SDL_Log("Ressource mit id [%s] nicht gefunden!\n", id);
     return ERR_FAIL;
 }
 
+int SDLW_PeekResource(char *id, resourceType_t type, void **resource) {
+    if (!resource) {
+        SDL_Log("Zielpointer ungueltig! SDLW_PeekResource()\n");
+        return ERR_NULLPARAMETER;
+    }
+    (*resource) = NULL;
+
+    if (type & SDLW_EVICTABLE_TYPES) { // Ohne Referenz könnten diese entladen werden
+        SDL_Log("Typ kann entladen werden! [%d] SDLW_PeekResource()\n", type);
+        return ERR_PARAMETER;
+    }
+    if (!initialized) { // Fehlerüberprüfung
+        SDL_Log("SLDW nicht initialisiert! SDLW_PeekResource()\n");
+        return ERR_FAIL;
+    }
+    if (!id) {
+        SDL_Log("Id ungueltig! SDLW_PeekResource()\n");
+        return ERR_NULLPARAMETER;
+    }
+
+    sdlwHandle_t handle = SDLW_ResolveHandle(id);
+    if (handle != SDLW_INVALID_HANDLE && !SDLW_UseResource(handle, type, resource)) {
+        return ERR_OK;
+    }
+    SDL_Log("Ressource mit id [%s] nicht gefunden! SDLW_PeekResource()\n", id);
+    return ERR_FAIL;
+}
+
+sdlwHandle_t SDLW_ResolveHandle(char *id) {
+    if (!initialized || !id || !registry.slotCount) {
+        return SDLW_INVALID_HANDLE;
+    }
+    return registry.slots[SDLW_FindSlot(id)];
+}
+
+int SDLW_GetResourceByHandle(sdlwHandle_t handle, resourceType_t type, void **resource) {
+    if (!resource) {
+        SDL_Log("Zielpointer ungueltig! SDLW_GetResourceByHandle()\n");
+        return ERR_NULLPARAMETER;
+    }
+    (*resource) = NULL;
+
+    if (!initialized) { // Fehlerüberprüfung
+        SDL_Log("SLDW nicht initialisiert! SDLW_GetResourceByHandle()\n");
+        return ERR_FAIL;
+    }
+    if (handle < 0 || handle >= registry.count) {
+        SDL_Log("Handle ungueltig! [%d] SDLW_GetResourceByHandle()\n", handle);
+        return ERR_PARAMETER;
+    }
+
+    int errorCode = SDLW_UseResource(handle, type, resource);
+    if (!errorCode) // Referenz zählen
+        registry.entries[handle]->refCount++;
+    return errorCode;
+}
+
+int SDLW_GetTextureRegion(char *id, SDL_Texture **texture, SDL_Rect *region) {
+    if (!texture || !region) { // Fehlerüberprüfung
+        SDL_Log("Zielpointer ungueltig! SDLW_GetTextureRegion()\n");
+        return ERR_NULLPARAMETER;
+    }
+    (*region) = (SDL_Rect){0};
+
+    int errorCode = SDLW_GetResource(id, RESOURCETYPE_TEXTURE, (void **)texture);
+    if (errorCode)
+        return errorCode;
+
+    // Ausschnitt der Atlasseite oder die gesamte Textur
+    sdlwEntry_t *entry = registry.entries[SDLW_ResolveHandle(id)];
+    if (entry->job.atlasPage != SDLW_INVALID_HANDLE)
+        (*region) = entry->job.region;
+    else
+        SDL_QueryTexture(*texture, NULL, NULL, &region->w, &region->h);
+    return ERR_OK;
+}
+
+int SDLW_GetTexturePixels(SDL_Texture *texture, SDL_Surface **pixels, resourceType_t *type) {
+    if (!texture || !pixels || !type) { // Fehlerüberprüfung
+        SDL_Log("Textur oder Zielpointer ungueltig! SDLW_GetTexturePixels()\n");
+        return ERR_NULLPARAMETER;
+    }
+    (*pixels) = NULL;
+
+    // Nur Masken und Stempel behalten ihre Pixel
+    for (int i = 0; i < registry.count; ++i) {
+        sdlwEntry_t *entry = registry.entries[i];
+        if (entry->job.pixels && entry->resource.resource.texture == texture) {
+            (*pixels) = entry->job.pixels;
+            (*type) = entry->resource.type;
+            entry->lastUse = ++registry.useTick;
+            return ERR_OK;
+        }
+    }
+    return ERR_FAIL;
+}
+
+int SDLW_LoadSurface(char *id, SDL_Surface **surface) {
+    if (!surface) { // Fehlerüberprüfung
+        SDL_Log("Zielpointer ungueltig! SDLW_LoadSurface()\n");
+        return ERR_NULLPARAMETER;
+    }
+    (*surface) = NULL;
+
+    sdlwHandle_t handle = SDLW_ResolveHandle(id);
+    if (handle == SDLW_INVALID_HANDLE || !(registry.entries[handle]->kind & RESOURCETYPE_TEXTURE) ||
+        registry.entries[handle]->job.config[0] == '\0') { // Atlasseiten haben keine Quelle
+        SDL_Log("Textur %s nicht gefunden! SDLW_LoadSurface()\n", id ? id : "NULL");
+        return ERR_FAIL;
+    }
+
+    // Quelle erneut dekodieren, die Textur selbst bleibt unberührt
+    sdlwLoadJob_t job = registry.entries[handle]->job;
+    job.decoded = NULL;
+    job.source = NULL;
+    job.pixels = NULL;
+    SDL_Surface *decoded = NULL;
+    if (job.packIndex >= 0) {
+        SDLW_OpenPackData(&job);
+        decoded = job.source ? IMG_Load_RW(job.source, 1) : job.decoded;
+    } else {
+        char fileName[64] = {0};
+        sscanf(job.config, "%*s %*s %63s", fileName);
+        decoded = IMG_Load(fileName);
+    }
+    if (!decoded) {
+        SDL_Log("IMG_Load error! [%s]\n", IMG_GetError());
+        return ERR_FAIL;
+    }
+
+    (*surface) = SDL_ConvertSurfaceFormat(decoded, SDL_PIXELFORMAT_RGBA8888, 0);
+    SDL_FreeSurface(decoded);
+    if (!*surface) {
+        SDL_Log("SDL_ConvertSurfaceFormat error! [%s]\n", SDL_GetError());
+        return ERR_FAIL;
+    }
+    return ERR_OK;
+}
+
+int SDLW_ReleaseResource(char *id) {
+    if (!initialized) { // Fehlerüberprüfung
+        SDL_Log("SLDW nicht initialisiert! SDLW_ReleaseResource()\n");
+        return ERR_FAIL;
+    }
+    if (!id) {
+        SDL_Log("Id ungueltig! SDLW_ReleaseResource()\n");
+        return ERR_NULLPARAMETER;
+    }
+
+    sdlwHandle_t handle = SDLW_ResolveHandle(id);
+    if (handle == SDLW_INVALID_HANDLE) {
+        SDL_Log("Ressource mit id [%s] nicht gefunden! SDLW_ReleaseResource()\n", id);
+        return ERR_FAIL;
+    }
+    return SDLW_ReleaseEntry(registry.entries[handle]);
+}
+
+int SDLW_SetMemoryBudget(size_t bytes) {
+    memoryBudget = bytes;
+    if (initialized) // Bereits geladene Ressourcen sofort anpassen
+        SDLW_EnforceBudget(NULL);
+    return ERR_OK;
+}
+
+size_t SDLW_GetMemoryUsage() {
+    return registry.usage;
+}
+
+int SDLW_GetResourceBytes(char *id, size_t *bytes) {
+    if (!id || !bytes) { // Fehlerüberprüfung
+        SDL_Log("Id oder Zielpointer ungueltig! SDLW_GetResourceBytes()\n");
+        return ERR_NULLPARAMETER;
+    }
+    (*bytes) = 0;
+
+    sdlwHandle_t handle = SDLW_ResolveHandle(id);
+    if (handle == SDLW_INVALID_HANDLE) {
+        SDL_Log("Ressource mit id [%s] nicht gefunden! SDLW_GetResourceBytes()\n", id);
+        return ERR_FAIL;
+    }
+    (*bytes) = registry.entries[handle]->bytes;
+    return ERR_OK;
+}
+
 int SDLW_DrawTexture(sprite_t sprite) {
     // Fehlerüberprüfung
     if (!initialized) {
@@ -392,8 +970,11 @@ int SDLW_CreateTextTexture(char *text, char *font, SDL_Color color, SDL_Texture
         return ERR_NULLPARAMETER;
     }
 
-    TTF_Font *fontResource;
-    SDLW_GetResource(font, RESOURCETYPE_FONT, (void **)&fontResource); // Suche nach der Font
+    // Suche nach der Font, sie wird nur für das Erstellen der Graphik benötigt
+    TTF_Font *fontResource = NULL;
+    sdlwHandle_t handle = SDLW_ResolveHandle(font);
+    if (handle != SDLW_INVALID_HANDLE)
+        SDLW_UseResource(handle, RESOURCETYPE_FONT, (void **)&fontResource);
 
     if (!fontResource) { // Fehlerüberprüfung
         return ERR_PARAMETER;
@@ -447,8 +1028,11 @@ int SDLW_PlayMusic(char *musicid) {
         return ERR_NULLPARAMETER;
     }
 
-    Mix_Music *music;
-    SDLW_GetResource(musicid, RESOURCETYPE_SOUND_MUSIC, (void **)&music);
+    // Die Musik bleibt referenziert solange sie gespielt wird
+    Mix_Music *music = NULL;
+    sdlwHandle_t handle = SDLW_ResolveHandle(musicid);
+    if (handle != SDLW_INVALID_HANDLE)
+        SDLW_GetResourceByHandle(handle, RESOURCETYPE_SOUND_MUSIC, (void **)&music);
 
     if (!music) { // Fehlerüberprüfung
         SDL_Log("Musik konnte nicht geladen werden!\n");
@@ -457,6 +1041,11 @@ int SDLW_PlayMusic(char *musicid) {
 
     Mix_PlayMusic(music, -1); // Spielt Musik in Endlosschleife, bis neue Musik abgespielt wird.
 
+    // Vorherige Musik freigeben
+    if (playingMusic != SDLW_INVALID_HANDLE)
+        SDLW_ReleaseEntry(registry.entries[playingMusic]);
+    playingMusic = handle;
+
     return ERR_OK;
 }
 
@@ -470,8 +1059,19 @@ int SDLW_PlaySoundEffect(char *chunk) {
         return ERR_NULLPARAMETER;
     }
 
-    Mix_Chunk *sound;
-    SDLW_GetResource(chunk, RESOURCETYPE_SOUND_EFFECT, (void **)&sound);
+    return SDLW_PlaySoundEffectByHandle(SDLW_ResolveHandle(chunk));
+}
+
+int SDLW_PlaySoundEffectByHandle(sdlwHandle_t handle) {
+    if (!initialized) { // Fehlerüberprüfung
+        SDL_Log("SLDW nicht initialisiert! SDLW_PlaySoundEffectByHandle()\n");
+        return ERR_FAIL;
+    }
+
+    // Der Soundeffekt wird nur für das Abspielen benötigt, keine Referenz
+    Mix_Chunk *sound = NULL;
+    if (handle >= 0 && handle < registry.count)
+        SDLW_UseResource(handle, RESOURCETYPE_SOUND_EFFECT, (void **)&sound);
 
     if (!sound) { // Fehlerüberprüfung
         SDL_Log("Soundeffekt konnte nicht geladen werden!\n");
@@ -495,15 +1095,744 @@ SDL_Renderer* SDLW_GetRenderer() {
  *
  */
 
-static int SDLW_CmpKey(sdlwResource_t *resource, char *searchKey) {
-    if (!searchKey)
+static unsigned int SDLW_HashKey(const char *key) {
+    unsigned int hash = 2166136261u;
+    while (*key) {
+        hash ^= (unsigned char)*key++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static int SDLW_FindSlot(const char *key) {
+    unsigned int mask = (unsigned int)registry.slotCount - 1;
+    unsigned int slot = SDLW_HashKey(key) & mask;
+    // Lineares Sondieren bis der Schlüssel oder ein freier Platz gefunden ist
+    while (registry.slots[slot] != SDLW_INVALID_HANDLE) {
+        if (!strcmp(registry.entries[registry.slots[slot]]->resource.key, key))
+            break;
+        slot = (slot + 1) & mask;
+    }
+    return (int)slot;
+}
+
+static int SDLW_RegisterResource(sdlwEntry_t *entry) {
+    // Eintragsarray bei Bedarf vergrössern. Auf realloc wird verzichtet,
+    // da der Heap-Mock der Tests dieses nicht ersetzt.
+    if (registry.count == registry.capacity) {
+        int capacity = registry.capacity ? registry.capacity * 2 : 64;
+        sdlwEntry_t **entries = malloc(sizeof(sdlwEntry_t *) * capacity);
+        if (!entries) {
+            SDL_Log("Ressourcenregister konnte nicht vergroessert werden! SDLW_RegisterResource()\n");
+            return ERR_MEMORY;
+        }
+        if (registry.entries) {
+            memcpy(entries, registry.entries, sizeof(sdlwEntry_t *) * registry.count);
+            free(registry.entries);
+        }
+        registry.entries = entries;
+        registry.capacity = capacity;
+    }
+    // Hashtabelle höchstens zur Hälfte füllen, ansonsten neu aufbauen
+    if ((registry.count + 1) * 2 > registry.slotCount) {
+        int slotCount = registry.slotCount ? registry.slotCount * 2 : 128;
+        sdlwHandle_t *slots = malloc(sizeof(sdlwHandle_t) * slotCount);
+        if (!slots) {
+            SDL_Log("Hashtabelle konnte nicht vergroessert werden! SDLW_RegisterResource()\n");
+            return ERR_MEMORY;
+        }
+        for (int i = 0; i < slotCount; ++i)
+            slots[i] = SDLW_INVALID_HANDLE;
+        sdlwHandle_t *oldSlots = registry.slots;
+        int oldSlotCount = registry.slotCount;
+        registry.slots = slots;
+        registry.slotCount = slotCount;
+        for (int i = 0; i < oldSlotCount; ++i) {
+            if (oldSlots[i] != SDLW_INVALID_HANDLE)
+                registry.slots[SDLW_FindSlot(registry.entries[oldSlots[i]]->resource.key)] = oldSlots[i];
+        }
+        free(oldSlots);
+    }
+    // Neuste Ressource mit gleichem Schlüssel überdeckt ältere
+    sdlwHandle_t handle = registry.count++;
+    registry.entries[handle] = entry;
+    registry.slots[SDLW_FindSlot(entry->resource.key)] = handle;
+    return ERR_OK;
+}
+
+static void SDLW_ClearRegistry(void) {
+    for (int i = 0; i < registry.count; ++i) {
+        if (registry.entries[i]->job.atlasPage == SDLW_INVALID_HANDLE) // Atlasseiten sind eigene Einträge
+            FreeSDLWResource(&registry.entries[i]->resource);
+        SDLW_FreeDecoded(&registry.entries[i]->job);
+        free(registry.entries[i]);
+    }
+    free(registry.entries);
+    free(registry.slots);
+    memset(&registry, 0, sizeof(registry));
+    playingMusic = SDLW_INVALID_HANDLE;
+}
+
+static int SDLW_UseResource(sdlwHandle_t handle, resourceType_t type, void **resource) {
+    sdlwEntry_t *entry = registry.entries[handle];
+    if (!(entry->kind & type)) // Ohne zu laden ablehnen
+        return ERR_FAIL;
+
+    // Ressource bei der ersten Verwendung oder nach dem Entladen erstellen
+    if (!entry->resource.resource.any) {
+        int errorCode = SDLW_LoadEntry(entry);
+        if (errorCode)
+            return errorCode;
+        SDLW_EnforceBudget(entry);
+    }
+
+    // Der genaue Typ einer Textur ist erst nach dem Laden bekannt
+    if (!(entry->resource.type & type))
+        return ERR_FAIL;
+    entry->lastUse = ++registry.useTick;
+    (*resource) = entry->resource.resource.any;
+    return ERR_OK;
+}
+
+static int SDLW_ReleaseEntry(sdlwEntry_t *entry) {
+    if (entry->refCount <= 0) {
+        SDL_Log("Ressource [%s] ist nicht referenziert! SDLW_ReleaseResource()\n", entry->resource.key);
+        return ERR_SEQUENCE;
+    }
+    if (--entry->refCount == 0) // Darf nun entladen werden
+        SDLW_EnforceBudget(NULL);
+    return ERR_OK;
+}
+
+static int SDLW_CheckEntry(sdlwEntry_t *entry) {
+    char key[32] = {0};
+    char type[32] = {0};
+    char fileName[64] = {0};
+    char arg1[16] = {0};
+    char arg2[8] = {0};
+
+    // Zeile wie in den jeweiligen Ladefunktionen lesen
+    int count = sscanf(entry->job.config, "%31s %31s %63s %15s %7s", key, type, fileName, arg1, arg2);
+
+    if (!strcmp(entry->job.type, "texture")) {
+        entry->kind = RESOURCETYPE_TEXTURE;
+        if (count == 3 || (count == 4 && !strcmp(arg1, "atlas")))
+            return ERR_OK;
+        if (count == 5 && !strcmp(arg1, "blendmode") && (!strcmp(arg2, "stamp") || !strcmp(arg2, "mask")))
+            return ERR_OK;
+    } else if (!strcmp(entry->job.type, "font")) {
+        entry->kind = RESOURCETYPE_FONT;
+        int size = atoi(arg1);
+        if (count == 4 && size >= 5 && size <= 200)
+            return ERR_OK;
+    } else if (!strcmp(entry->job.type, "sound")) {
+        if (count == 4 && !strcmp(arg1, "effect")) {
+            entry->kind = RESOURCETYPE_SOUND_EFFECT;
+            return ERR_OK;
+        }
+        if (count == 4 && !strcmp(arg1, "music")) {
+            entry->kind = RESOURCETYPE_SOUND_MUSIC;
+            return ERR_OK;
+        }
+    } else if (!strcmp(entry->job.type, "sprite")) {
+        entry->kind = RESOURCETYPE_SPRITE;
+        return ERR_OK; // Wird sofort geladen und dabei überprüft
+    } else if (!strcmp(entry->job.type, "world")) {
+        entry->kind = RESOURCETYPE_WORLD;
+        return ERR_OK; // Wird sofort geladen und dabei überprüft
+    } else {
+        SDL_Log("Unbekannter Ressourcentyp %s fuer %s!\n", entry->job.type, entry->job.key);
+        return ERR_FAIL;
+    }
+    SDL_Log("Konfigurationsargumente für %s ungültig!\n", entry->job.key);
+    return ERR_FAIL;
+}
+
+static int SDLW_LoadEntry(sdlwEntry_t *entry) {
+    sdlwLoadJob_t *job = &entry->job;
+    sdlwResource_t *resource = &entry->resource;
+
+    // Daten aus dem Paket werden erst jetzt aus der Abbildung gelesen. Ein
+    // Ausschnitt einer Atlasseite benötigt keine eigenen Daten.
+    if (job->packIndex >= 0 && job->atlasPage == SDLW_INVALID_HANDLE && !job->decoded && !job->source &&
+        SDLW_OpenPackData(job))
+        return ERR_FAIL;
+
+    // Erstellen der verschiedenen Ressourcentypen, die dekodierten Daten
+    // werden dabei übernommen.
+    int errorCode = ERR_FAIL;
+    if (entry->kind & RESOURCETYPE_TEXTURE) // Textur
+        errorCode = SDLW_LoadTexture(job, resource);
+    else if (entry->kind & RESOURCETYPE_FONT) // Font
+        errorCode = SDLW_LoadFont(job, resource);
+    else if (entry->kind & (RESOURCETYPE_SOUND_EFFECT | RESOURCETYPE_SOUND_MUSIC))
+        errorCode = SDLW_LoadSound(job, resource);
+    else if (entry->kind & RESOURCETYPE_SPRITE)
+        errorCode = Sprite_Load(job->config, resource);
+    else if (entry->kind & RESOURCETYPE_WORLD)
+        errorCode = World_LoadConfig(job->config, resource);
+
+    if (errorCode) { // Fehlerüberprüfung
+        resource->resource.any = NULL;
+        return errorCode;
+    }
+
+    // Speicherbedarf zählen
+    entry->bytes = SDLW_EntryBytes(entry);
+    registry.usage += entry->bytes;
+    entry->lastUse = ++registry.useTick;
+    return ERR_OK;
+}
+
+static void SDLW_UnloadEntry(sdlwEntry_t *entry) {
+    SDL_Log("Entladen %s\n", entry->resource.key);
+    FreeSDLWResource(&entry->resource);
+    SDLW_FreeDecoded(&entry->job);
+    registry.usage -= entry->bytes;
+    entry->bytes = 0;
+}
+
+static void SDLW_EnforceBudget(sdlwEntry_t *keep) {
+    while (registry.usage > memoryBudget) {
+        // Am längsten unbenutzte, unreferenzierte Ressource suchen
+        sdlwEntry_t *oldest = NULL;
+        for (int i = 0; i < registry.count; ++i) {
+            sdlwEntry_t *entry = registry.entries[i];
+            if (entry == keep || entry->refCount || !entry->resource.resource.any || !(entry->kind & SDLW_EVICTABLE_TYPES))
+                continue;
+            if (entry->job.atlasPage != SDLW_INVALID_HANDLE) // Belegt keinen eigenen Speicher
+                continue;
+            if (!oldest || entry->lastUse < oldest->lastUse)
+                oldest = entry;
+        }
+        if (!oldest) // Alle verbleibenden Ressourcen werden verwendet
+            return;
+        SDLW_UnloadEntry(oldest);
+    }
+}
+
+static size_t SDLW_EntryBytes(sdlwEntry_t *entry) {
+    if (entry->job.atlasPage != SDLW_INVALID_HANDLE) // Gezählt bei der Atlasseite
+        return 0;
+    if (entry->kind & RESOURCETYPE_TEXTURE) { // Textur im Format RGBA, samt Kopie der Pixel
+        int w = 0, h = 0;
+        SDL_QueryTexture(entry->resource.resource.texture, NULL, NULL, &w, &h);
+        return (size_t)w * h * 4 * (entry->job.pixels ? 2 : 1);
+    }
+    if (entry->kind & RESOURCETYPE_SPRITE)
+        return sizeof(sprite_t);
+    if (entry->kind & RESOURCETYPE_WORLD)
+        return sizeof(worldConfig_t);
+
+    // Schriften und Sounds gemäss Grösse der Quelldaten
+    return SDLW_SourceBytes(&entry->job);
+}
+
+static size_t SDLW_SourceBytes(const sdlwLoadJob_t *job) {
+    if (job->packIndex >= 0)
+        return (size_t)pack.entries[job->packIndex].size;
+    if (!strcmp(job->type, "sprite")) // Ohne eigene Datei
+        return 0;
+    char fileName[64] = {0};
+    sscanf(job->config, "%*s %*s %63s", fileName);
+    FILE *file = fopen(fileName, "rb");
+    if (!file)
+        return 0;
+    long size = 0;
+    if (!fseek(file, 0, SEEK_END))
+        size = ftell(file);
+    fclose(file);
+    return size > 0 ? (size_t)size : 0;
+}
+
+static int SDLW_CreateResources(sdlwLoadQueue_t *queue) {
+    uint64_t phaseStart = Profiler_Begin();
+    int errorCode = ERR_OK;
+
+    // Einträge in Reihenfolge der Konfiguration erstellen. Sprites verweisen
+    // auf zuvor registrierte Texturen.
+    int i = 0;
+    for (; i < queue->count && !errorCode; ++i) {
+        sdlwLoadJob_t *job = &queue->jobs[i];
+        uint64_t start = Profiler_Begin();
+
+        sdlwEntry_t *entry = malloc(sizeof(sdlwEntry_t));
+        if (!entry) { // Allozierung überprüfen
+            SDL_Log("Ressource konnte nicht alloziert werden! SDLW_LoadRessource()!\n");
+            errorCode = ERR_MEMORY;
+            break;
+        }
+        memset(entry, 0, sizeof(sdlwEntry_t));
+        strcpy(entry->resource.key, job->key); // Setzen des Schlüssels der Ressource
+        entry->job = *job; // Dekodierte Daten gehören nun dem Eintrag
+        job->decoded = NULL;
+        job->source = NULL;
+
+        // Überprüfen und nur falls nötig oder bereits dekodiert erstellen
+        errorCode = SDLW_CheckEntry(entry);
+        if (!errorCode && (entry->kind & (RESOURCETYPE_SPRITE | RESOURCETYPE_WORLD) || entry->job.decoded ||
+                           entry->job.atlasPage != SDLW_INVALID_HANDLE))
+            errorCode = SDLW_LoadEntry(entry);
+
+        if (errorCode) { // Fehlerüberprüfung
+            SDLW_FreeDecoded(&entry->job);
+            free(entry);
+            break;
+        }
+
+        // Hinzufügen des Eintrags
+        if (SDLW_RegisterResource(entry)) {
+            registry.usage -= entry->bytes;
+            FreeSDLWResource(&entry->resource);
+            free(entry);
+            errorCode = ERR_MEMORY;
+            break;
+        }
+        SDLW_EnforceBudget(entry);
+        SDL_Log("%s %s als %s\n", entry->resource.resource.any ? "Geladen" : "Registriert", job->key, job->type);
+        if (Profiler_IsEnabled())
+            Profiler_Record("resource", job->key, job->type, (long long)SDLW_SourceBytes(&entry->job),
+                            entry->job.decodeMs, entry->job.decodeMs + Profiler_Elapsed(start));
+    }
+
+    // Abschluss, nicht verwendete dekodierte Daten befreien
+    for (; i < queue->count; ++i)
+        SDLW_FreeDecoded(&queue->jobs[i]);
+    free(queue->jobs);
+    queue->jobs = NULL;
+    Profiler_End(phaseStart, "load", "SDLW_CreateResources");
+    return errorCode;
+}
+
+static int SDLW_ParseConfig(char *resourceConfigLocation, sdlwLoadQueue_t *queue) {
+    // Öffnen der Konfigurationsdatei
+    FILE *file;
+    file = fopen(resourceConfigLocation, "r");
+
+    if (!file) { // Fehlerüberprüfungs
+        SDL_Log("Fehler beim öffnen des Dokuments %s! SDLW_LoadRessource()\n", resourceConfigLocation);
+        return ERR_PARAMETER;
+    }
+    SDLW_HashFile(&queue->sources, resourceConfigLocation);
+
+    char config[256] = {0};
+    char key[64] = {0};  // Die ID der zu ladenen Ressource
+    char type[32] = {0}; // Der Typ der zu ladenen Ressource
+
+    int line = 0;
+
+    while (fgets(config, 255, file)) { // Lesen der Konfigurationszeilen
+        line++;
+
+        int count = sscanf(config, "%63s %31s", key, type);
+        if (count == 0)
+            continue;
+        if (!strcmp(key, "#")) // Kommentar
+            continue;
+
+        if (count < 2) { // Zu wenig Argumente in der Konfigurationszeile
+            SDL_Log("Konfigurationszeile %d ungueltig! [%s]\n", line, resourceConfigLocation);
+            fclose(file);
+            return ERR_FAIL;
+        }
+
+        if (!strcmp(type, "config")) { // Weitere Konfigurationsdatei
+            int errorCode = SDLW_ParseConfig(key, queue);
+            if (errorCode) {
+                fclose(file);
+                return errorCode;
+            }
+            continue;
+        }
+
+        // Auftragsliste bei Bedarf vergrössern
+        if (queue->count == queue->capacity) {
+            int capacity = queue->capacity ? queue->capacity * 2 : 64;
+            sdlwLoadJob_t *jobs = malloc(sizeof(sdlwLoadJob_t) * capacity);
+            if (!jobs) {
+                SDL_Log("Auftragsliste konnte nicht alloziert werden! SDLW_LoadRessource()!\n");
+                fclose(file);
+                return ERR_MEMORY;
+            }
+            if (queue->jobs) {
+                memcpy(jobs, queue->jobs, sizeof(sdlwLoadJob_t) * queue->count);
+                free(queue->jobs);
+            }
+            queue->jobs = jobs;
+            queue->capacity = capacity;
+        }
+
+        sdlwLoadJob_t *job = &queue->jobs[queue->count++];
+        strcpy(job->config, config);
+        strcpy(job->key, key);
+        strcpy(job->type, type);
+        job->decoded = NULL;
+        job->source = NULL;
+        job->packIndex = -1;
+        job->preload = 0;
+        job->atlasPage = SDLW_INVALID_HANDLE;
+        job->region = (SDL_Rect){0};
+        job->decodeMs = 0.0;
+        job->pixels = NULL;
+    }
+    // Abschluss
+    fclose(file);
+    return ERR_OK;
+}
+
+static void SDLW_HashFile(uint64_t *hash, const char *fileLocation) {
+    int64_t meta[2] = {-1, -1};
+    struct stat info;
+    if (!stat(fileLocation, &info)) {
+        meta[0] = (int64_t)info.st_mtime;
+        meta[1] = (int64_t)info.st_size;
+    }
+    // Pfad samt Nullterminator, danach Änderungszeit und Grösse
+    const unsigned char *parts[2] = {(const unsigned char *)fileLocation, (const unsigned char *)meta};
+    size_t sizes[2] = {strlen(fileLocation) + 1, sizeof(meta)};
+    for (int p = 0; p < 2; ++p) {
+        for (size_t i = 0; i < sizes[p]; ++i) {
+            *hash ^= parts[p][i];
+            *hash *= 1099511628211ull;
+        }
+    }
+}
+
+static void SDLW_MarkPreload(sdlwLoadQueue_t *queue) {
+    for (int i = 0; i < queue->count; ++i) {
+        if (SDLW_IsAtlasJob(&queue->jobs[i])) // Wird für den Atlas benötigt
+            queue->jobs[i].preload = 1;
+        if (strcmp(queue->jobs[i].type, "sprite"))
+            continue;
+        char textureKey[32] = {0};
+        if (sscanf(queue->jobs[i].config, "%*s %*s %31s", textureKey) != 1)
+            continue;
+        // Neuste zuvor konfigurierte Textur mit diesem Schlüssel
+        for (int j = i - 1; j >= 0; --j) {
+            if (!strcmp(queue->jobs[j].key, textureKey)) {
+                queue->jobs[j].preload = 1;
+                break;
+            }
+        }
+    }
+}
+
+static int SDLW_IsAtlasJob(const sdlwLoadJob_t *job) {
+    char mode[16] = {0};
+    char extra[8] = {0};
+    if (strcmp(job->type, "texture"))
         return 0;
-    if (!strcmp(resource->key, searchKey))
-        return 1;
+    return sscanf(job->config, "%*s %*s %*s %15s %7s", mode, extra) == 1 && !strcmp(mode, "atlas");
+}
+
+static int SDLW_BuildAtlas(sdlwLoadQueue_t *queue) {
+    uint64_t start = Profiler_Begin();
+    int count = 0;
+    for (int i = 0; i < queue->count; ++i)
+        count += SDLW_IsAtlasJob(&queue->jobs[i]);
+    if (!count)
+        return ERR_OK;
+
+    atlasItem_t *items = malloc(sizeof(atlasItem_t) * count);
+    sdlwLoadJob_t **jobs = malloc(sizeof(sdlwLoadJob_t *) * count);
+    if (!items || !jobs) {
+        SDL_Log("Memory Error! SDLW_BuildAtlas()\n");
+        free(items);
+        free(jobs);
+        return ERR_MEMORY;
+    }
+
+    // Dekodierte Bilder sammeln, aus einem Paket werden sie erst jetzt gelesen
+    int itemCount = 0;
+    for (int i = 0; i < queue->count; ++i) {
+        sdlwLoadJob_t *job = &queue->jobs[i];
+        if (!SDLW_IsAtlasJob(job))
+            continue;
+        if (!job->decoded && job->packIndex >= 0)
+            SDLW_OpenPackData(job);
+        SDL_Surface *surface = job->decoded;
+        if (!surface) // Fehler wird beim Erstellen der Ressource gemeldet
+            continue;
+        jobs[itemCount] = job;
+        items[itemCount] = (atlasItem_t){.w = surface->w, .h = surface->h};
+        itemCount++;
+    }
+
+    // Platzieren und Seiten erstellen
+    int pageCount = 0;
+    int errorCode = Atlas_Pack(items, itemCount, SDLW_ATLAS_PAGE_SIZE, SDLW_ATLAS_PADDING, &pageCount);
+    for (int page = 0; page < pageCount && !errorCode; ++page)
+        errorCode = SDLW_CreateAtlasPage(items, jobs, itemCount, page);
+    free(items);
+    free(jobs);
+    Profiler_End(start, "load", "SDLW_BuildAtlas");
+    return errorCode;
+}
+
+static int SDLW_CreateAtlasPage(const atlasItem_t *items, sdlwLoadJob_t **jobs, int count, int page) {
+    // Die Seite ist nur so hoch wie nötig
+    int height = Atlas_PageHeight(items, count, page, SDLW_ATLAS_PADDING);
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, SDLW_ATLAS_PAGE_SIZE, height, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) { // Ohne Seite bleiben die Bilder eigenständige Texturen
+        SDL_Log("Atlasseite konnte nicht erstellt werden! [%s]\n", SDL_GetError());
+        return ERR_OK;
+    }
+
+    // Pixel samt Alphakanal unverändert auf die Seite kopieren
+    for (int i = 0; i < count; ++i) {
+        if (items[i].page != page)
+            continue;
+        SDL_Rect destination = items[i].rect;
+        SDL_SetSurfaceBlendMode(jobs[i]->decoded, SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(jobs[i]->decoded, NULL, surface, &destination);
+    }
+
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+    if (!texture) {
+        SDL_Log("SDL_CreateTextureFromSurface error! [%s]\n", SDL_GetError());
+        return ERR_OK;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    // Seite als eigene Textur registrieren
+    sdlwEntry_t *entry = malloc(sizeof(sdlwEntry_t));
+    if (!entry) {
+        SDL_DestroyTexture(texture);
+        return ERR_MEMORY;
+    }
+    memset(entry, 0, sizeof(sdlwEntry_t));
+    sprintf(entry->resource.key, "@atlas%d", registry.count);
+    entry->job.packIndex = -1;
+    entry->job.atlasPage = SDLW_INVALID_HANDLE;
+    entry->kind = RESOURCETYPE_TEXTURE;
+    entry->resource.type = RESOURCETYPE_TEXTURE_N;
+    entry->resource.resource.texture = texture;
+    if (SDLW_RegisterResource(entry)) {
+        SDL_DestroyTexture(texture);
+        free(entry);
+        return ERR_MEMORY;
+    }
+    sdlwHandle_t handle = registry.count - 1;
+    entry->bytes = SDLW_EntryBytes(entry);
+    registry.usage += entry->bytes;
+    entry->lastUse = ++registry.useTick;
+
+    // Bilder verweisen nun auf die Seite, jedes hält eine Referenz
+    for (int i = 0; i < count; ++i) {
+        if (items[i].page != page)
+            continue;
+        jobs[i]->atlasPage = handle;
+        jobs[i]->region = items[i].rect;
+        SDL_FreeSurface(jobs[i]->decoded);
+        jobs[i]->decoded = NULL;
+        entry->refCount++;
+    }
+    SDL_Log("Atlasseite %s mit %dx%d Pixel erstellt\n", entry->resource.key, SDLW_ATLAS_PAGE_SIZE, height);
+    return ERR_OK;
+}
+
+static void SDLW_DecodeJobs(sdlwLoadQueue_t *queue) {
+    SDL_AtomicSet(&queue->next, 0);
+    // Anzahl Worker gemäss Prozessorkernen, der Hauptthread arbeitet mit
+    int threadCount = SDL_GetCPUCount() - 1;
+    if (threadCount > SDLW_MAX_LOADER_THREADS)
+        threadCount = SDLW_MAX_LOADER_THREADS;
+    if (threadCount > queue->count - 1)
+        threadCount = queue->count - 1;
+
+    SDL_Thread *threads[SDLW_MAX_LOADER_THREADS];
+    int started = 0;
+    for (; started < threadCount; ++started) {
+        threads[started] = SDL_CreateThread(SDLW_DecodeWorker, "SDLW_Loader", queue);
+        if (!threads[started]) // Ohne Thread dekodiert der Hauptthread den Rest
+            break;
+    }
+    SDLW_DecodeWorker(queue);
+    for (int i = 0; i < started; ++i)
+        SDL_WaitThread(threads[i], NULL);
+}
+
+static int SDLCALL SDLW_DecodeWorker(void *data) {
+    sdlwLoadQueue_t *queue = (sdlwLoadQueue_t *)data;
+    int i;
+    while ((i = SDL_AtomicAdd(&queue->next, 1)) < queue->count)
+        SDLW_DecodeJob(&queue->jobs[i]);
     return 0;
 }
 
-static int SDLW_LoadTexture(char *config, sdlwResource_t *resource) {
+static void SDLW_DecodeJob(sdlwLoadJob_t *job) {
+    uint64_t start = Profiler_Begin();
+    char key[32] = {0};
+    char type[32] = {0};
+    char fileName[64] = {0};
+    char soundType[8] = {0};
+
+    int count = sscanf(job->config, "%31s %31s %63s %7s", key, type, fileName, soundType);
+    if (count < 3)
+        return; // Fehler wird beim Erstellen der Ressource gemeldet
+
+    if (!strcmp(job->type, "texture") && job->preload) // Bild in eine Surface dekodieren
+        job->decoded = IMG_Load(fileName);
+    else if (!strcmp(job->type, "sound") && count == 4 && !strcmp(soundType, "effect"))
+        job->decoded = Mix_LoadWAV(fileName);
+    job->decodeMs = Profiler_Elapsed(start);
+}
+
+static void SDLW_FreeDecoded(sdlwLoadJob_t *job) {
+    if (job->pixels)
+        SDL_FreeSurface(job->pixels);
+    job->pixels = NULL;
+    if (job->source)
+        SDL_RWclose(job->source);
+    job->source = NULL;
+    if (!job->decoded)
+        return;
+    if (!strcmp(job->type, "texture"))
+        SDL_FreeSurface(job->decoded);
+    else
+        Mix_FreeChunk(job->decoded);
+    job->decoded = NULL;
+}
+
+static int SDLW_QueuePack(sdlwLoadQueue_t *queue) {
+    int count = pack.header->entryCount;
+    queue->jobs = malloc(sizeof(sdlwLoadJob_t) * (count ? count : 1));
+    if (!queue->jobs) {
+        SDL_Log("Auftragsliste konnte nicht alloziert werden! SDLW_LoadPack()!\n");
+        return ERR_MEMORY;
+    }
+    queue->capacity = count;
+
+    for (int i = 0; i < count; ++i) {
+        const assetPackEntry_t *entry = &pack.entries[i];
+        sdlwLoadJob_t *job = &queue->jobs[queue->count++];
+        strcpy(job->config, entry->config);
+        strcpy(job->key, entry->key);
+        strcpy(job->type, entry->type);
+        job->decoded = NULL;
+        job->source = NULL;
+        job->packIndex = i;
+        job->preload = 0;
+        job->atlasPage = SDLW_INVALID_HANDLE;
+        job->region = (SDL_Rect){0};
+        job->decodeMs = 0.0;
+        job->pixels = NULL;
+    }
+    return ERR_OK;
+}
+
+static int SDLW_OpenPackData(sdlwLoadJob_t *job) {
+    const assetPackEntry_t *entry = &pack.entries[job->packIndex];
+
+    // Die Abbildung ist schreibgeschützt, SDL liest die Daten aber nur
+    void *data = (void *)AssetPack_GetData(&pack, job->packIndex);
+    switch (entry->dataType) {
+    case ASSETPACK_DATA_PIXELS:
+        job->decoded = SDL_CreateRGBSurfaceWithFormatFrom(data, entry->width, entry->height, 32, entry->pitch, SDL_PIXELFORMAT_RGBA32);
+        break;
+    case ASSETPACK_DATA_SAMPLES:
+        job->decoded = Mix_QuickLoad_RAW(data, (Uint32)entry->size);
+        break;
+    case ASSETPACK_DATA_FILE:
+        job->source = SDL_RWFromConstMem(data, (int)entry->size);
+        break;
+    default:
+        return ERR_OK;
+    }
+    if (!job->decoded && !job->source) { // Fehlerüberprüfung
+        SDL_Log("Paketeintrag %s konnte nicht geladen werden! [%s]\n", job->key, SDL_GetError());
+        return ERR_FAIL;
+    }
+    return ERR_OK;
+}
+
+static int SDLW_PackJob(assetPackWriter_t *writer, sdlwLoadJob_t *job) {
+    char key[32] = {0};
+    char type[32] = {0};
+    char fileName[64] = {0};
+    char soundType[8] = {0};
+
+    assetPackEntry_t entry = {0};
+    strcpy(entry.config, job->config);
+    strcpy(entry.key, job->key);
+    strcpy(entry.type, job->type);
+    entry.dataType = ASSETPACK_DATA_NONE;
+
+    // Sprites, Welten und fehlerhafte Zeilen werden beim Laden geprüft
+    int count = sscanf(job->config, "%31s %31s %63s %7s", key, type, fileName, soundType);
+    int isTexture = !strcmp(job->type, "texture");
+    int isSound = !strcmp(job->type, "sound");
+    if (count < 3 || (!isTexture && !isSound && strcmp(job->type, "font")))
+        return AssetPack_WriteEntry(writer, &entry, NULL, 0);
+
+    if (isTexture) { // Bild vorab in RGBA32 Pixel dekodieren
+        SDL_Surface *image = IMG_Load(fileName);
+        SDL_Surface *surface = image ? SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_RGBA32, 0) : NULL;
+        if (image)
+            SDL_FreeSurface(image);
+        if (!surface) {
+            SDL_Log("IMG_Load error! [%s]\n", IMG_GetError());
+            return ERR_FAIL;
+        }
+        entry.dataType = ASSETPACK_DATA_PIXELS;
+        entry.width = surface->w;
+        entry.height = surface->h;
+        entry.pitch = surface->pitch;
+        int errorCode = AssetPack_WriteEntry(writer, &entry, surface->pixels, (uint64_t)surface->pitch * surface->h);
+        SDL_FreeSurface(surface);
+        return errorCode;
+    }
+
+    if (isSound && count == 4 && !strcmp(soundType, "effect")) {
+        // WAV vorab in das Audioformat von SDLW_Init() umwandeln
+        SDL_AudioSpec spec;
+        Uint8 *buffer = NULL;
+        Uint32 length = 0;
+        if (SDL_LoadWAV(fileName, &spec, &buffer, &length)) {
+            SDL_AudioCVT cvt;
+            int errorCode = ERR_FAIL;
+            if (SDL_BuildAudioCVT(&cvt, spec.format, spec.channels, spec.freq, MIX_DEFAULT_FORMAT, MIX_DEFAULT_CHANNELS, MIX_DEFAULT_FREQUENCY) >= 0) {
+                cvt.len = length;
+                cvt.buf = malloc((size_t)length * cvt.len_mult);
+                if (cvt.buf) {
+                    memcpy(cvt.buf, buffer, length);
+                    if (!SDL_ConvertAudio(&cvt)) {
+                        entry.dataType = ASSETPACK_DATA_SAMPLES;
+                        errorCode = AssetPack_WriteEntry(writer, &entry, cvt.buf, cvt.len_cvt);
+                    }
+                    free(cvt.buf);
+                }
+            }
+            SDL_FreeWAV(buffer);
+            return errorCode;
+        }
+        // Kein WAV, der Dateiinhalt wird beim Laden dekodiert
+    }
+
+    // Schriften, Musik und andere Formate unverändert übernehmen
+    size_t size = 0;
+    void *data = SDL_LoadFile(fileName, &size);
+    if (!data) {
+        SDL_Log("Datei %s konnte nicht gelesen werden! [%s]\n", fileName, SDL_GetError());
+        return ERR_FAIL;
+    }
+    entry.dataType = ASSETPACK_DATA_FILE;
+    int errorCode = AssetPack_WriteEntry(writer, &entry, data, size);
+    SDL_free(data);
+    return errorCode;
+}
+
+static int SDLW_LoadTexture(sdlwLoadJob_t *job, sdlwResource_t *resource) {
+    if (job->atlasPage != SDLW_INVALID_HANDLE) { // Ausschnitt einer Atlasseite
+        resource->type = RESOURCETYPE_TEXTURE_N;
+        resource->resource.texture = registry.entries[job->atlasPage]->resource.resource.texture;
+        return ERR_OK;
+    }
+
+    SDL_Surface *surface = job->decoded;
+    job->decoded = NULL;
+    char *config = job->config;
     char key[32] = {0};
     char type[32] = {0};
     char fileName[64] = {0};
@@ -514,31 +1843,59 @@ static int SDLW_LoadTexture(char *config, sdlwResource_t *resource) {
     int count = sscanf(config, "%31s %31s %63s %15s %7s", key, type, fileName, mode, modeType);
     if (count < 3) {
         SDL_Log("Pfad nicht angegeben %s! static SDLW_LoadTexture()\n", key);
+        if (surface)
+            SDL_FreeSurface(surface);
         return ERR_FAIL;
     }
 
+    if (!surface) { // Nicht vorab dekodiert, Fehlermeldung hier erzeugen
+        surface = IMG_Load(fileName);
+        if (!surface) { // Fehlerüberprüfung
+            SDL_Log("IMG_Load error! [%s]\n", IMG_GetError());
+            return ERR_FAIL;
+        }
+    }
+
+    // Nur das Hochladen der Textur benötigt den Renderer
     resource->type = RESOURCETYPE_TEXTURE_N;
-    resource->resource.texture = IMG_LoadTexture(renderer, fileName);
+    resource->resource.texture = SDL_CreateTextureFromSurface(renderer, surface);
+    // Masken und Stempel behalten eine Kopie der Pixel für SDLW_GetTexturePixels()
+    SDL_Surface *pixels = NULL;
+    if (resource->resource.texture && count == 5)
+        pixels = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA8888, 0);
+    SDL_FreeSurface(surface);
     if (!resource->resource.texture) { // Fehlerüberprüfung
-        SDL_Log("IMG_LoadTexture error! [%s]\n", IMG_GetError());
+        SDL_Log("SDL_CreateTextureFromSurface error! [%s]\n", SDL_GetError());
         return ERR_FAIL;
     }
 
-    if (count == 4) { // Entweder 3 oder 5 Argumente, 4 sind nicht zlässig
-        return ERR_FAIL;
+    if (count == 4) { // 4 Argumente nur für Atlas-Texturen, diese passen auf keine Seite
+        if (strcmp(mode, "atlas")) {
+            SDL_DestroyTexture(resource->resource.texture);
+            return ERR_FAIL;
+        }
+        return ERR_OK;
     }
 
     if (count == 5) {                    // Textur als stamp oder mask laden
         if (strcmp(mode, "blendmode")) { // Konfigurationsfehlerüberprüfung
             SDL_Log("Rendermodus für %s ungültig! [%s]\n", key, mode);
+            SDL_FreeSurface(pixels);
             SDL_DestroyTexture(resource->resource.texture);
             return ERR_FAIL;
         }
         if (strcmp(modeType, "stamp") && strcmp(modeType, "mask")) { // Konfigurationsfehlerüberprüfung
             SDL_Log("Rendermodustyp für %s ungültig! [%s]\n", key, modeType);
+            SDL_FreeSurface(pixels);
+            SDL_DestroyTexture(resource->resource.texture);
+            return ERR_FAIL;
+        }
+        if (!pixels) { // Fehlerüberprüfung
+            SDL_Log("SDL_ConvertSurfaceFormat error! [%s]\n", SDL_GetError());
             SDL_DestroyTexture(resource->resource.texture);
             return ERR_FAIL;
         }
+        job->pixels = pixels;
         SDL_BlendMode blendMode;
         if (!strcmp(modeType, "stamp")) {
             resource->type = RESOURCETYPE_TEXTURE_BM_STAMP;
@@ -557,7 +1914,10 @@ static int SDLW_LoadTexture(char *config, sdlwResource_t *resource) {
     return ERR_OK;
 }
 
-static int SDLW_LoadFont(char *config, sdlwResource_t *resource) {
+static int SDLW_LoadFont(sdlwLoadJob_t *job, sdlwResource_t *resource) {
+    SDL_RWops *source = job->source;
+    job->source = NULL;
+    char *config = job->config;
     char key[32] = {0};
     char type[32] = {0};
     char fileName[64] = {0};
@@ -568,23 +1928,35 @@ static int SDLW_LoadFont(char *config, sdlwResource_t *resource) {
 
     if (count != 4) { // Konfigurationsfehlerüberprüfung
         SDL_Log("Konfigurationsargumente für %s ungültig!\n", key);
+        if (source)
+            SDL_RWclose(source);
         return ERR_FAIL;
     }
 
     if (size < 5 || size > 200) { // Bounds für Schriftgrösse überprüfen
         SDL_Log("Schriftgrösse für %s zu gross oder zu klein! [%d]\n", key, size);
+        if (source)
+            SDL_RWclose(source);
         return ERR_FAIL;
     }
 
     resource->type = RESOURCETYPE_FONT;
-    resource->resource.font = TTF_OpenFont(fileName, size);
+    if (source) // Schrift aus einem Paket
+        resource->resource.font = TTF_OpenFontRW(source, 1, size);
+    else
+        resource->resource.font = TTF_OpenFont(fileName, size);
     if (resource->resource.font)
         return ERR_OK;
     SDL_Log("TTF_OpenFont error! [%s]\n", TTF_GetError());
     return ERR_FAIL;
 }
 
-static int SDLW_LoadSound(char *config, sdlwResource_t *resource) {
+static int SDLW_LoadSound(sdlwLoadJob_t *job, sdlwResource_t *resource) {
+    Mix_Chunk *chunk = job->decoded;
+    SDL_RWops *source = job->source;
+    job->decoded = NULL;
+    job->source = NULL;
+    char *config = job->config;
     char key[32] = {0};
     char type[32] = {0};
     char fileName[64] = {0};
@@ -594,11 +1966,17 @@ static int SDLW_LoadSound(char *config, sdlwResource_t *resource) {
 
     if (count != 4) { // Konfigurationsfehlerüberprüfung
         SDL_Log("Konfigurationsargumente für %s ungültig!\n", key);
+        if (chunk)
+            Mix_FreeChunk(chunk);
+        if (source)
+            SDL_RWclose(source);
         return ERR_FAIL;
     }
 
     if (strcmp(soundType, "effect") && strcmp(soundType, "music")) { // Bounds für Schriftgrösse überprüfen
         SDL_Log("Typ für %s ungueltig! [%s]\n", key, soundType);
+        if (source)
+            SDL_RWclose(source);
         return ERR_FAIL;
     }
 
@@ -606,14 +1984,22 @@ static int SDLW_LoadSound(char *config, sdlwResource_t *resource) {
 
     if (isMusic) { // Laden von Hintergrundmusik
         resource->type = RESOURCETYPE_SOUND_MUSIC;
-        resource->resource.bgMusic = Mix_LoadMUS(fileName);
+        if (source) // Musik aus einem Paket, wird beim Befreien geschlossen
+            resource->resource.bgMusic = Mix_LoadMUS_RW(source, 1);
+        else
+            resource->resource.bgMusic = Mix_LoadMUS(fileName);
         if (resource->resource.bgMusic)
             return ERR_OK;
         else
             SDL_Log("[%s] konnte nicht geladen werden!\n", key);
     } else { // Laden von Soundeffekten
         resource->type = RESOURCETYPE_SOUND_EFFECT;
-        resource->resource.soundEffect = Mix_LoadWAV(fileName);
+        if (chunk)
+            resource->resource.soundEffect = chunk;
+        else if (source)
+            resource->resource.soundEffect = Mix_LoadWAV_RW(source, 1);
+        else
+            resource->resource.soundEffect = Mix_LoadWAV(fileName);
         if (resource->resource.soundEffect)
             return ERR_OK;
         else
@@ -625,7 +2011,9 @@ static int SDLW_LoadSound(char *config, sdlwResource_t *resource) {
 }
 
 static int FreeSDLWResource(sdlwResource_t *resource) {
-    if (resource->type & RESOURCETYPE_TEXTURE) { // Zerstörte Textur
+    if (!resource->resource.any) { // Nicht geladen
+        return ERR_OK;
+    } else if (resource->type & RESOURCETYPE_TEXTURE) { // Zerstörte Textur
         SDL_DestroyTexture(resource->resource.texture);
     } else if (resource->type & RESOURCETYPE_FONT) { // Zerstöre Schriftwart
         TTF_CloseFont(resource->resource.font);
@@ -638,6 +2026,6 @@ static int FreeSDLWResource(sdlwResource_t *resource) {
     } else if (resource->type & RESOURCETYPE_WORLD) { // Zerstöre Welt
         free(resource->resource.world);
     }
-    free(resource); // Ressourcenunion zerstören
+    resource->resource.any = NULL;
     return ERR_OK;
 }
@@ -84,8 +84,8 @@ int Sprite_Load(char *config, struct sdlwResource_s *spriteResource) {
         return ERR_FAIL;
     }
 
-    // Laden der angegebenen Textur
-    SDLW_GetTexture(textureKey, &loadedSprite->texture);
+    // Laden der angegebenen Textur, bei Atlas-Texturen nur ein Ausschnitt
+    SDLW_GetTextureRegion(textureKey, &loadedSprite->texture, &loadedSprite->region);
     if (!loadedSprite->texture) { 
         SDL_Log("Textur mit Schluessel [%s] existiert nicht! Sprite_Load()\n", textureKey);
         free(loadedSprite);
@@ -94,10 +94,9 @@ int Sprite_Load(char *config, struct sdlwResource_s *spriteResource) {
 
     if (count == 10 && !strcmp(spriteType, "size")) { // Sprite mit destination grösse
         //Source des Sprites definieren
-        int w, h;
-        SDL_QueryTexture(loadedSprite->texture, NULL, NULL, &w, &h);
-        loadedSprite->source.w = w;
-        loadedSprite->source.h = h;
+        int w = loadedSprite->region.w;
+        int h = loadedSprite->region.h;
+        loadedSprite->source = loadedSprite->region;
         // Destination des Sprites definieren
         loadedSprite->destination.x = sizeXorDestX;
         loadedSprite->destination.y = sizeYorDestY;
@@ -118,10 +117,9 @@ int Sprite_Load(char *config, struct sdlwResource_s *spriteResource) {
 
     if (count == 3) { // Laden einer normalen Textur
         // Setzen der standard Breite und Höhe
-        int w, h;
-        SDL_QueryTexture(loadedSprite->texture, NULL, NULL, &w, &h);
-        loadedSprite->source.w = w;
-        loadedSprite->source.h = h;
+        int w = loadedSprite->region.w;
+        int h = loadedSprite->region.h;
+        loadedSprite->source = loadedSprite->region;
         // Definieren des destination
         loadedSprite->destination.w = w;
         loadedSprite->destination.h = h;
@@ -162,6 +160,7 @@ int Sprite_CreateText(char *text, char *font, SDL_Color color, sprite_t *sprite)
     int w, h;
     SDL_QueryTexture(sprite->texture, NULL, NULL, &w, &h);
     sprite->source = (SDL_Rect){0, 0, w, h};
+    sprite->region = sprite->source;
     sprite->destination.w = w;
     sprite->destination.h = h;
 
@@ -212,11 +211,17 @@ int Sprite_SetFrame(sprite_t *sprite, int index) {
         return ERR_PARAMETER;
     }
 
+    // Bereich der Subsprites, ohne Angabe die ganze Textur
+    SDL_Rect region = sprite->region;
+    if (region.w <= 0 || region.h <= 0) {
+        region.x = 0;
+        region.y = 0;
+        SDL_QueryTexture(sprite->texture, NULL, NULL, &region.w, &region.h);
+    }
+
     // Bestimmung der Breite und Höhe eines einzelnen Segments
-    int w, h;
-    SDL_QueryTexture(sprite->texture, NULL, NULL, &w, &h);
-    w /= sprite->multiSpriteSize.x;
-    h /= sprite->multiSpriteSize.y;
+    int w = region.w / sprite->multiSpriteSize.x;
+    int h = region.h / sprite->multiSpriteSize.y;
 
     // Bestimmung der x- und y-Position anhand des Index;
     int x, y;
@@ -224,8 +229,8 @@ int Sprite_SetFrame(sprite_t *sprite, int index) {
     y = index / sprite->multiSpriteSize.x;
 
     // Setzen der berechneten Daten
-    sprite->source.x = x * w;
-    sprite->source.y = y * h;
+    sprite->source.x = region.x + x * w;
+    sprite->source.y = region.y + y * h;
     sprite->source.w = w;
     sprite->source.h = h;
     sprite->multiSpriteIndex = index;
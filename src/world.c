@@ -15,10 +15,14 @@
  *
  */
 
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 
 #include "world.h"
+#include "worldKernel.h"
 #include "error.h"
 #include "sdlWrapper.h"
 #include "entity.h"
@@ -26,39 +30,540 @@
 
 /*
  * Typdeklarationen
- * 
+ *
+ */
+
+#define WORLD_WORD_BITS 64                                    //!< Anzahl Pixel pro Wort des Kollisionsrasters
+#define WORLD_CHUNK_SIZE 128                                  //!< Breite und Höhe eines Abschnitts in Pixel, Vielfaches von WORLD_WORD_BITS
+#define WORLD_CHUNK_WORDS (WORLD_CHUNK_SIZE / WORLD_WORD_BITS) //!< Wörter pro Zeile oder Spalte eines Abschnitts
+#define WORLD_DISTANCE_RANGE 32                               //!< Grösster Abstand zur Oberfläche im Distanzfeld in Pixel
+#define WORLD_DISTANCE_SCALE 16                               //!< Einheiten des Distanzfeldes pro Pixel
+#define WORLD_DISTANCE_GRADIENT 3                             //!< Abstand der Stützstellen für die Normale in Pixel
+#define WORLD_MIN_QUEUED 8                                    //!< Anzahl Modifikationen der ersten Allozierung der Warteschlange
+#define WORLD_MAX_SETTLE_THREADS 4                            //!< Maximale Anzahl Worker für das Absetzen von losem Gelände
+#define WORLD_SETTLE_THREAD_CHUNKS 4                          //!< Ab so vielen wachen Abschnitten werden Worker gestartet
+#define WORLD_CHUNK_PIXELS (WORLD_CHUNK_SIZE * WORLD_CHUNK_SIZE) //!< Anzahl Pixel eines Abschnitts
+#define WORLD_MIN_SNAPSHOT 256                                //!< Bytes der ersten Allozierung eines Schnappschusses
+#define WORLD_RUN_SAME 0                                      //!< Lauf von Pixeln wie beim Laden
+#define WORLD_RUN_FREE 1                                      //!< Lauf von ausgeschnittenen Pixeln, Farbe wie beim Laden
+#define WORLD_RUN_LITERAL 2                                   //!< Lauf von neuen Pixeln, die Pixel folgen dem Lauf
+#define WORLD_RUN_TYPE_SHIFT 14                               //!< Position der Art im Kopf eines Laufs, darunter Länge - 1
+#define WORLD_PRISTINE_FREE 0                                 //!< Lauf von freien Pixeln im geladenen Zustand
+#define WORLD_PRISTINE_FILL 1                                 //!< Lauf von gleichen Pixeln, ein Pixel folgt dem Lauf
+#define WORLD_PRISTINE_LITERAL 2                              //!< Lauf von verschiedenen Pixeln, die Pixel folgen dem Lauf
+
+/**
+ * @brief Ein quadratischer Abschnitt des Vordergrunds
+ *
+ * Alle Puffer liegen in einem Block, der erst angelegt wird, wenn im
+ * Abschnitt Gelände vorhanden ist. Koordinaten sind relativ zur linken oberen
+ * Ecke des Abschnitts.
+ */
+typedef struct {
+    uint32_t *pixels;     //!< Pixel im Format RGBA8888, massgebend für Textur und Kollision, NULL solange der Abschnitt leer ist
+    uint64_t *rows;       //!< Kollisionsraster zeilenweise, ein Bit pro Pixel
+    uint64_t *columns;    //!< Kollisionsraster spaltenweise für die vertikale Suche
+    int32_t *integral;    //!< Summentabelle des Kollisionsrasters, (WORLD_CHUNK_SIZE + 1)^2 Einträge
+    SDL_Texture *texture; //!< Textur des Abschnitts
+    SDL_Rect dirty;       //!< Veränderter Bereich, der noch nicht übernommen wurde, leer wenn w = 0
+    uint8_t settling;     //!< Loses Gelände im Abschnitt kann noch fallen
+    uint8_t moved;        //!< Im laufenden Schritt sind Pixel des Abschnitts gefallen
+    uint8_t fed;          //!< Im laufenden Schritt sind Pixel von oben in den Abschnitt gefallen
+    uint8_t lostTop;      //!< Im laufenden Schritt hat die oberste Zeile Pixel verloren
+    uint8_t touched;      //!< Pixel können vom geladenen Zustand abweichen
+    uint8_t *pristine;    //!< Pixel beim Laden der Welt als Läufe wie im Schnappschuss, NULL falls der Abschnitt leer geladen wurde
+    int16_t *distance;    //!< Vorzeichenbehaftetes Distanzfeld zeilenweise in 1/WORLD_DISTANCE_SCALE Pixel, NULL solange kein Gelände in Reichweite angelegt ist
+} worldChunk_t;
+
+/**
+ * @brief Kopf eines Schnappschusses
+ *
+ * Danach folgen die veränderten Abschnitte, je ein \ref worldSnapshotChunk_t
+ * und dessen Läufe. Ein Lauf beginnt mit einem uint16_t, oben die Art und
+ * darunter die Länge - 1. Neue Pixel folgen dem Lauf im Format RGBA8888.
+ */
+typedef struct {
+    char key[32];   //!< ID der Welt
+    int32_t width;  //!< Breite der Welt
+    int32_t height; //!< Höhe der Welt
+} worldSnapshotHeader_t;
+
+/**
+ * @brief Eintrag eines veränderten Abschnitts im Schnappschuss
+ *
+ */
+typedef struct {
+    int32_t index; //!< Index des Abschnitts, aufsteigend
+    int32_t size;  //!< Bytes der folgenden Läufe
+} worldSnapshotChunk_t;
+
+/**
+ * @brief Ein Durchgang des Absetzens über jedes zweite Band von Abschnitten
+ *
+ * Ein Band ist eine Zeile von Abschnitten. Pixel fallen höchstens in die
+ * oberste Zeile des nächsten Bandes, Bänder derselben Parität berühren sich
+ * daher nie und können gleichzeitig simuliert werden.
+ */
+typedef struct {
+    int parity;        //!< 0 für gerade, 1 für ungerade Bänder
+    int count;         //!< Anzahl Bänder dieser Parität
+    SDL_atomic_t next; //!< Nächstes zu simulierendes Band der Worker
+} worldSettlePass_t;
+
+/**
+ * @brief Eine Modifikation in der Warteschlange von \ref World_QueueModify()
+ *
  */
+typedef struct {
+    sprite_t sprite; //!< Maske oder Stempel
+    SDL_Rect bounds; //!< Betroffener Bereich in der Welt, nach dem Anwenden gesetzt
+} worldModification_t;
 
-/* ... */
+/**
+ * @brief Abbildung von Weltkoordinaten auf die Textur einer Modifikation
+ *
+ */
+typedef struct {
+    int destX;        //!< Linke Kante des Zielrechtecks
+    int destY;        //!< Obere Kante des Zielrechtecks
+    int destW;        //!< Breite des Zielrechtecks
+    int destH;        //!< Höhe des Zielrechtecks
+    double pivotX;    //!< Drehpunkt in Weltkoordinaten
+    double pivotY;    //!< Drehpunkt in Weltkoordinaten
+    double cosAngle;  //!< Cosinus der Rotation
+    double sinAngle;  //!< Sinus der Rotation
+    SDL_Rect source;  //!< Ausschnitt der Textur
+} worldTransform_t;
 
 
 /*
  * Variablendeklarationen
- * 
+ *
  */
 
-static const int width = 1024; //!< Die Höhe der Welt
-static const int height = 576; //!< Die Breite der Welt
+static int width = 0;                 //!< Die Breite der geladenen Welt
+static int height = 0;                //!< Die Höhe der geladenen Welt
+static int chunksX = 0;               //!< Anzahl Abschnitte pro Zeile
+static int chunksY = 0;               //!< Anzahl Abschnitte pro Spalte
 
 static int init = 0;                  //!< Ist dieses Modul initialisiert
 static int loaded = 0;                //!< Ist eine Welt geladen
-static unsigned char *worldCollision; //!< Array mit Informationen zum Vordergrund
-static sprite_t foreground = {0};     //!< Der Vordergrundsprite, kann darauf gezeichnet werden
+static worldChunk_t *chunks;          //!< Abschnitte des Vordergrunds zeilenweise, chunksX * chunksY Einträge
+static int32_t integralDelta[WORLD_CHUNK_SIZE + 1]; //!< Änderung einer Zeile der Summentabelle
+static SDL_Rect viewport = {0};       //!< Sichtbarer Ausschnitt der Welt, so gross wie der Renderer
 static sprite_t background = {0};     //!< Der Hintergrundsprite
+static worldConfig_t *loadedConfig;   //!< Konfiguration der geladenen Welt, hält eine Referenz auf den Hintergrund
+static struct {
+    worldModification_t *modifications; //!< Modifikationen in Reihenfolge
+    int count;                          //!< Anzahl Modifikationen
+    int capacity;                       //!< Platz für so viele Modifikationen
+} queue;                              //!< Warteschlange der Modifikationen bis \ref World_ApplyModifications()
+static int settle = 0;                //!< Ist das Absetzen von losem Gelände eingeschaltet
+static uint32_t pristinePixels[WORLD_CHUNK_PIXELS]; //!< Entpackter geladener Zustand des Abschnitts, der gerade gesichert oder hergestellt wird
+static struct {
+    SDL_Thread *threads[WORLD_MAX_SETTLE_THREADS]; //!< Gestartete Worker
+    int count;                                     //!< Anzahl gestarteter Worker
+    SDL_sem *start;                                //!< Weckt pro Signal einen Worker für den laufenden Durchgang
+    SDL_sem *done;                                 //!< Ein Signal pro Worker, der seinen Durchgang beendet hat
+    worldSettlePass_t *pass;                       //!< Laufender Durchgang, NULL beendet die Worker
+} pool;                               //!< Worker für das Absetzen, leben von \ref World_Init() bis \ref World_Quit()
+static struct {
+    float *grid;                      //!< Abstände zu beiden Zielen und Zeilenpuffer
+    int *vertices;                    //!< Scheitel der unteren Einhüllenden
+    size_t gridSize;                  //!< Platz in grid
+    int vertexCount;                  //!< Platz in vertices
+} distanceBuffer;                     //!< Arbeitsspeicher von UpdateDistance(), wächst bei Bedarf und wird wiederverwendet
 
 
 /*
  * Private Funktionsprototypen
- * 
+ *
+ */
+
+/**
+ * @brief Zählt die soliden Pixel einer Zeile eines Abschnitts im Bereich [\p x1, \p x2).
+ * Es werden ganze Wörter maskiert und gezählt.
+ *
+ * @param[in] chunk Der Abschnitt
+ * @param y Zeile, muss innerhalb des Abschnitts liegen
+ * @param x1 Erste Spalte, inklusive
+ * @param x2 Letzte Spalte, exklusive
+ *
+ * @return Anzahl solider Pixel
+ */
+static int CountRow(const worldChunk_t *chunk, int y, int x1, int x2);
+
+/**
+ * @brief Zählt die soliden Pixel im Rechteck [\p x1, \p x2) x [\p y1, \p y2).
+ * Benötigt pro berührtem Abschnitt nur vier Zugriffe auf dessen Summentabelle.
+ *
+ * @param x1 Erste Spalte, inklusive, innerhalb der Welt
+ * @param y1 Erste Zeile, inklusive, innerhalb der Welt
+ * @param x2 Letzte Spalte, exklusive, innerhalb der Welt
+ * @param y2 Letzte Zeile, exklusive, innerhalb der Welt
+ *
+ * @return Anzahl solider Pixel, 0 bei leerem Rechteck
+ */
+static int CountRect(int x1, int y1, int x2, int y2);
+
+/**
+ * @brief Sucht die oberste Zeile mit soliden Pixeln im Rechteck.
+ * Binäre Suche über die Summentabellen.
+ *
+ * @param area Rechteck, wird auf die Welt beschränkt
+ *
+ * @return Oberste solide Zeile oder Unterkante des Rechtecks, falls es frei ist
+ */
+static int FirstSolidRow(SDL_Rect area);
+
+/**
+ * @brief Berechnet den Versatz einer Achse nach \p step von \p steps Schritten.
+ * Gerundet wie beim DDA-Verfahren, der Versatz ist monoton in \p step.
+ *
+ * @param delta Gesamter Versatz der Achse
+ * @param step Aktueller Schritt
+ * @param steps Anzahl Schritte, grösser 0
+ *
+ * @return Versatz in Pixel
+ */
+static int SweepOffset(int delta, int step, int steps);
+
+/**
+ * @brief Prüft ob die AABB an einer der Positionen \p first bis \p last solid ist.
+ * Da die Positionen monoton sind, genügt das umschliessende Rechteck.
+ *
+ * @param aabb Kollisionsbox an der Startposition
+ * @param delta Gesamte Verschiebung
+ * @param steps Anzahl Schritte, grösser 0 falls \p last grösser 0
+ * @param first Erster Schritt
+ * @param last Letzter Schritt, inklusive
+ *
+ * @return 1 falls mindestens ein solider Pixel überdeckt wird, sonst 0
+ */
+static int SweepSolid(SDL_Rect aabb, SDL_Point delta, int steps, int first, int last);
+
+/**
+ * @brief Zählt die gesetzten Bits eines Wortes.
+ *
+ * @param word Das Wort
+ *
+ * @return Anzahl gesetzter Bits
+ */
+static int PopCount(uint64_t word);
+
+/**
+ * @brief Zählt die Nullen vor dem niederwertigsten gesetzten Bit.
+ *
+ * @param word Das Wort, darf nicht 0 sein
+ *
+ * @return Index des niederwertigsten gesetzten Bits
+ */
+static int TrailingZeros(uint64_t word);
+
+/**
+ * @brief Berechnet die Abbildung einer Modifikation und den betroffenen Bereich.
+ * Position, Grösse und Rotation werden wie bei SDLW_DrawTexture() berechnet.
+ *
+ * @param[in] sprite Die Modifikation
+ * @param[in] pixels Pixel der Textur
+ * @param[out] transform Die Abbildung
+ *
+ * @return Umschliessendes Rechteck innerhalb der Welt, leer wenn die Modifikation ausserhalb liegt
+ */
+static SDL_Rect SpriteTransform(const sprite_t *sprite, const SDL_Surface *pixels, worldTransform_t *transform);
+
+/**
+ * @brief Wendet eine Maske oder einen Stempel auf einen Abschnitt an.
+ *
+ * @param[in,out] chunk Der Abschnitt, muss angelegt sein
+ * @param origin Linke obere Ecke des Abschnitts in der Welt
+ * @param area Zu bearbeitender Bereich in Weltkoordinaten, innerhalb des Abschnitts
+ * @param[in] transform Abbildung der Modifikation
+ * @param[in] pixels Pixel der Textur im Format RGBA8888
+ * @param stamp 1 für einen Stempel, 0 für eine Maske
+ */
+static void BlendChunk(worldChunk_t *chunk, SDL_Point origin, SDL_Rect area, const worldTransform_t *transform, const SDL_Surface *pixels, int stamp);
+
+/**
+ * @brief Wendet eine Maske oder einen Stempel auf die Pixel der Abschnitte an.
+ * Die betroffenen Abschnitte merken sich den veränderten Bereich, übernommen
+ * wird er erst von FlushChunks().
+ *
+ * @param[in] sprite Die Modifikation
+ * @param[out] bounds Betroffener Bereich in der Welt, leer wenn nichts verändert wurde
+ *
+ * @return 0 oder Fehlercode
+ */
+static int BlendSprite(const sprite_t *sprite, SDL_Rect *bounds);
+
+/**
+ * @brief Erweitert den veränderten Bereich eines Abschnitts.
+ *
+ * @param[in,out] chunk Der Abschnitt
+ * @param area Veränderter Bereich relativ zum Abschnitt
+ */
+static void MarkDirty(worldChunk_t *chunk, SDL_Rect area);
+
+/**
+ * @brief Übernimmt die veränderten Bereiche aller Abschnitte.
+ * Jeder Abschnitt wird nur einmal gepackt und hochgeladen, egal wie viele
+ * Modifikationen ihn betroffen haben.
+ *
+ * @param distance 1 um das Distanzfeld pro Abschnitt nachzuführen, 0 wenn
+ * der Aufrufer das selbst zusammengefasst erledigt
+ *
+ * @return 0 oder Fehlercode
+ */
+static int FlushChunks(int distance);
+
+/**
+ * @brief Startet die Worker für das Absetzen.
+ * Ohne Worker simuliert der Hauptthread alle Bänder allein.
+ *
+ */
+static void StartPool();
+
+/**
+ * @brief Beendet die Worker für das Absetzen und wartet auf sie.
+ *
+ */
+static void StopPool();
+
+/**
+ * @brief Simuliert einen Durchgang des Absetzens.
+ * Weckt Worker für einen Teil der Bänder, wenn genug Abschnitte wach sind.
+ *
+ * @param[in,out] pass Der Durchgang
+ * @param awake Anzahl wacher Abschnitte
+ */
+static void SettlePass(worldSettlePass_t *pass, int awake);
+
+/**
+ * @brief Threadfunktion eines Workers.
+ * Wartet auf Durchgänge und simuliert deren Bänder, bis der Pool beendet wird.
+ *
+ * @param data unbenutzt
+ *
+ * @return immer 0
+ */
+static int SDLCALL SettleWorker(void *data);
+
+/**
+ * @brief Simuliert Bänder eines Durchgangs, bis keine mehr vorhanden sind.
+ *
+ * @param[in,out] pass Der Durchgang
+ */
+static void SettleBands(worldSettlePass_t *pass);
+
+/**
+ * @brief Lässt loses Gelände eines wachen Abschnitts um einen Pixel fallen.
+ * Zeilen werden von unten nach oben bearbeitet, übereinanderliegende Pixel
+ * fallen so gemeinsam. Die unterste Zeile fällt in den Abschnitt darunter,
+ * die unterste Zeile der Welt trägt.
+ *
+ * @param cx Spalte des Abschnitts
+ * @param cy Zeile des Abschnitts
+ */
+static void SettleChunk(int cx, int cy);
+
+/**
+ * @brief Aktualisiert Kollisionsraster, Summentabelle und Textur eines Abschnitts.
+ *
+ * @param[in,out] chunk Der Abschnitt, muss angelegt sein
+ * @param area Veränderter Bereich relativ zum Abschnitt
+ *
+ * @return 0 oder Fehlercode
+ */
+static int UpdateChunk(worldChunk_t *chunk, SDL_Rect area);
+
+/**
+ * @brief Aktualisiert die Summentabelle eines Abschnitts nach einer Änderung im angegebenen Bereich.
+ * Zeilen des Bereichs werden ab dessen linkem Rand neu summiert, darunter
+ * liegende Zeilen nur um die Änderung der letzten Zeile verschoben.
+ *
+ * @param[in,out] chunk Der Abschnitt
+ * @param area Bereich relativ zum Abschnitt
+ */
+static void UpdateIntegral(worldChunk_t *chunk, SDL_Rect area);
+
+/**
+ * @brief Legt die Puffer und die Textur eines leeren Abschnitts an.
+ * Die Pixel sind danach durchsichtig, die Textur ist noch nicht beschrieben.
+ *
+ * @param[out] chunk Der Abschnitt
+ *
+ * @return 0 oder Fehlercode
  */
+static int AllocateChunk(worldChunk_t *chunk);
 
 /**
- * @brief Aktualisiert das Kollisionsraster.
- * @warning Diese Funktion ist langsam 10-20 ms. So wenig wie möglich benutzen.
- * 
+ * @brief Legt das Distanzfeld eines Abschnitts und seiner Nachbarn an, soweit
+ * noch nicht vorhanden. Neue Felder stehen überall auf WORLD_DISTANCE_RANGE.
+ *
+ * @param c Index des Abschnitts
+ *
+ * @return 0 oder ERR_MEMORY
+ */
+static int AllocateDistance(int c);
+
+/**
+ * @brief Gibt alle Abschnitte und das Distanzfeld frei.
+ *
+ */
+static void FreeChunks();
+
+/**
+ * @brief Gibt den Arbeitsspeicher von UpdateDistance() frei.
+ *
+ */
+static void FreeDistanceBuffer();
+
+/**
+ * @brief Hängt Bytes an einen Schnappschuss an, der Speicher wird bei Bedarf verdoppelt.
+ *
+ * @param[in,out] snapshot Der Schnappschuss
+ * @param[in,out] capacity Allozierte Bytes von snapshot->data
+ * @param[in] data Anzuhängende Bytes
+ * @param size Anzahl Bytes
+ *
+ * @return 0 oder ERR_MEMORY
+ */
+static int SnapshotWrite(worldSnapshot_t *snapshot, size_t *capacity, const void *data, size_t size);
+
+/**
+ * @brief Kodiert einen Abschnitt als Läufe gegenüber dem geladenen Zustand.
+ * Abschnitte ohne Abweichung werden nicht angehängt.
+ *
+ * @param[in,out] snapshot Der Schnappschuss
+ * @param[in,out] capacity Allozierte Bytes von snapshot->data
+ * @param c Index des Abschnitts, muss angelegt sein
+ *
+ * @return 0 oder ERR_MEMORY
+ */
+static int SnapshotChunk(worldSnapshot_t *snapshot, size_t *capacity, int c);
+
+/**
+ * @brief Bestimmt die Art des Laufs für einen Pixel.
+ * Die Farbe freier Pixel ist unsichtbar und wird nicht unterschieden.
+ *
+ * @param[in] chunk Der Abschnitt
+ * @param[in] pristine Entpackter geladener Zustand des Abschnitts
+ * @param i Index des Pixels
+ *
+ * @return WORLD_RUN_SAME, WORLD_RUN_FREE oder WORLD_RUN_LITERAL
+ */
+static int SnapshotRun(const worldChunk_t *chunk, const uint32_t *pristine, int i);
+
+/**
+ * @brief Prüft ob ein Schnappschuss zur geladenen Welt passt und vollständig ist.
+ *
+ * @param[in] snapshot Der Schnappschuss
+ *
+ * @return 0 oder ERR_PARAMETER
+ */
+static int SnapshotValidate(const worldSnapshot_t *snapshot);
+
+/**
+ * @brief Stellt einen Abschnitt aus seinen Läufen oder dem geladenen Zustand her.
+ * Nur tatsächlich veränderte Pixel werden als veränderter Bereich gemerkt.
+ *
+ * @param c Index des Abschnitts
+ * @param[in] runs Läufe des Abschnitts, NULL für den geladenen Zustand
+ * @param size Bytes der Läufe
+ *
+ * @return 0 oder Fehlercode
+ */
+static int RestoreChunk(int c, const uint8_t *runs, size_t size);
+
+/**
+ * @brief Stellt einen Lauf von Pixeln her.
+ *
+ * @param[in,out] chunk Der Abschnitt, muss angelegt sein
+ * @param[in] pristine Entpackter geladener Zustand des Abschnitts
+ * @param start Index des ersten Pixels
+ * @param count Anzahl Pixel
+ * @param type Art des Laufs
+ * @param[in] literal Neue Pixel bei WORLD_RUN_LITERAL, sonst unbenutzt
+ * @param[in,out] changed Umschliessendes Rechteck der veränderten Pixel als x1, y1, x2, y2 inklusive
+ */
+static void RestoreRun(worldChunk_t *chunk, const uint32_t *pristine, int start, int count, int type, const uint8_t *literal, int changed[4]);
+
+/**
+ * @brief Packt die Pixel eines frisch geladenen Abschnitts als dessen geladenen Zustand.
+ * Freie Pixel verlieren dabei ihre unsichtbare Farbe, gleiche Pixel werden
+ * zusammengefasst.
+ *
+ * @param[in,out] chunk Der Abschnitt, muss angelegt sein
+ *
+ * @return 0 oder ERR_MEMORY
+ */
+static int PackPristine(worldChunk_t *chunk);
+
+/**
+ * @brief Entpackt den geladenen Zustand eines Abschnitts.
+ *
+ * @param[in] chunk Der Abschnitt
+ * @param[out] pixels WORLD_CHUNK_PIXELS Pixel, 0 falls der Abschnitt leer geladen wurde
+ */
+static void UnpackPristine(const worldChunk_t *chunk, uint32_t *pixels);
+
+/**
+ * @brief Setzt die Startwerte einer Zeile der Distanztransformation.
+ * Die Kollisionsraster werden wortweise gelesen, Ziele erhalten 0 und alle
+ * anderen Pixel \p far.
+ *
+ * @param[out] toFree Startwerte für den Abstand zum freien Raum
+ * @param[out] toSolid Startwerte für den Abstand zum Gelände
+ * @param x Erste Spalte, innerhalb der Welt
+ * @param y Zeile, innerhalb der Welt
+ * @param w Anzahl Pixel, höchstens bis zum rechten Rand der Welt
+ * @param far Wert für Pixel, die kein Ziel sind
+ */
+static void DistanceSeeds(float *toFree, float *toSolid, int x, int y, int w, float far);
+
+/**
+ * @brief Gibt den Wert des Distanzfeldes an einem Pixel zurück.
+ *
+ * @param x Spalte
+ * @param y Zeile
+ *
+ * @return Abstand in Pixel, ausserhalb der Welt und ohne Distanzfeld WORLD_DISTANCE_RANGE
+ */
+static float DistanceAt(int x, int y);
+
+/**
+ * @brief Liest das Distanzfeld an einem Pixel ohne Umrechnung.
+ *
+ * @param x x-Koordinate in der Welt
+ * @param y y-Koordinate in der Welt
+ *
+ * @return Abstand in 1/WORLD_DISTANCE_SCALE Pixel
+ */
+static int DistanceRawAt(int x, int y);
+
+/**
+ * @brief Berechnet das Distanzfeld im angegebenen Bereich neu.
+ * Da Abstände auf WORLD_DISTANCE_RANGE beschränkt sind, genügt dazu die
+ * Umgebung des Bereichs. Die exakte euklidische Distanztransformation wird
+ * spaltenweise und danach zeilenweise über der unteren Einhüllenden von
+ * Parabeln berechnet.
+ *
+ * @param area Veränderter Bereich in Weltkoordinaten
+ *
  * @return 0 oder Fehlercode
  */
-static int UpdateWorld();
+static int UpdateDistance(SDL_Rect area);
+
+/**
+ * @brief Eindimensionale quadrierte Distanztransformation einer Zeile.
+ *
+ * @param[in] f Quadrierte Abstände vor der Transformation
+ * @param[out] d Quadrierte Abstände nach der Transformation
+ * @param n Anzahl Elemente
+ * @param[out] vertices Arbeitsspeicher für n Scheitel
+ * @param[out] bounds Arbeitsspeicher für n + 1 Grenzen
+ */
+static void DistanceTransform(const float *f, float *d, int n, int *vertices, float *bounds);
 
 
 /*
@@ -80,6 +585,12 @@ int World_LoadConfig(char *config, struct sdlwResource_s *resource) {
         return ERR_FAIL;
     }
 
+    // Texturen müssen existieren, geladen werden sie erst mit World_Load()
+    if (SDLW_ResolveHandle(foregroundID) == SDLW_INVALID_HANDLE || SDLW_ResolveHandle(backgroundID) == SDLW_INVALID_HANDLE) {
+        SDL_Log("Texturen der Welt %s nicht gefunden! World_LoadConfig()\n", key);
+        return ERR_FAIL;
+    }
+
     // Konfiguration erstellen
     resource->type = RESOURCETYPE_WORLD;
     worldConfig_t *worldConfig = malloc(sizeof(worldConfig_t));
@@ -88,15 +599,9 @@ int World_LoadConfig(char *config, struct sdlwResource_s *resource) {
         SDL_Log("Memory Error! World_LoadConfig()\n");
         return ERR_MEMORY;
     }
-
-    // Vordergrund Textur holen
-    int code = SDLW_GetResource(foregroundID, RESOURCETYPE_TEXTURE, (void **)&worldConfig->foreground);
-    if (code != ERR_OK)
-        return code;
-    // Hintergrund Textur holen
-    code = SDLW_GetResource(backgroundID, RESOURCETYPE_TEXTURE, (void **)&worldConfig->background);
-    if (code != ERR_OK)
-        return code;
+    strcpy(worldConfig->key, key);
+    strcpy(worldConfig->foreground, foregroundID);
+    strcpy(worldConfig->background, backgroundID);
 
     // Hintergrundsmusik definieren
     if (count == 5)
@@ -109,47 +614,108 @@ int World_LoadConfig(char *config, struct sdlwResource_s *resource) {
     return ERR_OK;
 }
 
+static int PackPristine(worldChunk_t *chunk) {
+    // Jeder Lauf kostet höchstens einen Kopf und einen Pixel pro Pixel
+    const uint32_t *pixels = chunk->pixels;
+    uint8_t *runs = malloc((sizeof(uint16_t) + sizeof(uint32_t)) * WORLD_CHUNK_PIXELS);
+    if (!runs) {
+        SDL_Log("Memory Error! PackPristine()\n");
+        return ERR_MEMORY;
+    }
+    size_t size = 0;
+    for (int i = 0; i < WORLD_CHUNK_PIXELS;) {
+        int limit = WORLD_CHUNK_PIXELS - i < 1 << WORLD_RUN_TYPE_SHIFT ? WORLD_CHUNK_PIXELS - i : 1 << WORLD_RUN_TYPE_SHIFT;
+        int count = 1;
+        int type;
+        if (!(pixels[i] & 0xFF)) {
+            while (count < limit && !(pixels[i + count] & 0xFF))
+                count++;
+            type = WORLD_PRISTINE_FREE;
+        } else if (count < limit && pixels[i + 1] == pixels[i]) {
+            while (count < limit && pixels[i + count] == pixels[i])
+                count++;
+            type = WORLD_PRISTINE_FILL;
+        } else { // Bis zum nächsten freien Pixel oder Paar gleicher Pixel
+            while (count < limit && (pixels[i + count] & 0xFF) && !(count + 1 < limit && pixels[i + count + 1] == pixels[i + count]))
+                count++;
+            type = WORLD_PRISTINE_LITERAL;
+        }
+        uint16_t head = (uint16_t)(type << WORLD_RUN_TYPE_SHIFT | (count - 1));
+        memcpy(runs + size, &head, sizeof(head));
+        size += sizeof(head);
+        int stored = type == WORLD_PRISTINE_LITERAL ? count : type == WORLD_PRISTINE_FILL;
+        memcpy(runs + size, pixels + i, sizeof(uint32_t) * stored);
+        size += sizeof(uint32_t) * stored;
+        i += count;
+    }
+
+    // Überzähliger Platz wird zurückgegeben. Auf realloc wird verzichtet, da
+    // der Heap-Mock der Tests dieses nicht ersetzt.
+    uint8_t *exact = malloc(size ? size : 1);
+    if (!exact) { // Ohne Kopie bleibt der grosse Puffer bestehen
+        chunk->pristine = runs;
+        return ERR_OK;
+    }
+    memcpy(exact, runs, size);
+    free(runs);
+    chunk->pristine = exact;
+    return ERR_OK;
+}
+
+static void UnpackPristine(const worldChunk_t *chunk, uint32_t *pixels) {
+    if (!chunk->pristine) {
+        memset(pixels, 0, sizeof(uint32_t) * WORLD_CHUNK_PIXELS);
+        return;
+    }
+    const uint8_t *runs = chunk->pristine;
+    for (int i = 0; i < WORLD_CHUNK_PIXELS;) {
+        uint16_t head;
+        memcpy(&head, runs, sizeof(head));
+        runs += sizeof(head);
+        int type = head >> WORLD_RUN_TYPE_SHIFT;
+        int count = (head & ((1 << WORLD_RUN_TYPE_SHIFT) - 1)) + 1;
+        if (type == WORLD_PRISTINE_FREE) {
+            memset(pixels + i, 0, sizeof(uint32_t) * count);
+        } else if (type == WORLD_PRISTINE_FILL) {
+            uint32_t pixel;
+            memcpy(&pixel, runs, sizeof(pixel));
+            runs += sizeof(pixel);
+            for (int k = 0; k < count; k++)
+                pixels[i + k] = pixel;
+        } else {
+            memcpy(pixels + i, runs, sizeof(uint32_t) * count);
+            runs += sizeof(uint32_t) * count;
+        }
+        i += count;
+    }
+}
+
+
 int World_Init() {
     if (init) { // Fehlerüberprüfung
         SDL_Log("Welt wurde schon initialisiert!\n");
         return ERR_FAIL;
     }
 
-    // Initialisieren des Kollisionsraster auf eine gewisse grösse
-    worldCollision = malloc(sizeof(int) * width * height * 4);
-    if (!worldCollision) {
-        SDL_Log("Memory Error! World_Init()\n");
-        return ERR_MEMORY;
-    }
-
-    // Zerstörbarer Vordergrund erstellen
+    // Die Abschnitte des Vordergrunds werden erst mit der Welt angelegt
     SDL_Renderer *renderer = SDLW_GetRenderer(); // Renderer hohlen
     if (!renderer) {
-        free(worldCollision);
-        worldCollision = 0;
         SDL_Log("SDLW nicht richtig initialisiert! World_Init()\n");
         return ERR_FAIL;
     }
-    foreground.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height); // Textur erstellen
-    if (!foreground.texture) {
-        free(worldCollision);
-        worldCollision = 0;
-        SDL_Log("SDL CreateTexture fehler! [%s]\n", SDL_GetError());
-        return ERR_FAIL;
-    }
-    SDL_SetTextureBlendMode(foreground.texture, SDL_BLENDMODE_BLEND);
-    // Vordergrund einstellen, 1px = 1Raster
-    foreground.destination.w = width;
-    foreground.destination.h = height;
-    foreground.destination.x = width / 2;
-    foreground.destination.y = height / 2;
-    foreground.source.w = width;
-    foreground.source.h = height;
-    // Hintergrund einstellen, Skalierung kann unterschiedlich sein
-    background.destination.w = width;
-    background.destination.h = height;
-    background.destination.x = width / 2;
-    background.destination.y = height / 2;
+
+    // Sichtbarer Ausschnitt ist so gross wie der Renderer
+    SDL_RenderGetViewport(renderer, &viewport);
+    viewport.x = 0;
+    viewport.y = 0;
+    // Hintergrund füllt den Ausschnitt, Skalierung kann unterschiedlich sein
+    background.destination.w = viewport.w;
+    background.destination.h = viewport.h;
+    background.destination.x = viewport.w / 2;
+    background.destination.y = viewport.h / 2;
+
+    // Worker bleiben bis World_Quit() bestehen
+    StartPool();
 
     // Abschluss
     init = 1;
@@ -159,10 +725,21 @@ int World_Init() {
 
 void World_Quit() {
     if (init) {
-        free(worldCollision);
-        worldCollision = 0;
-        SDL_DestroyTexture(foreground.texture);
+        if (loadedConfig) { // Referenzen der geladenen Welt freigeben
+            SDLW_ReleaseResource(loadedConfig->background);
+            SDLW_ReleaseResource(loadedConfig->key);
+            loadedConfig = NULL;
+        }
+        FreeChunks();
+        StopPool();
+        free(queue.modifications);
+        queue.modifications = NULL;
+        queue.count = 0;
+        queue.capacity = 0;
+        settle = 0;
+        viewport = (SDL_Rect){0};
         Mix_HaltMusic();
+        loaded = 0;
         init = 0;
     }
 }
@@ -174,6 +751,11 @@ int World_Load(char *worldID) {
         return ERR_NULLPARAMETER;
     }
 
+    if (!init) { // Fehlerüberprüfung
+        SDL_Log("Welt nicht initialisiert! World_Load()\n");
+        return ERR_FAIL;
+    }
+
     // Laden der Konfiguration
     worldConfig_t *config;
     if (SDLW_GetResource(worldID, RESOURCETYPE_WORLD, (void **)&config)) {
@@ -181,34 +763,91 @@ int World_Load(char *worldID) {
         return ERR_FAIL;
     }
 
-    // Renderer vom SDLW holen
-    SDL_Renderer *renderer = SDLW_GetRenderer();
-    if (!renderer) {
-        SDL_Log("SDLW nicht richtig initialisiert! World_Load()\n");
+    // Hintergrund holen, dieser wird erst jetzt vom SDLW geladen
+    SDL_Texture *backgroundTexture;
+    if (SDLW_GetResource(config->background, RESOURCETYPE_TEXTURE, (void **)&backgroundTexture)) {
+        SDLW_ReleaseResource(worldID);
         return ERR_FAIL;
     }
 
-    // Vordergrund zum Schreiben vorbereiten
-    if (SDL_SetRenderTarget(renderer, foreground.texture)) {
-        SDL_Log("SDL_SetRenderTarget Error! [%s]\n", SDL_GetError());
+    // Vordergrund direkt aus dem Bild dekodieren, ohne Umweg über die Grafikkarte
+    SDL_Surface *surface;
+    if (SDLW_LoadSurface(config->foreground, &surface)) {
+        SDLW_ReleaseResource(config->background);
+        SDLW_ReleaseResource(worldID);
         return ERR_FAIL;
     }
 
-    // Vordergrund Schreiben
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 0);
-    SDL_RenderClear(renderer);
-    SDL_RenderCopy(renderer, config->foreground, NULL, NULL);
-    SDL_SetRenderTarget(renderer, NULL);
-    // Kollisionsraster aktualisieren
-    UpdateWorld();
+    // Die Welt ist so gross wie das Bild des Vordergrunds, ausstehende
+    // Modifikationen betreffen noch die vorherige Welt
+    FreeChunks();
+    queue.count = 0;
+    loaded = 0;
+    width = surface->w;
+    height = surface->h;
+    chunksX = (width + WORLD_CHUNK_SIZE - 1) / WORLD_CHUNK_SIZE;
+    chunksY = (height + WORLD_CHUNK_SIZE - 1) / WORLD_CHUNK_SIZE;
+    chunks = calloc(chunksX * chunksY, sizeof(worldChunk_t));
+    if (!chunks) {
+        SDL_Log("Memory Error! World_Load()\n");
+        errCode = ERR_MEMORY;
+    }
+
+    // Nur Abschnitte anlegen, in denen Gelände vorhanden ist
+    for (int c = 0; !errCode && c < chunksX * chunksY; c++) {
+        int originX = (c % chunksX) * WORLD_CHUNK_SIZE;
+        int originY = (c / chunksX) * WORLD_CHUNK_SIZE;
+        int w = width - originX < WORLD_CHUNK_SIZE ? width - originX : WORLD_CHUNK_SIZE;
+        int h = height - originY < WORLD_CHUNK_SIZE ? height - originY : WORLD_CHUNK_SIZE;
+        int solid = 0;
+        for (int y = 0; y < h && !solid; y++) {
+            const uint32_t *line = (const uint32_t *)((const uint8_t *)surface->pixels + (originY + y) * surface->pitch) + originX;
+            for (int x = 0; x < w && !solid; x++)
+                solid = (line[x] & 0xFF) != 0; // Alpha ist das niederwertigste Byte
+        }
+        if (!solid)
+            continue;
+
+        errCode = AllocateChunk(&chunks[c]);
+        for (int y = 0; !errCode && y < h; y++) {
+            const uint8_t *line = (const uint8_t *)surface->pixels + (originY + y) * surface->pitch;
+            memcpy(chunks[c].pixels + y * WORLD_CHUNK_SIZE, (const uint32_t *)line + originX, sizeof(uint32_t) * w);
+        }
+        if (!errCode) // Geladener Zustand als Basis für Schnappschüsse
+            errCode = PackPristine(&chunks[c]);
+        if (!errCode) // Ganzer Abschnitt, damit die neue Textur vollständig beschrieben wird
+            errCode = UpdateChunk(&chunks[c], (SDL_Rect){0, 0, WORLD_CHUNK_SIZE, WORLD_CHUNK_SIZE});
+    }
+    SDL_FreeSurface(surface);
+    if (!errCode)
+        errCode = UpdateDistance((SDL_Rect){0, 0, width, height});
+    FreeDistanceBuffer(); // So gross wird der Puffer erst beim nächsten Laden wieder
+    if (errCode) {
+        FreeChunks();
+        SDLW_ReleaseResource(config->background);
+        SDLW_ReleaseResource(worldID);
+        return errCode;
+    }
+
+    // Referenzen der vorherigen Welt erst jetzt freigeben, gemeinsame
+    // Texturen bleiben so geladen
+    if (loadedConfig) {
+        SDLW_ReleaseResource(loadedConfig->background);
+        SDLW_ReleaseResource(loadedConfig->key);
+    }
+    loadedConfig = config;
 
     // Hintergrund definieren
-    background.texture = config->background;
+    background.texture = backgroundTexture;
     int w, h;
     SDL_QueryTexture(background.texture, NULL, NULL, &w, &h);
     background.source.w = w;
     background.source.h = h;
 
+    // Ausschnitt beginnt links oben
+    viewport.x = 0;
+    viewport.y = 0;
+
     // Hintergrundmusik abspielen
     if (config->bgMusic[0] != '\0')
         errCode = SDLW_PlayMusic(config->bgMusic);
@@ -218,25 +857,78 @@ int World_Load(char *worldID) {
     return errCode;
 }
 
-int World_DrawBackground() {
+int World_GetSize(SDL_Point *size) {
     if (!loaded) { // Fehlerüberprüfung
-        SDL_Log("Keine Welt geladen! World_DrawBackground()\n");
+        SDL_Log("Keine Welt geladen! World_GetSize()\n");
         return ERR_FAIL;
     }
-    return SDLW_DrawTexture(background); // Zeichnen des Hintergrunds
+    if (!size) {
+        SDL_Log("Rueckgabespeicher size ungueltig! World_GetSize()\n");
+        return ERR_NULLPARAMETER;
+    }
+    size->x = width;
+    size->y = height;
+    return ERR_OK;
 }
 
-int World_DrawForeground() {
-    if (!loaded) { // Fehlerüberprüfung
-        SDL_Log("Keine Welt geladen! World_DrawForeground()\n");
+int World_SetViewport(SDL_Point position) {
+    if (!init) { // Fehlerüberprüfung
+        SDL_Log("Welt nicht initialisiert! World_SetViewport()\n");
         return ERR_FAIL;
     }
-    return SDLW_DrawTexture(foreground); // Zeichnen des Vordergrunds
+    viewport.x = position.x;
+    viewport.y = position.y;
+    return ERR_OK;
 }
 
-int World_CheckCollision(SDL_Rect aabb, struct entityCollision_s *collision) {
-    // Fehlerüberprüfung
-    if (!loaded) {
+int World_GetViewport(SDL_Rect *rect) {
+    if (!rect) { // Fehlerüberprüfung
+        SDL_Log("Rueckgabespeicher rect ungueltig! World_GetViewport()\n");
+        return ERR_NULLPARAMETER;
+    }
+    *rect = viewport;
+    return ERR_OK;
+}
+
+int World_DrawBackground() {
+    if (!loaded) { // Fehlerüberprüfung
+        SDL_Log("Keine Welt geladen! World_DrawBackground()\n");
+        return ERR_FAIL;
+    }
+    return SDLW_DrawTexture(background); // Zeichnen des Hintergrunds
+}
+
+int World_DrawForeground() {
+    if (!loaded) { // Fehlerüberprüfung
+        SDL_Log("Keine Welt geladen! World_DrawForeground()\n");
+        return ERR_FAIL;
+    }
+
+    // Nur angelegte Abschnitte im sichtbaren Ausschnitt zeichnen
+    int firstX = viewport.x > 0 ? viewport.x / WORLD_CHUNK_SIZE : 0;
+    int firstY = viewport.y > 0 ? viewport.y / WORLD_CHUNK_SIZE : 0;
+    for (int cy = firstY; cy < chunksY && cy * WORLD_CHUNK_SIZE < viewport.y + viewport.h; cy++) {
+        for (int cx = firstX; cx < chunksX && cx * WORLD_CHUNK_SIZE < viewport.x + viewport.w; cx++) {
+            worldChunk_t *chunk = &chunks[cx + cy * chunksX];
+            if (!chunk->texture)
+                continue;
+            sprite_t sprite = {0};
+            sprite.texture = chunk->texture;
+            sprite.source = (SDL_Rect){0, 0, WORLD_CHUNK_SIZE, WORLD_CHUNK_SIZE};
+            sprite.destination = (SDL_Rect){0, 0, WORLD_CHUNK_SIZE, WORLD_CHUNK_SIZE};
+            sprite.position.x = cx * WORLD_CHUNK_SIZE - viewport.x + WORLD_CHUNK_SIZE / 2;
+            sprite.position.y = cy * WORLD_CHUNK_SIZE - viewport.y + WORLD_CHUNK_SIZE / 2;
+            int errCode = SDLW_DrawTexture(sprite); // Zeichnen des Abschnitts
+            if (errCode)
+                return errCode;
+        }
+    }
+    return ERR_OK;
+}
+
+int World_CheckCollision(SDL_Rect aabb, struct entityCollision_s *collision) {
+    // Fehlerüberprüfung
+    if (!loaded) {
         SDL_Log("Keine Welt geladen! World_CheckCollision()\n");
         return ERR_FAIL;
     }
@@ -246,7 +938,7 @@ int World_CheckCollision(SDL_Rect aabb, struct entityCollision_s *collision) {
         return ERR_NULLPARAMETER;
     }
 
-    if (!worldCollision) {
+    if (!chunks) {
         printf("Weltbuffer ungueltig! World_CheckCollision()\n");
         return ERR_FAIL;
     }
@@ -279,23 +971,18 @@ int World_CheckCollision(SDL_Rect aabb, struct entityCollision_s *collision) {
         y2 = height;
         collision->flags |= ENTITY_COLLISION_BORDER_BOTTOM;
     }
-    // Kollision mit der Welt
-    for (int x = x1; x < x2; x++) {
-        for (int y = y1; y < y2; y++) {
-            if (worldCollision[(x + y * width) * 4] > 0) {
-                collision->flags |= ENTITY_COLLISION_WORLD;
-                if (x - aabb.x - aabb.w / 2 > 0) {
-                    hitNormal.x--;
-                } else if (x - aabb.x - aabb.w / 2 < aabb.w % 2 - 1) {
-                    hitNormal.x++;
-                }
-                if (y - aabb.y - aabb.h / 2 > 0) {
-                    hitNormal.y--;
-                } else if (y - aabb.y - aabb.h / 2 < aabb.h % 2 - 1) {
-                    hitNormal.y++;
-                }
-            }
-        }
+    // Grenzen der Hälften, Pixel links davon drücken nach rechts, Pixel
+    // rechts davon nach links. Die Mitte trägt nichts zur Normalen bei.
+    int leftEnd = aabb.x + aabb.w / 2 + aabb.w % 2 - 1;
+    int rightStart = aabb.x + aabb.w / 2 + 1;
+    int topEnd = aabb.y + aabb.h / 2 + aabb.h % 2 - 1;
+    int bottomStart = aabb.y + aabb.h / 2 + 1;
+
+    // Kollision mit der Welt, die Normale ist die Differenz der Hälften
+    if (CountRect(x1, y1, x2, y2)) {
+        collision->flags |= ENTITY_COLLISION_WORLD;
+        hitNormal.x = CountRect(x1, y1, leftEnd < x2 ? leftEnd : x2, y2) - CountRect(rightStart > x1 ? rightStart : x1, y1, x2, y2);
+        hitNormal.y = CountRect(x1, y1, x2, topEnd < y2 ? topEnd : y2) - CountRect(x1, bottomStart > y1 ? bottomStart : y1, x2, y2);
     }
 
     collision->normal.x = (float)hitNormal.x;
@@ -308,29 +995,220 @@ int World_Modify(sprite_t sprite) {
         SDL_Log("Keine Welt geladen! World_Modify()\n");
         return ERR_FAIL;
     }
+    if (!sprite.texture) // Nichts zu zeichnen
+        return ERR_OK;
+
+    // Auf der CPU anwenden, nur die betroffenen Abschnitte werden aktualisiert
+    SDL_Rect bounds;
+    int errCode = BlendSprite(&sprite, &bounds);
+    if (!errCode)
+        errCode = FlushChunks(0);
+    if (!errCode && bounds.w > 0 && bounds.h > 0)
+        errCode = UpdateDistance(bounds);
+    return errCode;
+}
 
-    // Renderer vom SDLW holen
-    SDL_Renderer *renderer = SDLW_GetRenderer();
-    if (!renderer) {
-        SDL_Log("SDLW nicht richtig initialisiert! World_Load()\n");
+int World_QueueModify(sprite_t sprite) {
+    if (!loaded) {
+        SDL_Log("Keine Welt geladen! World_QueueModify()\n");
         return ERR_FAIL;
     }
+    if (!sprite.texture) // Nichts zu zeichnen
+        return ERR_OK;
+
+    // Ungültige Texturen sofort melden und nicht erst beim Anwenden
+    SDL_Surface *pixels;
+    resourceType_t type;
+    if (SDLW_GetTexturePixels(sprite.texture, &pixels, &type)) {
+        SDL_Log("Textur ist weder Maske noch Stempel! World_QueueModify()\n");
+        return ERR_PARAMETER;
+    }
 
-    // Vordergrund zum Schreiben vorbereiten
-    if (SDL_SetRenderTarget(renderer, foreground.texture)) {
-        SDL_Log("SDL_SetRenderTarget Error! [%s]\n", SDL_GetError());
-        return ERR_FAIL;
+    // Warteschlange bei Bedarf verdoppeln
+    if (queue.count == queue.capacity) {
+        int capacity = queue.capacity ? queue.capacity * 2 : WORLD_MIN_QUEUED;
+        worldModification_t *modifications = malloc(capacity * sizeof(worldModification_t));
+        if (!modifications) {
+            SDL_Log("Memory Error! World_QueueModify()\n");
+            return ERR_MEMORY;
+        }
+        if (queue.modifications) {
+            memcpy(modifications, queue.modifications, queue.count * sizeof(worldModification_t));
+            free(queue.modifications);
+        }
+        queue.modifications = modifications;
+        queue.capacity = capacity;
     }
+    queue.modifications[queue.count++] = (worldModification_t){.sprite = sprite};
+    return ERR_OK;
+}
+
+int World_ApplyModifications() {
+    if (!queue.count) // Nichts zu tun, auch ohne geladene Welt
+        return ERR_OK;
 
-    // Vordergrund Schreiben
-    SDLW_DrawTexture(sprite);
-    SDL_SetRenderTarget(renderer, NULL);
-    // Welt aktualisieren
-    UpdateWorld();
+    // Alle Modifikationen in Reihenfolge auf die Pixel anwenden
+    int errCode = ERR_OK;
+    for (int i = 0; !errCode && i < queue.count; i++)
+        errCode = BlendSprite(&queue.modifications[i].sprite, &queue.modifications[i].bounds);
+    if (!errCode)
+        errCode = FlushChunks(0);
+
+    // Bereiche zusammenfassen, deren Umgebung für das Distanzfeld sich
+    // überschneidet. Jeder Pixel wird so höchstens einmal neu berechnet.
+    int count = queue.count;
+    for (int merged = 1; merged;) {
+        merged = 0;
+        for (int i = 0; i < count; i++) {
+            SDL_Rect *a = &queue.modifications[i].bounds;
+            for (int j = i + 1; j < count; j++) {
+                SDL_Rect *b = &queue.modifications[j].bounds;
+                if (a->x < b->x + b->w + 2 * WORLD_DISTANCE_RANGE && b->x < a->x + a->w + 2 * WORLD_DISTANCE_RANGE &&
+                    a->y < b->y + b->h + 2 * WORLD_DISTANCE_RANGE && b->y < a->y + a->h + 2 * WORLD_DISTANCE_RANGE) {
+                    SDL_Rect both;
+                    SDL_UnionRect(a, b, &both);
+                    *a = both;
+                    *b = queue.modifications[--count].bounds;
+                    merged = 1;
+                    j--;
+                }
+            }
+        }
+    }
+    for (int i = 0; !errCode && i < count; i++) {
+        if (queue.modifications[i].bounds.w > 0 && queue.modifications[i].bounds.h > 0)
+            errCode = UpdateDistance(queue.modifications[i].bounds);
+    }
+    queue.count = 0;
+    return errCode;
+}
 
+int World_SetSettling(int enabled) {
+    settle = enabled != 0;
     return ERR_OK;
 }
 
+int World_Settle() {
+    if (!settle || !loaded)
+        return ERR_OK;
+
+    // Abschnitte unter fallendem Gelände anlegen, Texturen darf nur der
+    // Hauptthread erstellen
+    int awake = 0;
+    for (int c = 0; c < chunksX * chunksY; c++) {
+        worldChunk_t *chunk = &chunks[c];
+        if (!chunk->settling)
+            continue;
+        awake++;
+        if (c + chunksX >= chunksX * chunksY || chunks[c + chunksX].pixels)
+            continue;
+        const uint64_t *bottom = chunk->rows + (WORLD_CHUNK_SIZE - 1) * WORLD_CHUNK_WORDS;
+        int solid = 0;
+        for (int w = 0; w < WORLD_CHUNK_WORDS; w++)
+            solid |= bottom[w] != 0;
+        if (!solid)
+            continue;
+        int errCode = AllocateChunk(&chunks[c + chunksX]);
+        if (errCode)
+            return errCode;
+        MarkDirty(&chunks[c + chunksX], (SDL_Rect){0, 0, WORLD_CHUNK_SIZE, WORLD_CHUNK_SIZE});
+    }
+    if (!awake)
+        return ERR_OK;
+
+    // Erst alle geraden, dann alle ungeraden Bänder
+    for (int parity = 0; parity < 2; parity++) {
+        worldSettlePass_t pass = {.parity = parity, .count = (chunksY - parity + 1) / 2};
+        SettlePass(&pass, awake);
+    }
+
+    // Abschnitte ohne Bewegung schlafen, bis sie wieder verändert werden oder
+    // unter ihnen Gelände wegfällt
+    for (int c = 0; c < chunksX * chunksY; c++) {
+        worldChunk_t *chunk = &chunks[c];
+        chunk->settling = chunk->moved || chunk->fed;
+        if (chunk->lostTop && c >= chunksX && chunks[c - chunksX].pixels)
+            chunks[c - chunksX].settling = 1;
+        chunk->moved = 0;
+        chunk->fed = 0;
+        chunk->lostTop = 0;
+    }
+    return FlushChunks(1);
+}
+
+int World_Snapshot(worldSnapshot_t *snapshot) {
+    if (!snapshot) { // Fehlerüberprüfung
+        SDL_Log("Rueckgabespeicher snapshot ungueltig! World_Snapshot()\n");
+        return ERR_NULLPARAMETER;
+    }
+    (*snapshot) = (worldSnapshot_t){0};
+    if (!loaded) {
+        SDL_Log("Keine Welt geladen! World_Snapshot()\n");
+        return ERR_FAIL;
+    }
+
+    // Nur Abschnitte, die seit dem Laden verändert wurden, alle anderen
+    // entsprechen dem geladenen Zustand
+    size_t capacity = 0;
+    worldSnapshotHeader_t header = {.width = width, .height = height};
+    memcpy(header.key, loadedConfig->key, sizeof(header.key));
+    int errCode = SnapshotWrite(snapshot, &capacity, &header, sizeof(header));
+    for (int c = 0; !errCode && c < chunksX * chunksY; c++) {
+        if (chunks[c].touched && chunks[c].pixels)
+            errCode = SnapshotChunk(snapshot, &capacity, c);
+    }
+    if (errCode)
+        World_FreeSnapshot(snapshot);
+    return errCode;
+}
+
+int World_Restore(const worldSnapshot_t *snapshot) {
+    if (!snapshot || !snapshot->data) { // Fehlerüberprüfung
+        SDL_Log("Schnappschuss ungueltig! World_Restore()\n");
+        return ERR_NULLPARAMETER;
+    }
+    if (!loaded) {
+        SDL_Log("Keine Welt geladen! World_Restore()\n");
+        return ERR_FAIL;
+    }
+    if (SnapshotValidate(snapshot)) {
+        SDL_Log("Schnappschuss passt nicht zur geladenen Welt! World_Restore()\n");
+        return ERR_PARAMETER;
+    }
+
+    // Abschnitte ohne Eintrag auf den geladenen Zustand zurücksetzen
+    const uint8_t *data = snapshot->data;
+    size_t offset = sizeof(worldSnapshotHeader_t);
+    int next = 0;
+    int errCode = ERR_OK;
+    while (!errCode && offset < snapshot->size) {
+        worldSnapshotChunk_t entry;
+        memcpy(&entry, data + offset, sizeof(entry));
+        offset += sizeof(entry);
+        for (; !errCode && next < entry.index; next++)
+            errCode = RestoreChunk(next, NULL, 0);
+        if (!errCode)
+            errCode = RestoreChunk(entry.index, data + offset, entry.size);
+        offset += entry.size;
+        next = entry.index + 1;
+    }
+    for (; !errCode && next < chunksX * chunksY; next++)
+        errCode = RestoreChunk(next, NULL, 0);
+
+    // Vorgemerkte Modifikationen gehören nicht zum hergestellten Zustand
+    queue.count = 0;
+    if (!errCode)
+        errCode = FlushChunks(1);
+    return errCode;
+}
+
+void World_FreeSnapshot(worldSnapshot_t *snapshot) {
+    if (snapshot) {
+        free(snapshot->data);
+        (*snapshot) = (worldSnapshot_t){0};
+    }
+}
+
 int World_VerticalLineIntersection(SDL_Point searchStart, SDL_Point *hitPoint) {
     // Fehlerüberprüfung
     if (!loaded) {
@@ -343,7 +1221,7 @@ int World_VerticalLineIntersection(SDL_Point searchStart, SDL_Point *hitPoint) {
         return ERR_NULLPARAMETER;
     }
 
-    if (!worldCollision) {
+    if (!chunks) {
         printf("Weltbuffer ungueltig! World_CheckCollision()\n");
         return ERR_FAIL;
     }
@@ -356,16 +1234,27 @@ int World_VerticalLineIntersection(SDL_Point searchStart, SDL_Point *hitPoint) {
         return ERR_PARAMETER;
     }
 
-    for (int y = searchStart.y; y < height; y++) {
-        if (worldCollision[(searchStart.x + y * width) * 4] > 0) {
-            hitPoint->x = searchStart.x;
-            hitPoint->y = y;
-            return ERR_OK;
-        }
-    }
-
+    // Spalte abschnittsweise absuchen, leere Abschnitte werden übersprungen
     hitPoint->x = searchStart.x;
     hitPoint->y = height;
+    int cx = searchStart.x / WORLD_CHUNK_SIZE;
+    const uint64_t mask = ~(uint64_t)0;
+    for (int y = searchStart.y; y < height; y = (y / WORLD_CHUNK_SIZE + 1) * WORLD_CHUNK_SIZE) {
+        const worldChunk_t *chunk = &chunks[cx + y / WORLD_CHUNK_SIZE * chunksX];
+        if (!chunk->pixels)
+            continue;
+        const uint64_t *column = chunk->columns + (searchStart.x % WORLD_CHUNK_SIZE) * WORLD_CHUNK_WORDS;
+        int localY = y % WORLD_CHUNK_SIZE;
+        for (int w = localY / WORLD_WORD_BITS; w < WORLD_CHUNK_WORDS; w++) {
+            uint64_t word = column[w];
+            if (w == localY / WORLD_WORD_BITS) // Bits oberhalb des Starts ignorieren
+                word &= mask << (localY % WORLD_WORD_BITS);
+            if (word) {
+                hitPoint->y = y - localY + w * WORLD_WORD_BITS + TrailingZeros(word);
+                return ERR_OK;
+            }
+        }
+    }
     return ERR_OK;
 }
 
@@ -387,42 +1276,951 @@ int World_CreateStartLocations(SDL_Rect aabb, int count, SDL_Point *locations) {
         SDL_Point hit = {0}; // Bei error VerticalLineIntersection hit = 0,0
         entityCollision_t collision;
         World_VerticalLineIntersection((SDL_Point){c * distance, 0}, &hit);
-        do { // AABB nach oben verschieben, bis der Raum total frei ist.
-            hit.y--;
-            if (hit.y < 0)
-                break;
+        int y = hit.y - 1;
+        while (y >= 0) { // AABB nach oben verschieben, bis der Raum total frei ist.
+            SDL_Rect box = {hit.x + aabb.x, y + aabb.y, aabb.w, aabb.h};
             collision.flags = 0; // Bei error CheckCollision collision.hasCollision = 0
-            World_CheckCollision((SDL_Rect){hit.x + aabb.x, hit.y + aabb.y, aabb.w, aabb.h}, &collision);
-        } while (collision.flags & ENTITY_COLLISION_WORLD);
+            World_CheckCollision(box, &collision);
+            if (!(collision.flags & ENTITY_COLLISION_WORLD))
+                break;
+            // Solange die oberste solide Zeile in der AABB liegt, kollidiert sie sicher
+            y -= box.y + box.h - FirstSolidRow(box);
+        }
+        hit.y = y < 0 ? -1 : y;
         locations[c - 1] = hit;
     }
 
     return ERR_OK;
 }
 
+int World_GetDistance(SDL_Point point, worldDistance_t *sample) {
+    // Fehlerüberprüfung
+    if (!loaded) {
+        SDL_Log("Keine Welt geladen! World_GetDistance()\n");
+        return ERR_FAIL;
+    }
+
+    if (!sample) {
+        SDL_Log("Rueckgabespeicher sample ungueltig! World_GetDistance()\n");
+        return ERR_NULLPARAMETER;
+    }
+
+    // Normale aus dem Gradienten, zeigt in Richtung zunehmender Distanz
+    sample->distance = DistanceAt(point.x, point.y);
+    sample->gradient.x = DistanceRawAt(point.x + WORLD_DISTANCE_GRADIENT, point.y) - DistanceRawAt(point.x - WORLD_DISTANCE_GRADIENT, point.y);
+    sample->gradient.y = DistanceRawAt(point.x, point.y + WORLD_DISTANCE_GRADIENT) - DistanceRawAt(point.x, point.y - WORLD_DISTANCE_GRADIENT);
+    float dx = (float)sample->gradient.x / WORLD_DISTANCE_SCALE;
+    float dy = (float)sample->gradient.y / WORLD_DISTANCE_SCALE;
+    float length = sqrtf(dx * dx + dy * dy);
+    sample->normal.x = length > 0.0f ? dx / length : 0.0f;
+    sample->normal.y = length > 0.0f ? dy / length : 0.0f;
+    return ERR_OK;
+}
+
+int World_Raycast(SDL_Point from, SDL_Point to, worldHit_t *hit) {
+    return World_Sweep((SDL_Rect){from.x, from.y, 1, 1}, (SDL_Point){to.x - from.x, to.y - from.y}, hit);
+}
+
+int World_Sweep(SDL_Rect aabb, SDL_Point delta, worldHit_t *hit) {
+    // Fehlerüberprüfung
+    if (!loaded) {
+        SDL_Log("Keine Welt geladen! World_Sweep()\n");
+        return ERR_FAIL;
+    }
+
+    if (!hit) {
+        SDL_Log("Rueckgabespeicher hit ungueltig! World_Sweep()\n");
+        return ERR_NULLPARAMETER;
+    }
+
+    if (aabb.w <= 0 || aabb.h <= 0) {
+        SDL_Log("Leere Kollisionsbox! World_Sweep()\n");
+        return ERR_PARAMETER;
+    }
+
+    int steps = abs(delta.x) > abs(delta.y) ? abs(delta.x) : abs(delta.y);
+    hit->hit = 0;
+    hit->position = (SDL_Point){aabb.x + delta.x, aabb.y + delta.y};
+    hit->contact = hit->position;
+    hit->fraction = 1.0f;
+    if (SweepSolid(aabb, delta, steps, 0, 0)) {
+        hit->hit = 1;
+        hit->position = (SDL_Point){aabb.x, aabb.y};
+        hit->contact = hit->position;
+        hit->fraction = 0.0f;
+        return ERR_OK;
+    }
+
+    // Freie Schritte galoppierend überspringen, bei Gelände die Schrittweite
+    // halbieren, bis der erste solide Schritt gefunden ist
+    int free = 0;
+    int stride = 1;
+    while (free < steps) {
+        int next = free + stride < steps ? free + stride : steps;
+        if (!SweepSolid(aabb, delta, steps, free + 1, next)) {
+            free = next;
+            stride *= 2;
+        } else if (next == free + 1) {
+            hit->hit = 1;
+            hit->position = (SDL_Point){aabb.x + SweepOffset(delta.x, free, steps), aabb.y + SweepOffset(delta.y, free, steps)};
+            hit->contact = (SDL_Point){aabb.x + SweepOffset(delta.x, next, steps), aabb.y + SweepOffset(delta.y, next, steps)};
+            hit->fraction = (float)next / steps;
+            break;
+        } else {
+            stride = (next - free) / 2;
+        }
+    }
+    return ERR_OK;
+}
+
 
 /*
  * Implementation Privater Funktionen
- * 
+ *
  */
 
-static int UpdateWorld() {
-    SDL_Renderer *renderer = SDLW_GetRenderer(); // Holt den Renderer von SDLW
-    if (!renderer) {
-        SDL_Log("SDLW nicht richtig initialisiert! World_Load()\n");
+static int CountRow(const worldChunk_t *chunk, int y, int x1, int x2) {
+    if (x1 >= x2)
+        return 0;
+    const uint64_t *words = chunk->rows + y * WORLD_CHUNK_WORDS;
+    int first = x1 / WORLD_WORD_BITS;
+    int last = (x2 - 1) / WORLD_WORD_BITS;
+    uint64_t firstMask = ~(uint64_t)0 << (x1 % WORLD_WORD_BITS);
+    uint64_t lastMask = ~(uint64_t)0 >> (WORLD_WORD_BITS - 1 - (x2 - 1) % WORLD_WORD_BITS);
+    if (first == last)
+        return PopCount(words[first] & firstMask & lastMask);
+
+    int count = PopCount(words[first] & firstMask);
+    for (int w = first + 1; w < last; w++)
+        count += PopCount(words[w]);
+    return count + PopCount(words[last] & lastMask);
+}
+
+static int CountRect(int x1, int y1, int x2, int y2) {
+    if (x1 >= x2 || y1 >= y2)
+        return 0;
+    const int stride = WORLD_CHUNK_SIZE + 1;
+    int count = 0;
+    // Jeder berührte Abschnitt trägt mit seiner Summentabelle bei
+    for (int cy = y1 / WORLD_CHUNK_SIZE; cy * WORLD_CHUNK_SIZE < y2; cy++) {
+        int originY = cy * WORLD_CHUNK_SIZE;
+        int top = y1 > originY ? y1 - originY : 0;
+        int bottom = y2 < originY + WORLD_CHUNK_SIZE ? y2 - originY : WORLD_CHUNK_SIZE;
+        for (int cx = x1 / WORLD_CHUNK_SIZE; cx * WORLD_CHUNK_SIZE < x2; cx++) {
+            const int32_t *integral = chunks[cx + cy * chunksX].integral;
+            if (!integral) // Leerer Abschnitt
+                continue;
+            int originX = cx * WORLD_CHUNK_SIZE;
+            int left = x1 > originX ? x1 - originX : 0;
+            int right = x2 < originX + WORLD_CHUNK_SIZE ? x2 - originX : WORLD_CHUNK_SIZE;
+            count += integral[bottom * stride + right] - integral[top * stride + right] - integral[bottom * stride + left] + integral[top * stride + left];
+        }
+    }
+    return count;
+}
+
+static int FirstSolidRow(SDL_Rect area) {
+    int x1 = area.x < 0 ? 0 : area.x;
+    int x2 = area.x + area.w > width ? width : area.x + area.w;
+    int y1 = area.y < 0 ? 0 : area.y;
+    int y2 = area.y + area.h > height ? height : area.y + area.h;
+    if (!CountRect(x1, y1, x2, y2))
+        return area.y + area.h;
+
+    // Kleinste Zeile, bis zu der bereits etwas solid ist
+    int low = y1, high = y2 - 1;
+    while (low < high) {
+        int middle = (low + high) / 2;
+        if (CountRect(x1, y1, x2, middle + 1))
+            high = middle;
+        else
+            low = middle + 1;
+    }
+    return low;
+}
+
+static int SweepOffset(int delta, int step, int steps) {
+    // Auf den nächsten Pixel runden, Hälften von 0 weg
+    long long scaled = 2LL * delta * step;
+    if (scaled >= 0)
+        return (int)((scaled + steps) / (2LL * steps));
+    return -(int)((-scaled + steps) / (2LL * steps));
+}
+
+static int SweepSolid(SDL_Rect aabb, SDL_Point delta, int steps, int first, int last) {
+    int x1 = aabb.x, x2 = aabb.x, y1 = aabb.y, y2 = aabb.y;
+    if (last > 0) {
+        int firstX = SweepOffset(delta.x, first, steps), lastX = SweepOffset(delta.x, last, steps);
+        int firstY = SweepOffset(delta.y, first, steps), lastY = SweepOffset(delta.y, last, steps);
+        x1 += firstX < lastX ? firstX : lastX;
+        x2 += firstX < lastX ? lastX : firstX;
+        y1 += firstY < lastY ? firstY : lastY;
+        y2 += firstY < lastY ? lastY : firstY;
+    }
+    x2 += aabb.w;
+    y2 += aabb.h;
+    // Auf die Welt beschränken, ausserhalb ist nichts solid
+    x1 = x1 < 0 ? 0 : x1;
+    y1 = y1 < 0 ? 0 : y1;
+    x2 = x2 > width ? width : x2;
+    y2 = y2 > height ? height : y2;
+    return CountRect(x1, y1, x2, y2) > 0;
+}
+
+static int PopCount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    // Paarweise Summen der Bits
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (int)((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+static int TrailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    // Alle Bits unterhalb des niederwertigsten gesetzten Bits zählen
+    return PopCount((word & (~word + 1)) - 1);
+#endif
+}
+
+static SDL_Rect SpriteTransform(const sprite_t *sprite, const SDL_Surface *pixels, worldTransform_t *transform) {
+    SDL_Rect bounds = {0};
+    transform->source = sprite->source; // Ohne Ausschnitt die ganze Textur
+    if (transform->source.w <= 0 || transform->source.h <= 0)
+        transform->source = (SDL_Rect){0, 0, pixels->w, pixels->h};
+    transform->destW = sprite->destination.w;
+    transform->destH = sprite->destination.h;
+    if (transform->destW <= 0 || transform->destH <= 0)
+        return bounds;
+
+    // Zielrechteck und Pivot wie bei SDLW_DrawTexture()
+    transform->destX = sprite->destination.x + sprite->position.x - transform->destW / 2;
+    transform->destY = sprite->destination.y + sprite->position.y - transform->destH / 2;
+    transform->pivotX = transform->destX + sprite->pivot.x + transform->destW / 2;
+    transform->pivotY = transform->destY + sprite->pivot.y + transform->destH / 2;
+    double angle = sprite->rotation * M_PI / 180.0;
+    transform->cosAngle = cos(angle);
+    transform->sinAngle = sin(angle);
+
+    // Umschliessendes Rechteck der im Uhrzeigersinn gedrehten Zielfläche
+    double minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (int corner = 0; corner < 4; corner++) {
+        double dx = transform->destX + (corner & 1) * transform->destW - transform->pivotX;
+        double dy = transform->destY + (corner >> 1) * transform->destH - transform->pivotY;
+        double x = transform->pivotX + dx * transform->cosAngle - dy * transform->sinAngle;
+        double y = transform->pivotY + dx * transform->sinAngle + dy * transform->cosAngle;
+        minX = x < minX ? x : minX;
+        maxX = x > maxX ? x : maxX;
+        minY = y < minY ? y : minY;
+        maxY = y > maxY ? y : maxY;
+    }
+    int x1 = minX < 0 ? 0 : (int)floor(minX);
+    int y1 = minY < 0 ? 0 : (int)floor(minY);
+    int x2 = maxX > width ? width : (int)ceil(maxX);
+    int y2 = maxY > height ? height : (int)ceil(maxY);
+    if (x1 < x2 && y1 < y2)
+        bounds = (SDL_Rect){x1, y1, x2 - x1, y2 - y1};
+    return bounds;
+}
+
+static void BlendChunk(worldChunk_t *chunk, SDL_Point origin, SDL_Rect area, const worldTransform_t *transform, const SDL_Surface *pixels, int stamp) {
+    // Jeden Pixel zurück in die Textur drehen und dort abtasten
+    for (int y = area.y; y < area.y + area.h; y++) {
+        uint32_t *row = chunk->pixels + (y - origin.y) * WORLD_CHUNK_SIZE - origin.x;
+        for (int x = area.x; x < area.x + area.w; x++) {
+            double dx = x + 0.5 - transform->pivotX;
+            double dy = y + 0.5 - transform->pivotY;
+            double localX = transform->pivotX + dx * transform->cosAngle + dy * transform->sinAngle - transform->destX;
+            double localY = transform->pivotY - dx * transform->sinAngle + dy * transform->cosAngle - transform->destY;
+            if (localX < 0 || localY < 0 || localX >= transform->destW || localY >= transform->destH)
+                continue;
+            int sourceX = transform->source.x + (int)(localX * transform->source.w / transform->destW);
+            int sourceY = transform->source.y + (int)(localY * transform->source.h / transform->destH);
+            if (sourceX < 0 || sourceY < 0 || sourceX >= pixels->w || sourceY >= pixels->h)
+                continue;
+            uint32_t src = ((const uint32_t *)((const uint8_t *)pixels->pixels + sourceY * pixels->pitch))[sourceX];
+            uint32_t srcAlpha = src & 0xFF;
+            uint32_t dst = row[x];
+            uint32_t dstAlpha = dst & 0xFF;
+            if (!stamp) { // Ausschneiden wo src_alpha > 0 ist, Farbe bleibt
+                row[x] = (dst & 0xFFFFFF00) | ((dstAlpha * (255 - srcAlpha) + 127) / 255);
+                continue;
+            }
+            // Stempel zeichnet dort wo dst_alpha < 1 ist, Alpha wird zusammengezählt
+            uint32_t result = srcAlpha + dstAlpha > 255 ? 255 : srcAlpha + dstAlpha;
+            for (int shift = 8; shift < 32; shift += 8) {
+                uint32_t channel = (((src >> shift) & 0xFF) * (255 - dstAlpha) + ((dst >> shift) & 0xFF) * dstAlpha + 127) / 255;
+                result |= channel << shift;
+            }
+            row[x] = result;
+        }
+    }
+}
+
+static int BlendSprite(const sprite_t *sprite, SDL_Rect *bounds) {
+    (*bounds) = (SDL_Rect){0};
+
+    // Die Pixel der Maske oder des Stempels vom SDLW holen
+    SDL_Surface *pixels;
+    resourceType_t type;
+    if (SDLW_GetTexturePixels(sprite->texture, &pixels, &type)) {
+        SDL_Log("Textur ist weder Maske noch Stempel! World_Modify()\n");
+        return ERR_PARAMETER;
+    }
+    int stamp = type == RESOURCETYPE_TEXTURE_BM_STAMP;
+
+    worldTransform_t transform;
+    (*bounds) = SpriteTransform(sprite, pixels, &transform);
+    if (bounds->w <= 0 || bounds->h <= 0)
+        return ERR_OK;
+    for (int cy = bounds->y / WORLD_CHUNK_SIZE; cy * WORLD_CHUNK_SIZE < bounds->y + bounds->h; cy++) {
+        for (int cx = bounds->x / WORLD_CHUNK_SIZE; cx * WORLD_CHUNK_SIZE < bounds->x + bounds->w; cx++) {
+            worldChunk_t *chunk = &chunks[cx + cy * chunksX];
+            SDL_Point origin = {cx * WORLD_CHUNK_SIZE, cy * WORLD_CHUNK_SIZE};
+            SDL_Rect area;
+            area.x = bounds->x > origin.x ? bounds->x : origin.x;
+            area.y = bounds->y > origin.y ? bounds->y : origin.y;
+            area.w = (bounds->x + bounds->w < origin.x + WORLD_CHUNK_SIZE ? bounds->x + bounds->w : origin.x + WORLD_CHUNK_SIZE) - area.x;
+            area.h = (bounds->y + bounds->h < origin.y + WORLD_CHUNK_SIZE ? bounds->y + bounds->h : origin.y + WORLD_CHUNK_SIZE) - area.y;
+            SDL_Rect dirty = {area.x - origin.x, area.y - origin.y, area.w, area.h};
+            if (!chunk->pixels) {
+                if (!stamp) // Aus leeren Abschnitten kann nichts ausgeschnitten werden
+                    continue;
+                int errCode = AllocateChunk(chunk);
+                if (errCode)
+                    return errCode;
+                dirty = (SDL_Rect){0, 0, WORLD_CHUNK_SIZE, WORLD_CHUNK_SIZE}; // Neue Textur vollständig beschreiben
+            }
+            BlendChunk(chunk, origin, area, &transform, pixels, stamp);
+            MarkDirty(chunk, dirty);
+            if (settle) { // Der Abschnitt und Gelände darüber können nun fallen
+                chunk->settling = 1;
+                if (cy > 0 && chunks[cx + (cy - 1) * chunksX].pixels)
+                    chunks[cx + (cy - 1) * chunksX].settling = 1;
+            }
+        }
+    }
+    return ERR_OK;
+}
+
+static void MarkDirty(worldChunk_t *chunk, SDL_Rect area) {
+    chunk->touched = 1;
+    if (chunk->dirty.w > 0) { // Mit vorherigen Änderungen zusammenfassen
+        SDL_Rect both;
+        SDL_UnionRect(&chunk->dirty, &area, &both);
+        area = both;
+    }
+    chunk->dirty = area;
+}
+
+static int FlushChunks(int distance) {
+    for (int c = 0; c < chunksX * chunksY; c++) {
+        SDL_Rect dirty = chunks[c].dirty;
+        if (dirty.w <= 0)
+            continue;
+        int errCode = UpdateChunk(&chunks[c], dirty);
+        chunks[c].dirty = (SDL_Rect){0};
+        if (!errCode && distance) {
+            dirty.x += (c % chunksX) * WORLD_CHUNK_SIZE;
+            dirty.y += (c / chunksX) * WORLD_CHUNK_SIZE;
+            errCode = UpdateDistance(dirty);
+        }
+        if (errCode)
+            return errCode;
+    }
+    return ERR_OK;
+}
+
+static void StartPool() {
+    // Der Hauptthread arbeitet bei jedem Durchgang mit
+    int threadCount = SDL_GetCPUCount() - 1;
+    if (threadCount > WORLD_MAX_SETTLE_THREADS)
+        threadCount = WORLD_MAX_SETTLE_THREADS;
+    pool.count = 0;
+    pool.pass = NULL;
+    if (threadCount < 1)
+        return;
+    pool.start = SDL_CreateSemaphore(0);
+    pool.done = SDL_CreateSemaphore(0);
+    if (!pool.start || !pool.done) {
+        SDL_Log("SDL CreateSemaphore fehler! [%s]\n", SDL_GetError());
+        StopPool();
+        return;
+    }
+    for (; pool.count < threadCount; pool.count++) {
+        pool.threads[pool.count] = SDL_CreateThread(SettleWorker, "World_Settle", NULL);
+        if (!pool.threads[pool.count]) // Mit weniger Workern weiterfahren
+            break;
+    }
+}
+
+static void StopPool() {
+    pool.pass = NULL;
+    for (int i = 0; i < pool.count; i++)
+        SDL_SemPost(pool.start);
+    for (int i = 0; i < pool.count; i++)
+        SDL_WaitThread(pool.threads[i], NULL);
+    if (pool.start)
+        SDL_DestroySemaphore(pool.start);
+    if (pool.done)
+        SDL_DestroySemaphore(pool.done);
+    pool.start = NULL;
+    pool.done = NULL;
+    pool.count = 0;
+}
+
+static void SettlePass(worldSettlePass_t *pass, int awake) {
+    SDL_AtomicSet(&pass->next, 0);
+    // Worker lohnen sich erst ab einigen wachen Abschnitten
+    int threadCount = 0;
+    if (awake >= WORLD_SETTLE_THREAD_CHUNKS) {
+        threadCount = pool.count;
+        if (threadCount > pass->count - 1)
+            threadCount = pass->count - 1;
+    }
+
+    // Die Semaphoren ordnen den Zugriff auf pool.pass und die Abschnitte
+    pool.pass = pass;
+    for (int i = 0; i < threadCount; i++)
+        SDL_SemPost(pool.start);
+    SettleBands(pass);
+    for (int i = 0; i < threadCount; i++)
+        SDL_SemWait(pool.done);
+    pool.pass = NULL;
+}
+
+static int SDLCALL SettleWorker(void *data) {
+    (void)data;
+    for (;;) {
+        SDL_SemWait(pool.start);
+        worldSettlePass_t *pass = pool.pass;
+        if (!pass)
+            return 0;
+        SettleBands(pass);
+        SDL_SemPost(pool.done);
+    }
+}
+
+static void SettleBands(worldSettlePass_t *pass) {
+    int i;
+    while ((i = SDL_AtomicAdd(&pass->next, 1)) < pass->count) {
+        for (int cx = 0; cx < chunksX; cx++)
+            SettleChunk(cx, pass->parity + 2 * i);
+    }
+}
+
+static void SettleChunk(int cx, int cy) {
+    worldChunk_t *chunk = &chunks[cx + cy * chunksX];
+    if (!chunk->settling || !chunk->pixels)
+        return;
+    worldChunk_t *below = cy + 1 < chunksY ? &chunks[cx + (cy + 1) * chunksX] : NULL;
+    int floor = height - 1 - cy * WORLD_CHUNK_SIZE; // Unterste Zeile der Welt relativ zum Abschnitt
+
+    int top = WORLD_CHUNK_SIZE, bottom = -1, left = WORLD_CHUNK_SIZE, right = -1;
+    for (int y = (floor < WORLD_CHUNK_SIZE ? floor : WORLD_CHUNK_SIZE) - 1; y >= 0; y--) {
+        // Ziel ist die Zeile darunter, eventuell im nächsten Abschnitt
+        worldChunk_t *target = chunk;
+        int targetY = y + 1;
+        if (targetY == WORLD_CHUNK_SIZE) {
+            target = below;
+            targetY = 0;
+        }
+        if (!target->pixels) // Nur angelegt, wenn die Zeile leer ist
+            continue;
+        uint64_t *row = chunk->rows + y * WORLD_CHUNK_WORDS;
+        uint64_t *under = target->rows + targetY * WORLD_CHUNK_WORDS;
+        int rowLeft = WORLD_CHUNK_SIZE, rowRight = -1;
+        for (int w = 0; w < WORLD_CHUNK_WORDS; w++) {
+            uint64_t falling = row[w] & ~under[w];
+            if (!falling)
+                continue;
+            row[w] &= ~falling;
+            under[w] |= falling;
+            for (; falling; falling &= falling - 1) {
+                int x = w * WORLD_WORD_BITS + TrailingZeros(falling);
+                uint32_t *source = &chunk->pixels[x + y * WORLD_CHUNK_SIZE];
+                target->pixels[x + targetY * WORLD_CHUNK_SIZE] = *source;
+                *source &= 0xFFFFFF00; // Durchsichtig, Farbe bleibt wie beim Ausschneiden
+                rowLeft = x < rowLeft ? x : rowLeft;
+                rowRight = x;
+            }
+        }
+        if (rowRight < 0)
+            continue;
+        left = rowLeft < left ? rowLeft : left;
+        right = rowRight > right ? rowRight : right;
+        top = y;
+        if (bottom < 0)
+            bottom = target == chunk ? targetY : y;
+        if (target != chunk) { // Das darunterliegende Band ruht während diesem Durchgang
+            MarkDirty(target, (SDL_Rect){rowLeft, 0, rowRight - rowLeft + 1, 1});
+            target->fed = 1;
+        }
+        if (y == 0)
+            chunk->lostTop = 1;
+    }
+    if (bottom < 0)
+        return;
+    chunk->moved = 1;
+    MarkDirty(chunk, (SDL_Rect){left, top, right - left + 1, bottom - top + 1});
+}
+
+static int UpdateChunk(worldChunk_t *chunk, SDL_Rect area) {
+    // Ganze Zeilen des Abschnitts packen, das sind nur wenige Wörter
+    for (int y = area.y; y < area.y + area.h; y++)
+        WorldKernel_PackAlpha(chunk->pixels + y * WORLD_CHUNK_SIZE, WORLD_CHUNK_SIZE, chunk->rows + y * WORLD_CHUNK_WORDS);
+
+    // Spaltenweises Raster im Bereich nachführen
+    for (int x = area.x; x < area.x + area.w; x++) {
+        uint64_t *column = chunk->columns + x * WORLD_CHUNK_WORDS;
+        uint64_t rowBit = (uint64_t)1 << (x % WORLD_WORD_BITS);
+        for (int y = area.y; y < area.y + area.h; y++) {
+            uint64_t columnBit = (uint64_t)1 << (y % WORLD_WORD_BITS);
+            if (chunk->rows[y * WORLD_CHUNK_WORDS + x / WORLD_WORD_BITS] & rowBit)
+                column[y / WORLD_WORD_BITS] |= columnBit;
+            else
+                column[y / WORLD_WORD_BITS] &= ~columnBit;
+        }
+    }
+    UpdateIntegral(chunk, area);
+
+    // Nur den veränderten Bereich übertragen, die Zeilenlänge bleibt die des Abschnitts
+    const int pitch = WORLD_CHUNK_SIZE * (int)sizeof(uint32_t);
+    if (SDL_UpdateTexture(chunk->texture, &area, chunk->pixels + area.x + area.y * WORLD_CHUNK_SIZE, pitch)) {
+        SDL_Log("SDL_UpdateTexture Error! [%s]\n", SDL_GetError());
         return ERR_FAIL;
     }
+    return ERR_OK;
+}
+
+static void UpdateIntegral(worldChunk_t *chunk, SDL_Rect area) {
+    const int stride = WORLD_CHUNK_SIZE + 1;
+    int x0 = area.x;
+    memset(integralDelta, 0, sizeof(integralDelta));
+
+    // Zeilen des Bereichs, links davon bleibt die Zeilensumme gleich
+    for (int y = area.y; y < area.y + area.h; y++) {
+        const uint64_t *words = chunk->rows + y * WORLD_CHUNK_WORDS;
+        const int32_t *above = chunk->integral + y * stride;
+        int32_t *row = chunk->integral + (y + 1) * stride;
+        int32_t running = CountRow(chunk, y, 0, x0);
+        for (int x = x0; x < WORLD_CHUNK_SIZE; x++) {
+            running += (int32_t)((words[x / WORLD_WORD_BITS] >> (x % WORLD_WORD_BITS)) & 1);
+            int32_t value = above[x + 1] + running;
+            integralDelta[x + 1] = value - row[x + 1];
+            row[x + 1] = value;
+        }
+    }
+
+    // Darunter ändert sich jede Zeile um die Differenz der letzten
+    for (int y = area.y + area.h; y < WORLD_CHUNK_SIZE; y++)
+        WorldKernel_AddRow(chunk->integral + (y + 1) * stride + x0 + 1, integralDelta + x0 + 1, WORLD_CHUNK_SIZE - x0);
+}
 
-    if (SDL_SetRenderTarget(renderer, foreground.texture)) { // Bereitet Vordergrund zum Lesen vor
-        SDL_Log("SDL_SetRenderTarget Error! [%s]\n", SDL_GetError());
+static int AllocateChunk(worldChunk_t *chunk) {
+    // Distanzfelder zuerst, ein Fehler lässt den Abschnitt so leer
+    if (AllocateDistance((int)(chunk - chunks)))
+        return ERR_MEMORY;
+
+    // Ein Block für alle Puffer, erste Zeile und Spalte der Summentabelle bleiben 0
+    const size_t pixelBytes = sizeof(uint32_t) * WORLD_CHUNK_SIZE * WORLD_CHUNK_SIZE;
+    const size_t bitBytes = sizeof(uint64_t) * WORLD_CHUNK_SIZE * WORLD_CHUNK_WORDS;
+    const size_t integralBytes = sizeof(int32_t) * (WORLD_CHUNK_SIZE + 1) * (WORLD_CHUNK_SIZE + 1);
+    uint8_t *block = calloc(1, pixelBytes + 2 * bitBytes + integralBytes);
+    if (!block) {
+        SDL_Log("Memory Error! AllocateChunk()\n");
+        return ERR_MEMORY;
+    }
+
+    // Textur wird nur von der CPU beschrieben
+    chunk->texture = SDL_CreateTexture(SDLW_GetRenderer(), SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, WORLD_CHUNK_SIZE, WORLD_CHUNK_SIZE);
+    if (!chunk->texture) {
+        free(block);
+        SDL_Log("SDL CreateTexture fehler! [%s]\n", SDL_GetError());
         return ERR_FAIL;
     }
+    SDL_SetTextureBlendMode(chunk->texture, SDL_BLENDMODE_BLEND);
+
+    chunk->pixels = (uint32_t *)block;
+    chunk->rows = (uint64_t *)(block + pixelBytes);
+    chunk->columns = (uint64_t *)(block + pixelBytes + bitBytes);
+    chunk->integral = (int32_t *)(block + pixelBytes + 2 * bitBytes);
+    return ERR_OK;
+}
+
+static int AllocateDistance(int c) {
+    // WORLD_DISTANCE_RANGE ist kleiner als ein Abschnitt, Abstände unter der
+    // Grenze reichen daher höchstens in die direkten Nachbarn
+    int chunkX = c % chunksX;
+    int chunkY = c / chunksX;
+    for (int y = chunkY - 1; y <= chunkY + 1; y++) {
+        for (int x = chunkX - 1; x <= chunkX + 1; x++) {
+            if (x < 0 || y < 0 || x >= chunksX || y >= chunksY || chunks[x + y * chunksX].distance)
+                continue;
+            int16_t *distance = malloc(sizeof(int16_t) * WORLD_CHUNK_PIXELS);
+            if (!distance) {
+                SDL_Log("Memory Error! AllocateDistance()\n");
+                return ERR_MEMORY;
+            }
+            // Bisher lag kein Gelände in Reichweite
+            for (int i = 0; i < WORLD_CHUNK_PIXELS; i++)
+                distance[i] = WORLD_DISTANCE_RANGE * WORLD_DISTANCE_SCALE;
+            chunks[x + y * chunksX].distance = distance;
+        }
+    }
+    return ERR_OK;
+}
+
+static void FreeChunks() {
+    for (int c = 0; chunks && c < chunksX * chunksY; c++) {
+        if (chunks[c].texture)
+            SDL_DestroyTexture(chunks[c].texture);
+        free(chunks[c].pixels); // Anfang des Blocks
+        free(chunks[c].pristine);
+        free(chunks[c].distance);
+    }
+    free(chunks);
+    chunks = NULL;
+    FreeDistanceBuffer();
+}
+
+static void FreeDistanceBuffer() {
+    free(distanceBuffer.grid);
+    free(distanceBuffer.vertices);
+    distanceBuffer.grid = NULL;
+    distanceBuffer.vertices = NULL;
+    distanceBuffer.gridSize = 0;
+    distanceBuffer.vertexCount = 0;
+}
+
+static void DistanceSeeds(float *toFree, float *toSolid, int x, int y, int w, float far) {
+    const worldChunk_t *chunkRow = chunks + y / WORLD_CHUNK_SIZE * chunksX;
+    const int row = (y % WORLD_CHUNK_SIZE) * WORLD_CHUNK_WORDS;
+    for (int i = 0; i < w;) {
+        // Ein Wort oder der Rest davon pro Durchgang
+        const worldChunk_t *chunk = &chunkRow[(x + i) / WORLD_CHUNK_SIZE];
+        int localX = (x + i) % WORLD_CHUNK_SIZE;
+        int bit = localX % WORLD_WORD_BITS;
+        int end = i + (WORLD_WORD_BITS - bit < w - i ? WORLD_WORD_BITS - bit : w - i);
+        uint64_t word = chunk->rows ? chunk->rows[row + localX / WORLD_WORD_BITS] >> bit : 0;
+        for (; i < end; i++, word >>= 1) {
+            toFree[i] = word & 1 ? far : 0.0f;
+            toSolid[i] = word & 1 ? 0.0f : far;
+        }
+    }
+}
+
+static float DistanceAt(int x, int y) {
+    return (float)DistanceRawAt(x, y) / WORLD_DISTANCE_SCALE;
+}
 
-    // Liest die Daten vom Vordergrund
-    SDL_Rect r = (SDL_Rect){0, 0, width, height};
+static int DistanceRawAt(int x, int y) {
+    if (x < 0 || y < 0 || x >= width || y >= height)
+        return WORLD_DISTANCE_RANGE * WORLD_DISTANCE_SCALE;
+    const worldChunk_t *chunk = &chunks[x / WORLD_CHUNK_SIZE + y / WORLD_CHUNK_SIZE * chunksX];
+    if (!chunk->distance) // Kein Gelände in Reichweite
+        return WORLD_DISTANCE_RANGE * WORLD_DISTANCE_SCALE;
+    return chunk->distance[x % WORLD_CHUNK_SIZE + y % WORLD_CHUNK_SIZE * WORLD_CHUNK_SIZE];
+}
 
-    SDL_RenderReadPixels(renderer, &r, SDL_PIXELFORMAT_RGBA8888, worldCollision, width * 4);
-    SDL_SetRenderTarget(renderer, NULL);
+static int UpdateDistance(SDL_Rect area) {
+    // Neu zu berechnender Bereich und dessen Umgebung, beide in der Welt
+    int x1 = area.x - WORLD_DISTANCE_RANGE > 0 ? area.x - WORLD_DISTANCE_RANGE : 0;
+    int y1 = area.y - WORLD_DISTANCE_RANGE > 0 ? area.y - WORLD_DISTANCE_RANGE : 0;
+    int x2 = area.x + area.w + WORLD_DISTANCE_RANGE < width ? area.x + area.w + WORLD_DISTANCE_RANGE : width;
+    int y2 = area.y + area.h + WORLD_DISTANCE_RANGE < height ? area.y + area.h + WORLD_DISTANCE_RANGE : height;
+    if (x1 >= x2 || y1 >= y2)
+        return ERR_OK;
+    int windowX = x1 - WORLD_DISTANCE_RANGE > 0 ? x1 - WORLD_DISTANCE_RANGE : 0;
+    int windowY = y1 - WORLD_DISTANCE_RANGE > 0 ? y1 - WORLD_DISTANCE_RANGE : 0;
+    int windowW = (x2 + WORLD_DISTANCE_RANGE < width ? x2 + WORLD_DISTANCE_RANGE : width) - windowX;
+    int windowH = (y2 + WORLD_DISTANCE_RANGE < height ? y2 + WORLD_DISTANCE_RANGE : height) - windowY;
+    int n = windowW > windowH ? windowW : windowH;
+
+    // Abstände zum Gelände und zum freien Raum, danach Zeilenpuffer. Der
+    // Puffer wird nur vergrössert, der alte Inhalt ist nicht mehr gültig.
+    size_t gridSize = 2 * (size_t)windowW * windowH + 3 * n + 1;
+    if (distanceBuffer.gridSize < gridSize || distanceBuffer.vertexCount < n) {
+        int vertexCount = n > distanceBuffer.vertexCount ? n : distanceBuffer.vertexCount;
+        if (gridSize < distanceBuffer.gridSize)
+            gridSize = distanceBuffer.gridSize;
+        FreeDistanceBuffer();
+        distanceBuffer.grid = malloc(sizeof(float) * gridSize);
+        distanceBuffer.vertices = malloc(sizeof(int) * vertexCount);
+        if (!distanceBuffer.grid || !distanceBuffer.vertices) {
+            SDL_Log("Memory Error! UpdateDistance()\n");
+            FreeDistanceBuffer();
+            return ERR_MEMORY;
+        }
+        distanceBuffer.gridSize = gridSize;
+        distanceBuffer.vertexCount = vertexCount;
+    }
+    float *grid = distanceBuffer.grid;
+    int *vertices = distanceBuffer.vertices;
+    float *line = grid + 2 * windowW * windowH;
+    float *result = line + n;
+    float *bounds = result + n;
+
+    // Grössere Abstände werden ohnehin begrenzt, so bleiben die Werte exakt
+    const float far = (float)(4 * WORLD_DISTANCE_RANGE * WORLD_DISTANCE_RANGE);
+    for (int y = 0; y < windowH; y++)
+        DistanceSeeds(grid + y * windowW, grid + (windowH + y) * windowW, windowX, windowY + y, windowW, far);
+    for (int target = 0; target < 2; target++) {
+        float *field = grid + target * windowW * windowH;
+        // Spaltenweise Abstand zum nächsten Ziel, vorwärts und rückwärts, mit
+        // einem laufenden Abstand pro Spalte in line
+        for (int x = 0; x < windowW; x++)
+            line[x] = far;
+        for (int y = 0; y < windowH; y++) {
+            float *cells = field + y * windowW;
+            for (int x = 0; x < windowW; x++) {
+                line[x] = cells[x] == 0.0f ? 0.0f : line[x] + 1.0f;
+                cells[x] = line[x];
+            }
+        }
+        for (int x = 0; x < windowW; x++)
+            line[x] = far;
+        for (int y = windowH - 1; y >= 0; y--) {
+            float *cells = field + y * windowW;
+            for (int x = 0; x < windowW; x++) {
+                line[x] = cells[x] == 0.0f ? 0.0f : line[x] + 1.0f;
+                if (line[x] < cells[x])
+                    cells[x] = line[x];
+                cells[x] = cells[x] * cells[x] < far ? cells[x] * cells[x] : far;
+            }
+        }
+        // Zeilenweise über die quadrierten Spaltenabstände
+        for (int y = 0; y < windowH; y++) {
+            memcpy(line, field + y * windowW, sizeof(float) * windowW);
+            DistanceTransform(line, result, windowW, vertices, bounds);
+            memcpy(field + y * windowW, result, sizeof(float) * windowW);
+        }
+    }
 
+    // Positiv im freien Raum, negativ im Gelände, 0 liegt zwischen zwei Pixeln.
+    // Abschnitte ohne Distanzfeld haben kein Gelände in Reichweite.
+    for (int y = y1; y < y2; y++) {
+        const int row = (y % WORLD_CHUNK_SIZE) * WORLD_CHUNK_SIZE;
+        for (int x = x1; x < x2;) {
+            worldChunk_t *chunk = &chunks[x / WORLD_CHUNK_SIZE + y / WORLD_CHUNK_SIZE * chunksX];
+            int originX = x - x % WORLD_CHUNK_SIZE;
+            int end = originX + WORLD_CHUNK_SIZE < x2 ? originX + WORLD_CHUNK_SIZE : x2;
+            for (; chunk->distance && x < end; x++) {
+                int cell = (x - windowX) + (y - windowY) * windowW;
+                float value = grid[cell] > 0.0f ? 0.5f - sqrtf(grid[cell]) : sqrtf(grid[windowW * windowH + cell]) - 0.5f;
+                if (value > WORLD_DISTANCE_RANGE)
+                    value = WORLD_DISTANCE_RANGE;
+                if (value < -WORLD_DISTANCE_RANGE)
+                    value = -WORLD_DISTANCE_RANGE;
+                chunk->distance[row + x - originX] = (int16_t)lroundf(value * WORLD_DISTANCE_SCALE);
+            }
+            x = end;
+        }
+    }
     return ERR_OK;
 }
+
+static void DistanceTransform(const float *f, float *d, int n, int *vertices, float *bounds) {
+    // Untere Einhüllende der Parabeln (q - v)^2 + f(v) aufbauen
+    int k = 0;
+    vertices[0] = 0;
+    bounds[0] = -HUGE_VALF;
+    bounds[1] = HUGE_VALF;
+    for (int q = 1; q < n; q++) {
+        float s;
+        for (;;) {
+            int v = vertices[k];
+            // Schnittpunkt, umgeformt damit keine grossen Quadrate auftreten
+            s = (f[q] - f[v]) / (2.0f * (q - v)) + (q + v) / 2.0f;
+            if (s > bounds[k] || k == 0)
+                break;
+            k--;
+        }
+        k++;
+        vertices[k] = q;
+        bounds[k] = s;
+        bounds[k + 1] = HUGE_VALF;
+    }
+    // Einhüllende abtasten
+    k = 0;
+    for (int q = 0; q < n; q++) {
+        while (bounds[k + 1] < q)
+            k++;
+        int v = vertices[k];
+        d[q] = (float)(q - v) * (q - v) + f[v];
+    }
+}
+
+static int SnapshotWrite(worldSnapshot_t *snapshot, size_t *capacity, const void *data, size_t size) {
+    if (snapshot->size + size > *capacity) { // Speicher verdoppeln
+        size_t grown = *capacity ? *capacity * 2 : WORLD_MIN_SNAPSHOT;
+        while (grown < snapshot->size + size)
+            grown *= 2;
+        uint8_t *buffer = malloc(grown);
+        if (!buffer) {
+            SDL_Log("Memory Error! SnapshotWrite()\n");
+            return ERR_MEMORY;
+        }
+        if (snapshot->data) {
+            memcpy(buffer, snapshot->data, snapshot->size);
+            free(snapshot->data);
+        }
+        snapshot->data = buffer;
+        *capacity = grown;
+    }
+    memcpy((uint8_t *)snapshot->data + snapshot->size, data, size);
+    snapshot->size += size;
+    return ERR_OK;
+}
+
+static int SnapshotChunk(worldSnapshot_t *snapshot, size_t *capacity, int c) {
+    const worldChunk_t *chunk = &chunks[c];
+    size_t start = snapshot->size;
+    worldSnapshotChunk_t entry = {.index = c};
+    int errCode = SnapshotWrite(snapshot, capacity, &entry, sizeof(entry));
+
+    // Läufe gleicher Art, ein Lauf ist nie länger als der Abschnitt
+    UnpackPristine(chunk, pristinePixels);
+    int changed = 0;
+    int runType = SnapshotRun(chunk, pristinePixels, 0);
+    int runStart = 0;
+    for (int i = 1; !errCode && i <= WORLD_CHUNK_PIXELS; i++) {
+        int type = i < WORLD_CHUNK_PIXELS ? SnapshotRun(chunk, pristinePixels, i) : -1;
+        if (type == runType)
+            continue;
+        uint16_t head = (uint16_t)(runType << WORLD_RUN_TYPE_SHIFT | (i - runStart - 1));
+        errCode = SnapshotWrite(snapshot, capacity, &head, sizeof(head));
+        if (!errCode && runType == WORLD_RUN_LITERAL)
+            errCode = SnapshotWrite(snapshot, capacity, chunk->pixels + runStart, sizeof(uint32_t) * (i - runStart));
+        changed |= runType != WORLD_RUN_SAME;
+        runType = type;
+        runStart = i;
+    }
+    if (errCode)
+        return errCode;
+
+    if (!changed) { // Wieder im geladenen Zustand
+        snapshot->size = start;
+        return ERR_OK;
+    }
+    entry.size = (int32_t)(snapshot->size - start - sizeof(entry));
+    memcpy((uint8_t *)snapshot->data + start, &entry, sizeof(entry));
+    return ERR_OK;
+}
+
+static int SnapshotRun(const worldChunk_t *chunk, const uint32_t *pristine, int i) {
+    uint32_t pixel = chunk->pixels[i];
+    if (!(pixel & 0xFF))
+        return pristine[i] & 0xFF ? WORLD_RUN_FREE : WORLD_RUN_SAME;
+    return pixel == pristine[i] ? WORLD_RUN_SAME : WORLD_RUN_LITERAL;
+}
+
+static int SnapshotValidate(const worldSnapshot_t *snapshot) {
+    worldSnapshotHeader_t header;
+    if (snapshot->size < sizeof(header))
+        return ERR_PARAMETER;
+    memcpy(&header, snapshot->data, sizeof(header));
+    if (strncmp(header.key, loadedConfig->key, sizeof(header.key)) || header.width != width || header.height != height)
+        return ERR_PARAMETER;
+
+    // Alle Einträge und Läufe ablaufen, ohne etwas zu verändern
+    const uint8_t *data = snapshot->data;
+    size_t offset = sizeof(header);
+    int previous = -1;
+    while (offset < snapshot->size) {
+        worldSnapshotChunk_t entry;
+        if (snapshot->size - offset < sizeof(entry))
+            return ERR_PARAMETER;
+        memcpy(&entry, data + offset, sizeof(entry));
+        offset += sizeof(entry);
+        if (entry.index <= previous || entry.index >= chunksX * chunksY || entry.size < 0 || (size_t)entry.size > snapshot->size - offset)
+            return ERR_PARAMETER;
+        size_t end = offset + entry.size;
+        int pixels = 0;
+        while (offset < end) {
+            uint16_t head;
+            if (end - offset < sizeof(head))
+                return ERR_PARAMETER;
+            memcpy(&head, data + offset, sizeof(head));
+            offset += sizeof(head);
+            int type = head >> WORLD_RUN_TYPE_SHIFT;
+            int count = (head & ((1 << WORLD_RUN_TYPE_SHIFT) - 1)) + 1;
+            if (type > WORLD_RUN_LITERAL || pixels + count > WORLD_CHUNK_PIXELS)
+                return ERR_PARAMETER;
+            if (type == WORLD_RUN_LITERAL) {
+                if (end - offset < sizeof(uint32_t) * count)
+                    return ERR_PARAMETER;
+                offset += sizeof(uint32_t) * count;
+            }
+            pixels += count;
+        }
+        if (pixels != WORLD_CHUNK_PIXELS)
+            return ERR_PARAMETER;
+        previous = entry.index;
+    }
+    return ERR_OK;
+}
+
+static int RestoreChunk(int c, const uint8_t *runs, size_t size) {
+    worldChunk_t *chunk = &chunks[c];
+    if (!runs && !chunk->touched) // Entspricht bereits dem geladenen Zustand
+        return ERR_OK;
+    if (!chunk->pixels) {
+        if (!runs)
+            return ERR_OK;
+        int errCode = AllocateChunk(chunk);
+        if (errCode)
+            return errCode;
+        MarkDirty(chunk, (SDL_Rect){0, 0, WORLD_CHUNK_SIZE, WORLD_CHUNK_SIZE}); // Neue Textur vollständig beschreiben
+    }
+
+    int changed[4] = {WORLD_CHUNK_SIZE, WORLD_CHUNK_SIZE, -1, -1};
+    UnpackPristine(chunk, pristinePixels);
+    if (!runs) {
+        RestoreRun(chunk, pristinePixels, 0, WORLD_CHUNK_PIXELS, WORLD_RUN_SAME, NULL, changed);
+    } else {
+        size_t offset = 0;
+        for (int i = 0; offset < size;) {
+            uint16_t head;
+            memcpy(&head, runs + offset, sizeof(head));
+            offset += sizeof(head);
+            int type = head >> WORLD_RUN_TYPE_SHIFT;
+            int count = (head & ((1 << WORLD_RUN_TYPE_SHIFT) - 1)) + 1;
+            RestoreRun(chunk, pristinePixels, i, count, type, runs + offset, changed);
+            if (type == WORLD_RUN_LITERAL)
+                offset += sizeof(uint32_t) * count;
+            i += count;
+        }
+    }
+    if (changed[2] >= 0) {
+        MarkDirty(chunk, (SDL_Rect){changed[0], changed[1], changed[2] - changed[0] + 1, changed[3] - changed[1] + 1});
+        if (settle) // Hergestelltes Gelände kann wieder fallen
+            chunk->settling = 1;
+    }
+    chunk->touched = runs != NULL;
+    return ERR_OK;
+}
+
+static void RestoreRun(worldChunk_t *chunk, const uint32_t *pristine, int start, int count, int type, const uint8_t *literal, int changed[4]) {
+    for (int i = start; i < start + count; i++) {
+        uint32_t pixel = pristine[i];
+        if (type == WORLD_RUN_FREE)
+            pixel = pristine[i] & 0xFFFFFF00;
+        else if (type == WORLD_RUN_LITERAL)
+            memcpy(&pixel, literal + sizeof(uint32_t) * (i - start), sizeof(pixel));
+        uint32_t current = chunk->pixels[i];
+        if (current == pixel || (!(current & 0xFF) && !(pixel & 0xFF))) // Farbe freier Pixel ist unsichtbar
+            continue;
+        chunk->pixels[i] = pixel;
+        int x = i % WORLD_CHUNK_SIZE, y = i / WORLD_CHUNK_SIZE;
+        changed[0] = x < changed[0] ? x : changed[0];
+        changed[1] = y < changed[1] ? y : changed[1];
+        changed[2] = x > changed[2] ? x : changed[2];
+        changed[3] = y > changed[3] ? y : changed[3];
+    }
+}
@@ -0,0 +1,284 @@
+/**
+ * @file worldKernel.c
+ * @brief Vektorisierte Schleifen für das Kollisionsraster der Welt
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ */
+
+
+/*
+ * Includes
+ *
+ */
+
+#include <stdint.h>
+
+#include "worldKernel.h"
+#include "error.h"
+
+// SSE2 ist auf x86-64 immer vorhanden, AVX2 wird zur Laufzeit abgefragt
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WORLDKERNEL_HAS_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define WORLDKERNEL_HAS_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+
+/*
+ * Typdeklarationen
+ *
+ */
+
+#define WORLDKERNEL_WORD_BITS 64 //!< Anzahl Pixel pro Wort des Bitrasters
+
+typedef void (*packAlpha_t)(const uint32_t *pixels, int count, uint64_t *words); //!< Signatur von WorldKernel_PackAlpha()
+typedef void (*addRow_t)(int32_t *row, const int32_t *delta, int count);         //!< Signatur von WorldKernel_AddRow()
+
+
+/*
+ * Variablendeklarationen
+ *
+ */
+
+static worldKernel_t selected = WORLDKERNEL_AUTO; //!< Gewählte Variante, AUTO bis zum ersten Aufruf
+static packAlpha_t packAlpha;                     //!< Gewählte Variante von WorldKernel_PackAlpha()
+static addRow_t addRow;                           //!< Gewählte Variante von WorldKernel_AddRow()
+
+
+/*
+ * Private Funktionsprototypen
+ *
+ */
+
+/**
+ * @brief Packt die Pixel nach dem letzten ganzen Wort, siehe WorldKernel_PackAlpha().
+ *
+ * @param[in] pixels Die Pixel
+ * @param count Anzahl Pixel
+ * @param[out] words Das Bitraster
+ * @param start Erster noch nicht gepackter Pixel, Vielfaches von 64
+ */
+static void PackAlphaTail(const uint32_t *pixels, int count, uint64_t *words, int start);
+
+/**
+ * @brief Portable Variante von WorldKernel_PackAlpha().
+ *
+ * @param[in] pixels Die Pixel
+ * @param count Anzahl Pixel
+ * @param[out] words Das Bitraster
+ */
+static void PackAlphaScalar(const uint32_t *pixels, int count, uint64_t *words);
+
+/**
+ * @brief Portable Variante von WorldKernel_AddRow().
+ *
+ * @param[in,out] row Zeile zu der addiert wird
+ * @param[in] delta Summanden
+ * @param count Anzahl Elemente
+ */
+static void AddRowScalar(int32_t *row, const int32_t *delta, int count);
+
+#ifdef WORLDKERNEL_HAS_SSE2
+/**
+ * @brief SSE2 Variante von WorldKernel_PackAlpha().
+ *
+ * @param[in] pixels Die Pixel
+ * @param count Anzahl Pixel
+ * @param[out] words Das Bitraster
+ */
+static void PackAlphaSSE2(const uint32_t *pixels, int count, uint64_t *words);
+
+/**
+ * @brief SSE2 Variante von WorldKernel_AddRow().
+ *
+ * @param[in,out] row Zeile zu der addiert wird
+ * @param[in] delta Summanden
+ * @param count Anzahl Elemente
+ */
+static void AddRowSSE2(int32_t *row, const int32_t *delta, int count);
+#endif
+
+#ifdef WORLDKERNEL_HAS_AVX2
+/**
+ * @brief Prüft ob die CPU AVX2 unterstützt.
+ *
+ * @return 1 wenn unterstützt, sonst 0
+ */
+static int HasAVX2(void);
+
+/**
+ * @brief AVX2 Variante von WorldKernel_PackAlpha().
+ *
+ * @param[in] pixels Die Pixel
+ * @param count Anzahl Pixel
+ * @param[out] words Das Bitraster
+ */
+static void PackAlphaAVX2(const uint32_t *pixels, int count, uint64_t *words);
+
+/**
+ * @brief AVX2 Variante von WorldKernel_AddRow().
+ *
+ * @param[in,out] row Zeile zu der addiert wird
+ * @param[in] delta Summanden
+ * @param count Anzahl Elemente
+ */
+static void AddRowAVX2(int32_t *row, const int32_t *delta, int count);
+#endif
+
+
+/*
+ * Implementation öffentlicher Funktionen
+ *
+ */
+
+int WorldKernel_Select(worldKernel_t kernel) {
+    switch (kernel) {
+    case WORLDKERNEL_AUTO:
+#ifdef WORLDKERNEL_HAS_AVX2
+        if (HasAVX2())
+            return WorldKernel_Select(WORLDKERNEL_AVX2);
+#endif
+#ifdef WORLDKERNEL_HAS_SSE2
+        return WorldKernel_Select(WORLDKERNEL_SSE2);
+#else
+        return WorldKernel_Select(WORLDKERNEL_SCALAR);
+#endif
+    case WORLDKERNEL_SCALAR:
+        packAlpha = PackAlphaScalar;
+        addRow = AddRowScalar;
+        break;
+#ifdef WORLDKERNEL_HAS_SSE2
+    case WORLDKERNEL_SSE2:
+        packAlpha = PackAlphaSSE2;
+        addRow = AddRowSSE2;
+        break;
+#endif
+#ifdef WORLDKERNEL_HAS_AVX2
+    case WORLDKERNEL_AVX2:
+        if (!HasAVX2())
+            return ERR_PARAMETER;
+        packAlpha = PackAlphaAVX2;
+        addRow = AddRowAVX2;
+        break;
+#endif
+    default: // Auf dieser Plattform nicht übersetzt
+        return ERR_PARAMETER;
+    }
+    selected = kernel;
+    return ERR_OK;
+}
+
+worldKernel_t WorldKernel_Selected(void) {
+    if (selected == WORLDKERNEL_AUTO)
+        WorldKernel_Select(WORLDKERNEL_AUTO);
+    return selected;
+}
+
+void WorldKernel_PackAlpha(const uint32_t *pixels, int count, uint64_t *words) {
+    if (selected == WORLDKERNEL_AUTO)
+        WorldKernel_Select(WORLDKERNEL_AUTO);
+    packAlpha(pixels, count, words);
+}
+
+void WorldKernel_AddRow(int32_t *row, const int32_t *delta, int count) {
+    if (selected == WORLDKERNEL_AUTO)
+        WorldKernel_Select(WORLDKERNEL_AUTO);
+    addRow(row, delta, count);
+}
+
+
+/*
+ * Implementation privater Funktionen
+ *
+ */
+
+static void PackAlphaTail(const uint32_t *pixels, int count, uint64_t *words, int start) {
+    for (int w = start / WORLDKERNEL_WORD_BITS; w * WORLDKERNEL_WORD_BITS < count; w++) {
+        uint64_t word = 0;
+        for (int b = 0; b < WORLDKERNEL_WORD_BITS && w * WORLDKERNEL_WORD_BITS + b < count; b++) {
+            if (pixels[w * WORLDKERNEL_WORD_BITS + b] & 0xFF) // Alpha ist das niederwertigste Byte
+                word |= (uint64_t)1 << b;
+        }
+        words[w] = word;
+    }
+}
+
+static void PackAlphaScalar(const uint32_t *pixels, int count, uint64_t *words) {
+    PackAlphaTail(pixels, count, words, 0);
+}
+
+static void AddRowScalar(int32_t *row, const int32_t *delta, int count) {
+    for (int i = 0; i < count; i++)
+        row[i] += delta[i];
+}
+
+#ifdef WORLDKERNEL_HAS_SSE2
+static void PackAlphaSSE2(const uint32_t *pixels, int count, uint64_t *words) {
+    const __m128i alpha = _mm_set1_epi32(0xFF);
+    const __m128i zero = _mm_setzero_si128();
+    int full = count / WORLDKERNEL_WORD_BITS;
+    for (int w = 0; w < full; w++) {
+        const __m128i *source = (const __m128i *)(pixels + w * WORLDKERNEL_WORD_BITS);
+        uint64_t word = 0;
+        // Je 16 Pixel vergleichen und auf ein Byte pro Pixel zusammenpacken
+        for (int i = 0; i < 4; i++) {
+            __m128i a = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128(source + 4 * i + 0), alpha), zero);
+            __m128i b = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128(source + 4 * i + 1), alpha), zero);
+            __m128i c = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128(source + 4 * i + 2), alpha), zero);
+            __m128i d = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128(source + 4 * i + 3), alpha), zero);
+            __m128i packed = _mm_packs_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+            uint64_t transparent = (uint64_t)(unsigned int)_mm_movemask_epi8(packed);
+            word |= (~transparent & 0xFFFF) << (16 * i);
+        }
+        words[w] = word;
+    }
+    PackAlphaTail(pixels, count, words, full * WORLDKERNEL_WORD_BITS);
+}
+
+static void AddRowSSE2(int32_t *row, const int32_t *delta, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i sum = _mm_add_epi32(_mm_loadu_si128((const __m128i *)(row + i)), _mm_loadu_si128((const __m128i *)(delta + i)));
+        _mm_storeu_si128((__m128i *)(row + i), sum);
+    }
+    AddRowScalar(row + i, delta + i, count - i);
+}
+#endif
+
+#ifdef WORLDKERNEL_HAS_AVX2
+static int HasAVX2(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+}
+
+__attribute__((target("avx2"))) static void PackAlphaAVX2(const uint32_t *pixels, int count, uint64_t *words) {
+    const __m256i alpha = _mm256_set1_epi32(0xFF);
+    const __m256i zero = _mm256_setzero_si256();
+    int full = count / WORLDKERNEL_WORD_BITS;
+    for (int w = 0; w < full; w++) {
+        const __m256i *source = (const __m256i *)(pixels + w * WORLDKERNEL_WORD_BITS);
+        uint64_t word = 0;
+        // Je 8 Pixel vergleichen, das Vorzeichen jedes Elements ergibt ein Bit
+        for (int i = 0; i < 8; i++) {
+            __m256i transparent = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_loadu_si256(source + i), alpha), zero);
+            uint64_t bits = (uint64_t)(unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(transparent));
+            word |= (~bits & 0xFF) << (8 * i);
+        }
+        words[w] = word;
+    }
+    PackAlphaTail(pixels, count, words, full * WORLDKERNEL_WORD_BITS);
+}
+
+__attribute__((target("avx2"))) static void AddRowAVX2(int32_t *row, const int32_t *delta, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i sum = _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(row + i)), _mm256_loadu_si256((const __m256i *)(delta + i)));
+        _mm256_storeu_si256((__m256i *)(row + i), sum);
+    }
+    AddRowScalar(row + i, delta + i, count - i);
+}
+#endif
@@ -10,10 +10,6 @@
  */
 
 
-// Ubuntu der GitLab-Pipeline mag es nicht wenn man malloc / free neu definiert.
-#ifndef CI_TEST
-
-
 /*
  * Includes
  *
@@ -25,6 +21,23 @@
 #include <cmocka.h>
 
 
+/*
+ * Variablendeklarationen
+ * 
+ */
+
+/**
+ * @brief Anzahl Aufrufe von malloc() und calloc() seit Programmstart.
+ * 
+ * Tests können damit prüfen, ob ein Codeabschnitt Heapspeicher alloziert.
+ */
+unsigned long mockHeapAllocations = 0;
+
+
+// Ubuntu der GitLab-Pipeline mag es nicht wenn man malloc / free neu definiert.
+#ifndef CI_TEST
+
+
 /*
  * Mocks
  * 
@@ -42,6 +55,7 @@
  * @return Pointer auf Speicherblock
  */
 void *malloc(const size_t size) {
+    mockHeapAllocations++;
     return test_malloc(size);
 }
 
@@ -58,6 +72,7 @@ void *malloc(const size_t size) {
  * @return Pointer auf Speicherblock
  */
 void *calloc(const size_t num, const size_t size) {
+    mockHeapAllocations++;
     return test_calloc(num, size);
 }
 
@@ -88,13 +103,41 @@ void free(void *const ptr) {
     test_free(ptr);
 }
 
-#else
+#elif !defined(_MSC_VER)
+
+/*
+ * Mocks
+ * 
+ * Im CI werden malloc() und calloc() stattdessen per Linker-Flag
+ * -Wl,--wrap umgeleitet. Es wird nur gezählt, nicht auf Lecks geprüft.
+ */
+
+void *__real_malloc(size_t size);           //!< Originales malloc()
+void *__real_calloc(size_t num, size_t size); //!< Originales calloc()
+
+/**
+ * @brief Zählender Ersatz für malloc() im CI.
+ * 
+ * @param size Grösse des Speicherblocks
+ * 
+ * @return Pointer auf Speicherblock
+ */
+void *__wrap_malloc(size_t size) {
+    mockHeapAllocations++;
+    return __real_malloc(size);
+}
 
 /**
- * @brief Dummy Typedef
- * Durch aktiviertem -pedantic Flag des Compilers ist eine .c Datei ohne Inhalt
- * nicht zulässig. Unterdrücke hiermit die Warnung.
+ * @brief Zählender Ersatz für calloc() im CI.
+ * 
+ * @param num Anzahl zu allozierender Speicherblöcke
+ * @param size Grösse eines Speicherblocks
+ * 
+ * @return Pointer auf Speicherblock
  */
-typedef int mutePedanticWarning;
+void *__wrap_calloc(size_t num, size_t size) {
+    mockHeapAllocations++;
+    return __real_calloc(num, size);
+}
 
 #endif
@@ -32,11 +32,11 @@
  * Ersetze das originale \ref Physics_Update() mit dieser Funktion.
  * Somit kann isoliert getestet werden.
  * 
- * @param[in] entityList Liste aller Entitäten
+ * @param[in] store Physikspeicher mit allen Entitäten
  * 
  * @return immer 0
  */
-int Physics_Update(void *entityList) {
-    (void)entityList;
+int Physics_Update(void *store) {
+    (void)store;
     return 0;
 }
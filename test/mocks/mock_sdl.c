@@ -69,19 +69,26 @@ int IMG_Init(int flags) {
 }
 
 /**
- * @brief Mock-Ersatz für originales IMG_LoadTexture()
+ * @brief Mock-Ersatz für originales IMG_Load()
  * 
- * @param renderer unbenutzt
  * @param file unbenutzt
  * 
  * @return immer 1
  */
-void *IMG_LoadTexture(void *renderer, const char *file) {
-    (void)renderer;
+void *IMG_Load(const char *file) {
     (void)file;
     return (void *)1;
 }
 
+/**
+ * @brief Mock-Ersatz für originales SDL_FreeSurface()
+ * 
+ * @param surface unbenutzt
+ */
+void SDL_FreeSurface(void *surface) {
+    (void)surface;
+}
+
 /**
  * @brief Mock-Ersatz für originales SDL_DestroyTexture()
  * 
@@ -247,12 +254,14 @@ int Mix_PlayChannelTimed(int channel, void *chunk, int loops, int ticks) {
  * @param renderer unbenutzt
  * @param surface unbenutzt
  * 
- * @return immer 1
+ * @return bei jedem Aufruf ein anderer Pointer ungleich 0, damit Texturen unterscheidbar sind
  */
 void *SDL_CreateTextureFromSurface(void *renderer, void *surface) {
     (void)renderer;
     (void)surface;
-    return (void *)1;
+    static char textures[4096];
+    static int next = 0;
+    return &textures[next++ % sizeof(textures)];
 }
 
 /**
@@ -281,6 +290,59 @@ void *Mix_LoadWAV_RW(void *src, int freesrc) {
     return (void *)1;
 }
 
+/**
+ * @brief Mock-Ersatz für originales Mix_QuickLoad_RAW()
+ * 
+ * @param mem unbenutzt
+ * @param len unbenutzt
+ * 
+ * @return immer 1
+ */
+void *Mix_QuickLoad_RAW(void *mem, unsigned int len) {
+    (void)mem;
+    (void)len;
+    return (void *)1;
+}
+
+/**
+ * @brief Mock-Ersatz für originales Mix_QuerySpec()
+ * Meldet das Audioformat mit dem SDLW_Init() das Audio öffnet.
+ * 
+ * @param[out] frequency MIX_DEFAULT_FREQUENCY
+ * @param[out] format MIX_DEFAULT_FORMAT
+ * @param[out] channels MIX_DEFAULT_CHANNELS
+ * 
+ * @return immer 1
+ */
+int Mix_QuerySpec(int *frequency, unsigned short *format, int *channels) {
+    *frequency = 22050; // MIX_DEFAULT_FREQUENCY
+    *format = 0x8010;   // MIX_DEFAULT_FORMAT, AUDIO_S16LSB
+    *channels = 2;      // MIX_DEFAULT_CHANNELS
+    return 1;
+}
+
+/**
+ * @brief Mock-Ersatz für originales SDL_CreateRGBSurfaceWithFormatFrom()
+ * 
+ * @param pixels unbenutzt
+ * @param width unbenutzt
+ * @param height unbenutzt
+ * @param depth unbenutzt
+ * @param pitch unbenutzt
+ * @param format unbenutzt
+ * 
+ * @return immer 1
+ */
+void *SDL_CreateRGBSurfaceWithFormatFrom(void *pixels, int width, int height, int depth, int pitch, unsigned int format) {
+    (void)pixels;
+    (void)width;
+    (void)height;
+    (void)depth;
+    (void)pitch;
+    (void)format;
+    return (void *)1;
+}
+
 /**
  * @brief Mock-Ersatz für originales Mix_FreeMusic()
  * 
@@ -336,32 +398,33 @@ int SDL_SetRenderTarget(void *renderer, void *texture) {
 /**
  * @brief Mock-Ersatz für originales SDL_RenderReadPixels().
  * 
- * Erstellt eine Test Welt.
+ * Erstellt eine Test Welt. Es wird nur der angeforderte Ausschnitt geschrieben.
  * 
  * @param renderer unbenutzt
- * @param rect unbenutzt
+ * @param rect Ausschnitt der Welt, NULL für die ganze Welt
  * @param format unbenutzt
  * @param pixels Speicherort der Welt
- * @param pitch unbenutzt
+ * @param pitch Bytes pro Zeile in \p pixels
  * 
  * @return 0 oder 1 wenn pixels ungültig
  */
 int SDL_RenderReadPixels(void *renderer, const void *rect, int format, void *pixels, int pitch) {
     (void)renderer;
-    (void)rect;
     (void)format;
-    (void)pitch;
     if (!pixels)
         return 1;
+    // Ausschnitt im Format von SDL_Rect: x, y, w, h
+    const int full[4] = {0, 0, 1024, 576};
+    const int *area = rect ? (const int *)rect : full;
     /* Erstellt ein Künstliches Bild in der Form
      __
      ##\
      ###\
      ####\__
     */
-    for (int y = 0; y < 576; y++) {
-        for (int x = 0; x < 1024; x++) {
-            ((char *)pixels)[(x + y * 1024) * 4] = (y + 100) > x;
+    for (int y = area[1]; y < area[1] + area[3]; y++) {
+        for (int x = area[0]; x < area[0] + area[2]; x++) {
+            ((char *)pixels)[(x - area[0]) * 4 + (y - area[1]) * pitch] = (y + 100) > x;
         }
     }
     return 0;
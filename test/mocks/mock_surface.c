@@ -0,0 +1,99 @@
+/**
+ * @file mock_surface.c
+ * @brief Mocks der SDL Funktionen für Pixel von Oberflächen
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * Im Gegensatz zu mock_sdl.c wird hier der Aufbau von SDL_Surface benötigt,
+ * darum sind diese Mocks in einer eigenen Datei mit SDL.h.
+ */
+
+
+/*
+ * Includes
+ *
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdint.h>
+
+#include <SDL.h>
+
+
+/*
+ * Variablendeklarationen
+ *
+ */
+
+#define MOCK_SURFACE_WIDTH 1024     //!< Breite der Testwelt
+#define MOCK_SURFACE_MAX_WIDTH 4096 //!< Maximale Breite der breiten Testwelt
+#define MOCK_SURFACE_HEIGHT 576     //!< Höhe der Testwelt
+
+int mockSurfaceWidth = MOCK_SURFACE_WIDTH; //!< Breite der Testwelt, Tests können bis MOCK_SURFACE_MAX_WIDTH vergrössern
+unsigned long mockTextureUpdates = 0;      //!< Anzahl Aufrufe von SDL_UpdateTexture()
+
+static uint32_t mockPixels[MOCK_SURFACE_WIDTH * MOCK_SURFACE_HEIGHT];         //!< Pixel der Testwelt
+static SDL_Surface mockSurface;                                              //!< Oberfläche der Testwelt
+static uint32_t mockWidePixels[MOCK_SURFACE_MAX_WIDTH * MOCK_SURFACE_HEIGHT]; //!< Pixel der breiten Testwelt
+static SDL_Surface mockWideSurface;                                          //!< Oberfläche der breiten Testwelt
+
+
+/*
+ * Mocks
+ *
+ */
+
+/**
+ * @brief Mock-Ersatz für originales SDL_ConvertSurfaceFormat()
+ * Gibt unabhängig von der Quelle immer die Testwelt zurück. Sie ist überall
+ * dort voll deckend wo auch SDL_RenderReadPixels() aus mock_sdl.c Alpha setzt.
+ *
+ * @param src unbenutzt
+ * @param pixel_format unbenutzt
+ * @param flags unbenutzt
+ *
+ * @return Oberfläche der Testwelt im Format RGBA8888, wird bei jedem Aufruf neu gefüllt.
+ * Ist mockSurfaceWidth vergrössert, eine eigene Oberfläche, damit die Pixel
+ * bereits geladener Masken und Stempel unverändert bleiben.
+ */
+SDL_Surface *SDL_ConvertSurfaceFormat(SDL_Surface *src, Uint32 pixel_format, Uint32 flags) {
+    (void)src;
+    (void)pixel_format;
+    (void)flags;
+    int wide = mockSurfaceWidth != MOCK_SURFACE_WIDTH;
+    uint32_t *pixels = wide ? mockWidePixels : mockPixels;
+    SDL_Surface *surface = wide ? &mockWideSurface : &mockSurface;
+    for (int y = 0; y < MOCK_SURFACE_HEIGHT; y++) {
+        for (int x = 0; x < mockSurfaceWidth; x++)
+            pixels[x + y * mockSurfaceWidth] = (y + 100) > x ? 0xFFFFFFFF : 0xFFFFFF00;
+    }
+    surface->w = mockSurfaceWidth;
+    surface->h = MOCK_SURFACE_HEIGHT;
+    surface->pitch = mockSurfaceWidth * (int)sizeof(uint32_t);
+    surface->pixels = pixels;
+    return surface;
+}
+
+/**
+ * @brief Mock-Ersatz für originales SDL_UpdateTexture()
+ * Zählt die Aufrufe in mockTextureUpdates.
+ *
+ * @param texture unbenutzt
+ * @param rect unbenutzt
+ * @param pixels unbenutzt
+ * @param pitch unbenutzt
+ *
+ * @return immer 0
+ */
+int SDL_UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *pixels, int pitch) {
+    (void)texture;
+    (void)rect;
+    (void)pixels;
+    (void)pitch;
+    mockTextureUpdates++;
+    return 0;
+}
@@ -0,0 +1,205 @@
+/**
+ * @file test_assetPack.c
+ * @brief Tests für assetPack-Modul
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ */
+
+/*
+ * Includes
+ *
+ */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "assetPack.h"
+#include "error.h"
+
+
+/*
+ * Variablendeklarationen
+ *
+ */
+
+static const char *packFile = "test_assetPack.pack"; //!< Temporäre Paketdatei
+
+
+/*
+ * Hilfsfunktionen
+ *
+ */
+
+/**
+ * @brief Schreibt ein Paket mit drei Einträgen.
+ *
+ * Eine Textur mit 2x2 Pixeln, ein Sprite ohne Daten und eine Datei mit
+ * ungerader Grösse, damit die Ausrichtung der Folgedaten geprüft wird.
+ */
+static void writeTestPack(void) {
+    assetPackWriter_t writer;
+    assert_int_equal(AssetPack_BeginWrite(&writer, packFile, 0x8010, 22050, 2, 0x1234), ERR_OK);
+
+    const uint32_t pixels[4] = {0x11111111, 0x22222222, 0x33333333, 0x44444444};
+    assetPackEntry_t texture = {.config = "tex texture tex.png\n", .key = "tex", .type = "texture",
+                                .dataType = ASSETPACK_DATA_PIXELS, .width = 2, .height = 2, .pitch = 8};
+    assert_int_equal(AssetPack_WriteEntry(&writer, &texture, pixels, sizeof(pixels)), ERR_OK);
+
+    assetPackEntry_t sprite = {.config = "spr sprite tex\n", .key = "spr", .type = "sprite"};
+    assert_int_equal(AssetPack_WriteEntry(&writer, &sprite, NULL, 0), ERR_OK);
+
+    assetPackEntry_t file = {.config = "fnt font f.ttf 12\n", .key = "fnt", .type = "font",
+                             .dataType = ASSETPACK_DATA_FILE};
+    assert_int_equal(AssetPack_WriteEntry(&writer, &file, "abc", 3), ERR_OK);
+
+    assert_int_equal(AssetPack_EndWrite(&writer, packFile, 1), ERR_OK);
+}
+
+/**
+ * @brief Überschreibt ein Feld der Paketdatei.
+ *
+ * @param offset Position in der Datei
+ * @param data Neue Daten
+ * @param size Grösse der Daten
+ */
+static void patchPack(long offset, const void *data, size_t size) {
+    FILE *file = fopen(packFile, "r+b");
+    assert_non_null(file);
+    fseek(file, offset, SEEK_SET);
+    fwrite(data, 1, size, file);
+    fclose(file);
+}
+
+
+/*
+ * Tests
+ *
+ */
+
+/**
+ * @brief Ein geschriebenes Paket kann geöffnet und gelesen werden.
+ *
+ * @param state unbenutzt
+ */
+static void write_and_read_pack(void **state) {
+    (void)state;
+    writeTestPack();
+    assetPack_t pack;
+    assert_int_equal(AssetPack_Open(packFile, &pack), ERR_OK);
+    assert_int_equal(pack.header->entryCount, 3);
+    assert_int_equal(pack.header->audioFrequency, 22050);
+    assert_int_equal(pack.header->sourceHash, 0x1234);
+    // Einträge in Reihenfolge des Schreibens
+    assert_string_equal(pack.entries[0].key, "tex");
+    assert_string_equal(pack.entries[1].config, "spr sprite tex\n");
+    assert_string_equal(pack.entries[2].type, "font");
+    // Daten sind ausgerichtet und unverändert
+    const uint32_t *pixels = AssetPack_GetData(&pack, 0);
+    assert_non_null(pixels);
+    assert_int_equal((uintptr_t)pixels % ASSETPACK_ALIGNMENT, 0);
+    assert_int_equal(pixels[3], 0x44444444);
+    assert_int_equal(pack.entries[0].width, 2);
+    assert_null(AssetPack_GetData(&pack, 1));
+    const char *file = AssetPack_GetData(&pack, 2);
+    assert_memory_equal(file, "abc", 3);
+    assert_int_equal(pack.entries[2].size, 3);
+    // Ungültige Indizes
+    assert_null(AssetPack_GetData(&pack, -1));
+    assert_null(AssetPack_GetData(&pack, 3));
+    assert_int_equal(AssetPack_Close(&pack), ERR_OK);
+    assert_null(pack.base);
+    // Erneutes Schliessen ist wirkungslos
+    assert_int_equal(AssetPack_Close(&pack), ERR_OK);
+    remove(packFile);
+}
+
+/**
+ * @brief Fehlende, veraltete oder beschädigte Pakete werden abgelehnt.
+ *
+ * @param state unbenutzt
+ */
+static void reject_invalid_packs(void **state) {
+    (void)state;
+    assetPack_t pack;
+    remove(packFile);
+    assert_int_equal(AssetPack_Open(packFile, &pack), ERR_PARAMETER);
+    // Andere Version
+    writeTestPack();
+    uint32_t version = ASSETPACK_VERSION + 1;
+    patchPack(offsetof(assetPackHeader_t, version), &version, sizeof(version));
+    assert_int_equal(AssetPack_Open(packFile, &pack), ERR_FAIL);
+    assert_null(pack.base);
+    // Daten ausserhalb der Datei
+    writeTestPack();
+    uint64_t entryOffset;
+    FILE *file = fopen(packFile, "rb");
+    fseek(file, offsetof(assetPackHeader_t, entryOffset), SEEK_SET);
+    assert_int_equal(fread(&entryOffset, sizeof(entryOffset), 1, file), 1);
+    fclose(file);
+    uint64_t size = 1 << 20;
+    patchPack((long)(entryOffset + offsetof(assetPackEntry_t, size)), &size, sizeof(size));
+    assert_int_equal(AssetPack_Open(packFile, &pack), ERR_FAIL);
+    // Abgeschnittene Datei
+    writeTestPack();
+    file = fopen(packFile, "wb");
+    fwrite("TNPK", 1, 4, file);
+    fclose(file);
+    assert_int_equal(AssetPack_Open(packFile, &pack), ERR_FAIL);
+    remove(packFile);
+}
+
+/**
+ * @brief Ein abgebrochenes Paket hinterlässt keine Datei.
+ *
+ * @param state unbenutzt
+ */
+static void abort_write_removes_file(void **state) {
+    (void)state;
+    assetPackWriter_t writer;
+    assert_int_equal(AssetPack_BeginWrite(&writer, packFile, 0, 0, 0, 0), ERR_OK);
+    assetPackEntry_t entry = {.key = "a", .type = "sprite"};
+    assert_int_equal(AssetPack_WriteEntry(&writer, &entry, NULL, 0), ERR_OK);
+    assert_int_equal(AssetPack_EndWrite(&writer, packFile, 0), ERR_OK);
+    assert_null(fopen(packFile, "rb"));
+}
+
+/**
+ * @brief Ungültige Parameter werden abgefangen.
+ *
+ * @param state unbenutzt
+ */
+static void check_null_catch(void **state) {
+    (void)state;
+    assetPack_t pack = {0};
+    assetPackWriter_t writer = {0};
+    assetPackEntry_t entry = {0};
+    assert_int_equal(AssetPack_Open(NULL, &pack), ERR_NULLPARAMETER);
+    assert_int_equal(AssetPack_Open(packFile, NULL), ERR_NULLPARAMETER);
+    assert_null(AssetPack_GetData(NULL, 0));
+    assert_null(AssetPack_GetData(&pack, 0));
+    assert_int_equal(AssetPack_Close(NULL), ERR_NULLPARAMETER);
+    assert_int_equal(AssetPack_BeginWrite(NULL, packFile, 0, 0, 0, 0), ERR_NULLPARAMETER);
+    assert_int_equal(AssetPack_BeginWrite(&writer, NULL, 0, 0, 0, 0), ERR_NULLPARAMETER);
+    assert_int_equal(AssetPack_WriteEntry(&writer, &entry, NULL, 0), ERR_NULLPARAMETER);
+    assert_int_equal(AssetPack_EndWrite(&writer, packFile, 1), ERR_NULLPARAMETER);
+}
+
+/**
+ * @brief Testprogramm
+ *
+ * @return int Anzahl fehlgeschlagener Tests
+ */
+int main(void) {
+    const struct CMUnitTest assetPackTest[] = {
+        cmocka_unit_test(write_and_read_pack),
+        cmocka_unit_test(reject_invalid_packs),
+        cmocka_unit_test(abort_write_removes_file),
+        cmocka_unit_test(check_null_catch),
+    };
+    return cmocka_run_group_tests(assetPackTest, NULL, NULL);
+}
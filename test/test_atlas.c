@@ -0,0 +1,141 @@
+/**
+ * @file test_atlas.c
+ * @brief Tests für atlas-Modul
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ */
+
+/*
+ * Includes
+ *
+ */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "atlas.h"
+#include "error.h"
+
+
+/*
+ * Hilfsfunktionen
+ *
+ */
+
+/**
+ * @brief Prüft ob sich zwei Rechtecke inklusive Rand überlappen.
+ *
+ * @param a Erstes Rechteck
+ * @param b Zweites Rechteck
+ * @param padding Rand um die Rechtecke
+ *
+ * @return 1 bei Überlappung, sonst 0
+ */
+static int overlaps(const atlasItem_t *a, const atlasItem_t *b, int padding) {
+    if (a->page != b->page)
+        return 0;
+    return a->rect.x - padding < b->rect.x + b->rect.w + padding &&
+           b->rect.x - padding < a->rect.x + a->rect.w + padding &&
+           a->rect.y - padding < b->rect.y + b->rect.h + padding &&
+           b->rect.y - padding < a->rect.y + a->rect.h + padding;
+}
+
+
+/*
+ * Tests
+ *
+ */
+
+/**
+ * @brief Rechtecke werden ohne Überlappung innerhalb der Seite abgelegt.
+ *
+ * @param state unbenutzt
+ */
+static void pack_without_overlap(void **state) {
+    (void)state;
+    atlasItem_t items[] = {{.w = 90, .h = 11}, {.w = 181, .h = 57}, {.w = 156, .h = 28}, {.w = 224, .h = 224}, {.w = 192, .h = 168}, {.w = 16, .h = 6}, {.w = 16, .h = 6}};
+    const int count = sizeof(items) / sizeof(items[0]);
+    int pageCount = -1;
+    assert_int_equal(Atlas_Pack(items, count, 512, 1, &pageCount), ERR_OK);
+    assert_int_equal(pageCount, 1);
+    for (int i = 0; i < count; ++i) {
+        assert_int_equal(items[i].page, 0);
+        // Grösse bleibt, Rand wird freigehalten
+        assert_true(items[i].rect.w == items[i].w && items[i].rect.h == items[i].h);
+        assert_true(items[i].rect.x >= 1 && items[i].rect.y >= 1);
+        assert_true(items[i].rect.x + items[i].rect.w + 1 <= 512);
+        assert_true(items[i].rect.y + items[i].rect.h + 1 <= 512);
+        for (int j = 0; j < i; ++j)
+            assert_false(overlaps(&items[i], &items[j], 1));
+    }
+    // Höchstes Rechteck liegt oben links
+    assert_int_equal(items[3].rect.x, 1);
+    assert_int_equal(items[3].rect.y, 1);
+    // Seite ist nur so hoch wie nötig
+    int height = Atlas_PageHeight(items, count, 0, 1);
+    assert_true(height > 224 && height <= 512);
+    assert_int_equal(Atlas_PageHeight(items, count, 1, 1), 0);
+}
+
+/**
+ * @brief Zu grosse Rechtecke erhalten keine Seite, volle Seiten eine neue.
+ *
+ * @param state unbenutzt
+ */
+static void pack_oversize_and_pages(void **state) {
+    (void)state;
+    atlasItem_t items[] = {{.w = 64, .h = 64}, {.w = 64, .h = 64}, {.w = 64, .h = 64}, {.w = 64, .h = 64}, {.w = 64, .h = 64}, {.w = 128, .h = 1}, {.w = 0, .h = 4}};
+    const int count = sizeof(items) / sizeof(items[0]);
+    int pageCount = 0;
+    assert_int_equal(Atlas_Pack(items, count, 128, 0, &pageCount), ERR_OK);
+    // Vier Rechtecke pro Seite, das flache Rechteck passt auf ein neues Regal
+    assert_int_equal(pageCount, 2);
+    for (int i = 0; i < 4; ++i)
+        assert_int_equal(items[i].page, 0);
+    assert_int_equal(items[4].page, 1);
+    assert_int_equal(items[5].page, 1);
+    assert_int_equal(items[5].rect.y, 64);
+    assert_int_equal(items[6].page, -1);
+    // Mit Rand passt die volle Breite nicht mehr
+    assert_int_equal(Atlas_Pack(items, count, 128, 1, &pageCount), ERR_OK);
+    assert_int_equal(items[5].page, -1);
+    for (int i = 0; i < 5; ++i)
+        assert_int_equal(items[i].page, i);
+    assert_int_equal(pageCount, 5);
+    // Ohne Rechtecke keine Seiten
+    assert_int_equal(Atlas_Pack(NULL, 0, 128, 0, &pageCount), ERR_OK);
+    assert_int_equal(pageCount, 0);
+}
+
+/**
+ * @brief Ungültige Parameter werden abgefangen.
+ *
+ * @param state unbenutzt
+ */
+static void check_null_catch(void **state) {
+    (void)state;
+    atlasItem_t item = {.w = 1, .h = 1};
+    int pageCount;
+    assert_int_equal(Atlas_Pack(NULL, 1, 128, 0, &pageCount), ERR_NULLPARAMETER);
+    assert_int_equal(Atlas_Pack(&item, 1, 128, 0, NULL), ERR_NULLPARAMETER);
+    assert_int_equal(Atlas_Pack(&item, -1, 128, 0, &pageCount), ERR_PARAMETER);
+    assert_int_equal(Atlas_Pack(&item, 1, 0, 0, &pageCount), ERR_PARAMETER);
+    assert_int_equal(Atlas_Pack(&item, 1, 128, -1, &pageCount), ERR_PARAMETER);
+    assert_int_equal(Atlas_PageHeight(NULL, 1, 0, 0), 0);
+}
+
+/**
+ * @brief Testprogramm
+ *
+ * @return int Anzahl fehlgeschlagener Tests
+ */
+int main(void) {
+    const struct CMUnitTest atlasTest[] = {
+        cmocka_unit_test(pack_without_overlap),
+        cmocka_unit_test(pack_oversize_and_pages),
+        cmocka_unit_test(check_null_catch),
+    };
+    return cmocka_run_group_tests(atlasTest, NULL, NULL);
+}
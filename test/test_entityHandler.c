@@ -19,10 +19,13 @@
 #include <setjmp.h>
 #include <cmocka.h>
 
+#include <stdlib.h>
+
 #include "error.h"
-#include "list.h"
+#include "intrusiveList.h"
 #define SDL_MAIN_HANDLED
 #include "entityHandler.h"
+#include "physics.h"
 
 
 /*
@@ -117,8 +120,7 @@ static void one_hundred_entities_can_be_added_and_removed(void **state) {
 static int setupOneEntity(void **state) {
     static entity_t entity = {
         .owner = (player_t *)1, // müsste eigentlich Pointer auf player_t sein
-        .name = "Test",
-        .parts = NULL
+        .name = "Test"
     };
     *state = (void *)&entity;
     return (EntityHandler_AddEntity(&entity) != ERR_OK);
@@ -267,7 +269,6 @@ static int setupOneEntityAndOnePart(void **state) {
         .owner = (player_t *)1, // müsste eigentlich Pointer auf player_t sein
         .name = "Test",
         .state = ENTITY_STATE_CREATED,
-        .parts = NULL,
         .callbacks = {
             .onUpdate = onUpdate,
             .onDraw = onDraw}};
@@ -408,6 +409,113 @@ static void draw_callback_doesnt_get_called_if_state_is_equal_to_created(void **
     assert_int_equal(EntityHandler_Draw(), ERR_OK);
 }
 
+/**
+ * @brief Kind-Entität für \ref spawnChildAndRemoveSelf().
+ * 
+ */
+static entity_t childEntity;
+
+/**
+ * @brief onUpdate Callback der eine Kind-Entität erstellt und sich selbst
+ * samt Daten löscht.
+ * 
+ * @param self Pointer auf die Entität dessen Callback gerade aufgerufen wird
+ * @param inputEvents Eingabeevents für die Entität
+ * 
+ * @return immer ERR_OK
+ */
+static int spawnChildAndRemoveSelf(entity_t *self, inputEvent_t *inputEvents) {
+    (void)inputEvents;
+    function_called();
+    assert_int_equal(EntityHandler_AddEntity(&childEntity), ERR_OK);
+    assert_int_equal(EntityHandler_RemoveEntity(self), ERR_OK);
+    assert_int_equal(EntityHandler_FreeData(self->data), ERR_OK);
+    // Befehle werden erst nach der Phase ausgeführt
+    assert_false(IntrusiveList_IsLinked(&childEntity.link));
+    assert_true(IntrusiveList_IsLinked(&self->link));
+    return ERR_OK;
+}
+
+/**
+ * @brief Entitäten können innerhalb ihrer Callbacks Entitäten hinzufügen und
+ * sich selbst löschen. Die Befehle werden nach der Update-Phase ausgeführt.
+ * 
+ * @param state unbenutzt
+ */
+static void entities_can_be_added_and_removed_inside_update_callback(void **state) {
+    (void)state;
+    inputEvent_t *inputEvents = (inputEvent_t *)0xDEADBEEF;
+    static entity_t spawner;
+    spawner = (entity_t){
+        .owner = (player_t *)1, // müsste eigentlich Pointer auf player_t sein
+        .name = "Spawner",
+        .callbacks.onUpdate = spawnChildAndRemoveSelf,
+        .data = malloc(16)};
+    childEntity = (entity_t){
+        .owner = (player_t *)1,
+        .name = "Kind",
+        .callbacks.onUpdate = onUpdate};
+    assert_int_equal(EntityHandler_AddEntity(&spawner), ERR_OK);
+    // Erster Zyklus: nur der Spawner wird aktualisiert
+    expect_function_call(spawnChildAndRemoveSelf);
+    assert_int_equal(EntityHandler_Update(inputEvents), ERR_OK);
+    assert_false(IntrusiveList_IsLinked(&spawner.link));
+    assert_true(IntrusiveList_IsLinked(&childEntity.link));
+    // Zweiter Zyklus: nur das Kind wird aktualisiert
+    expect_function_call(onUpdate);
+    expect_value(onUpdate, self, &childEntity);
+    expect_value(onUpdate, inputEvents, inputEvents);
+    will_return(onUpdate, ERR_OK);
+    assert_int_equal(EntityHandler_Update(inputEvents), ERR_OK);
+    assert_int_equal(EntityHandler_RemoveEntity(&childEntity), ERR_OK);
+}
+
+/**
+ * @brief \ref EntityHandler_Interpolate() positioniert die Einzelteile
+ * zwischen dem Zustand vor und nach dem letzten Update. Die Rotation nimmt
+ * den kürzeren Weg über ±180°.
+ * 
+ * @param state unbenutzt
+ */
+static void parts_are_interpolated_between_previous_and_current_state(void **state) {
+    (void)state;
+    inputEvent_t *inputEvents = (inputEvent_t *)0xDEADBEEF;
+    static entity_t entity;
+    static entityPart_t part;
+    entity = (entity_t){
+        .owner = (player_t *)1, // müsste eigentlich Pointer auf player_t sein
+        .name = "Test",
+        .physics = {.position = {100.0f, 200.0f}, .rotation = 170.0}};
+    part = (entityPart_t){
+        .name = "Test",
+        .sprite = {
+            .texture = (SDL_Texture *)0xDEADBEEF,
+            .destination = {.h = 10, .w = 10}}};
+    assert_int_equal(EntityHandler_AddEntity(&entity), ERR_OK);
+    assert_int_equal(EntityHandler_AddEntityPart(&entity, &part), ERR_OK);
+    // Das Update merkt sich den Zustand, danach bewegt sich die Entität
+    assert_int_equal(EntityHandler_Update(inputEvents), ERR_OK);
+    Physics_SetPosition(&entity, 120.0f, 100.0f);
+    Physics_SetRotation(&entity, -170.0);
+    assert_int_equal(EntityHandler_Interpolate(0.0f), ERR_OK);
+    assert_int_equal(part.tempSprite.position.x, 100);
+    assert_int_equal(part.tempSprite.position.y, 200);
+    assert_float_equal(part.tempSprite.rotation, 170.0, 1e-3);
+    assert_int_equal(EntityHandler_Interpolate(0.5f), ERR_OK);
+    assert_int_equal(part.tempSprite.position.x, 110);
+    assert_int_equal(part.tempSprite.position.y, 150);
+    assert_float_equal(part.tempSprite.rotation, 180.0, 1e-3);
+    assert_int_equal(EntityHandler_Interpolate(1.0f), ERR_OK);
+    assert_int_equal(part.tempSprite.position.x, 120);
+    assert_int_equal(part.tempSprite.position.y, 100);
+    assert_float_equal(part.tempSprite.rotation, 190.0, 1e-3);
+    // Anteile ausserhalb von [0, 1] sind ungültig
+    assert_int_equal(EntityHandler_Interpolate(1.5f), ERR_PARAMETER);
+    assert_int_equal(EntityHandler_Interpolate(-0.5f), ERR_PARAMETER);
+    assert_int_equal(EntityHandler_RemoveAllEntityParts(&entity), ERR_OK);
+    assert_int_equal(EntityHandler_RemoveEntity(&entity), ERR_OK);
+}
+
 /**
  * @brief Testprogramm
  * 
@@ -450,6 +558,9 @@ int main(void) {
         cmocka_unit_test_setup_teardown(
             draw_callback_doesnt_get_called_if_state_is_equal_to_created,
             setupOneEntityAndOnePart, teardownOneEntityAndOnePart),
+
+        cmocka_unit_test(entities_can_be_added_and_removed_inside_update_callback),
+        cmocka_unit_test(parts_are_interpolated_between_previous_and_current_state),
     };
     return cmocka_run_group_tests(entityHandler, NULL, NULL);
 }
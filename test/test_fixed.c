@@ -0,0 +1,142 @@
+/**
+ * @file test_fixed.c
+ * @brief Tests für fixed-Modul
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ */
+
+/*
+ * Includes
+ *
+ */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <math.h>
+#include <stdint.h>
+
+#include "fixed.h"
+
+
+/*
+ * Variablendeklarationen
+ *
+ */
+
+#define TRIG_EPSILON 0.0001 //!< Erlaubter Fehler von Sinus und Cosinus
+#define ATAN_EPSILON 0.001  //!< Erlaubter Fehler von Atan2 [°]
+
+
+/*
+ * Tests
+ *
+ */
+
+/**
+ * @brief Umwandlungen runden zur nächsten Festkommazahl und begrenzen.
+ *
+ * @param state unbenutzt
+ */
+static void conversions_round_and_saturate(void **state) {
+    (void)state;
+    assert_int_equal(Fixed_FromInt(3), 3 * FIXED_ONE);
+    assert_int_equal(Fixed_FromInt(-3), -3 * FIXED_ONE);
+    assert_int_equal(Fixed_FromFloat(1.5f), FIXED_ONE + FIXED_ONE / 2);
+    assert_int_equal(Fixed_FromFloat(-0.25f), -FIXED_ONE / 4);
+    assert_int_equal(Fixed_FromFloat(0.1f), 6554);
+    assert_int_equal(Fixed_FromFloat(-0.1f), -6554);
+    assert_int_equal(Fixed_FromFloat(1e10f), INT32_MAX);
+    assert_int_equal(Fixed_FromFloat(-1e10f), INT32_MIN);
+    assert_int_equal(Fixed_FromFloat(NAN), 0);
+    assert_true(Fixed_ToFloat(FIXED_ONE / 2) == 0.5f);
+    assert_true(Fixed_ToFloat(-3 * FIXED_ONE) == -3.0f);
+    // Abschneiden wie ein Cast von float nach int
+    assert_int_equal(Fixed_ToInt(Fixed_FromFloat(2.75f)), 2);
+    assert_int_equal(Fixed_ToInt(Fixed_FromFloat(-2.75f)), -2);
+}
+
+/**
+ * @brief Multiplikation und Division runden definiert, auch mit negativen
+ * Zahlen, und begrenzen.
+ *
+ * @param state unbenutzt
+ */
+static void mul_and_div_round_and_saturate(void **state) {
+    (void)state;
+    assert_int_equal(Fixed_Mul(Fixed_FromInt(3), Fixed_FromFloat(0.5f)), Fixed_FromFloat(1.5f));
+    assert_int_equal(Fixed_Mul(Fixed_FromInt(-3), Fixed_FromFloat(0.5f)), Fixed_FromFloat(-1.5f));
+    // 1/65536 * 0.5 wird von 0 weg gerundet
+    assert_int_equal(Fixed_Mul(1, FIXED_ONE / 2), 1);
+    assert_int_equal(Fixed_Mul(-1, FIXED_ONE / 2), -1);
+    assert_int_equal(Fixed_Mul(Fixed_FromInt(30000), Fixed_FromInt(30000)), INT32_MAX);
+    assert_int_equal(Fixed_Mul(Fixed_FromInt(-30000), Fixed_FromInt(30000)), INT32_MIN);
+    assert_int_equal(Fixed_Div(Fixed_FromInt(3), Fixed_FromInt(2)), Fixed_FromFloat(1.5f));
+    assert_int_equal(Fixed_Div(Fixed_FromInt(-3), Fixed_FromInt(2)), Fixed_FromFloat(-1.5f));
+    assert_int_equal(Fixed_Div(FIXED_ONE, Fixed_FromInt(3)), 21845);
+    assert_int_equal(Fixed_Div(-FIXED_ONE, Fixed_FromInt(3)), -21845);
+    assert_int_equal(Fixed_Div(FIXED_ONE, 0), INT32_MAX);
+    assert_int_equal(Fixed_Div(-FIXED_ONE, 0), INT32_MIN);
+}
+
+/**
+ * @brief Sinus und Cosinus aus der Tabelle stimmen mit der
+ * Standardbibliothek überein, auch für negative und grosse Winkel.
+ *
+ * @param state unbenutzt
+ */
+static void sin_and_cos_match_reference(void **state) {
+    (void)state;
+    for (int tenth = -7200; tenth <= 7200; tenth += 7) {
+        fixed_t degrees = Fixed_Div(Fixed_FromInt(tenth), Fixed_FromInt(10));
+        double radians = (double)degrees / FIXED_ONE * M_PI / 180.0;
+        assert_float_equal((double)Fixed_Sin(degrees) / FIXED_ONE, sin(radians), TRIG_EPSILON);
+        assert_float_equal((double)Fixed_Cos(degrees) / FIXED_ONE, cos(radians), TRIG_EPSILON);
+    }
+    // Exakte Werte an den Achsen
+    assert_int_equal(Fixed_Sin(Fixed_FromInt(90)), FIXED_ONE);
+    assert_int_equal(Fixed_Sin(Fixed_FromInt(180)), 0);
+    assert_int_equal(Fixed_Sin(Fixed_FromInt(-90)), -FIXED_ONE);
+    assert_int_equal(Fixed_Cos(0), FIXED_ONE);
+    assert_int_equal(Fixed_Cos(Fixed_FromInt(180)), -FIXED_ONE);
+}
+
+/**
+ * @brief Atan2 aus der Tabelle stimmt in allen Quadranten mit der
+ * Standardbibliothek überein.
+ *
+ * @param state unbenutzt
+ */
+static void atan2_matches_reference(void **state) {
+    (void)state;
+    for (int y = -50; y <= 50; y += 3) {
+        for (int x = -50; x <= 50; x += 3) {
+            fixed_t fy = Fixed_Div(Fixed_FromInt(y), Fixed_FromInt(7));
+            fixed_t fx = Fixed_Div(Fixed_FromInt(x), Fixed_FromInt(7));
+            double expected = atan2((double)fy, (double)fx) * 180.0 / M_PI;
+            assert_float_equal((double)Fixed_Atan2(fy, fx) / FIXED_ONE, expected, ATAN_EPSILON);
+        }
+    }
+    assert_int_equal(Fixed_Atan2(0, 0), 0);
+    assert_int_equal(Fixed_Atan2(FIXED_ONE, 0), Fixed_FromInt(90));
+    assert_int_equal(Fixed_Atan2(-FIXED_ONE, 0), Fixed_FromInt(-90));
+    assert_int_equal(Fixed_Atan2(0, -FIXED_ONE), Fixed_FromInt(180));
+    assert_int_equal(Fixed_Atan2(INT32_MIN, INT32_MIN), Fixed_FromInt(-135));
+}
+
+/**
+ * @brief Testprogramm
+ *
+ * @return int Anzahl fehlgeschlagener Tests
+ */
+int main(void) {
+    const struct CMUnitTest fixed[] = {
+        cmocka_unit_test(conversions_round_and_saturate),
+        cmocka_unit_test(mul_and_div_round_and_saturate),
+        cmocka_unit_test(sin_and_cos_match_reference),
+        cmocka_unit_test(atan2_matches_reference),
+    };
+    return cmocka_run_group_tests(fixed, NULL, NULL);
+}
@@ -74,7 +74,7 @@ static void gui_can_be_initialized(void **state) {
     gui_t gui = {0};
     assert_int_equal(GUI_Init(&gui), ERR_OK);
     assert_non_null(&gui.element);
-    List_Clear(&gui.element);
+    IntrusiveList_Clear(&gui.element);
 }
 
 /**
@@ -92,6 +92,10 @@ static void gui_can_add_and_remove_elements(void **state) {
     assert_int_equal(GUI_AddElement(&element0, &gui), ERR_OK);
     assert_int_equal(GUI_AddElement(&element1, &gui), ERR_OK);
     assert_int_equal(gui.element.elementCount, 2);
+    // Ein erneutes Hinzufügen ändert die Liste nicht
+    assert_int_equal(GUI_AddElement(&element0, &gui), ERR_OK);
+    assert_int_equal(gui.element.elementCount, 2);
+    assert_ptr_equal(gui.element.first->data, &element1);
     // Beide Elemente können entfernt werden
     assert_int_equal(GUI_RemoveElement(&element0, &gui), ERR_OK);
     assert_int_equal(GUI_RemoveElement(&element1, &gui), ERR_OK);
@@ -100,7 +104,7 @@ static void gui_can_add_and_remove_elements(void **state) {
     assert_int_equal(GUI_RemoveElement(&element0, &gui), ERR_OK);
     assert_int_equal(GUI_RemoveElement(&element1, &gui), ERR_OK);
     assert_int_equal(gui.element.elementCount, 0);
-    List_Clear(&gui.element);
+    IntrusiveList_Clear(&gui.element);
 }
 
 /**
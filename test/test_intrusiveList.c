@@ -0,0 +1,256 @@
+/**
+ * @file test_intrusiveList.c
+ * @brief Tests für intrusiveList-Modul
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ */
+
+/*
+ * Includes
+ *
+ */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "intrusiveList.h"
+#include "error.h"
+
+
+/*
+ * Typdeklarationen
+ *
+ */
+
+/**
+ * @brief Testelement mit eingebettetem Kettenglied
+ *
+ */
+typedef struct {
+    int value;       //!< Wert des Elements
+    listLink_t link; //!< Kettenglied
+} testElement_t;
+
+
+/*
+ * Variablendeklarationen
+ *
+ */
+
+static intrusiveList_t *foreachList; //!< Liste die im Callback bearbeitet wird
+
+extern unsigned long mockHeapAllocations; //!< Allozierungszähler aus mock_heap.c
+
+
+/*
+ * Hilfsfunktionen
+ *
+ */
+
+/**
+ * @brief Callback welcher das aktuelle Element aus der Liste entfernt.
+ *
+ * @param data opaker Pointer auf testElement_t
+ *
+ * @return immer 0
+ */
+static int removeSelf(void *data) {
+    testElement_t *element = (testElement_t *)data;
+    return IntrusiveList_Remove(foreachList, &element->link);
+}
+
+/**
+ * @brief Callback welcher die Werte aufsummiert.
+ *
+ * @param data opaker Pointer auf testElement_t
+ * @param userData opaker Pointer auf Summe als int
+ *
+ * @return immer 0
+ */
+static int sumValues(void *data, void *userData) {
+    *(int *)userData += ((testElement_t *)data)->value;
+    return ERR_OK;
+}
+
+
+/*
+ * Tests
+ *
+ */
+
+/**
+ * @brief Eine mit 0 initialisierte und eine initialisierte Liste sind leer.
+ *
+ * @param state unbenutzt
+ */
+static void init_and_check_initialized_members(void **state) {
+    (void)state;
+    intrusiveList_t list = {0};
+    assert_null(list.first);
+    list.elementCount = 5;
+    assert_int_equal(IntrusiveList_Init(&list), ERR_OK);
+    assert_null(list.first);
+    assert_int_equal(list.elementCount, 0);
+}
+
+/**
+ * @brief Elemente werden am Anfang eingefügt und in beliebiger Reihenfolge
+ * entfernt.
+ *
+ * @param state unbenutzt
+ */
+static void check_add_order_and_remove(void **state) {
+    (void)state;
+    intrusiveList_t list = {0};
+    testElement_t e[3] = {{.value = 1}, {.value = 2}, {.value = 3}};
+    for (int i = 0; i < 3; ++i) {
+        assert_int_equal(IntrusiveList_Add(&list, &e[i].link, &e[i]), ERR_OK);
+        assert_true(IntrusiveList_IsLinked(&e[i].link));
+    }
+    assert_int_equal(list.elementCount, 3);
+    // Zuletzt hinzugefügtes Element ist das erste
+    assert_ptr_equal(list.first->data, &e[2]);
+    assert_ptr_equal(list.first->next->data, &e[1]);
+    assert_ptr_equal(list.first->next->next->data, &e[0]);
+    // Mittleres Element entfernen
+    assert_int_equal(IntrusiveList_Remove(&list, &e[1].link), ERR_OK);
+    assert_false(IntrusiveList_IsLinked(&e[1].link));
+    assert_int_equal(list.elementCount, 2);
+    assert_ptr_equal(list.first->next->data, &e[0]);
+    // Erstes Element entfernen
+    assert_int_equal(IntrusiveList_Remove(&list, &e[2].link), ERR_OK);
+    assert_ptr_equal(list.first->data, &e[0]);
+    // Erneutes Entfernen ist wirkungslos
+    assert_int_equal(IntrusiveList_Remove(&list, &e[2].link), ERR_OK);
+    assert_int_equal(list.elementCount, 1);
+    // Letztes Element entfernen
+    assert_int_equal(IntrusiveList_Remove(&list, &e[0].link), ERR_OK);
+    assert_null(list.first);
+    assert_int_equal(list.elementCount, 0);
+}
+
+/**
+ * @brief Ein bereits verkettetes Glied kann nicht erneut hinzugefügt werden.
+ *
+ * @param state unbenutzt
+ */
+static void check_double_add(void **state) {
+    (void)state;
+    intrusiveList_t list = {0}, other = {0};
+    testElement_t e = {0};
+    assert_int_equal(IntrusiveList_Add(&list, &e.link, &e), ERR_OK);
+    assert_int_equal(IntrusiveList_Add(&list, &e.link, &e), ERR_SEQUENCE);
+    assert_int_equal(IntrusiveList_Add(&other, &e.link, &e), ERR_SEQUENCE);
+    assert_int_equal(list.elementCount, 1);
+    assert_int_equal(other.elementCount, 0);
+}
+
+/**
+ * @brief Clear entfernt alle Elemente, diese können danach erneut
+ * hinzugefügt werden.
+ *
+ * @param state unbenutzt
+ */
+static void check_clear(void **state) {
+    (void)state;
+    intrusiveList_t list = {0};
+    testElement_t e[3] = {0};
+    for (int i = 0; i < 3; ++i) {
+        IntrusiveList_Add(&list, &e[i].link, &e[i]);
+    }
+    assert_int_equal(IntrusiveList_Clear(&list), ERR_OK);
+    assert_null(list.first);
+    assert_int_equal(list.elementCount, 0);
+    for (int i = 0; i < 3; ++i) {
+        assert_false(IntrusiveList_IsLinked(&e[i].link));
+        assert_int_equal(IntrusiveList_Add(&list, &e[i].link, &e[i]), ERR_OK);
+    }
+    assert_int_equal(list.elementCount, 3);
+}
+
+/**
+ * @brief Foreach durchläuft alle Elemente und der Callback darf das aktuelle
+ * Element entfernen.
+ *
+ * @param state unbenutzt
+ */
+static void check_foreach_and_remove_inside_loop(void **state) {
+    (void)state;
+    intrusiveList_t list = {0};
+    testElement_t e[10];
+    for (int i = 0; i < 10; ++i) {
+        e[i] = (testElement_t){.value = i};
+        IntrusiveList_Add(&list, &e[i].link, &e[i]);
+    }
+    int sum = 0;
+    assert_int_equal(IntrusiveList_ForeachArg(&list, sumValues, &sum), ERR_OK);
+    assert_int_equal(sum, 45);
+    foreachList = &list;
+    assert_int_equal(IntrusiveList_Foreach(&list, removeSelf), ERR_OK);
+    assert_null(list.first);
+    assert_int_equal(list.elementCount, 0);
+}
+
+/**
+ * @brief Hinzufügen, Entfernen und Leeren allozieren keinen Heapspeicher.
+ *
+ * @param state unbenutzt
+ */
+static void check_no_allocations(void **state) {
+    (void)state;
+    intrusiveList_t list = {0};
+    testElement_t e[20] = {0};
+    unsigned long allocations = mockHeapAllocations;
+    for (int frame = 0; frame < 100; ++frame) {
+        for (int i = 0; i < 20; ++i) {
+            IntrusiveList_Add(&list, &e[i].link, &e[i]);
+        }
+        for (int i = 0; i < 20; i += 2) {
+            IntrusiveList_Remove(&list, &e[i].link);
+        }
+        IntrusiveList_Clear(&list);
+    }
+    assert_int_equal(mockHeapAllocations, allocations);
+}
+
+/**
+ * @brief Ungültige Parameter werden abgefangen.
+ *
+ * @param state unbenutzt
+ */
+static void check_null_catch(void **state) {
+    (void)state;
+    intrusiveList_t list = {0};
+    testElement_t e = {0};
+    assert_int_equal(IntrusiveList_Init(NULL), ERR_NULLPARAMETER);
+    assert_int_equal(IntrusiveList_Add(NULL, &e.link, &e), ERR_NULLPARAMETER);
+    assert_int_equal(IntrusiveList_Add(&list, NULL, &e), ERR_NULLPARAMETER);
+    assert_int_equal(IntrusiveList_Remove(NULL, &e.link), ERR_NULLPARAMETER);
+    assert_int_equal(IntrusiveList_Remove(&list, NULL), ERR_NULLPARAMETER);
+    assert_int_equal(IntrusiveList_Clear(NULL), ERR_NULLPARAMETER);
+    assert_false(IntrusiveList_IsLinked(NULL));
+    assert_int_equal(IntrusiveList_Foreach(NULL, removeSelf), ERR_NULLPARAMETER);
+    assert_int_equal(IntrusiveList_Foreach(&list, NULL), ERR_NULLPARAMETER);
+    assert_int_equal(IntrusiveList_ForeachArg(NULL, sumValues, NULL), ERR_NULLPARAMETER);
+    assert_int_equal(IntrusiveList_ForeachArg(&list, NULL, NULL), ERR_NULLPARAMETER);
+}
+
+/**
+ * @brief Testprogramm
+ *
+ * @return int Anzahl fehlgeschlagener Tests
+ */
+int main(void) {
+    const struct CMUnitTest list[] = {
+        cmocka_unit_test(init_and_check_initialized_members),
+        cmocka_unit_test(check_add_order_and_remove),
+        cmocka_unit_test(check_double_add),
+        cmocka_unit_test(check_clear),
+        cmocka_unit_test(check_foreach_and_remove_inside_loop),
+        cmocka_unit_test(check_no_allocations),
+        cmocka_unit_test(check_null_catch),
+    };
+    return cmocka_run_group_tests(list, NULL, NULL);
+}
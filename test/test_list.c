@@ -22,6 +22,14 @@
 #include "error.h"
 
 
+/*
+ * Variablendeklarationen
+ * 
+ */
+
+extern unsigned long mockHeapAllocations; //!< Allozierungszähler aus mock_heap.c
+
+
 /*
  * Tests
  * 
@@ -40,6 +48,7 @@ static void init_and_check_initialized_members(void **state) {
     assert_int_equal(list.elementCount, 0);
     assert_null(list.listHead);
     assert_null(list.dataAutoFree);
+    assert_null(list.pool);
 }
 
 /**
@@ -512,6 +521,74 @@ static void lists_can_delete_elements_inside_for_loop(void **state) {
     assert_int_equal(List_ForeachArg(&list, forCallbackDeleteAllArg, NULL), ERR_OK);
 }
 
+/**
+ * @brief Testet ob eine Liste mit Pool nach dem Aufwärmen keinen Heap mehr braucht
+ * 
+ * @param state unbenutzt
+ */
+static void pooled_list_has_no_allocations_after_warmup(void **state) {
+    (void)state;
+    list_t list;
+    int values[20];
+    List_Init(&list);
+    // Ungültige Poolgrösse
+    assert_int_equal(List_InitPooled(NULL, 8), ERR_NULLPARAMETER);
+    assert_int_equal(List_InitPooled(&list, 0), ERR_PARAMETER);
+    assert_int_equal(List_InitPooled(&list, 65537), ERR_PARAMETER);
+    assert_int_equal(List_InitPooled(&list, 8), ERR_OK);
+    assert_non_null(list.pool);
+    // Aufwärmen, 20 Elemente benötigen drei Blöcke
+    for (int i = 0; i < 20; ++i) {
+        assert_int_equal(List_Add(&list, &values[i]), ERR_OK);
+    }
+    assert_int_equal(list.elementCount, 20);
+    assert_int_equal(List_Clear(&list), ERR_OK);
+    assert_non_null(list.pool); // Pool bleibt nach Clear erhalten
+    // Eingeschwungener Zustand: Hinzufügen und Entfernen ohne Heapzugriff
+    unsigned long allocations = mockHeapAllocations;
+    for (int frame = 0; frame < 100; ++frame) {
+        for (int i = 0; i < 20; ++i) {
+            List_Add(&list, &values[i]);
+        }
+        assert_ptr_equal(list.listHead->data, &values[19]);
+        for (int i = 0; i < 20; i += 2) {
+            List_Remove(&list, &values[i]);
+        }
+        List_Clear(&list);
+    }
+    assert_int_equal(mockHeapAllocations, allocations);
+    // Pool befreien, danach wird wieder einzeln alloziert
+    assert_int_equal(List_ReleasePool(&list), ERR_OK);
+    assert_null(list.pool);
+    assert_int_equal(List_Add(&list, &values[0]), ERR_OK);
+    assert_int_equal(mockHeapAllocations, allocations + 1);
+    List_Clear(&list);
+}
+
+/**
+ * @brief Testet das Erstellen und Zerstören einer Liste mit Pool
+ * 
+ * @param state unbenutzt
+ */
+static void create_pooled_then_destroy_list(void **state) {
+    (void)state;
+    list_t *list = NULL;
+    int v1 = 1;
+    assert_int_equal(List_Create(&list), ERR_OK);
+    assert_int_equal(List_InitPooled(list, 4), ERR_OK);
+    List_Add(list, &v1);
+    List_Add(list, &v1);
+    // Erneuter Aufruf befreit den alten Pool samt Elementen
+    assert_int_equal(List_InitPooled(list, 8), ERR_OK);
+    assert_int_equal(list->elementCount, 0);
+    assert_null(list->listHead);
+    assert_non_null(list->pool);
+    assert_int_equal(list->pool->chunkCapacity, 8);
+    List_Add(list, &v1);
+    assert_int_equal(List_Destroy(&list), ERR_OK); // Befreit auch den Pool
+    assert_null(list);
+}
+
 /**
  * @brief Testprogramm
  * 
@@ -529,6 +606,8 @@ int main(void) {
         cmocka_unit_test(check_dataAutoFree),
         cmocka_unit_test(check_null_catch),
         cmocka_unit_test(lists_can_delete_elements_inside_for_loop),
+        cmocka_unit_test(pooled_list_has_no_allocations_after_warmup),
+        cmocka_unit_test(create_pooled_then_destroy_list),
     };
     return cmocka_run_group_tests(list, NULL, NULL);
 }
@@ -21,6 +21,9 @@
 #include <cmocka.h>
 
 #include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "sdlWrapper.h"
 #include "error.h"
@@ -32,6 +35,9 @@
  * 
  */
 
+static int mockGroundY;      //!< Oberkante des simulierten Bodens
+static int mockWorldQueries; //!< Anzahl Abfragen des simulierten Bodens
+
 /**
  * @brief Das echte \ref World_CheckCollision().
  * 
@@ -50,7 +56,8 @@ extern int __real_World_CheckCollision(SDL_Rect aabb, entityCollision_t *collisi
  * Funktion nicht als eigenständige Mock-Datei wie z.B. \ref mock_sdlw.c zu
  * ersetzen. Denn damit könnte die originale Funktion nicht aufgerufen werden.
  * @note Wird die echte Funktion benötigt, sollte per will_return eine 1 gesetzt
- * werden.
+ * werden. Mit einer 2 wird ein flacher Boden ab \ref mockGroundY simuliert und
+ * jede Abfrage in \ref mockWorldQueries gezählt.
  * 
  * @param[in] aabb Die AABB-Kollisionsbox
  * @param[out] collision Die Kollisionsdaten
@@ -58,8 +65,15 @@ extern int __real_World_CheckCollision(SDL_Rect aabb, entityCollision_t *collisi
  * @return immer 0 falls gemockt, sonst den Fehlercode von der echten Funktion
  */
 int __wrap_World_CheckCollision(SDL_Rect aabb, entityCollision_t *collision) {
-    if (mock_type(int)) {
+    int mode = mock_type(int);
+    if (mode == 1) {
         return __real_World_CheckCollision(aabb, collision);
+    } else if (mode == 2) {
+        ++mockWorldQueries;
+        int depth = aabb.y + aabb.h - mockGroundY;
+        collision->flags = depth > 0 ? ENTITY_COLLISION_WORLD : 0;
+        collision->normal = (SDL_FPoint){0.0f, depth > 0 ? (float)-depth : 0.0f};
+        return ERR_OK;
     } else {
         return ERR_OK;
     }
@@ -122,8 +136,8 @@ static void physics_can_set_position_of_entity(void **state) {
         } else {
             assert_int_equal(Physics_SetPosition(entity, testPoints[i].given.x, testPoints[i].given.y), ERR_OK);
         }
-        assert_float_equal(entity->physics.position.x, testPoints[i].expected.x, EPSILON);
-        assert_float_equal(entity->physics.position.y, testPoints[i].expected.y, EPSILON);
+        assert_float_equal(Physics_GetPosition(entity).x, testPoints[i].expected.x, EPSILON);
+        assert_float_equal(Physics_GetPosition(entity).y, testPoints[i].expected.y, EPSILON);
     }
 }
 
@@ -161,8 +175,8 @@ static void physics_can_set_velocity_of_entity(void **state) {
         } else {
             assert_int_equal(Physics_SetVelocity(entity, testPoints[i].given.x, testPoints[i].given.y), ERR_OK);
         }
-        assert_float_equal(entity->physics.velocity.x, testPoints[i].expected.x, EPSILON);
-        assert_float_equal(entity->physics.velocity.y, testPoints[i].expected.y, EPSILON);
+        assert_float_equal(Physics_GetVelocity(entity).x, testPoints[i].expected.x, EPSILON);
+        assert_float_equal(Physics_GetVelocity(entity).y, testPoints[i].expected.y, EPSILON);
     }
 }
 
@@ -210,8 +224,8 @@ static void physics_can_set_velocity_in_polar_of_entity(void **state) {
         } else {
             assert_int_equal(Physics_SetVelocityPolar(entity, testPoints[i].given.v, testPoints[i].given.angle), ERR_OK);
         }
-        assert_float_equal(entity->physics.velocity.x, testPoints[i].expected.x, EPSILON);
-        assert_float_equal(entity->physics.velocity.y, testPoints[i].expected.y, EPSILON);
+        assert_float_equal(Physics_GetVelocity(entity).x, testPoints[i].expected.x, EPSILON);
+        assert_float_equal(Physics_GetVelocity(entity).y, testPoints[i].expected.y, EPSILON);
     }
 }
 
@@ -249,7 +263,7 @@ static void physics_can_set_rotation_of_entity(void **state) {
         } else {
             assert_int_equal(Physics_SetRotation(entity, testPoints[i].given), ERR_OK);
         }
-        assert_float_equal(entity->physics.rotation, testPoints[i].expected, EPSILON);
+        assert_float_equal(Physics_GetRotation(entity), testPoints[i].expected, EPSILON);
     }
 }
 
@@ -279,17 +293,17 @@ static int onCollision(entity_t *self, entityCollision_t *collision) {
 }
 
 /**
- * @brief Testzustand mit Entitäten und einer Liste der Entitäten
+ * @brief Testzustand mit Entitäten und deren Physikspeicher
  * 
  */
 typedef struct {
-    entity_t entity0;   //!< Erste Entität mit allen Werten = 0, aber w & h = 10
-    entity_t entity1;   //!< Zweite Entität mit allen Werten = 0, aber w & h = 10
-    list_t *entityList; //!< Liste der Entitäten
+    entity_t entity0;     //!< Erste Entität mit allen Werten = 0, aber w & h = 10
+    entity_t entity1;     //!< Zweite Entität mit allen Werten = 0, aber w & h = 10
+    physicsStore_t store; //!< Physikspeicher mit den Entitäten
 } testState_t;
 
 /**
- * @brief Setup: Testzustand mit Entitäten und Liste erstellen
+ * @brief Setup: Testzustand mit Entitäten und Physikspeicher erstellen
  * 
  * @param[out] state Pointer auf testState_t*
  * 
@@ -304,17 +318,16 @@ static int setupTestState(void **state) {
     };
     testState.entity0 = entityOk;
     testState.entity1 = entityOk;
-    // Entitäten der Liste hinzufügen
-    List_Create(&testState.entityList);
-    List_Add(testState.entityList, &testState.entity0);
-    List_Add(testState.entityList, &testState.entity1);
+    // Entitäten dem Physikspeicher hinzufügen
+    PhysicsStore_Add(&testState.store, &testState.entity0);
+    PhysicsStore_Add(&testState.store, &testState.entity1);
     // Testzustand erstellen
     *state = (void *)&testState;
-    return (testState.entityList == NULL);
+    return (testState.store.count != 2);
 }
 
 /**
- * @brief Teardown: Testzustand mit Entitäten und Liste löschen.
+ * @brief Teardown: Testzustand mit Entitäten und Physikspeicher löschen.
  * 
  * @param[in] state Pointer auf testState_t*
  * 
@@ -322,8 +335,7 @@ static int setupTestState(void **state) {
  */
 static int teardownTestState(void **state) {
     testState_t *testState = (testState_t *)*state;
-    List_Destroy(&testState->entityList);
-    return (testState->entityList != NULL);
+    return PhysicsStore_Destroy(&testState->store);
 }
 
 /**
@@ -339,13 +351,13 @@ static void physics_applies_gravity_to_entity(void **state) {
     // keine Kollisionen mit der Welt abfragen
     will_return_always(__wrap_World_CheckCollision, 0);
     // Nach mindestens 10 Iterationen wurde Entität in y Richtung verschoben
-    assert_float_equal(testState->entity0.physics.position.y, 0.0f, EPSILON);
-    assert_float_equal(testState->entity1.physics.position.y, 0.0f, EPSILON);
+    assert_float_equal(Physics_GetPosition(&testState->entity0).y, 0.0f, EPSILON);
+    assert_float_equal(Physics_GetPosition(&testState->entity1).y, 0.0f, EPSILON);
     for (int i = 0; i < 10; ++i) {
-        assert_int_equal(Physics_Update(testState->entityList), ERR_OK);
+        assert_int_equal(Physics_Update(&testState->store), ERR_OK);
     }
-    assert_float_not_equal(testState->entity0.physics.position.y, 0.0f, EPSILON);
-    assert_float_not_equal(testState->entity1.physics.position.y, 0.0f, EPSILON);
+    assert_float_not_equal(Physics_GetPosition(&testState->entity0).y, 0.0f, EPSILON);
+    assert_float_not_equal(Physics_GetPosition(&testState->entity1).y, 0.0f, EPSILON);
 }
 
 /**
@@ -360,18 +372,18 @@ static void physics_on_collision_callback_is_called_for_identical_aabbs(void **s
     Physics_SetPosition(&testState->entity1, 0.0f, 0.0f);
     // keine Kollisionen mit der Welt abfragen
     will_return_always(__wrap_World_CheckCollision, 0);
-    // Callback der zweiten Entität wird aufgerufen (da diese in der Liste zuerst ist)
+    // Callback der zweiten Entität wird aufgerufen (da diese zuletzt hinzugefügt wurde)
     expect_function_call(onCollision);
     expect_value(onCollision, self, &testState->entity1);
     will_return(onCollision, 0);      // keine Flags zurücksetzen
     will_return(onCollision, ERR_OK); // Callback hat keinen Fehler
-    // Callback der ersten Entität wird aufgerufen (da diese in der Liste zuletzt ist)
+    // Callback der ersten Entität wird aufgerufen (da diese zuerst hinzugefügt wurde)
     expect_function_call(onCollision);
     expect_value(onCollision, self, &testState->entity0);
     will_return(onCollision, 0);      // keine Flags zurücksetzen
     will_return(onCollision, ERR_OK); // Callback hat keinen Fehler
     // Update durchführen
-    assert_int_equal(Physics_Update(testState->entityList), ERR_OK);
+    assert_int_equal(Physics_Update(&testState->store), ERR_OK);
 }
 
 /**
@@ -386,18 +398,18 @@ static void physics_on_collision_callback_is_called_for_touching_aabbs(void **st
     Physics_SetPosition(&testState->entity1, 9.0f, 0.0f);
     // keine Kollisionen mit der Welt abfragen
     will_return_always(__wrap_World_CheckCollision, 0);
-    // Callback der zweiten Entität wird aufgerufen (da diese in der Liste zuerst ist)
+    // Callback der zweiten Entität wird aufgerufen (da diese zuletzt hinzugefügt wurde)
     expect_function_call(onCollision);
     expect_value(onCollision, self, &testState->entity1);
     will_return(onCollision, 0);      // keine Flags zurücksetzen
     will_return(onCollision, ERR_OK); // Callback hat keinen Fehler
-    // Callback der ersten Entität wird aufgerufen (da diese in der Liste zuletzt ist)
+    // Callback der ersten Entität wird aufgerufen (da diese zuerst hinzugefügt wurde)
     expect_function_call(onCollision);
     expect_value(onCollision, self, &testState->entity0);
     will_return(onCollision, 0);      // keine Flags zurücksetzen
     will_return(onCollision, ERR_OK); // Callback hat keinen Fehler
     // Update durchführen
-    assert_int_equal(Physics_Update(testState->entityList), ERR_OK);
+    assert_int_equal(Physics_Update(&testState->store), ERR_OK);
 }
 
 /**
@@ -415,7 +427,7 @@ static void physics_on_collision_callback_is_not_called_for_side_by_side_aabbs(v
     // Callback der zweiten Entität wird nicht aufgerufen
     // Callback der ersten Entität wird nicht aufgerufen
     // Update durchführen
-    assert_int_equal(Physics_Update(testState->entityList), ERR_OK);
+    assert_int_equal(Physics_Update(&testState->store), ERR_OK);
 }
 
 /**
@@ -433,22 +445,22 @@ static void physics_on_collision_callback_can_clear_flags(void **state) {
     Physics_SetVelocity(&testState->entity1, horizontalVelocity, 0.0f);
     // keine Kollisionen mit der Welt abfragen
     will_return_always(__wrap_World_CheckCollision, 0);
-    // Callback der zweiten Entität wird aufgerufen (da diese in der Liste zuerst ist)
+    // Callback der zweiten Entität wird aufgerufen (da diese zuletzt hinzugefügt wurde)
     expect_function_call(onCollision);
     expect_value(onCollision, self, &testState->entity1);
     will_return(onCollision, ENTITY_COLLISION_ENTITY); // "handle" die Kollision
     will_return(onCollision, ERR_OK);                  // Callback hat keinen Fehler
-    // Callback der ersten Entität wird aufgerufen (da diese in der Liste zuletzt ist)
+    // Callback der ersten Entität wird aufgerufen (da diese zuerst hinzugefügt wurde)
     expect_function_call(onCollision);
     expect_value(onCollision, self, &testState->entity0);
     will_return(onCollision, 0);      // keine Flags zurücksetzen
     will_return(onCollision, ERR_OK); // Callback hat keinen Fehler
     // Update durchführen
-    assert_int_equal(Physics_Update(testState->entityList), ERR_OK);
+    assert_int_equal(Physics_Update(&testState->store), ERR_OK);
     // Für die erste Entität wurde die Standardaktion durchgeführt
-    assert_float_not_equal(testState->entity0.physics.velocity.x, horizontalVelocity, EPSILON);
+    assert_float_not_equal(Physics_GetVelocity(&testState->entity0).x, horizontalVelocity, EPSILON);
     // Für die zweite Entität wurde nicht Standardmässig reagiert
-    assert_float_equal(testState->entity1.physics.velocity.x, horizontalVelocity, EPSILON);
+    assert_float_equal(Physics_GetVelocity(&testState->entity1).x, horizontalVelocity, EPSILON);
 }
 
 /**
@@ -486,20 +498,20 @@ static void physics_two_falling_entities_that_are_aproaching_do_not_cross(void *
 #endif
     // 5 Sekunden lang simulieren
     for (int i = 0; i < 60 * 5; ++i) {
-        Physics_Update(testState->entityList);
+        Physics_Update(&testState->store);
 #ifndef CI_TEST
         // Stelle die AABBs visuell dar
         SDL_Color black = {.r = 255, .g = 255, .b = 255};
         SDLW_Clear(black);
         SDL_Color red = {.r = 255, .g = 0, .b = 0};
-        SDLW_DrawFilledRect(testState->entity0.physics.aabb, red);
+        SDLW_DrawFilledRect(Physics_GetAABB(&testState->entity0), red);
         SDL_Color green = {.r = 0, .g = 255, .b = 0};
-        SDLW_DrawFilledRect(testState->entity1.physics.aabb, green);
+        SDLW_DrawFilledRect(Physics_GetAABB(&testState->entity1), green);
         SDLW_Render();
 #endif
     }
     // Das rechte Rechteck ist nicht durch das linke hindurch gegangen
-    assert_true(testState->entity0.physics.position.x < testState->entity1.physics.position.x);
+    assert_true(Physics_GetPosition(&testState->entity0).x < Physics_GetPosition(&testState->entity1).x);
 #ifndef CI_TEST
     SDLW_Quit();
 #endif
@@ -521,8 +533,7 @@ static void physics_resting_entity_ontop_of_another_entity_does_not_fall_through
     // Startzustand setzen, oberes Rechteck direkt über dem unteren
     Physics_SetPosition(&testState->entity0, (800.0f / 2.0f), 100.0f - 10.0f);
     // unteres Rechteck ist sehr breit
-    testState->entity1.physics.aabb.w = 600;
-    testState->entity1.physics.aabb.h = 10;
+    Physics_SetSize(&testState->entity1, 600, 10);
     // keine Kollisionen mit der Welt abfragen
     will_return_always(__wrap_World_CheckCollision, 0);
     // Der Kollisionscallback soll mindestens 1 mal aufgerufen werden
@@ -541,22 +552,22 @@ static void physics_resting_entity_ontop_of_another_entity_does_not_fall_through
         // Position und Geschwindigkeit des unteren Rechtecks fixieren
         Physics_SetPosition(&testState->entity1, (800.0f / 2.0f), 100.0f);
         Physics_SetVelocity(&testState->entity1, 0.0f, 0.0f);
-        Physics_Update(testState->entityList);
+        Physics_Update(&testState->store);
 #ifndef CI_TEST
         // Stelle die AABBs visuell dar
         SDL_Color black = {.r = 255, .g = 255, .b = 255};
         SDLW_Clear(black);
         SDL_Color red = {.r = 255, .g = 0, .b = 0};
-        SDLW_DrawFilledRect(testState->entity0.physics.aabb, red);
+        SDLW_DrawFilledRect(Physics_GetAABB(&testState->entity0), red);
         SDL_Color green = {.r = 0, .g = 255, .b = 0};
-        SDLW_DrawFilledRect(testState->entity1.physics.aabb, green);
+        SDLW_DrawFilledRect(Physics_GetAABB(&testState->entity1), green);
         SDLW_Render();
 #endif
     }
     // Das fallende Rechteck ist nicht zur Seite bewegt worden.
-    assert_float_equal(testState->entity0.physics.position.x, (800.0f / 2.0f), EPSILON);
+    assert_float_equal(Physics_GetPosition(&testState->entity0).x, (800.0f / 2.0f), EPSILON);
     // Es ist in etwa an Ort und Stelle geblieben (+- 2 Pixel)
-    assert_float_equal(testState->entity0.physics.position.y, 90.0f, 2.0f);
+    assert_float_equal(Physics_GetPosition(&testState->entity0).y, 90.0f, 2.0f);
 #ifndef CI_TEST
     SDLW_Quit();
 #endif
@@ -578,8 +589,7 @@ static void physics_falling_entity_stops_on_collision_with_another_entity_and_do
     // Startzustand setzen, oberes Rechteck ist oben in der Mitte
     Physics_SetPosition(&testState->entity0, (800.0f / 2.0f), 50.0f);
     // unteres Rechteck ist sehr breit
-    testState->entity1.physics.aabb.w = 600;
-    testState->entity1.physics.aabb.h = 10;
+    Physics_SetSize(&testState->entity1, 600, 10);
     // keine Kollisionen mit der Welt abfragen
     will_return_always(__wrap_World_CheckCollision, 0);
     // Der Kollisionscallback soll mindestens 1 mal aufgerufen werden
@@ -598,22 +608,22 @@ static void physics_falling_entity_stops_on_collision_with_another_entity_and_do
         // Position und Geschwindigkeit des unteren Rechtecks fixieren
         Physics_SetPosition(&testState->entity1, (800.0f / 2.0f), 100.0f);
         Physics_SetVelocity(&testState->entity1, 0.0f, 0.0f);
-        Physics_Update(testState->entityList);
+        Physics_Update(&testState->store);
 #ifndef CI_TEST
         // Stelle die AABBs visuell dar
         SDL_Color black = {.r = 255, .g = 255, .b = 255};
         SDLW_Clear(black);
         SDL_Color red = {.r = 255, .g = 0, .b = 0};
-        SDLW_DrawFilledRect(testState->entity0.physics.aabb, red);
+        SDLW_DrawFilledRect(Physics_GetAABB(&testState->entity0), red);
         SDL_Color green = {.r = 0, .g = 255, .b = 0};
-        SDLW_DrawFilledRect(testState->entity1.physics.aabb, green);
+        SDLW_DrawFilledRect(Physics_GetAABB(&testState->entity1), green);
         SDLW_Render();
 #endif
     }
     // Das fallende Rechteck ist höchstens nach oben, aber nicht zur Seite bewegt worden.
-    assert_float_equal(testState->entity0.physics.position.x, (800.0f / 2.0f), EPSILON);
+    assert_float_equal(Physics_GetPosition(&testState->entity0).x, (800.0f / 2.0f), EPSILON);
     // Es ist nicht durch das untere Rechteck gefallen
-    assert_true(testState->entity0.physics.position.y < testState->entity1.physics.position.y);
+    assert_true(Physics_GetPosition(&testState->entity0).y < Physics_GetPosition(&testState->entity1).y);
 #ifndef CI_TEST
     SDLW_Quit();
 #endif
@@ -636,8 +646,7 @@ static void physics_falling_entity_that_collides_with_another_falling_entity_doe
     Physics_SetPosition(&testState->entity0, (800.0f / 2.0f), 50.0f);
     // unteres Rechteck ist sehr breit
     Physics_SetPosition(&testState->entity1, (800.0f / 2.0f), 100.0f);
-    testState->entity1.physics.aabb.w = 600;
-    testState->entity1.physics.aabb.h = 10;
+    Physics_SetSize(&testState->entity1, 600, 10);
     // keine Kollisionen mit der Welt abfragen
     will_return_always(__wrap_World_CheckCollision, 0);
     // Der Kollisionscallback soll mindestens 1 mal aufgerufen werden
@@ -655,22 +664,22 @@ static void physics_falling_entity_that_collides_with_another_falling_entity_doe
     for (int i = 0; i < 60 * 5; ++i) {
         // Geschwindigkeit des unteren Rechtecks fixieren
         Physics_SetVelocity(&testState->entity1, 0.0f, 20.0f);
-        Physics_Update(testState->entityList);
+        Physics_Update(&testState->store);
 #ifndef CI_TEST
         // Stelle die AABBs visuell dar
         SDL_Color black = {.r = 255, .g = 255, .b = 255};
         SDLW_Clear(black);
         SDL_Color red = {.r = 255, .g = 0, .b = 0};
-        SDLW_DrawFilledRect(testState->entity0.physics.aabb, red);
+        SDLW_DrawFilledRect(Physics_GetAABB(&testState->entity0), red);
         SDL_Color green = {.r = 0, .g = 255, .b = 0};
-        SDLW_DrawFilledRect(testState->entity1.physics.aabb, green);
+        SDLW_DrawFilledRect(Physics_GetAABB(&testState->entity1), green);
         SDLW_Render();
 #endif
     }
     // Das fallende Rechteck ist höchstens nach oben, aber nicht zur Seite bewegt worden.
-    assert_float_equal(testState->entity0.physics.position.x, (800.0f / 2.0f), EPSILON);
+    assert_float_equal(Physics_GetPosition(&testState->entity0).x, (800.0f / 2.0f), EPSILON);
     // Es ist nicht durch das untere Rechteck gefallen
-    assert_true(testState->entity0.physics.position.y < testState->entity1.physics.position.y);
+    assert_true(Physics_GetPosition(&testState->entity0).y < Physics_GetPosition(&testState->entity1).y);
 #ifndef CI_TEST
     SDLW_Quit();
 #endif
@@ -693,8 +702,7 @@ static void physics_falling_entity_that_collides_with_another_rising_entity_does
     Physics_SetPosition(&testState->entity0, (800.0f / 2.0f), 50.0f);
     // unteres Rechteck ist sehr breit
     Physics_SetPosition(&testState->entity1, (800.0f / 2.0f), 100.0f);
-    testState->entity1.physics.aabb.w = 600;
-    testState->entity1.physics.aabb.h = 10;
+    Physics_SetSize(&testState->entity1, 600, 10);
     // keine Kollisionen mit der Welt abfragen
     will_return_always(__wrap_World_CheckCollision, 0);
     // Der Kollisionscallback soll mindestens 1 mal aufgerufen werden
@@ -712,27 +720,27 @@ static void physics_falling_entity_that_collides_with_another_rising_entity_does
     for (int i = 0; i < 60 * 5; ++i) {
         // Geschwindigkeit des unteren Rechtecks fixieren
         Physics_SetVelocity(&testState->entity1, 0.0f, -30.0f);
-        Physics_Update(testState->entityList);
+        Physics_Update(&testState->store);
 #ifndef CI_TEST
         // Stelle die AABBs visuell dar
         SDL_Color black = {.r = 255, .g = 255, .b = 255};
         SDLW_Clear(black);
         SDL_Color red = {.r = 255, .g = 0, .b = 0};
-        SDLW_DrawFilledRect(testState->entity0.physics.aabb, red);
+        SDLW_DrawFilledRect(Physics_GetAABB(&testState->entity0), red);
         SDL_Color green = {.r = 0, .g = 255, .b = 0};
-        SDLW_DrawFilledRect(testState->entity1.physics.aabb, green);
+        SDLW_DrawFilledRect(Physics_GetAABB(&testState->entity1), green);
         SDLW_Render();
 #endif
     }
     // Das fallende Rechteck ist höchstens nach oben, aber nicht zur Seite bewegt worden.
-    assert_float_equal(testState->entity0.physics.position.x, (800.0f / 2.0f), EPSILON);
+    assert_float_equal(Physics_GetPosition(&testState->entity0).x, (800.0f / 2.0f), EPSILON);
 #ifndef CI_TEST
     SDLW_Quit();
 #endif
 }
 
 /**
- * @brief Setup: Welt laden und Testzustand mit Entitäten und Liste erstellen.
+ * @brief Setup: Welt laden und Testzustand mit Entitäten und Physikspeicher erstellen.
  * 
  * @note in der GitLap-Pipeline wird keine Welt geladen
  * 
@@ -749,10 +757,9 @@ static int setupTestStateAndWorld(void **state) {
     };
     testState.entity0 = entityOk;
     testState.entity1 = entityOk;
-    // Entitäten der Liste hinzufügen
-    List_Create(&testState.entityList);
-    List_Add(testState.entityList, &testState.entity0);
-    List_Add(testState.entityList, &testState.entity1);
+    // Entitäten dem Physikspeicher hinzufügen
+    PhysicsStore_Add(&testState.store, &testState.entity0);
+    PhysicsStore_Add(&testState.store, &testState.entity1);
     // Testzustand erstellen
     *state = (void *)&testState;
     // SDLW und Welt laden
@@ -763,8 +770,8 @@ static int setupTestStateAndWorld(void **state) {
     ret |= SDLW_LoadResources("assets/test/config.cfg");
     ret |= World_Load("world");
 #endif
-    // Erfolgreich wenn Entitätsliste erstellt und Welt geladen
-    if (testState.entityList && ret == ERR_OK) { // cppcheck-suppress knownConditionTrueFalse
+    // Erfolgreich wenn Physikspeicher erstellt und Welt geladen
+    if (testState.store.count == 2 && ret == ERR_OK) { // cppcheck-suppress knownConditionTrueFalse
         return 0;
     }
     return 1;
@@ -780,15 +787,14 @@ static int setupTestStateAndWorld(void **state) {
 static int teardownTestStateAndWorld(void **state) {
     testState_t *testState = (testState_t *)*state;
     // Testzustand löschen
-    List_Destroy(&testState->entityList);
+    int ret = PhysicsStore_Destroy(&testState->store);
     // Welt entladen
-    int ret = ERR_OK;
 #ifndef CI_TEST
     World_Quit();
     SDLW_Quit();
 #endif
-    // Erfolgreich wenn Entitätsliste gelöscht und Welt entladen
-    if (!testState->entityList && ret == ERR_OK) { // cppcheck-suppress knownConditionTrueFalse
+    // Erfolgreich wenn Physikspeicher gelöscht und Welt entladen
+    if (!testState->store.count && ret == ERR_OK) { // cppcheck-suppress knownConditionTrueFalse
         return 0;
     }
     return 1;
@@ -812,7 +818,7 @@ static void physics_resting_entity_ontop_of_the_world_does_not_fall_through(void
     // Startpunkte abfragen
     const int points = 10;
     SDL_Point startPoints[points];
-    assert_int_equal(World_CreateStartLocations(testState->entity0.physics.aabb, points, startPoints), ERR_OK);
+    assert_int_equal(World_CreateStartLocations(Physics_GetAABB(&testState->entity0), points, startPoints), ERR_OK);
     // Kollisionen mit der Welt aktivieren
     will_return_always(__wrap_World_CheckCollision, 1);
     // Der Kollisionscallback soll mindestens 1 mal aufgerufen werden
@@ -828,24 +834,24 @@ static void physics_resting_entity_ontop_of_the_world_does_not_fall_through(void
         Physics_SetPosition(&testState->entity1, startPoints[p + 1].x + 5, startPoints[p + 1].y + 5);
         // 2 Sekunden lang simulieren
         for (int i = 0; i < 60 * 2; ++i) {
-            Physics_Update(testState->entityList);
+            Physics_Update(&testState->store);
             // Stelle die AABBs und die Welt visuell dar
             SDL_Color black = {.r = 255, .g = 255, .b = 255};
             SDLW_Clear(black);
             World_DrawBackground();
             World_DrawForeground();
             SDL_Color red = {.r = 255, .g = 0, .b = 0};
-            SDLW_DrawFilledRect(testState->entity0.physics.aabb, red);
+            SDLW_DrawFilledRect(Physics_GetAABB(&testState->entity0), red);
             SDL_Color green = {.r = 0, .g = 255, .b = 0};
-            SDLW_DrawFilledRect(testState->entity1.physics.aabb, green);
+            SDLW_DrawFilledRect(Physics_GetAABB(&testState->entity1), green);
             SDLW_Render();
         }
         // Das Rechteck ist nicht zur Seite bewegt worden.
-        assert_int_equal(testState->entity0.physics.aabb.x, startPoints[p].x);
-        assert_int_equal(testState->entity1.physics.aabb.x, startPoints[p + 1].x);
+        assert_int_equal(Physics_GetAABB(&testState->entity0).x, startPoints[p].x);
+        assert_int_equal(Physics_GetAABB(&testState->entity1).x, startPoints[p + 1].x);
         // Es ist in etwa an Ort und Stelle geblieben (+- 2 Pixel)
-        assert_in_range(testState->entity0.physics.aabb.y, startPoints[p].y - 2, startPoints[p].y + 2);
-        assert_in_range(testState->entity1.physics.aabb.y, startPoints[p + 1].y - 2, startPoints[p + 1].y + 2);
+        assert_in_range(Physics_GetAABB(&testState->entity0).y, startPoints[p].y - 2, startPoints[p].y + 2);
+        assert_in_range(Physics_GetAABB(&testState->entity1).y, startPoints[p + 1].y - 2, startPoints[p + 1].y + 2);
     }
 }
 
@@ -866,10 +872,10 @@ static void physics_manually_moving_entity_ontop_of_the_world_does_not_fall_thro
     skip();
 #endif
     // Zweite Entität weit weg setzen, wird nicht benötigt
-    testState->entity1.physics.position.x = -1000.0;
+    Physics_SetPosition(&testState->entity1, -1000.0f, NAN);
     // Startpunkt
     SDL_Point startPoint;
-    assert_int_equal(World_CreateStartLocations(testState->entity0.physics.aabb, 1, &startPoint), ERR_OK);
+    assert_int_equal(World_CreateStartLocations(Physics_GetAABB(&testState->entity0), 1, &startPoint), ERR_OK);
     // Kollisionen mit der Welt aktivieren
     will_return_always(__wrap_World_CheckCollision, 1);
     // Der Kollisionscallback soll mindestens 1 mal aufgerufen werden
@@ -885,29 +891,506 @@ static void physics_manually_moving_entity_ontop_of_the_world_does_not_fall_thro
         // per Pfeiltasten kann bewegt werden
         SDL_Event e;
         SDL_PollEvent(&e);
-        float *x = &testState->entity0.physics.velocity.x;
+        float x = Physics_GetVelocity(&testState->entity0).x;
         if (e.type == SDL_KEYDOWN) {
             // Geschwindigkeit gemäss Pfeiltasten verändern
             if (e.key.keysym.sym == SDLK_LEFT) {
-                if (*x > -50.0f) *x -= 10.0f;
+                if (x > -50.0f) x -= 10.0f;
             } else if (e.key.keysym.sym == SDLK_RIGHT) {
-                if (*x < 50.0f) *x += 10.0f;
+                if (x < 50.0f) x += 10.0f;
             }
         }
-        *x *= 0.99; // dämpfen
+        x *= 0.99; // dämpfen
+        Physics_SetVelocity(&testState->entity0, x, NAN);
         // Physik berechnen
-        Physics_Update(testState->entityList);
+        Physics_Update(&testState->store);
         // Stelle die AABBs und die Welt visuell dar
         SDL_Color black = {.r = 255, .g = 255, .b = 255};
         SDLW_Clear(black);
         World_DrawBackground();
         World_DrawForeground();
         SDL_Color red = {.r = 255, .g = 0, .b = 0};
-        SDLW_DrawFilledRect(testState->entity0.physics.aabb, red);
+        SDLW_DrawFilledRect(Physics_GetAABB(&testState->entity0), red);
         SDLW_Render();
     }
 }
 
+#define BROAD_PHASE_TEST_COUNT 300 //!< Anzahl Entitäten im Test der Breitphase
+
+static entity_t broadPhaseEntities[BROAD_PHASE_TEST_COUNT];                            //!< Entitäten im Test der Breitphase
+static unsigned char broadPhaseHits[BROAD_PHASE_TEST_COUNT][BROAD_PHASE_TEST_COUNT]; //!< Anzahl Callbacks pro Entität und Partner
+
+/**
+ * @brief onCollision Callback, der Kollisionen zwischen Entitäten zählt.
+ * 
+ * @param self Pointer auf die Entität dessen Callback gerade aufgerufen wird
+ * @param collision Pointer auf Informationen zur aufgetretenen Kollision
+ * 
+ * @return immer ERR_OK
+ */
+static int countingCollision(entity_t *self, entityCollision_t *collision) {
+    if (collision->partner && self >= broadPhaseEntities && self < broadPhaseEntities + BROAD_PHASE_TEST_COUNT) {
+        broadPhaseHits[self - broadPhaseEntities][collision->partner - broadPhaseEntities]++;
+    }
+    collision->flags = 0;
+    return ERR_OK;
+}
+
+/**
+ * @brief Breitphase meldet jedes überlappende Paar genau einmal pro Partner
+ * 
+ * Zufällig verteilte, unbewegte Entitäten, teilweise ausserhalb des Bildes,
+ * eine ohne Fläche und eine über sehr viele Zellen. Verglichen wird mit der
+ * paarweisen Prüfung aller Entitäten.
+ * 
+ * @param state unbenutzt
+ */
+static void physics_broad_phase_reports_each_overlapping_pair_once(void **state) {
+    (void)state;
+    will_return_always(__wrap_World_CheckCollision, 0);
+    physicsStore_t store = {0};
+    unsigned int seed = 12345;
+    for (int i = 0; i < BROAD_PHASE_TEST_COUNT; ++i) {
+        entity_t *entity = &broadPhaseEntities[i];
+        *entity = (entity_t){.callbacks.onCollision = countingCollision};
+        entity->physics.isStatic = 1;
+        seed = seed * 1103515245u + 12345u;
+        int x = (int)(seed >> 8) % 1400 - 200;
+        seed = seed * 1103515245u + 12345u;
+        int y = (int)(seed >> 8) % 1000 - 200;
+        seed = seed * 1103515245u + 12345u;
+        int w = 4 + (int)(seed >> 8) % 60;
+        int h = 4 + (int)(seed >> 16) % 60;
+        if (i == 5) {
+            w = 0;
+        } else if (i == 17) {
+            w = 2000;
+        }
+        entity->physics.aabb = (SDL_Rect){x, y, w, h};
+        Physics_SetPosition(entity, x + w / 2, y + h / 2);
+        assert_int_equal(PhysicsStore_Add(&store, entity), ERR_OK);
+    }
+    memset(broadPhaseHits, 0, sizeof(broadPhaseHits));
+    assert_int_equal(Physics_Update(&store), ERR_OK);
+    int pairs = 0;
+    for (int i = 0; i < BROAD_PHASE_TEST_COUNT; ++i) {
+        for (int j = 0; j < BROAD_PHASE_TEST_COUNT; ++j) {
+            SDL_Rect a = Physics_GetAABB(&broadPhaseEntities[i]);
+            SDL_Rect b = Physics_GetAABB(&broadPhaseEntities[j]);
+            int overlap = i != j && a.w > 0 && a.h > 0 && b.w > 0 && b.h > 0 &&
+                          a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+            assert_int_equal(broadPhaseHits[i][j], overlap);
+            pairs += overlap;
+        }
+    }
+    // Auch die grosse Entität hat Partner
+    assert_true(pairs > 0);
+    int partnersOfLarge = 0;
+    for (int j = 0; j < BROAD_PHASE_TEST_COUNT; ++j) {
+        partnersOfLarge += broadPhaseHits[17][j];
+    }
+    assert_true(partnersOfLarge > 0);
+    PhysicsStore_Destroy(&store);
+}
+
+#define MATCH_STEPS 600 //!< Anzahl Schritte eines Testspiels, 10 Sekunden
+#define MATCH_SHOTS 12  //!< Anzahl Schüsse eines Testspiels
+#define MATCH_GROUND 500 //!< Oberkante des simulierten Bodens eines Testspiels
+
+/**
+ * @brief Gradienten des Distanzfeldes unter den Panzern eines Testspiels.
+ *
+ * Ganzzahlig in 1/16 Pixel wie \ref worldDistance_t.gradient. Der erste
+ * Panzer steht eben, der zweite am Hang.
+ */
+static const SDL_Point matchSlopes[2] = {{0, -96}, {37, -88}};
+
+/**
+ * @brief Erwarteter Hash des Testspiels im deterministischen Modus.
+ *
+ * Muss mit jedem Compiler, jeder Optimierung und auf jeder Plattform gleich
+ * sein. Ändert sich die Physik absichtlich, ist der Wert neu zu ermitteln.
+ */
+#define MATCH_HASH 0x1fa9abd8bd491889ull
+
+/**
+ * @brief Entitäten eines Testspiels
+ * 
+ */
+typedef struct {
+    entity_t tanks[2];            //!< Zwei Panzer die auf den Boden fallen
+    entity_t shells[MATCH_SHOTS]; //!< Abwechselnd abgefeuerte Schüsse
+} testMatch_t;
+
+/**
+ * @brief Erweitere einen FNV-1a Hash um die Physikdaten einer Entität.
+ * 
+ * @param hash Bisheriger Hash
+ * @param entity Die Entität
+ * 
+ * @return Der erweiterte Hash
+ */
+static uint64_t hashPhysics(uint64_t hash, const entity_t *entity) {
+    const entityPhysics_t *physics = &entity->physics;
+    unsigned char bytes[sizeof(SDL_FPoint) * 2 + sizeof(double) + sizeof(SDL_Rect)];
+    memcpy(bytes, &physics->position, sizeof(SDL_FPoint));
+    memcpy(bytes + sizeof(SDL_FPoint), &physics->velocity, sizeof(SDL_FPoint));
+    memcpy(bytes + sizeof(SDL_FPoint) * 2, &physics->rotation, sizeof(double));
+    memcpy(bytes + sizeof(SDL_FPoint) * 2 + sizeof(double), &physics->aabb, sizeof(SDL_Rect));
+    for (size_t b = 0; b < sizeof(bytes); ++b) {
+        hash = (hash ^ bytes[b]) * 1099511628211u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Prüfe ob eine Position auf dem Raster von Q16.16 liegt.
+ * 
+ * @param position Die Position
+ * 
+ * @return true falls beide Koordinaten ein Vielfaches von 1/65536 sind
+ */
+static bool onFixedGrid(SDL_FPoint position) {
+    return position.x * FIXED_ONE == floorf(position.x * FIXED_ONE) &&
+           position.y * FIXED_ONE == floorf(position.y * FIXED_ONE);
+}
+
+/**
+ * @brief onCollision Callback der Entitäten eines Testspiels.
+ * Die Physik reagiert mit ihrer Standardaktion.
+ * 
+ * @param self unbenutzt
+ * @param collision unbenutzt
+ * 
+ * @return immer ERR_OK
+ */
+static int matchCollision(entity_t *self, entityCollision_t *collision) {
+    (void)self;
+    (void)collision;
+    return ERR_OK;
+}
+
+/**
+ * @brief onCollision Callback der Panzer eines Testspiels.
+ * Im Spiel explodieren Geschosse beim Aufprall, die Panzer werden deshalb
+ * nicht von ihnen verschoben. Auf den Boden reagiert die Physik mit ihrer
+ * Standardaktion.
+ * 
+ * @param self unbenutzt
+ * @param collision Infos der Kollision
+ * 
+ * @return immer ERR_OK
+ */
+static int matchTankCollision(entity_t *self, entityCollision_t *collision) {
+    (void)self;
+    collision->flags &= ~ENTITY_COLLISION_ENTITY;
+    return ERR_OK;
+}
+
+/**
+ * @brief Feuere einen Schuss eines Testspiels ab.
+ * 
+ * Rechnet wie fire() in tank.c im deterministischen Modus: Rohransatz und
+ * Rohrende werden aus der Rotation des Panzers in Festkommazahlen bestimmt.
+ * 
+ * @param store Der Physikspeicher
+ * @param tank Der schiessende Panzer
+ * @param shell Der Schuss, wird neu initialisiert
+ * @param shot Nummer des Schusses
+ */
+static void matchFire(physicsStore_t *store, entity_t *tank, entity_t *shell, int shot) {
+    *shell = (entity_t){.callbacks.onCollision = matchCollision, .physics.aabb = {.w = 6, .h = 6}};
+    assert_int_equal(PhysicsStore_Add(store, shell), ERR_OK);
+    double tube = shot % 2 ? -140.0 - 3.3 * shot : -40.0 + 2.7 * shot;
+    fixed_t rotation = Physics_GetRotationFixed(tank);
+    fixed_t angle = rotation + Fixed_FromFloat((float)tube);
+    fixedVector_t position = Physics_GetPositionFixed(tank);
+    fixedVector_t offset = Physics_PolarToVectorFixed(Fixed_FromInt(-10), rotation + Fixed_FromInt(90));
+    position.x += offset.x;
+    position.y += offset.y;
+    offset = Physics_PolarToVectorFixed(Fixed_FromInt(20), angle);
+    position.x += offset.x;
+    position.y += offset.y;
+    Physics_SetPositionFixed(shell, position);
+    Physics_SetVelocityFixed(shell, Physics_PolarToVectorFixed(Fixed_FromFloat(120.0f + 7.5f * shot), angle));
+}
+
+/**
+ * @brief Spiele ein festgelegtes Testspiel und bilde einen Hash des Endzustands.
+ * 
+ * Wie im Spiel werden die Panzer gedämpft und nach dem Gradienten des Bodens
+ * ausgerichtet, die Schüsse per Polarform abgefeuert und entlang ihrer
+ * Flugbahn ausgerichtet. Der Hash ist FNV-1a über die Bits aller Physikdaten.
+ * 
+ * @param[out] match Die Entitäten nach dem Spiel
+ * 
+ * @return Der Hash
+ */
+static uint64_t playMatch(testMatch_t *match) {
+    physicsStore_t store = {0};
+    *match = (testMatch_t){0};
+    for (int t = 0; t < 2; ++t) {
+        match->tanks[t] = (entity_t){
+            .callbacks.onCollision = matchTankCollision,
+            .physics = {.position = {250.0f + 500.0f * t, 300.0f + 37.5f * t}, .aabb = {.w = 30, .h = 16}}};
+        assert_int_equal(PhysicsStore_Add(&store, &match->tanks[t]), ERR_OK);
+        // Wie rotateToWorld() in tank.c, ohne Normierung des Gradienten
+        fixed_t slope = Fixed_Atan2(Fixed_FromInt(matchSlopes[t].y), Fixed_FromInt(matchSlopes[t].x));
+        Physics_SetRotationFixed(&match->tanks[t], slope + Fixed_FromInt(90));
+    }
+    for (int step = 0; step < MATCH_STEPS; ++step) {
+        // Alle 40 Schritte schiesst abwechselnd ein Panzer auf den anderen
+        int shot = step / 40;
+        if (step % 40 == 0 && shot < MATCH_SHOTS) {
+            matchFire(&store, &match->tanks[shot % 2], &match->shells[shot], shot);
+        }
+        for (int t = 0; t < 2; ++t) {
+            Physics_SetVelocity(&match->tanks[t], Physics_GetVelocity(&match->tanks[t]).x * 0.95f, NAN);
+        }
+        for (int i = 0; i < shot && i < MATCH_SHOTS; ++i) {
+            entity_t *shell = &match->shells[i];
+            SDL_FPoint velocity = Physics_GetVelocity(shell);
+            Physics_SetRotation(shell, Physics_VectorToAngle(velocity.x, velocity.y));
+        }
+        assert_int_equal(Physics_Update(&store), ERR_OK);
+    }
+    PhysicsStore_Destroy(&store);
+    uint64_t hash = 14695981039346656037u;
+    for (int t = 0; t < 2; ++t) {
+        hash = hashPhysics(hash, &match->tanks[t]);
+    }
+    for (int i = 0; i < MATCH_SHOTS; ++i) {
+        hash = hashPhysics(hash, &match->shells[i]);
+    }
+    return hash;
+}
+
+/**
+ * @brief Im deterministischen Modus ergibt dasselbe Spiel bitgenau denselben
+ * Zustand.
+ * 
+ * Das Testspiel läuft auf einem simulierten Boden und wird zweimal gespielt.
+ * Dazwischen läuft es einmal mit Gleitkommazahlen, damit der Wechsel des
+ * Modus keinen Zustand hinterlässt. Beide Hashes müssen dem festen Wert
+ * \ref MATCH_HASH entsprechen, so werden auch verschiedene Builds verglichen.
+ * Alle Positionen liegen zudem auf dem Raster von Q16.16.
+ * 
+ * @param state unbenutzt
+ */
+static void physics_deterministic_match_is_bit_identical(void **state) {
+    (void)state;
+    mockGroundY = MATCH_GROUND;
+    will_return_always(__wrap_World_CheckCollision, 2);
+    static testMatch_t first, second, floating;
+    Physics_SetDeterministic(1);
+    uint64_t firstHash = playMatch(&first);
+    Physics_SetDeterministic(0);
+    playMatch(&floating);
+    Physics_SetDeterministic(1);
+    uint64_t secondHash = playMatch(&second);
+    Physics_SetDeterministic(0);
+    assert_int_equal(firstHash, MATCH_HASH);
+    assert_int_equal(secondHash, MATCH_HASH);
+    // Die Panzer sind auf den Boden gefallen und liegen darauf
+    for (int t = 0; t < 2; ++t) {
+        SDL_Rect aabb = Physics_GetAABB(&first.tanks[t]);
+        assert_int_equal(aabb.y + aabb.h, MATCH_GROUND);
+        assert_true(onFixedGrid(Physics_GetPosition(&first.tanks[t])));
+    }
+    // Nur der zweite Panzer steht am Hang und schiesst schräg zu seinem Rohr
+    assert_true(first.tanks[0].physics.rotation == 0.0);
+    assert_true(first.tanks[1].physics.rotation > 20.0);
+    for (int i = 0; i < MATCH_SHOTS; ++i) {
+        assert_true(onFixedGrid(Physics_GetPosition(&first.shells[i])));
+    }
+}
+
+/**
+ * @brief Eine auf dem Boden ruhende Entität braucht pro Schritt wenige
+ * Abfragen der Welt.
+ * 
+ * Die Entität fällt schnell auf einen simulierten Boden und wird dabei auf
+ * dessen Oberkante befreit. Danach genügt dank der gemerkten Befreiungshöhe
+ * pro Schritt eine Abfrage zur Erkennung und höchstens zwei zur Befreiung.
+ * 
+ * @param state unbenutzt
+ */
+static void physics_resting_entity_on_ground_needs_few_world_queries(void **state) {
+    (void)state;
+    physicsStore_t store = {0};
+    entity_t entity = {
+        .callbacks.onCollision = matchCollision,
+        .physics = {.position = {100.0f, 280.0f}, .velocity = {0.0f, 300.0f}, .aabb = {.w = 10, .h = 10}}};
+    assert_int_equal(PhysicsStore_Add(&store, &entity), ERR_OK);
+    mockGroundY = 300;
+    will_return_always(__wrap_World_CheckCollision, 2);
+    // Landen, die Unterkante liegt danach auf dem Boden
+    for (int i = 0; i < 60; ++i) {
+        assert_int_equal(Physics_Update(&store), ERR_OK);
+    }
+    SDL_Rect aabb = Physics_GetAABB(&entity);
+    assert_in_range(aabb.y + aabb.h, 299, 300);
+    // Ruhen
+    int maxQueries = 0;
+    for (int i = 0; i < 60 * 2; ++i) {
+        mockWorldQueries = 0;
+        assert_int_equal(Physics_Update(&store), ERR_OK);
+        if (mockWorldQueries > maxQueries) {
+            maxQueries = mockWorldQueries;
+        }
+        aabb = Physics_GetAABB(&entity);
+        assert_int_equal(aabb.x, 95);
+        assert_in_range(aabb.y + aabb.h, 299, 300);
+    }
+    assert_in_range(maxQueries, 1, 3);
+    PhysicsStore_Destroy(&store);
+}
+
+#define ORDER_TEST_COUNT 4 //!< Anzahl Entitäten im Test der Reihenfolge
+
+static entity_t *orderCalls[ORDER_TEST_COUNT * ORDER_TEST_COUNT]; //!< Entitäten in der Reihenfolge ihrer Callbacks
+static int orderCallCount;                                         //!< Anzahl aufgezeichneter Callbacks
+
+/**
+ * @brief onCollision Callback, der die Reihenfolge der Aufrufe aufzeichnet.
+ * 
+ * @param self Pointer auf die Entität dessen Callback gerade aufgerufen wird
+ * @param collision Pointer auf Informationen zur aufgetretenen Kollision
+ * 
+ * @return immer ERR_OK
+ */
+static int orderCollision(entity_t *self, entityCollision_t *collision) {
+    orderCalls[orderCallCount++] = self;
+    collision->flags = 0;
+    return ERR_OK;
+}
+
+/**
+ * @brief Entfernen aus dem Physikspeicher erhält die Reihenfolge der Slots.
+ * 
+ * Der Slot wird erst frei markiert und im nächsten Schritt geschlossen. Die
+ * übrigen Entitäten rücken dabei nach, die Kollisionen werden also weiterhin
+ * in umgekehrter Reihenfolge des Hinzufügens gemeldet. Die entfernte Entität
+ * erhält ihre Physikdaten aus dem Speicher zurück.
+ * 
+ * @param state unbenutzt
+ */
+static void physics_store_remove_keeps_collision_order(void **state) {
+    (void)state;
+    will_return_always(__wrap_World_CheckCollision, 0);
+    physicsStore_t store = {0};
+    entity_t entities[ORDER_TEST_COUNT];
+    for (int i = 0; i < ORDER_TEST_COUNT; ++i) {
+        // Alle liegen übereinander und kollidieren paarweise
+        entities[i] = (entity_t){.callbacks.onCollision = orderCollision, .physics.aabb = {.w = 10, .h = 10}};
+        Physics_SetPosition(&entities[i], 100.0f, 100.0f);
+        assert_int_equal(PhysicsStore_Add(&store, &entities[i]), ERR_OK);
+    }
+    // Ab jetzt gilt der Speicher, die Entität selbst bleibt unverändert
+    Physics_SetPosition(&entities[1], 100.0f, 102.0f);
+    assert_float_equal(Physics_GetPosition(&entities[1]).y, 102.0f, EPSILON);
+    assert_float_equal(entities[1].physics.position.y, 100.0f, EPSILON);
+    assert_int_equal(PhysicsStore_Remove(&store, &entities[1]), ERR_OK);
+    assert_false(PhysicsStore_Contains(&store, &entities[1]));
+    assert_float_equal(entities[1].physics.position.y, 102.0f, EPSILON);
+    // Slot nur frei markiert, nichts wurde verschoben
+    assert_int_equal(store.count, ORDER_TEST_COUNT);
+    assert_int_equal(store.freeCount, 1);
+    assert_null(store.entity[1]);
+    assert_int_equal(entities[3].physicsSlot, 3);
+    // Der zuletzt hinzugefügte zuerst, beide Partner nacheinander
+    entity_t *calls[] = {&entities[3], &entities[2], &entities[3], &entities[0],
+                         &entities[2], &entities[0]};
+    orderCallCount = 0;
+    assert_int_equal(Physics_Update(&store), ERR_OK);
+    assert_int_equal(orderCallCount, 6);
+    for (int i = 0; i < 6; ++i) {
+        assert_ptr_equal(orderCalls[i], calls[i]);
+    }
+    // Verbleibende Slots geschlossen, in der Reihenfolge des Hinzufügens
+    entity_t *expected[] = {&entities[0], &entities[2], &entities[3]};
+    assert_int_equal(store.count, 3);
+    assert_int_equal(store.freeCount, 0);
+    for (int slot = 0; slot < 3; ++slot) {
+        assert_ptr_equal(store.entity[slot], expected[slot]);
+        assert_int_equal(expected[slot]->physicsSlot, slot);
+    }
+    // Der letzte Slot wird sofort freigegeben
+    assert_int_equal(PhysicsStore_Remove(&store, &entities[3]), ERR_OK);
+    assert_int_equal(store.count, 2);
+    assert_int_equal(store.freeCount, 0);
+    PhysicsStore_Destroy(&store);
+}
+
+/**
+ * @brief Laufzeit eines Physikupdates für 1'000 und 10'000 Entitäten.
+ * 
+ * Die Entitäten liegen in einem Raster und überlappen sich nicht. Damit wird
+ * hauptsächlich die Iteration über die Physikdaten gemessen. Zusätzlich 2'000
+ * zufällig verteilte Geschosse für die Breitphase.
+ * 
+ * @param state unbenutzt
+ */
+static void physics_update_benchmark(void **state) {
+    (void)state;
+    // keine Kollisionen mit der Welt abfragen
+    will_return_always(__wrap_World_CheckCollision, 0);
+    const int entityCounts[] = {1000, 10000};
+    for (int c = 0; c < 2; ++c) {
+        int count = entityCounts[c];
+        physicsStore_t store = {0};
+        entity_t *entities = calloc(count, sizeof(entity_t));
+        assert_non_null(entities);
+        for (int i = 0; i < count; ++i) {
+            entities[i].callbacks.onCollision = onCollision;
+            entities[i].physics.aabb = (SDL_Rect){.w = 10, .h = 10};
+            Physics_SetPosition(&entities[i], (i % 100) * 20.0f + 10.0f, (i / 100) * 20.0f + 10.0f);
+            assert_int_equal(PhysicsStore_Add(&store, &entities[i]), ERR_OK);
+        }
+        Uint64 start = SDL_GetPerformanceCounter();
+        assert_int_equal(Physics_Update(&store), ERR_OK);
+        double seconds = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+        print_message("Physics_Update mit %d Entitaeten: %.3f ms\n", count, seconds * 1000.0);
+        // Jede zweite Entität auf einmal entfernen, geschlossen wird im Update
+        start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < count; i += 2) {
+            assert_int_equal(PhysicsStore_Remove(&store, &entities[i]), ERR_OK);
+        }
+        double removeSeconds = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+        start = SDL_GetPerformanceCounter();
+        assert_int_equal(Physics_Update(&store), ERR_OK);
+        seconds = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+        assert_int_equal(store.count, count / 2);
+        print_message("%d Entfernungen: %.3f ms, danach Physics_Update: %.3f ms\n",
+                      count / 2, removeSeconds * 1000.0, seconds * 1000.0);
+        PhysicsStore_Destroy(&store);
+        free(entities);
+    }
+
+    // 2'000 Geschosse zufällig im Bild verteilt, viele überlappen sich
+    const int projectiles = 2000;
+    physicsStore_t store = {0};
+    entity_t *entities = calloc(projectiles, sizeof(entity_t));
+    assert_non_null(entities);
+    unsigned int seed = 42;
+    for (int i = 0; i < projectiles; ++i) {
+        entities[i].callbacks.onCollision = countingCollision;
+        entities[i].physics.aabb = (SDL_Rect){.w = 4, .h = 4};
+        seed = seed * 1103515245u + 12345u;
+        float x = (float)((seed >> 8) % 1024);
+        seed = seed * 1103515245u + 12345u;
+        Physics_SetPosition(&entities[i], x, (float)((seed >> 8) % 576));
+        Physics_SetVelocity(&entities[i], 100.0f, -100.0f);
+        assert_int_equal(PhysicsStore_Add(&store, &entities[i]), ERR_OK);
+    }
+    Uint64 start = SDL_GetPerformanceCounter();
+    assert_int_equal(Physics_Update(&store), ERR_OK);
+    double seconds = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+    print_message("Physics_Update mit %d Geschossen: %.3f ms\n", projectiles, seconds * 1000.0);
+    PhysicsStore_Destroy(&store);
+    free(entities);
+}
+
 
 /**
  * @brief Testprogramm
@@ -963,6 +1446,12 @@ int main(void) {
         cmocka_unit_test_setup_teardown(
             physics_manually_moving_entity_ontop_of_the_world_does_not_fall_through,
             setupTestStateAndWorld, teardownTestStateAndWorld),
+
+        cmocka_unit_test(physics_broad_phase_reports_each_overlapping_pair_once),
+        cmocka_unit_test(physics_deterministic_match_is_bit_identical),
+        cmocka_unit_test(physics_resting_entity_on_ground_needs_few_world_queries),
+        cmocka_unit_test(physics_store_remove_keeps_collision_order),
+        cmocka_unit_test(physics_update_benchmark),
     };
     return cmocka_run_group_tests(physics, NULL, NULL);
 }
@@ -0,0 +1,142 @@
+/**
+ * @file test_profiler.c
+ * @brief Tests für profiler-Modul
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ */
+
+/*
+ * Includes
+ *
+ */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "profiler.h"
+#include "error.h"
+
+
+/*
+ * Variablendeklarationen
+ *
+ */
+
+static const char *reportFile = "test_profiler.json"; //!< Temporäre JSON-Ausgabe
+
+
+/*
+ * Hilfsfunktionen
+ *
+ */
+
+/**
+ * @brief Liest die JSON-Ausgabe ein.
+ *
+ * @param[out] buffer Puffer für den Inhalt
+ * @param size Grösse des Puffers
+ */
+static void readReport(char *buffer, size_t size) {
+    FILE *file = fopen(reportFile, "r");
+    assert_non_null(file);
+    size_t length = fread(buffer, 1, size - 1, file);
+    buffer[length] = '\0';
+    fclose(file);
+}
+
+
+/*
+ * Tests
+ *
+ */
+
+/**
+ * @brief Ohne Argument bleibt der Profiler aus und schreibt nichts.
+ *
+ * @param state unbenutzt
+ */
+static void disabled_by_default(void **state) {
+    (void)state;
+    remove(reportFile);
+    char *argv[] = {"tanks"};
+    assert_int_equal(Profiler_Init(1, argv), ERR_OK);
+    assert_false(Profiler_IsEnabled());
+    assert_int_equal(Profiler_Begin(), 0);
+    assert_true(Profiler_Elapsed(0) == 0.0);
+    assert_int_equal(Profiler_Record("init", "SDL_Init", NULL, -1, 0.0, 1.0), ERR_OK);
+    assert_int_equal(Profiler_Report(), ERR_OK);
+    assert_null(fopen(reportFile, "r"));
+}
+
+/**
+ * @brief Messungen werden absteigend sortiert als JSON geschrieben.
+ *
+ * @param state unbenutzt
+ */
+static void report_sorted_json(void **state) {
+    (void)state;
+    char argument[64];
+    snprintf(argument, sizeof(argument), "--profile=%s", reportFile);
+    char *argv[] = {"tanks", argument};
+    assert_int_equal(Profiler_Init(2, argv), ERR_OK);
+    assert_true(Profiler_IsEnabled());
+
+    uint64_t start = Profiler_Begin();
+    assert_true(start != 0);
+    assert_true(Profiler_Elapsed(start) >= 0.0);
+    assert_int_equal(Profiler_Record("init", "SDL_Init", NULL, -1, 0.0, 2.0), ERR_OK);
+    assert_int_equal(Profiler_Record("resource", "tubeTex", "texture", 1234, 3.0, 5.0), ERR_OK);
+    assert_int_equal(Profiler_Record("scene", "sce\"ne", NULL, -1, 0.0, 0.5), ERR_OK);
+    // Mehr Messungen als anfänglich Platz
+    for (int i = 0; i < 100; ++i)
+        assert_int_equal(Profiler_End(start, "load", "SDLW_DecodeJobs"), ERR_OK);
+    assert_int_equal(Profiler_Report(), ERR_OK);
+    assert_false(Profiler_IsEnabled());
+
+    static char report[32768];
+    readReport(report, sizeof(report));
+    assert_non_null(strstr(report, "\"totalMs\""));
+    char *slowest = strstr(report, "\"name\": \"tubeTex\", \"type\": \"texture\", \"bytes\": 1234, \"decodeMs\": 3.000, \"ms\": 5.000");
+    char *middle = strstr(report, "\"name\": \"SDL_Init\"");
+    char *fastest = strstr(report, "\"name\": \"sce\\\"ne\"");
+    assert_non_null(slowest);
+    assert_non_null(middle);
+    assert_non_null(fastest);
+    assert_true(slowest < middle && middle < fastest);
+    remove(reportFile);
+}
+
+/**
+ * @brief Ungültige Parameter werden abgefangen.
+ *
+ * @param state unbenutzt
+ */
+static void check_null_catch(void **state) {
+    (void)state;
+    assert_int_equal(Profiler_Init(1, NULL), ERR_NULLPARAMETER);
+    char *argv[] = {"tanks", "--profile"};
+    assert_int_equal(Profiler_Init(2, argv), ERR_OK);
+    assert_int_equal(Profiler_Record(NULL, "name", NULL, -1, 0.0, 0.0), ERR_NULLPARAMETER);
+    assert_int_equal(Profiler_Record("init", NULL, NULL, -1, 0.0, 0.0), ERR_NULLPARAMETER);
+    assert_int_equal(Profiler_Report(), ERR_OK);
+    remove("startup_profile.json");
+}
+
+/**
+ * @brief Testprogramm
+ *
+ * @return int Anzahl fehlgeschlagener Tests
+ */
+int main(void) {
+    const struct CMUnitTest profilerTest[] = {
+        cmocka_unit_test(disabled_by_default),
+        cmocka_unit_test(report_sorted_json),
+        cmocka_unit_test(check_null_catch),
+    };
+    return cmocka_run_group_tests(profilerTest, NULL, NULL);
+}
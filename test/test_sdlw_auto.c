@@ -20,7 +20,10 @@
 #include <setjmp.h>
 #include <cmocka.h>
 
+#include <stdio.h>
+
 #include "sdlWrapper.h"
+#include "assetPack.h"
 #include "error.h"
 
 
@@ -203,6 +206,264 @@ static void test_sdlw_getSound_and_play(void **state) {
     SDLW_Quit();
 }
 
+/**
+ * @brief Handles können aufgelöst und anstelle der ID verwendet werden.
+ * 
+ * @param state unbenutzt
+ */
+static void test_sdlw_handles(void **state) {
+    (void)state;
+    // Ohne Initialisierung gibt es keine Handles
+    assert_int_equal(SDLW_ResolveHandle("peep"), SDLW_INVALID_HANDLE);
+    SDLW_Init(500, 500);
+    assert_int_equal(SDLW_LoadResources("assets/test/config.cfg"), ERR_OK);
+
+    void *resource;
+    // Fehlerhafte id oder Handle
+    assert_int_equal(SDLW_ResolveHandle(NULL), SDLW_INVALID_HANDLE);
+    assert_int_equal(SDLW_ResolveHandle("nonsense"), SDLW_INVALID_HANDLE);
+    assert_int_equal(SDLW_GetResourceByHandle(SDLW_INVALID_HANDLE, RESOURCETYPE_ANY, &resource), ERR_PARAMETER);
+    assert_int_equal(SDLW_GetResourceByHandle(100000, RESOURCETYPE_ANY, &resource), ERR_PARAMETER);
+    assert_int_equal(SDLW_GetResourceByHandle(0, RESOURCETYPE_ANY, NULL), ERR_NULLPARAMETER);
+    assert_int_equal(SDLW_PlaySoundEffectByHandle(SDLW_INVALID_HANDLE), ERR_FAIL);
+
+    // Handle liefert dieselbe Ressource wie die Suche per ID
+    sdlwHandle_t peep = SDLW_ResolveHandle("peep");
+    assert_int_not_equal(peep, SDLW_INVALID_HANDLE);
+    assert_int_equal(SDLW_ResolveHandle("peep"), peep);
+    void *byId;
+    assert_int_equal(SDLW_GetResource("peep", RESOURCETYPE_SOUND_EFFECT, &byId), ERR_OK);
+    assert_int_equal(SDLW_GetResourceByHandle(peep, RESOURCETYPE_SOUND_EFFECT, &resource), ERR_OK);
+    assert_ptr_equal(resource, byId);
+    // Falscher Typ
+    assert_int_equal(SDLW_GetResourceByHandle(peep, RESOURCETYPE_TEXTURE, &resource), ERR_FAIL);
+    assert_null(resource);
+    // Abspielen
+    assert_int_equal(SDLW_PlaySoundEffectByHandle(peep), ERR_OK);
+    assert_int_equal(SDLW_PlaySoundEffectByHandle(SDLW_ResolveHandle("nswo")), ERR_FAIL);
+
+    SDLW_Quit();
+    // Nach dem Beenden sind die Handles ungültig
+    assert_int_equal(SDLW_ResolveHandle("peep"), SDLW_INVALID_HANDLE);
+}
+
+/**
+ * @brief Ressourcen werden aus einem Paket geladen, ohne Paket aus der
+ * Konfiguration.
+ * 
+ * @param state unbenutzt
+ */
+static void test_sdlw_pack(void **state) {
+    (void)state;
+    const char *packFile = "test_sdlw.pack";
+    void *resource;
+    // Ohne Initialisierung
+    assert_int_equal(SDLW_LoadPack((char *)packFile, "assets/test/config.cfg"), ERR_FAIL);
+    SDLW_Init(500, 500);
+    assert_int_equal(SDLW_LoadPack(NULL, "assets/test/config.cfg"), ERR_NULLPARAMETER);
+    assert_int_equal(SDLW_LoadPack((char *)packFile, NULL), ERR_NULLPARAMETER);
+
+    // Ohne Paket wird die Konfiguration geladen
+    remove(packFile);
+    assert_int_equal(SDLW_LoadPack((char *)packFile, "assets/test/config.cfg"), ERR_OK);
+    assert_int_equal(SDLW_GetResource("peep", RESOURCETYPE_SOUND_EFFECT, &resource), ERR_OK);
+    SDLW_Quit();
+
+    // Die Prüfsumme hängt nur von den Quelldateien ab
+    uint64_t sources, again;
+    assert_int_equal(SDLW_HashSources(NULL, &sources), ERR_NULLPARAMETER);
+    assert_int_equal(SDLW_HashSources("assets/test/config.cfg", NULL), ERR_NULLPARAMETER);
+    assert_int_equal(SDLW_HashSources("assets/test/missing.cfg", &sources), ERR_PARAMETER);
+    assert_int_equal(SDLW_HashSources("assets/test/config.cfg", &sources), ERR_OK);
+    assert_int_equal(SDLW_HashSources("assets/test/config.cfg", &again), ERR_OK);
+    assert_int_equal(sources, again);
+    assert_int_equal(SDLW_HashSources("assets/test/sounds/config.cfg", &again), ERR_OK);
+    assert_int_not_equal(sources, again);
+
+    // Paket mit Textur, Sprite und Soundeffekt erstellen
+    assetPackWriter_t writer;
+    assert_int_equal(AssetPack_BeginWrite(&writer, packFile, MIX_DEFAULT_FORMAT, MIX_DEFAULT_FREQUENCY, MIX_DEFAULT_CHANNELS, sources), ERR_OK);
+    const uint32_t pixels[4] = {0};
+    assetPackEntry_t texture = {.config = "packtex texture packtex.png\n", .key = "packtex", .type = "texture",
+                                .dataType = ASSETPACK_DATA_PIXELS, .width = 2, .height = 2, .pitch = 8};
+    assert_int_equal(AssetPack_WriteEntry(&writer, &texture, pixels, sizeof(pixels)), ERR_OK);
+    assetPackEntry_t sprite = {.config = "packsprite sprite packtex\n", .key = "packsprite", .type = "sprite"};
+    assert_int_equal(AssetPack_WriteEntry(&writer, &sprite, NULL, 0), ERR_OK);
+    const int16_t samples[8] = {0};
+    assetPackEntry_t effect = {.config = "packpeep sound packpeep.wav effect\n", .key = "packpeep", .type = "sound",
+                               .dataType = ASSETPACK_DATA_SAMPLES};
+    assert_int_equal(AssetPack_WriteEntry(&writer, &effect, samples, sizeof(samples)), ERR_OK);
+    assert_int_equal(AssetPack_EndWrite(&writer, packFile, 1), ERR_OK);
+
+    // Laden aus dem Paket, die Konfiguration wird nicht gelesen
+    SDLW_Init(500, 500);
+    assert_int_equal(SDLW_LoadPack((char *)packFile, "assets/test/config.cfg"), ERR_OK);
+    assert_int_equal(SDLW_GetResource("packtex", RESOURCETYPE_TEXTURE, &resource), ERR_OK);
+    assert_int_equal(SDLW_GetResource("packsprite", RESOURCETYPE_SPRITE, &resource), ERR_OK);
+    assert_int_equal(SDLW_PlaySoundEffect("packpeep"), ERR_OK);
+    assert_int_equal(SDLW_GetResource("peep", RESOURCETYPE_SOUND_EFFECT, &resource), ERR_FAIL);
+    // Es kann nur ein Paket geladen sein
+    assert_int_equal(SDLW_LoadPack((char *)packFile, "assets/test/config.cfg"), ERR_SEQUENCE);
+    SDLW_Quit();
+
+    // Ist das Paket veraltet, wird die Konfiguration geladen
+    assert_int_equal(AssetPack_BeginWrite(&writer, packFile, MIX_DEFAULT_FORMAT, MIX_DEFAULT_FREQUENCY, MIX_DEFAULT_CHANNELS, sources + 1), ERR_OK);
+    assert_int_equal(AssetPack_WriteEntry(&writer, &effect, samples, sizeof(samples)), ERR_OK);
+    assert_int_equal(AssetPack_EndWrite(&writer, packFile, 1), ERR_OK);
+    SDLW_Init(500, 500);
+    assert_int_equal(SDLW_LoadPack((char *)packFile, "assets/test/config.cfg"), ERR_OK);
+    assert_int_equal(SDLW_GetResource("peep", RESOURCETYPE_SOUND_EFFECT, &resource), ERR_OK);
+    assert_int_equal(SDLW_GetResource("packpeep", RESOURCETYPE_SOUND_EFFECT, &resource), ERR_FAIL);
+    SDLW_Quit();
+
+    // Passt das Audioformat nicht, wird die Konfiguration geladen
+    assert_int_equal(AssetPack_BeginWrite(&writer, packFile, MIX_DEFAULT_FORMAT, 8000, 1, sources), ERR_OK);
+    assert_int_equal(AssetPack_WriteEntry(&writer, &effect, samples, sizeof(samples)), ERR_OK);
+    assert_int_equal(AssetPack_EndWrite(&writer, packFile, 1), ERR_OK);
+    SDLW_Init(500, 500);
+    assert_int_equal(SDLW_LoadPack((char *)packFile, "assets/test/config.cfg"), ERR_OK);
+    assert_int_equal(SDLW_GetResource("peep", RESOURCETYPE_SOUND_EFFECT, &resource), ERR_OK);
+    assert_int_equal(SDLW_GetResource("packpeep", RESOURCETYPE_SOUND_EFFECT, &resource), ERR_FAIL);
+    SDLW_Quit();
+    remove(packFile);
+}
+
+/**
+ * @brief Texturen werden erst bei Bedarf geladen und ohne Referenz gemäss
+ * Budget wieder entladen.
+ * 
+ * @param state unbenutzt
+ */
+static void test_sdlw_lazy_and_budget(void **state) {
+    (void)state;
+    const size_t textureBytes = 100 * 100 * 4; // Grösse gemäss Mock von SDL_QueryTexture()
+    void *resource;
+    size_t bytes;
+    SDLW_Init(500, 500);
+    assert_int_equal(SDLW_LoadResources("assets/test/config.cfg"), ERR_OK);
+
+    // Fehlerbehandlung
+    assert_int_equal(SDLW_ReleaseResource(NULL), ERR_NULLPARAMETER);
+    assert_int_equal(SDLW_ReleaseResource("nonsense"), ERR_FAIL);
+    assert_int_equal(SDLW_GetResourceBytes(NULL, &bytes), ERR_NULLPARAMETER);
+    assert_int_equal(SDLW_GetResourceBytes("nswo", NULL), ERR_NULLPARAMETER);
+    assert_int_equal(SDLW_GetResourceBytes("nonsense", &bytes), ERR_FAIL);
+
+    // Von Sprites verwendete Texturen sind geladen, die übrigen noch nicht
+    assert_int_equal(SDLW_GetResourceBytes("nswo", &bytes), ERR_OK);
+    assert_int_equal(bytes, textureBytes);
+    assert_int_equal(SDLW_GetResourceBytes("green", &bytes), ERR_OK);
+    assert_int_equal(bytes, 0);
+    size_t baseUsage = SDLW_GetMemoryUsage();
+    assert_true(baseUsage >= 3 * textureBytes);
+
+    // Laden bei der ersten Verwendung
+    assert_int_equal(SDLW_GetResource("green", RESOURCETYPE_TEXTURE, &resource), ERR_OK);
+    assert_int_equal(SDLW_GetResourceBytes("green", &bytes), ERR_OK);
+    assert_int_equal(bytes, textureBytes);
+    assert_int_equal(SDLW_GetMemoryUsage(), baseUsage + textureBytes);
+    assert_int_equal(SDLW_ReleaseResource("green"), ERR_OK);
+    assert_int_equal(SDLW_ReleaseResource("green"), ERR_SEQUENCE);
+
+    // Vorlagen ohne Referenz, nur für Typen die nie entladen werden
+    assert_int_equal(SDLW_PeekResource("rect", RESOURCETYPE_SPRITE, NULL), ERR_NULLPARAMETER);
+    assert_int_equal(SDLW_PeekResource(NULL, RESOURCETYPE_SPRITE, &resource), ERR_NULLPARAMETER);
+    assert_int_equal(SDLW_PeekResource("nonsense", RESOURCETYPE_SPRITE, &resource), ERR_FAIL);
+    assert_int_equal(SDLW_PeekResource("green", RESOURCETYPE_TEXTURE, &resource), ERR_PARAMETER);
+    assert_null(resource);
+    assert_int_equal(SDLW_PeekResource("rect", RESOURCETYPE_SPRITE, &resource), ERR_OK);
+    assert_non_null(resource);
+    assert_int_equal(SDLW_ReleaseResource("rect"), ERR_SEQUENCE);
+
+    // Platz für zwei weitere Texturen, die am längsten unbenutzte wird entladen
+    assert_int_equal(SDLW_SetMemoryBudget(baseUsage + 2 * textureBytes), ERR_OK);
+    assert_int_equal(SDLW_GetResource("blue", RESOURCETYPE_TEXTURE, &resource), ERR_OK);
+    assert_int_equal(SDLW_ReleaseResource("blue"), ERR_OK);
+    assert_int_equal(SDLW_GetResource("green", RESOURCETYPE_TEXTURE, &resource), ERR_OK);
+    assert_int_equal(SDLW_ReleaseResource("green"), ERR_OK);
+    assert_int_equal(SDLW_GetResource("circle", RESOURCETYPE_TEXTURE, &resource), ERR_OK);
+    assert_int_equal(SDLW_GetResourceBytes("blue", &bytes), ERR_OK);
+    assert_int_equal(bytes, 0);
+    assert_int_equal(SDLW_GetResourceBytes("green", &bytes), ERR_OK);
+    assert_int_equal(bytes, textureBytes);
+
+    // Ohne Budget werden nur referenzierte Ressourcen behalten
+    assert_int_equal(SDLW_SetMemoryBudget(0), ERR_OK);
+    assert_int_equal(SDLW_GetResourceBytes("green", &bytes), ERR_OK);
+    assert_int_equal(bytes, 0);
+    assert_int_equal(SDLW_GetResourceBytes("circle", &bytes), ERR_OK);
+    assert_int_equal(bytes, textureBytes);
+    assert_int_equal(SDLW_GetResourceBytes("nswo", &bytes), ERR_OK);
+    assert_int_equal(bytes, textureBytes);
+    assert_int_equal(SDLW_ReleaseResource("circle"), ERR_OK);
+    assert_int_equal(SDLW_GetResourceBytes("circle", &bytes), ERR_OK);
+    assert_int_equal(bytes, 0);
+    // Entladene Ressourcen werden bei Bedarf neu erstellt
+    assert_int_equal(SDLW_PlaySoundEffect("peep"), ERR_OK);
+    assert_int_equal(SDLW_PlayMusic("jingle"), ERR_OK);
+    assert_int_equal(SDLW_GetResource("blue", RESOURCETYPE_TEXTURE, &resource), ERR_OK);
+    assert_non_null(resource);
+
+    SDLW_SetMemoryBudget(SDLW_DEFAULT_MEMORY_BUDGET);
+    SDLW_Quit();
+    assert_int_equal(SDLW_GetMemoryUsage(), 0);
+}
+
+/**
+ * @brief Benchmark der Ressourcensuche.
+ * 
+ * Lädt 1000 Texturen aus einer generierten Konfigurationsdatei und misst die
+ * Dauer von 10000 Suchen per ID und per Handle.
+ * 
+ * @param state unbenutzt
+ */
+static void test_sdlw_lookup_benchmark(void **state) {
+    (void)state;
+    const int resourceCount = 1000;
+    const int lookupCount = 10000;
+    const char *configFile = "bench_resources.cfg";
+    // Konfigurationsdatei generieren
+    FILE *file = fopen(configFile, "w");
+    assert_non_null(file);
+    for (int i = 0; i < resourceCount; ++i) {
+        fprintf(file, "tex%d texture assets/test/nswo.png\n", i);
+    }
+    fclose(file);
+
+    SDLW_Init(500, 500);
+    assert_int_equal(SDLW_LoadResources((char *)configFile), ERR_OK);
+    remove(configFile);
+
+    char keys[1000][16];
+    sdlwHandle_t handles[1000];
+    for (int i = 0; i < resourceCount; ++i) {
+        sprintf(keys[i], "tex%d", i);
+        handles[i] = SDLW_ResolveHandle(keys[i]);
+        assert_int_not_equal(handles[i], SDLW_INVALID_HANDLE);
+    }
+
+    // Suche per ID
+    void *texture;
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < lookupCount; ++i) {
+        SDLW_GetResource(keys[(i * 7) % resourceCount], RESOURCETYPE_TEXTURE, &texture);
+    }
+    double byId = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+    assert_non_null(texture);
+
+    // Zugriff per Handle
+    start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < lookupCount; ++i) {
+        SDLW_GetResourceByHandle(handles[(i * 7) % resourceCount], RESOURCETYPE_TEXTURE, &texture);
+    }
+    double byHandle = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+    assert_non_null(texture);
+
+    print_message("%d Suchen bei %d Ressourcen: per ID %.3f ms, per Handle %.3f ms\n",
+                  lookupCount, resourceCount, byId * 1000.0, byHandle * 1000.0);
+    SDLW_Quit();
+}
+
 /**
  * @brief Testprogramm
  * 
@@ -214,7 +475,11 @@ int main(void) {
         cmocka_unit_test(test_config_files),
         cmocka_unit_test(test_sdlw_getTexture_and_draw),
         cmocka_unit_test(test_sdlw_getFont_and_create),
-        cmocka_unit_test(test_sdlw_getSound_and_play)
+        cmocka_unit_test(test_sdlw_getSound_and_play),
+        cmocka_unit_test(test_sdlw_handles),
+        cmocka_unit_test(test_sdlw_pack),
+        cmocka_unit_test(test_sdlw_lazy_and_budget),
+        cmocka_unit_test(test_sdlw_lookup_benchmark)
     };
     return cmocka_run_group_tests(sdlwAutoTest, NULL, NULL);
 }
@@ -0,0 +1,327 @@
+/**
+ * @file test_sdlw_decode.c
+ * @brief Tests für das parallele Dekodieren im sdlWrapper-Modul
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ */
+
+/*
+ * Includes
+ *
+ */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdlWrapper.h"
+#include "error.h"
+
+
+/*
+ * Defines
+ *
+ */
+
+/**
+ * @brief Anzahl Gruppen aus Textur, Sprite und Soundeffekt in decode.cfg.
+ *
+ */
+#define DECODE_COUNT 6
+
+/**
+ * @brief Simulierte Dekodierdauer pro Schritt in ms.
+ * Frühe Dateien dauern am längsten und werden daher zuletzt fertig.
+ *
+ */
+#define DECODE_DELAY_MS 5
+
+/**
+ * @brief Gemeldete Anzahl Prozessorkerne, ergibt drei Worker und den
+ * Hauptthread.
+ *
+ */
+#define DECODE_CPU_COUNT 4
+
+
+/*
+ * Mocks
+ *
+ */
+
+static SDL_Surface surfaces[DECODE_COUNT]; //!< Von IMG_Load() gelieferte Surfaces
+static Mix_Chunk chunks[DECODE_COUNT];     //!< Von Mix_LoadWAV_RW() gelieferte Samples
+static SDL_RWops sources[DECODE_COUNT];    //!< Von SDL_RWFromFile() gelieferte Quellen
+
+static SDL_atomic_t activeDecodes; //!< Anzahl gleichzeitig laufender Dekodierungen
+static SDL_atomic_t maxDecodes;    //!< Höchste Anzahl gleichzeitiger Dekodierungen
+static SDL_atomic_t liveSurfaces;  //!< Erstellte aber nicht befreite Surfaces
+static SDL_atomic_t liveChunks;    //!< Erstellte aber nicht befreite Samples
+
+static int createOrder[DECODE_COUNT]; //!< Reihenfolge der hochgeladenen Texturen
+static int createCount;               //!< Anzahl hochgeladener Texturen
+static int failIndex;                 //!< Index dessen Bild nicht dekodiert werden kann
+
+extern SDL_RWops *__real_SDL_RWFromFile(const char *file, const char *mode);
+extern Mix_Chunk *__real_Mix_LoadWAV_RW(SDL_RWops *src, int freesrc);
+extern void __real_SDL_FreeSurface(SDL_Surface *surface);
+extern void __real_Mix_FreeChunk(Mix_Chunk *chunk);
+extern SDL_Texture *__real_SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *surface);
+
+/**
+ * @brief Liest den Index aus einem Dateinamen in assets/test/decode.
+ *
+ * @param file Dateiname wie assets/test/decode/t3.png
+ *
+ * @return Index oder -1 für fremde Dateien
+ */
+static int decodeIndex(const char *file) {
+    if (!strstr(file, "assets/test/decode/"))
+        return -1;
+    return atoi(strrchr(file, '/') + 2);
+}
+
+/**
+ * @brief Simuliert eine Dekodierung und zählt die gleichzeitig laufenden.
+ *
+ * @param index Index der Datei, bestimmt die Dauer
+ */
+static void simulateDecode(int index) {
+    int active = SDL_AtomicAdd(&activeDecodes, 1) + 1;
+    int max = SDL_AtomicGet(&maxDecodes);
+    while (active > max && !SDL_AtomicCAS(&maxDecodes, max, active))
+        max = SDL_AtomicGet(&maxDecodes);
+    SDL_Delay((DECODE_COUNT - index) * DECODE_DELAY_MS);
+    SDL_AtomicAdd(&activeDecodes, -1);
+}
+
+/**
+ * @brief Mock-Ersatz für SDL_GetCPUCount(), unabhängig von der Maschine.
+ *
+ * @return immer \ref DECODE_CPU_COUNT
+ */
+int __wrap_SDL_GetCPUCount(void) {
+    return DECODE_CPU_COUNT;
+}
+
+/**
+ * @brief Mock-Ersatz für IMG_Load(), dekodiert verzögert und nebenläufig.
+ *
+ * @param file Dateiname in assets/test/decode
+ *
+ * @return Surface oder NULL für \ref failIndex
+ */
+SDL_Surface *__wrap_IMG_Load(const char *file) {
+    int index = decodeIndex(file);
+    if (index < 0)
+        return NULL;
+    simulateDecode(index);
+    if (index == failIndex)
+        return NULL;
+    SDL_AtomicAdd(&liveSurfaces, 1);
+    return &surfaces[index];
+}
+
+/**
+ * @brief Mock-Ersatz für SDL_RWFromFile(), ersetzt Dateien in
+ * assets/test/decode.
+ *
+ * @param file Dateiname
+ * @param mode Zugriffsmodus
+ *
+ * @return Quelle
+ */
+SDL_RWops *__wrap_SDL_RWFromFile(const char *file, const char *mode) {
+    int index = decodeIndex(file);
+    if (index < 0)
+        return __real_SDL_RWFromFile(file, mode);
+    return &sources[index];
+}
+
+/**
+ * @brief Mock-Ersatz für Mix_LoadWAV_RW(), dekodiert verzögert und nebenläufig.
+ *
+ * @param src Quelle aus __wrap_SDL_RWFromFile()
+ * @param freesrc Quelle nach dem Laden schliessen
+ *
+ * @return Sample
+ */
+Mix_Chunk *__wrap_Mix_LoadWAV_RW(SDL_RWops *src, int freesrc) {
+    if (src < sources || src >= sources + DECODE_COUNT)
+        return __real_Mix_LoadWAV_RW(src, freesrc);
+    int index = (int)(src - sources);
+    simulateDecode(index);
+    SDL_AtomicAdd(&liveChunks, 1);
+    return &chunks[index];
+}
+
+/**
+ * @brief Mock-Ersatz für SDL_FreeSurface(), zählt befreite Surfaces.
+ *
+ * @param surface Surface
+ */
+void __wrap_SDL_FreeSurface(SDL_Surface *surface) {
+    if (surface >= surfaces && surface < surfaces + DECODE_COUNT)
+        SDL_AtomicAdd(&liveSurfaces, -1);
+    else
+        __real_SDL_FreeSurface(surface);
+}
+
+/**
+ * @brief Mock-Ersatz für Mix_FreeChunk(), zählt befreite Samples.
+ *
+ * @param chunk Sample
+ */
+void __wrap_Mix_FreeChunk(Mix_Chunk *chunk) {
+    if (chunk >= chunks && chunk < chunks + DECODE_COUNT)
+        SDL_AtomicAdd(&liveChunks, -1);
+    else
+        __real_Mix_FreeChunk(chunk);
+}
+
+/**
+ * @brief Mock-Ersatz für SDL_CreateTextureFromSurface(), merkt sich die
+ * Reihenfolge der hochgeladenen Surfaces.
+ *
+ * @param renderer Renderer
+ * @param surface Surface
+ *
+ * @return Textur gemäss \ref mock_sdl.c
+ */
+SDL_Texture *__wrap_SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *surface) {
+    if (surface >= surfaces && surface < surfaces + DECODE_COUNT && createCount < DECODE_COUNT)
+        createOrder[createCount++] = (int)(surface - surfaces);
+    return __real_SDL_CreateTextureFromSurface(renderer, surface);
+}
+
+
+/*
+ * Tests
+ *
+ */
+
+/**
+ * @brief Setup: Mocks zurücksetzen und SDLW initialisieren
+ *
+ * @param state unbenutzt
+ *
+ * @return 0 Setup erfolgreich, -1 Setup fehlgeschlagen
+ */
+static int setupDecode(void **state) {
+    (void)state;
+    SDL_AtomicSet(&activeDecodes, 0);
+    SDL_AtomicSet(&maxDecodes, 0);
+    SDL_AtomicSet(&liveSurfaces, 0);
+    SDL_AtomicSet(&liveChunks, 0);
+    createCount = 0;
+    failIndex = -1;
+    return (SDLW_Init(500, 500) != ERR_OK);
+}
+
+/**
+ * @brief Teardown: SDLW beenden, danach dürfen keine Samples mehr leben
+ *
+ * @param state unbenutzt
+ *
+ * @return 0 Teardown erfolgreich, -1 Teardown fehlgeschlagen
+ */
+static int teardownDecode(void **state) {
+    (void)state;
+    SDLW_Quit();
+    return (SDL_AtomicGet(&liveChunks) != 0);
+}
+
+/**
+ * @brief Dekodiert mit mehreren Workern. Die Dateien werden in umgekehrter
+ * Reihenfolge fertig, die Einträge entstehen trotzdem in der Reihenfolge der
+ * Konfiguration.
+ *
+ * @param state unbenutzt
+ */
+static void test_decode_order(void **state) {
+    (void)state;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    assert_int_equal(SDLW_LoadResources("assets/test/decode.cfg"), ERR_OK);
+    double elapsed = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+
+    // Mehrere Worker haben gleichzeitig dekodiert
+    assert_true(SDL_AtomicGet(&maxDecodes) >= 2);
+    assert_true(SDL_AtomicGet(&maxDecodes) <= DECODE_CPU_COUNT);
+
+    // Texturen in Reihenfolge der Konfiguration hochgeladen, Surfaces befreit
+    assert_int_equal(createCount, DECODE_COUNT);
+    for (int i = 0; i < DECODE_COUNT; ++i)
+        assert_int_equal(createOrder[i], i);
+    assert_int_equal(SDL_AtomicGet(&liveSurfaces), 0);
+
+    // Jeder Soundeffekt gehört zum richtigen Eintrag
+    for (int i = 0; i < DECODE_COUNT; ++i) {
+        char key[8];
+        void *resource = NULL;
+        sprintf(key, "s%d", i);
+        assert_int_equal(SDLW_GetResource(key, RESOURCETYPE_SOUND_EFFECT, &resource), ERR_OK);
+        assert_ptr_equal(resource, &chunks[i]);
+        sprintf(key, "p%d", i);
+        assert_int_equal(SDLW_GetResource(key, RESOURCETYPE_SPRITE, &resource), ERR_OK);
+    }
+    assert_int_equal(SDL_AtomicGet(&liveChunks), DECODE_COUNT);
+
+    // Simulierte Dauer, sagt nichts über echte Dekoder auf dieser Maschine aus
+    int serial = 0;
+    for (int i = 0; i < DECODE_COUNT; ++i)
+        serial += 2 * (DECODE_COUNT - i) * DECODE_DELAY_MS;
+    print_message("Dekodieren mit %d Threads: %.1f ms, seriell %d ms simuliert\n",
+                  SDL_AtomicGet(&maxDecodes), elapsed * 1000.0, serial);
+}
+
+/**
+ * @brief Ein nicht dekodierbares Bild bricht das Laden beim Sprite ab. Bereits
+ * erstellte Einträge bleiben, alle übrigen dekodierten Daten werden befreit.
+ *
+ * @param state unbenutzt
+ */
+static void test_decode_error_cleanup(void **state) {
+    (void)state;
+    const int fail = 3;
+    failIndex = fail;
+    assert_int_equal(SDLW_LoadResources("assets/test/decode.cfg"), ERR_FAIL);
+
+    // Nur die Texturen vor dem Fehler wurden hochgeladen
+    assert_int_equal(createCount, fail);
+    for (int i = 0; i < fail; ++i)
+        assert_int_equal(createOrder[i], i);
+
+    // Einträge vor dem Fehler sind registriert, danach keine mehr
+    void *resource = NULL;
+    char key[8];
+    for (int i = 0; i < DECODE_COUNT; ++i) {
+        int expected = i < fail ? ERR_OK : ERR_FAIL;
+        sprintf(key, "s%d", i);
+        assert_int_equal(SDLW_GetResource(key, RESOURCETYPE_SOUND_EFFECT, &resource), expected);
+        sprintf(key, "p%d", i);
+        assert_int_equal(SDLW_GetResource(key, RESOURCETYPE_SPRITE, &resource), expected);
+    }
+
+    // Surfaces und Samples nach dem Fehler sind befreit
+    assert_int_equal(SDL_AtomicGet(&liveSurfaces), 0);
+    assert_int_equal(SDL_AtomicGet(&liveChunks), fail);
+}
+
+/**
+ * @brief Testprogramm
+ *
+ * @return int Anzahl fehlgeschlagener Tests
+ */
+int main(void) {
+    const struct CMUnitTest sdlwDecodeTest[] = {
+        cmocka_unit_test_setup_teardown(test_decode_order, setupDecode, teardownDecode),
+        cmocka_unit_test_setup_teardown(test_decode_error_cleanup, setupDecode, teardownDecode)
+    };
+    return cmocka_run_group_tests(sdlwDecodeTest, NULL, NULL);
+}
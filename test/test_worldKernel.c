@@ -0,0 +1,125 @@
+/**
+ * @file test_worldKernel.c
+ * @brief Tests für worldKernel-Modul
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ */
+
+/*
+ * Includes
+ *
+ */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "worldKernel.h"
+#include "error.h"
+
+
+/*
+ * Variablendeklarationen
+ *
+ */
+
+static const worldKernel_t kernels[] = {WORLDKERNEL_SCALAR, WORLDKERNEL_SSE2, WORLDKERNEL_AVX2}; //!< Alle Varianten
+static const int counts[] = {0, 1, 7, 8, 15, 16, 63, 64, 65, 127, 1000, 1024};                   //!< Längen über und unter den Vektorbreiten
+
+
+/*
+ * Tests
+ *
+ */
+
+/**
+ * @brief Alle verfügbaren Varianten packen bitgenau gleich wie die Referenz.
+ *
+ * @param state unbenutzt
+ */
+static void pack_alpha_exact(void **state) {
+    (void)state;
+    static uint32_t pixels[1024 + 1];
+    static uint64_t words[16 + 1];
+    srand(15);
+    for (int i = 0; i < 1024 + 1; i++) // Nur einzelne Bits im Alpha gesetzt
+        pixels[i] = ((uint32_t)rand() << 8) | (rand() % 3 ? 0 : 1u << (rand() % 8));
+
+    for (unsigned int k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        if (WorldKernel_Select(kernels[k]))
+            continue; // Auf dieser CPU nicht verfügbar
+        assert_int_equal(WorldKernel_Selected(), kernels[k]);
+        for (unsigned int c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+            int count = counts[c];
+            for (int w = 0; w < 17; w++)
+                words[w] = 0x5A5A5A5A5A5A5A5Aull;
+            WorldKernel_PackAlpha(pixels + 1, count, words); // Nicht ausgerichtet
+            for (int i = 0; i < (count + 63) / 64 * 64; i++) {
+                uint64_t expected = i < count && (pixels[1 + i] & 0xFF);
+                assert_int_equal((words[i / 64] >> (i % 64)) & 1, expected);
+            }
+            // Wörter nach dem Ende bleiben unberührt
+            assert_true(words[(count + 63) / 64] == 0x5A5A5A5A5A5A5A5Aull);
+        }
+    }
+    assert_int_equal(WorldKernel_Select(WORLDKERNEL_AUTO), ERR_OK);
+}
+
+/**
+ * @brief Alle verfügbaren Varianten addieren gleich wie die Referenz.
+ *
+ * @param state unbenutzt
+ */
+static void add_row_exact(void **state) {
+    (void)state;
+    static int32_t row[1024 + 1], delta[1024 + 1], expected[1024 + 1];
+    for (unsigned int k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        if (WorldKernel_Select(kernels[k]))
+            continue;
+        for (unsigned int c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+            int count = counts[c];
+            for (int i = 0; i < 1024 + 1; i++) {
+                row[i] = rand() - RAND_MAX / 2;
+                delta[i] = rand() % 2001 - 1000;
+                expected[i] = i >= 1 && i <= count ? row[i] + delta[i] : row[i];
+            }
+            WorldKernel_AddRow(row + 1, delta + 1, count);
+            assert_memory_equal(row, expected, sizeof(row));
+        }
+    }
+    assert_int_equal(WorldKernel_Select(WORLDKERNEL_AUTO), ERR_OK);
+}
+
+/**
+ * @brief Automatische Wahl ergibt immer eine konkrete Variante.
+ *
+ * @param state unbenutzt
+ */
+static void select_auto(void **state) {
+    (void)state;
+    assert_int_equal(WorldKernel_Select(WORLDKERNEL_AUTO), ERR_OK);
+    assert_true(WorldKernel_Selected() != WORLDKERNEL_AUTO);
+    assert_int_equal(WorldKernel_Select(WORLDKERNEL_SCALAR), ERR_OK);
+    assert_int_equal(WorldKernel_Selected(), WORLDKERNEL_SCALAR);
+    assert_int_equal(WorldKernel_Select((worldKernel_t)42), ERR_PARAMETER);
+    assert_int_equal(WorldKernel_Selected(), WORLDKERNEL_SCALAR);
+    assert_int_equal(WorldKernel_Select(WORLDKERNEL_AUTO), ERR_OK);
+}
+
+/**
+ * @brief Testprogramm
+ *
+ * @return int Anzahl fehlgeschlagener Tests
+ */
+int main(void) {
+    const struct CMUnitTest worldKernelTest[] = {
+        cmocka_unit_test(pack_alpha_exact),
+        cmocka_unit_test(add_row_exact),
+        cmocka_unit_test(select_auto),
+    };
+    return cmocka_run_group_tests(worldKernelTest, NULL, NULL);
+}
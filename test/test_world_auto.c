@@ -20,9 +20,99 @@
 #include <setjmp.h>
 #include <cmocka.h>
 
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include "error.h"
 #include "sdlWrapper.h"
 #include "world.h"
+#include "worldKernel.h"
+
+
+extern int mockSurfaceWidth;              //!< Breite der Testwelt aus mock_surface.c
+extern unsigned long mockTextureUpdates; //!< Anzahl hochgeladener Bereiche aus mock_surface.c
+
+static unsigned char referenceWorld[576][4096]; //!< Solide Pixel der Referenz
+static int referenceWidth = 1024;               //!< Breite der Referenz
+
+/**
+ * @brief Setzt die Referenz auf die Testwelt aus mock_surface.c zurück.
+ * 
+ * @param width Breite der Testwelt
+ */
+static void referenceReset(int width) {
+    referenceWidth = width;
+    for (int y = 0; y < 576; y++) {
+        for (int x = 0; x < width; x++)
+            referenceWorld[y][x] = (y + 100) > x;
+    }
+}
+
+/**
+ * @brief Wendet die Textur aus mock_surface.c ohne Rotation auf die Referenz an.
+ * Die Textur hat die Pixel der 1024 Pixel breiten Testwelt und wird auf
+ * \p destination gestreckt.
+ * 
+ * @param destination Zielrechteck in der Welt
+ * @param solid 0 für eine Maske, 1 für einen Stempel
+ */
+static void referenceApply(SDL_Rect destination, unsigned char solid) {
+    for (int y = destination.y; y < destination.y + destination.h; y++) {
+        for (int x = destination.x; x < destination.x + destination.w; x++) {
+            if (x < 0 || y < 0 || x >= referenceWidth || y >= 576)
+                continue;
+            int sourceX = (int)((x + 0.5 - destination.x) * 1024 / destination.w);
+            int sourceY = (int)((y + 0.5 - destination.y) * 576 / destination.h);
+            if ((sourceY + 100) > sourceX)
+                referenceWorld[y][x] = solid;
+        }
+    }
+}
+
+/**
+ * @brief Schneidet die Maske aus mock_surface.c ohne Rotation aus der Referenz.
+ * 
+ * @param destination Zielrechteck in der Welt
+ */
+static void referenceCarve(SDL_Rect destination) {
+    referenceApply(destination, 0);
+}
+
+/**
+ * @brief Berechnet die Kollision pixelweise an der Referenz.
+ * Referenz für die Summentabelle in World_CheckCollision().
+ * 
+ * @param aabb Das Überprüfungsrechteck
+ * @param[out] collision Erwartete Kollision
+ */
+static void referenceCollision(SDL_Rect aabb, entityCollision_t *collision) {
+    int x1 = aabb.x < 0 ? 0 : aabb.x;
+    int x2 = aabb.x + aabb.w > referenceWidth ? referenceWidth : aabb.x + aabb.w;
+    int y1 = aabb.y < 0 ? 0 : aabb.y;
+    int y2 = aabb.y + aabb.h > 576 ? 576 : aabb.y + aabb.h;
+    int flags = 0, normalX = 0, normalY = 0;
+    for (int x = x1; x < x2; x++) {
+        for (int y = y1; y < y2; y++) {
+            if (!referenceWorld[y][x])
+                continue;
+            flags = ENTITY_COLLISION_WORLD;
+            if (x - aabb.x - aabb.w / 2 > 0) {
+                normalX--;
+            } else if (x - aabb.x - aabb.w / 2 < aabb.w % 2 - 1) {
+                normalX++;
+            }
+            if (y - aabb.y - aabb.h / 2 > 0) {
+                normalY--;
+            } else if (y - aabb.y - aabb.h / 2 < aabb.h % 2 - 1) {
+                normalY++;
+            }
+        }
+    }
+    collision->flags = flags;
+    collision->normal.x = (float)normalX;
+    collision->normal.y = (float)normalY;
+}
 
 
 /**
@@ -69,7 +159,17 @@ void test_world_init_and_load(void **state) {
     assert_int_equal(World_VerticalLineIntersection((SDL_Point){0}, &point), ERR_OK);
     assert_int_equal(World_CreateStartLocations((SDL_Rect){0}, 0, (void *)1), ERR_OK);
 
+    // Nur der Hintergrund bleibt referenziert, bis die Welt geschlossen wird
+    size_t bytes;
+    assert_int_equal(SDLW_SetMemoryBudget(0), ERR_OK);
+    assert_int_equal(SDLW_GetResourceBytes("foreground", &bytes), ERR_OK);
+    assert_int_equal(bytes, 0);
+    assert_int_equal(SDLW_GetResourceBytes("blue", &bytes), ERR_OK);
+    assert_true(bytes > 0);
     World_Quit();
+    assert_int_equal(SDLW_GetResourceBytes("blue", &bytes), ERR_OK);
+    assert_int_equal(bytes, 0);
+    SDLW_SetMemoryBudget(SDLW_DEFAULT_MEMORY_BUDGET);
     SDLW_Quit();
 }
 
@@ -162,6 +262,693 @@ static void test_verticalLineIntersection(void **state) {
     SDLW_Quit();
 }
 
+/**
+ * @brief Testet ob World_Modify() die Maske nur im betroffenen Bereich auf der CPU anwendet.
+ * Die Maske hat im Mock die Pixel der Testwelt, ist also nur links deckend.
+ * 
+ * @param state unbenutzt
+ */
+static void test_modify(void **state) {
+    (void)state;
+    assert_int_equal(SDLW_Init(1024, 576), ERR_OK);
+    assert_int_equal(World_Init(), ERR_OK);
+    assert_int_equal(SDLW_LoadResources("assets/test/config.cfg"), ERR_OK);
+    assert_int_equal(World_Load("world"), ERR_OK);
+
+    // Normale Texturen können nicht angewendet werden
+    sprite_t sprite = {.destination = {0, 0, 20, 20}, .position = {100, 400}};
+    assert_int_equal(SDLW_GetResource("blue", RESOURCETYPE_TEXTURE, (void **)&sprite.texture), ERR_OK);
+    assert_int_equal(World_Modify(sprite), ERR_PARAMETER);
+    SDLW_ReleaseResource("blue");
+
+    // Vorher ist alles um den Punkt fest
+    SDL_Point position;
+    assert_int_equal(World_VerticalLineIntersection((SDL_Point){90, 0}, &position), ERR_OK);
+    assert_int_equal(position.y, 0);
+    assert_int_equal(World_VerticalLineIntersection((SDL_Point){109, 0}, &position), ERR_OK);
+    assert_int_equal(position.y, 10);
+
+    // Maske von 20x20 Pixel bei (100, 400) ausschneiden
+    assert_int_equal(SDLW_GetResource("circle_mask", RESOURCETYPE_TEXTURE, (void **)&sprite.texture), ERR_OK);
+    assert_int_equal(World_Modify(sprite), ERR_OK);
+    // Linke Spalte ist bis unterhalb der Maske frei, ausserhalb bleibt es fest
+    assert_int_equal(World_VerticalLineIntersection((SDL_Point){90, 390}, &position), ERR_OK);
+    assert_int_equal(position.y, 410);
+    assert_int_equal(World_VerticalLineIntersection((SDL_Point){89, 390}, &position), ERR_OK);
+    assert_int_equal(position.y, 390);
+    // Rechts ist die Maske durchsichtig
+    assert_int_equal(World_VerticalLineIntersection((SDL_Point){109, 390}, &position), ERR_OK);
+    assert_int_equal(position.y, 390);
+    entityCollision_t info;
+    assert_int_equal(World_CheckCollision((SDL_Rect){90, 392, 3, 16}, &info), ERR_OK);
+    assert_int_equal(info.flags, 0);
+    SDLW_ReleaseResource("circle_mask");
+
+    World_Quit();
+    SDLW_Quit();
+}
+
+/**
+ * @brief Vergleicht World_CheckCollision() auf einem Raster von Rechtecken mit der Referenz.
+ * 
+ * @param step Abstand der Rechtecke in beiden Richtungen
+ */
+static void crossCheckCollision(int step) {
+    entityCollision_t info, expected;
+    const SDL_Point sizes[] = {{1, 1}, {40, 30}, {63, 5}, {64, 64}, {65, 2}, {129, 17}, {200, 300}};
+    for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        for (int x = -70; x < referenceWidth + 70; x += step) {
+            for (int y = -70; y < 576 + 70; y += step + 4) {
+                SDL_Rect aabb = {x, y, sizes[s].x, sizes[s].y};
+                assert_int_equal(World_CheckCollision(aabb, &info), ERR_OK);
+                referenceCollision(aabb, &expected);
+                assert_int_equal(info.flags & ENTITY_COLLISION_WORLD, expected.flags);
+                assert_int_equal(info.normal.x, expected.normal.x);
+                assert_int_equal(info.normal.y, expected.normal.y);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Testet ob die Summentabelle nach mehreren Modifikationen dieselben
+ * Kollisionen liefert wie die pixelweise Berechnung.
+ * 
+ * @param state unbenutzt
+ */
+static void test_collision_integral(void **state) {
+    (void)state;
+    assert_int_equal(SDLW_Init(1024, 576), ERR_OK);
+    assert_int_equal(World_Init(), ERR_OK);
+    assert_int_equal(SDLW_LoadResources("assets/test/config.cfg"), ERR_OK);
+    assert_int_equal(World_Load("world"), ERR_OK);
+    referenceReset(1024);
+
+    // Masken in der Mitte, überlappend und über die Ränder hinaus
+    const SDL_Rect carves[] = {{90, 390, 20, 20}, {268, 275, 64, 50}, {290, 300, 31, 77}, {-40, 460, 80, 80}, {975, 535, 50, 50}, {0, 0, 1024, 40}};
+    sprite_t sprite = {0};
+    assert_int_equal(SDLW_GetResource("circle_mask", RESOURCETYPE_TEXTURE, (void **)&sprite.texture), ERR_OK);
+    for (unsigned int i = 0; i < sizeof(carves) / sizeof(carves[0]); i++) {
+        sprite.destination = (SDL_Rect){0, 0, carves[i].w, carves[i].h};
+        sprite.position = (SDL_Point){carves[i].x + carves[i].w / 2, carves[i].y + carves[i].h / 2};
+        assert_int_equal(World_Modify(sprite), ERR_OK);
+        referenceCarve(carves[i]);
+        crossCheckCollision(53);
+    }
+    SDLW_ReleaseResource("circle_mask");
+
+    // Neu laden stellt die Testwelt wieder her
+    assert_int_equal(World_Load("world"), ERR_OK);
+    referenceReset(1024);
+    crossCheckCollision(53);
+
+    World_Quit();
+    SDLW_Quit();
+}
+
+/**
+ * @brief Vergleicht die vertikale Suche und die Startpositionen mit der Referenz.
+ * 
+ * @param aabb Kollisionsbox der Startpositionen relativ zum Punkt
+ */
+static void crossCheckVertical(SDL_Rect aabb) {
+    SDL_Point hit;
+    for (int x = 0; x < referenceWidth; x += 3) {
+        for (int start = -5; start < 576; start += 23) {
+            assert_int_equal(World_VerticalLineIntersection((SDL_Point){x, start}, &hit), ERR_OK);
+            int expected = start < 0 ? 0 : start;
+            while (expected < 576 && !referenceWorld[expected][x])
+                expected++;
+            assert_int_equal(hit.x, x);
+            assert_int_equal(hit.y, expected);
+        }
+    }
+
+    // Pixelweise nach oben schieben wie vor der Summentabelle
+    SDL_Point locations[7];
+    assert_int_equal(World_CreateStartLocations(aabb, 7, locations), ERR_OK);
+    for (int c = 1; c <= 7; c++) {
+        int x = c * (referenceWidth / 8);
+        int y = 0;
+        while (y < 576 && !referenceWorld[y][x])
+            y++;
+        entityCollision_t expected;
+        do {
+            y--;
+            if (y < 0)
+                break;
+            referenceCollision((SDL_Rect){x + aabb.x, y + aabb.y, aabb.w, aabb.h}, &expected);
+        } while (expected.flags);
+        assert_int_equal(locations[c - 1].x, x);
+        assert_int_equal(locations[c - 1].y, y);
+    }
+}
+
+/**
+ * @brief Testet ob die Abschnitte der Spalten nach Modifikationen richtig
+ * neu aufgebaut werden, auch mit Höhlen unter der Oberfläche.
+ * 
+ * @param state unbenutzt
+ */
+static void test_heightmap(void **state) {
+    (void)state;
+    assert_int_equal(SDLW_Init(1024, 576), ERR_OK);
+    assert_int_equal(World_Init(), ERR_OK);
+    assert_int_equal(SDLW_LoadResources("assets/test/config.cfg"), ERR_OK);
+    assert_int_equal(World_Load("world"), ERR_OK);
+    referenceReset(1024);
+    crossCheckVertical((SDL_Rect){-20, -30, 40, 30});
+
+    // Höhlen und Überhänge ausschneiden
+    const SDL_Rect carves[] = {{100, 300, 60, 40}, {120, 320, 90, 90}, {380, 350, 100, 30}, {500, 450, 40, 60}, {630, 520, 80, 40}, {250, 0, 30, 200}};
+    sprite_t sprite = {0};
+    assert_int_equal(SDLW_GetResource("circle_mask", RESOURCETYPE_TEXTURE, (void **)&sprite.texture), ERR_OK);
+    for (unsigned int i = 0; i < sizeof(carves) / sizeof(carves[0]); i++) {
+        sprite.destination = (SDL_Rect){0, 0, carves[i].w, carves[i].h};
+        sprite.position = (SDL_Point){carves[i].x + carves[i].w / 2, carves[i].y + carves[i].h / 2};
+        assert_int_equal(World_Modify(sprite), ERR_OK);
+        referenceCarve(carves[i]);
+        crossCheckVertical((SDL_Rect){-20, -30, 40, 30});
+        crossCheckVertical((SDL_Rect){-35, -90, 70, 90});
+    }
+    SDLW_ReleaseResource("circle_mask");
+
+    World_Quit();
+    SDLW_Quit();
+}
+
+/**
+ * @brief Vergleicht das Distanzfeld mit einer Suche im Umkreis an der Referenz.
+ * 
+ * @param step Abstand der geprüften Pixel in beiden Richtungen
+ */
+static void crossCheckDistance(int step) {
+    const int range = 32;
+    for (int y = 0; y < 576; y += step) {
+        for (int x = 0; x < referenceWidth; x += step) {
+            unsigned char solid = referenceWorld[y][x];
+            int nearest = (range + 1) * (range + 1);
+            for (int v = y - range - 1; v <= y + range + 1; v++) {
+                for (int u = x - range - 1; u <= x + range + 1; u++) {
+                    if (u < 0 || v < 0 || u >= referenceWidth || v >= 576 || referenceWorld[v][u] == solid)
+                        continue;
+                    int squared = (u - x) * (u - x) + (v - y) * (v - y);
+                    if (squared < nearest)
+                        nearest = squared;
+                }
+            }
+            float expected = sqrtf((float)nearest) - 0.5f;
+            if (expected > range)
+                expected = range;
+            if (solid)
+                expected = -expected;
+            worldDistance_t sample;
+            assert_int_equal(World_GetDistance((SDL_Point){x, y}, &sample), ERR_OK);
+            assert_float_equal(sample.distance, expected, 0.04f);
+        }
+    }
+}
+
+/**
+ * @brief Testet eine Welt, die breiter ist als das Fenster. Die rechte Seite
+ * der Testwelt ist leer, dort werden keine Abschnitte angelegt, bis ein
+ * Stempel Gelände hinzufügt.
+ * 
+ * @param state unbenutzt
+ */
+static void test_largeWorld(void **state) {
+    (void)state;
+    assert_int_equal(SDLW_Init(1024, 576), ERR_OK);
+    assert_int_equal(World_Init(), ERR_OK);
+    assert_int_equal(World_GetSize(NULL), ERR_FAIL);
+    assert_int_equal(SDLW_LoadResources("assets/test/config.cfg"), ERR_OK);
+    mockSurfaceWidth = 4096;
+    assert_int_equal(World_Load("world"), ERR_OK);
+    mockSurfaceWidth = 1024;
+    referenceReset(4096);
+
+    // Die Welt ist so gross wie der Vordergrund
+    SDL_Point size;
+    assert_int_equal(World_GetSize(NULL), ERR_NULLPARAMETER);
+    assert_int_equal(World_GetSize(&size), ERR_OK);
+    assert_int_equal(size.x, 4096);
+    assert_int_equal(size.y, 576);
+
+    // Rechts ist die Welt leer
+    entityCollision_t info;
+    SDL_Point hit;
+    assert_int_equal(World_CheckCollision((SDL_Rect){3000, 0, 500, 576}, &info), ERR_OK);
+    assert_int_equal(info.flags, 0);
+    assert_int_equal(World_VerticalLineIntersection((SDL_Point){4095, 0}, &hit), ERR_OK);
+    assert_int_equal(hit.y, 576);
+    assert_int_equal(World_VerticalLineIntersection((SDL_Point){4096, 0}, &hit), ERR_PARAMETER);
+    crossCheckCollision(97);
+    crossCheckVertical((SDL_Rect){-20, -30, 40, 30});
+
+    // Verschieben des Ausschnitts ändert nichts an der Kollision
+    SDL_Rect viewport;
+    assert_int_equal(World_GetViewport(NULL), ERR_NULLPARAMETER);
+    assert_int_equal(World_SetViewport((SDL_Point){3072, 0}), ERR_OK);
+    assert_int_equal(World_GetViewport(&viewport), ERR_OK);
+    assert_int_equal(viewport.x, 3072);
+    assert_int_equal(viewport.y, 0);
+    assert_int_equal(viewport.w, 1024);
+    assert_int_equal(World_DrawForeground(), ERR_OK);
+
+    // Stempel in leere Abschnitte und über Abschnittsgrenzen
+    const SDL_Rect stamps[] = {{3000, 400, 200, 150}, {2040, 250, 20, 20}, {4000, 500, 200, 200}};
+    sprite_t sprite = {0};
+    assert_int_equal(SDLW_GetResource("circle_stamp", RESOURCETYPE_TEXTURE, (void **)&sprite.texture), ERR_OK);
+    for (unsigned int i = 0; i < sizeof(stamps) / sizeof(stamps[0]); i++) {
+        sprite.destination = (SDL_Rect){0, 0, stamps[i].w, stamps[i].h};
+        sprite.position = (SDL_Point){stamps[i].x + stamps[i].w / 2, stamps[i].y + stamps[i].h / 2};
+        assert_int_equal(World_Modify(sprite), ERR_OK);
+        referenceApply(stamps[i], 1);
+    }
+    SDLW_ReleaseResource("circle_stamp");
+    assert_int_equal(World_VerticalLineIntersection((SDL_Point){3001, 0}, &hit), ERR_OK);
+    assert_true(hit.y < 576);
+    crossCheckCollision(97);
+    crossCheckVertical((SDL_Rect){-20, -30, 40, 30});
+
+    // Masken über gestempeltem und geladenem Gelände
+    const SDL_Rect carves[] = {{3050, 420, 80, 80}, {600, 500, 100, 100}};
+    assert_int_equal(SDLW_GetResource("circle_mask", RESOURCETYPE_TEXTURE, (void **)&sprite.texture), ERR_OK);
+    for (unsigned int i = 0; i < sizeof(carves) / sizeof(carves[0]); i++) {
+        sprite.destination = (SDL_Rect){0, 0, carves[i].w, carves[i].h};
+        sprite.position = (SDL_Point){carves[i].x + carves[i].w / 2, carves[i].y + carves[i].h / 2};
+        assert_int_equal(World_Modify(sprite), ERR_OK);
+        referenceCarve(carves[i]);
+    }
+    SDLW_ReleaseResource("circle_mask");
+    crossCheckCollision(97);
+    crossCheckVertical((SDL_Rect){-20, -30, 40, 30});
+    crossCheckDistance(13);
+
+    World_Quit();
+    SDLW_Quit();
+}
+
+/**
+ * @brief Vergleicht World_Sweep() mit einer pixelweisen Verschiebung an der Referenz.
+ * 
+ * @param aabb Kollisionsbox an der Startposition
+ * @param delta Verschiebung
+ */
+static void crossCheckSweep(SDL_Rect aabb, SDL_Point delta) {
+    worldHit_t hit;
+    assert_int_equal(World_Sweep(aabb, delta, &hit), ERR_OK);
+    int steps = abs(delta.x) > abs(delta.y) ? abs(delta.x) : abs(delta.y);
+    SDL_Point previous = {aabb.x, aabb.y};
+    for (int i = 0; i <= steps; i++) {
+        SDL_Point offset = {0, 0};
+        if (steps) {
+            offset.x = (int)lround((double)delta.x * i / steps);
+            offset.y = (int)lround((double)delta.y * i / steps);
+        }
+        SDL_Point current = {aabb.x + offset.x, aabb.y + offset.y};
+        entityCollision_t expected;
+        referenceCollision((SDL_Rect){current.x, current.y, aabb.w, aabb.h}, &expected);
+        if (expected.flags) {
+            assert_int_equal(hit.hit, 1);
+            assert_int_equal(hit.contact.x, current.x);
+            assert_int_equal(hit.contact.y, current.y);
+            assert_int_equal(hit.position.x, previous.x);
+            assert_int_equal(hit.position.y, previous.y);
+            assert_float_equal(hit.fraction, steps ? (float)i / steps : 0.0f, 0.0001f);
+            return;
+        }
+        previous = current;
+    }
+    assert_int_equal(hit.hit, 0);
+    assert_int_equal(hit.position.x, aabb.x + delta.x);
+    assert_int_equal(hit.position.y, aabb.y + delta.y);
+}
+
+/**
+ * @brief Testet Strahlen und bewegte AABBs gegen die Referenz, auch durch
+ * schmale Wände, die eine schrittweise Prüfung der Endposition verpasst.
+ * 
+ * @param state unbenutzt
+ */
+static void test_raycast(void **state) {
+    (void)state;
+    assert_int_equal(SDLW_Init(1024, 576), ERR_OK);
+    assert_int_equal(World_Init(), ERR_OK);
+    worldHit_t hit;
+    assert_int_equal(World_Raycast((SDL_Point){0, 0}, (SDL_Point){10, 10}, &hit), ERR_FAIL);
+    assert_int_equal(SDLW_LoadResources("assets/test/config.cfg"), ERR_OK);
+    assert_int_equal(World_Load("world"), ERR_OK);
+    referenceReset(1024);
+    assert_int_equal(World_Raycast((SDL_Point){0, 0}, (SDL_Point){10, 10}, NULL), ERR_NULLPARAMETER);
+    assert_int_equal(World_Sweep((SDL_Rect){0, 0, 0, 5}, (SDL_Point){10, 10}, &hit), ERR_PARAMETER);
+
+    // Waagrechter Strahl von rechts in den Hang, die Kante liegt bei x = y + 99
+    assert_int_equal(World_Raycast((SDL_Point){1000, 300}, (SDL_Point){0, 300}, &hit), ERR_OK);
+    assert_int_equal(hit.hit, 1);
+    assert_int_equal(hit.contact.x, 399);
+    assert_int_equal(hit.position.x, 400);
+    assert_int_equal(hit.contact.y, 300);
+    // Start im Gelände
+    assert_int_equal(World_Raycast((SDL_Point){0, 300}, (SDL_Point){1000, 300}, &hit), ERR_OK);
+    assert_int_equal(hit.hit, 1);
+    assert_float_equal(hit.fraction, 0.0f, 0.0001f);
+    // Über den Rand hinaus ist nichts solid
+    assert_int_equal(World_Raycast((SDL_Point){900, 10}, (SDL_Point){1500, -300}, &hit), ERR_OK);
+    assert_int_equal(hit.hit, 0);
+    assert_int_equal(hit.position.x, 1500);
+
+    // Eine Wand von zwei Pixel Breite durch einen Stempel, die Endposition ist frei
+    sprite_t sprite = {.destination = {0, 0, 4, 300}, .position = {802, 150}};
+    assert_int_equal(SDLW_GetResource("circle_stamp", RESOURCETYPE_TEXTURE, (void **)&sprite.texture), ERR_OK);
+    assert_int_equal(World_Modify(sprite), ERR_OK);
+    SDLW_ReleaseResource("circle_stamp");
+    referenceApply((SDL_Rect){800, 0, 4, 300}, 1);
+    entityCollision_t info;
+    assert_int_equal(World_CheckCollision((SDL_Rect){900, 200, 5, 5}, &info), ERR_OK);
+    assert_int_equal(info.flags, 0);
+    assert_int_equal(World_Sweep((SDL_Rect){700, 200, 5, 5}, (SDL_Point){200, 0}, &hit), ERR_OK);
+    assert_int_equal(hit.hit, 1);
+    assert_int_equal(hit.contact.x, 796);
+    assert_int_equal(hit.position.x, 795);
+
+    // Strahlen und AABBs in alle Richtungen
+    const SDL_Point sizes[] = {{1, 1}, {5, 5}, {40, 30}, {200, 3}};
+    for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        for (int i = 0; i < 400; i++) {
+            SDL_Rect aabb = {(i * 97) % 1200 - 80, (i * 61) % 700 - 60, sizes[s].x, sizes[s].y};
+            SDL_Point delta = {(i * 37) % 1100 - 550, (i * 53) % 800 - 400};
+            crossCheckSweep(aabb, delta);
+        }
+        crossCheckSweep((SDL_Rect){600, 10, sizes[s].x, sizes[s].y}, (SDL_Point){0, 0});
+    }
+
+    World_Quit();
+    SDLW_Quit();
+}
+
+/**
+ * @brief Testet das Distanzfeld nach dem Laden und nach Modifikationen sowie
+ * die Normale am Hang der Testwelt.
+ * 
+ * @param state unbenutzt
+ */
+static void test_distance(void **state) {
+    (void)state;
+    assert_int_equal(SDLW_Init(1024, 576), ERR_OK);
+    assert_int_equal(World_Init(), ERR_OK);
+    worldDistance_t sample;
+    assert_int_equal(World_GetDistance((SDL_Point){0, 0}, &sample), ERR_FAIL);
+    assert_int_equal(SDLW_LoadResources("assets/test/config.cfg"), ERR_OK);
+    assert_int_equal(World_Load("world"), ERR_OK);
+    referenceReset(1024);
+    assert_int_equal(World_GetDistance((SDL_Point){0, 0}, NULL), ERR_NULLPARAMETER);
+    crossCheckDistance(7);
+
+    // Der Hang x = y + 100 steigt nach rechts oben, die Normale zeigt hinaus
+    assert_int_equal(World_GetDistance((SDL_Point){400, 300}, &sample), ERR_OK);
+    assert_float_equal(sample.normal.x, 0.7071f, 0.01f);
+    assert_float_equal(sample.normal.y, -0.7071f, 0.01f);
+    // Fern vom Gelände und ausserhalb der Welt gibt es keine Normale
+    assert_int_equal(World_GetDistance((SDL_Point){900, 10}, &sample), ERR_OK);
+    assert_float_equal(sample.distance, 32.0f, 0.001f);
+    assert_float_equal(sample.normal.x, 0.0f, 0.001f);
+    assert_int_equal(World_GetDistance((SDL_Point){-100, 10}, &sample), ERR_OK);
+    assert_float_equal(sample.distance, 32.0f, 0.001f);
+
+    // Nach Masken und Stempeln wird die Umgebung nachgeführt
+    sprite_t sprite = {0};
+    const SDL_Rect carves[] = {{150, 300, 60, 60}, {-20, 500, 100, 100}, {380, 350, 100, 30}};
+    assert_int_equal(SDLW_GetResource("circle_mask", RESOURCETYPE_TEXTURE, (void **)&sprite.texture), ERR_OK);
+    for (unsigned int i = 0; i < sizeof(carves) / sizeof(carves[0]); i++) {
+        sprite.destination = (SDL_Rect){0, 0, carves[i].w, carves[i].h};
+        sprite.position = (SDL_Point){carves[i].x + carves[i].w / 2, carves[i].y + carves[i].h / 2};
+        assert_int_equal(World_Modify(sprite), ERR_OK);
+        referenceCarve(carves[i]);
+    }
+    SDLW_ReleaseResource("circle_mask");
+    crossCheckDistance(5);
+    const SDL_Rect stamps[] = {{700, 100, 40, 40}, {600, 0, 30, 300}};
+    assert_int_equal(SDLW_GetResource("circle_stamp", RESOURCETYPE_TEXTURE, (void **)&sprite.texture), ERR_OK);
+    for (unsigned int i = 0; i < sizeof(stamps) / sizeof(stamps[0]); i++) {
+        sprite.destination = (SDL_Rect){0, 0, stamps[i].w, stamps[i].h};
+        sprite.position = (SDL_Point){stamps[i].x + stamps[i].w / 2, stamps[i].y + stamps[i].h / 2};
+        assert_int_equal(World_Modify(sprite), ERR_OK);
+        referenceApply(stamps[i], 1);
+    }
+    SDLW_ReleaseResource("circle_stamp");
+    crossCheckDistance(5);
+
+    World_Quit();
+    SDLW_Quit();
+}
+
+/**
+ * @brief Testet ob vorgemerkte Modifikationen erst beim Anwenden und dann
+ * gleich wie einzelne Modifikationen wirken, mit einem Upload pro Abschnitt.
+ * 
+ * @param state unbenutzt
+ */
+static void test_queueModify(void **state) {
+    (void)state;
+    assert_int_equal(SDLW_Init(1024, 576), ERR_OK);
+    assert_int_equal(World_Init(), ERR_OK);
+    assert_int_equal(World_QueueModify((sprite_t){0}), ERR_FAIL);
+    assert_int_equal(World_ApplyModifications(), ERR_OK); // Ohne Welt nichts zu tun
+    assert_int_equal(SDLW_LoadResources("assets/test/config.cfg"), ERR_OK);
+    assert_int_equal(World_Load("world"), ERR_OK);
+    referenceReset(1024);
+
+    // Normale Texturen werden sofort abgewiesen
+    sprite_t sprite = {.destination = {0, 0, 20, 20}, .position = {100, 400}};
+    assert_int_equal(SDLW_GetResource("blue", RESOURCETYPE_TEXTURE, (void **)&sprite.texture), ERR_OK);
+    assert_int_equal(World_QueueModify(sprite), ERR_PARAMETER);
+    SDLW_ReleaseResource("blue");
+
+    // Mehrere Explosionen im selben Abschnitt und eine weit entfernt, mehr
+    // als die erste Allozierung der Warteschlange
+    const SDL_Rect carves[] = {{10, 400, 30, 30}, {20, 410, 30, 30}, {30, 420, 30, 30}, {40, 400, 30, 30},
+                               {50, 410, 30, 30}, {60, 420, 30, 30}, {70, 400, 30, 30}, {80, 410, 30, 30},
+                               {90, 390, 30, 30}, {400, 450, 40, 40}};
+    assert_int_equal(SDLW_GetResource("circle_mask", RESOURCETYPE_TEXTURE, (void **)&sprite.texture), ERR_OK);
+    for (unsigned int i = 0; i < sizeof(carves) / sizeof(carves[0]); i++) {
+        sprite.destination = (SDL_Rect){0, 0, carves[i].w, carves[i].h};
+        sprite.position = (SDL_Point){carves[i].x + carves[i].w / 2, carves[i].y + carves[i].h / 2};
+        assert_int_equal(World_QueueModify(sprite), ERR_OK);
+        referenceCarve(carves[i]);
+    }
+    SDLW_ReleaseResource("circle_mask");
+
+    // Vor dem Anwenden ist die Welt unverändert
+    SDL_Point hit;
+    assert_int_equal(World_VerticalLineIntersection((SDL_Point){50, 390}, &hit), ERR_OK);
+    assert_int_equal(hit.y, 390);
+
+    // Die ersten neun liegen alle im Abschnitt (0, 3), die letzte in (3, 3)
+    mockTextureUpdates = 0;
+    assert_int_equal(World_ApplyModifications(), ERR_OK);
+    assert_int_equal(mockTextureUpdates, 2);
+    crossCheckCollision(53);
+    crossCheckVertical((SDL_Rect){-20, -30, 40, 30});
+    crossCheckDistance(7);
+
+    // Die Warteschlange ist danach leer
+    mockTextureUpdates = 0;
+    assert_int_equal(World_ApplyModifications(), ERR_OK);
+    assert_int_equal(mockTextureUpdates, 0);
+
+    // Neu laden verwirft vorgemerkte Modifikationen
+    assert_int_equal(SDLW_GetResource("circle_mask", RESOURCETYPE_TEXTURE, (void **)&sprite.texture), ERR_OK);
+    assert_int_equal(World_QueueModify(sprite), ERR_OK);
+    SDLW_ReleaseResource("circle_mask");
+    assert_int_equal(World_Load("world"), ERR_OK);
+    referenceReset(1024);
+    assert_int_equal(World_ApplyModifications(), ERR_OK);
+    crossCheckCollision(53);
+
+    World_Quit();
+    SDLW_Quit();
+}
+
+/**
+ * @brief Lässt in der Referenz alles Gelände spaltenweise auf den Boden fallen.
+ * 
+ */
+static void referenceSettle(void) {
+    for (int x = 0; x < referenceWidth; x++) {
+        int solid = 0;
+        for (int y = 0; y < 576; y++)
+            solid += referenceWorld[y][x];
+        for (int y = 0; y < 576; y++)
+            referenceWorld[y][x] = y >= 576 - solid;
+    }
+}
+
+/**
+ * @brief Testet das Absetzen von losem Gelände mit World_Settle().
+ * 
+ * @param state unbenutzt
+ */
+static void test_settle(void **state) {
+    (void)state;
+    assert_int_equal(SDLW_Init(1024, 576), ERR_OK);
+    assert_int_equal(World_Init(), ERR_OK);
+    assert_int_equal(World_SetSettling(1), ERR_OK);
+    assert_int_equal(World_Settle(), ERR_OK); // Ohne Welt nichts zu tun
+    assert_int_equal(World_SetSettling(0), ERR_OK);
+    assert_int_equal(SDLW_LoadResources("assets/test/config.cfg"), ERR_OK);
+    assert_int_equal(World_Load("world"), ERR_OK);
+    referenceReset(1024);
+
+    // Ausgeschaltet bleibt der Überhang über dem Tunnel hängen
+    sprite_t sprite = {.destination = {0, 0, 60, 60}, .position = {180, 330}};
+    assert_int_equal(SDLW_GetResource("circle_mask", RESOURCETYPE_TEXTURE, (void **)&sprite.texture), ERR_OK);
+    assert_int_equal(World_Modify(sprite), ERR_OK);
+    referenceCarve((SDL_Rect){150, 300, 60, 60});
+    mockTextureUpdates = 0;
+    assert_int_equal(World_Settle(), ERR_OK);
+    assert_int_equal(mockTextureUpdates, 0);
+    crossCheckCollision(53);
+
+    // Eingeschaltet wecken neue Modifikationen ihre Abschnitte, hier vier
+    // Stück, damit auch Worker gestartet werden
+    assert_int_equal(World_SetSettling(1), ERR_OK);
+    const SDL_Rect carves[] = {{170, 330, 60, 60}, {600, 540, 30, 30}};
+    for (unsigned int i = 0; i < sizeof(carves) / sizeof(carves[0]); i++) {
+        sprite.destination = (SDL_Rect){0, 0, carves[i].w, carves[i].h};
+        sprite.position = (SDL_Point){carves[i].x + carves[i].w / 2, carves[i].y + carves[i].h / 2};
+        assert_int_equal(World_QueueModify(sprite), ERR_OK);
+    }
+    SDLW_ReleaseResource("circle_mask");
+    assert_int_equal(World_ApplyModifications(), ERR_OK);
+
+    // Stempel im leeren Himmel fällt durch noch nicht angelegte Abschnitte
+    assert_int_equal(SDLW_GetResource("circle_stamp", RESOURCETYPE_TEXTURE, (void **)&sprite.texture), ERR_OK);
+    sprite.destination = (SDL_Rect){0, 0, 40, 40};
+    sprite.position = (SDL_Point){720, 40};
+    assert_int_equal(World_Modify(sprite), ERR_OK);
+    SDLW_ReleaseResource("circle_stamp");
+
+    // Pro Schritt fällt Gelände höchstens um zwei Pixel, danach schlafen alle
+    // Abschnitte und es wird nichts mehr hochgeladen
+    int steps = 0;
+    do {
+        mockTextureUpdates = 0;
+        assert_int_equal(World_Settle(), ERR_OK);
+    } while (mockTextureUpdates && ++steps < 600);
+    assert_true(steps > 0 && steps < 600);
+    assert_int_equal(World_Settle(), ERR_OK);
+
+    // Gelände liegt spaltenweise auf dem Boden auf
+    referenceCarve(carves[0]);
+    referenceCarve(carves[1]);
+    referenceApply((SDL_Rect){700, 20, 40, 40}, 1);
+    referenceSettle();
+    crossCheckCollision(53);
+    crossCheckVertical((SDL_Rect){-20, -30, 40, 30});
+    crossCheckDistance(7);
+
+    World_Quit();
+    SDLW_Quit();
+}
+
+/**
+ * @brief Testet World_Snapshot() und World_Restore().
+ * 
+ * @param state unbenutzt
+ */
+static void test_snapshot(void **state) {
+    (void)state;
+    assert_int_equal(SDLW_Init(1024, 576), ERR_OK);
+    assert_int_equal(World_Init(), ERR_OK);
+    worldSnapshot_t pristine, destroyed, other;
+    assert_int_equal(World_Snapshot(NULL), ERR_NULLPARAMETER);
+    assert_int_equal(World_Snapshot(&pristine), ERR_FAIL);
+    assert_int_equal(World_Restore(NULL), ERR_NULLPARAMETER);
+    assert_int_equal(SDLW_LoadResources("assets/test/config.cfg"), ERR_OK);
+    assert_int_equal(World_Load("world"), ERR_OK);
+    referenceReset(1024);
+
+    // Die geladene Welt braucht nur den Kopf
+    assert_int_equal(World_Snapshot(&pristine), ERR_OK);
+    assert_true(pristine.size < 64);
+
+    // Masken kosten nur Läufe, Stempel zusätzlich ihre Pixel
+    const SDL_Rect carves[] = {{10, 400, 60, 60}, {300, 300, 80, 80}, {600, 530, 40, 40}};
+    sprite_t sprite = {0};
+    assert_int_equal(SDLW_GetResource("circle_mask", RESOURCETYPE_TEXTURE, (void **)&sprite.texture), ERR_OK);
+    for (unsigned int i = 0; i < sizeof(carves) / sizeof(carves[0]); i++) {
+        sprite.destination = (SDL_Rect){0, 0, carves[i].w, carves[i].h};
+        sprite.position = (SDL_Point){carves[i].x + carves[i].w / 2, carves[i].y + carves[i].h / 2};
+        assert_int_equal(World_Modify(sprite), ERR_OK);
+        referenceCarve(carves[i]);
+    }
+    SDLW_ReleaseResource("circle_mask");
+    assert_int_equal(World_Snapshot(&destroyed), ERR_OK);
+    assert_true(destroyed.size < 2048);
+    World_FreeSnapshot(&destroyed);
+    assert_int_equal(SDLW_GetResource("circle_stamp", RESOURCETYPE_TEXTURE, (void **)&sprite.texture), ERR_OK);
+    sprite.destination = (SDL_Rect){0, 0, 30, 30};
+    sprite.position = (SDL_Point){815, 215};
+    assert_int_equal(World_Modify(sprite), ERR_OK);
+    referenceApply((SDL_Rect){800, 200, 30, 30}, 1);
+    SDLW_ReleaseResource("circle_stamp");
+    assert_int_equal(World_Snapshot(&destroyed), ERR_OK);
+    assert_true(destroyed.size < 8192);
+    static unsigned char saved[576][4096];
+    memcpy(saved, referenceWorld, sizeof(saved));
+
+    // Weitere Zerstörung und Wiederherstellen, unveränderte Abschnitte
+    // werden dabei nicht hochgeladen
+    assert_int_equal(SDLW_GetResource("circle_mask", RESOURCETYPE_TEXTURE, (void **)&sprite.texture), ERR_OK);
+    sprite.destination = (SDL_Rect){0, 0, 100, 100};
+    sprite.position = (SDL_Point){350, 350};
+    assert_int_equal(World_Modify(sprite), ERR_OK);
+    SDLW_ReleaseResource("circle_mask");
+    mockTextureUpdates = 0;
+    assert_int_equal(World_Restore(&destroyed), ERR_OK);
+    assert_true(mockTextureUpdates > 0 && mockTextureUpdates <= 4);
+    crossCheckCollision(53);
+    crossCheckVertical((SDL_Rect){-20, -30, 40, 30});
+    crossCheckDistance(7);
+    mockTextureUpdates = 0;
+    assert_int_equal(World_Restore(&destroyed), ERR_OK);
+    assert_int_equal(mockTextureUpdates, 0);
+
+    // Zurück zur geladenen Welt und wieder vorwärts
+    assert_int_equal(World_Restore(&pristine), ERR_OK);
+    referenceReset(1024);
+    crossCheckCollision(53);
+    crossCheckDistance(7);
+    assert_int_equal(World_Snapshot(&other), ERR_OK);
+    assert_int_equal(other.size, pristine.size);
+    World_FreeSnapshot(&other);
+    assert_int_equal(World_Restore(&destroyed), ERR_OK);
+    memcpy(referenceWorld, saved, sizeof(saved));
+    crossCheckCollision(53);
+    crossCheckVertical((SDL_Rect){-20, -30, 40, 30});
+
+    // Beschädigte Schnappschüsse verändern nichts
+    destroyed.size -= 1;
+    assert_int_equal(World_Restore(&destroyed), ERR_PARAMETER);
+    destroyed.size += 1;
+    ((char *)destroyed.data)[0] ^= 1; // Andere Welt
+    assert_int_equal(World_Restore(&destroyed), ERR_PARAMETER);
+    ((char *)destroyed.data)[0] ^= 1;
+    crossCheckCollision(53);
+
+    // Schnappschüsse gelten nur für ihre Welt
+    assert_int_equal(World_Load("worlds"), ERR_OK);
+    assert_int_equal(World_Restore(&destroyed), ERR_PARAMETER);
+
+    World_FreeSnapshot(&destroyed);
+    assert_null(destroyed.data);
+    World_FreeSnapshot(&pristine);
+    World_FreeSnapshot(NULL);
+    World_Quit();
+    SDLW_Quit();
+}
+
 /**
  * @brief Testet ob die Funktion World_CreateStartLocations() die richtigen Werte zurückgibt.
  * 
@@ -218,6 +1005,76 @@ static void test_createStartLocations(void **state) {
     SDLW_Quit();
 }
 
+/**
+ * @brief Vergleicht die Kollision mit der pixelweisen Referenz und misst den Durchsatz.
+ * 
+ * Rechtecke unterschiedlicher Grösse und Wortausrichtung werden über die
+ * ganze Welt geschoben. Danach werden je 100000 Abfragen von 5x5 bis 200x200,
+ * 10000 vertikale Suchen und das Laden der Welt mit jeder Variante der
+ * Schleifen aus worldKernel.h gemessen.
+ * 
+ * @param state unbenutzt
+ */
+static void test_collision_benchmark(void **state) {
+    (void)state;
+    entityCollision_t info;
+    SDL_Point point;
+
+    assert_int_equal(SDLW_Init(1024, 576), ERR_OK);
+    assert_int_equal(World_Init(), ERR_OK);
+    assert_int_equal(SDLW_LoadResources("assets/test/config.cfg"), ERR_OK);
+    assert_int_equal(World_Load("world"), ERR_OK);
+
+    // Übereinstimmung mit der Referenz, auch über Wortgrenzen und Ränder
+    referenceReset(1024);
+    crossCheckCollision(37);
+
+    // Durchsatz der Kollisionsabfrage, von Geschossen bis zu grossen Rechtecken
+    const SDL_Point querySizes[] = {{5, 5}, {20, 20}, {40, 30}, {100, 100}, {200, 200}};
+    const int queryCount = 100000;
+    for (unsigned int s = 0; s < sizeof(querySizes) / sizeof(querySizes[0]); s++) {
+        int hits = 0;
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < queryCount; i++) {
+            SDL_Rect aabb = {(i * 7) % 1024 - querySizes[s].x / 2, (i * 13) % 576 - querySizes[s].y / 2, querySizes[s].x, querySizes[s].y};
+            World_CheckCollision(aabb, &info);
+            hits += (info.flags & ENTITY_COLLISION_WORLD) != 0;
+        }
+        double collisionTime = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+        assert_true(hits > 0);
+        print_message("%d Kollisionsabfragen %dx%d: %.3f ms (%.1f MPixel/s)\n", queryCount, querySizes[s].x, querySizes[s].y,
+                      collisionTime * 1000.0, queryCount * (double)querySizes[s].x * querySizes[s].y / collisionTime / 1e6);
+    }
+
+    // Durchsatz der vertikalen Suche
+    const int lineCount = 10000;
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < lineCount; i++) {
+        World_VerticalLineIntersection((SDL_Point){(i * 7) % 1024, 0}, &point);
+    }
+    double lineTime = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+    print_message("%d vertikale Suchen: %.3f ms\n", lineCount, lineTime * 1000.0);
+
+    // Aufbau von Kollisionsraster und Summentabelle beim Laden, je Variante der Schleifen
+    const worldKernel_t kernels[] = {WORLDKERNEL_SCALAR, WORLDKERNEL_SSE2, WORLDKERNEL_AVX2};
+    const char *kernelNames[] = {"skalar", "SSE2", "AVX2"};
+    const int loadCount = 20;
+    for (unsigned int k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        if (WorldKernel_Select(kernels[k]))
+            continue;
+        start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < loadCount; i++)
+            World_Load("world");
+        double loadTime = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+        print_message("%d Welten laden (%s): %.3f ms\n", loadCount, kernelNames[k], loadTime * 1000.0);
+        crossCheckCollision(97);
+    }
+    WorldKernel_Select(WORLDKERNEL_AUTO);
+
+    World_Quit();
+    SDLW_Quit();
+}
+
 /**
  * @brief Testprogramm
  * 
@@ -228,6 +1085,16 @@ int main(void) {
         cmocka_unit_test(test_world_init_and_load),
         cmocka_unit_test(test_checkCollision),
         cmocka_unit_test(test_verticalLineIntersection),
-        cmocka_unit_test(test_createStartLocations)};
+        cmocka_unit_test(test_modify),
+        cmocka_unit_test(test_createStartLocations),
+        cmocka_unit_test(test_collision_integral),
+        cmocka_unit_test(test_heightmap),
+        cmocka_unit_test(test_largeWorld),
+        cmocka_unit_test(test_raycast),
+        cmocka_unit_test(test_distance),
+        cmocka_unit_test(test_queueModify),
+        cmocka_unit_test(test_settle),
+        cmocka_unit_test(test_snapshot),
+        cmocka_unit_test(test_collision_benchmark)};
     return cmocka_run_group_tests(worldAutoTest, NULL, NULL);
 }